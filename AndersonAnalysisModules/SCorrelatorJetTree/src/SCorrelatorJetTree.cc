@@ -79,6 +79,9 @@ int SCorrelatorJetTree::Init(PHCompositeNode *topNode) {
     createJetNode(topNode);
   }
 
+  // publish jets & constituents for downstream modules
+  createCorrJetNodes(topNode);
+
   // initialize QA histograms and output trees
   initializeHists();
   initializeTrees();
@@ -27,6 +27,7 @@
 // phool includes
 #include <phool/phool.h>
 #include <phool/getClass.h>
+#include <phool/PHDataNode.h>
 #include <phool/PHIODataNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHCompositeNode.h>
@@ -79,6 +80,9 @@
 
 #pragma GCC diagnostic pop
 
+// user includes
+#include "SCorrelatorJets.h"
+
 using namespace std;
 using namespace fastjet;
 using namespace findNode;
@@ -248,12 +252,16 @@ class SCorrelatorJetTree : public SubsysReco {
     void setSaveDST(bool s)                 {m_save_dst = s;}
     void setIsMC(bool b)                    {m_ismc = b;}
     void setSaveDSTMC(bool s)               {m_save_truth_dst = s;}
+    void setSaveTrees(bool s)               {m_save_trees = s;}
+    void setCorrJetNodeName(std::string n)  {m_corrjetnode_name = n;}
     // i/o getters
     bool        getDoQualityPlots()   {return m_doQualityPlots;}
     std::string getJetContainerName() {return m_jetcontainer_name;}
     bool        getSaveDST()          {return m_save_dst;}
     bool        getIsMC()             {return m_ismc;}
     bool        getSaveDSTMC()        {return m_save_truth_dst;}
+    bool        getSaveTrees()        {return m_save_trees;}
+    std::string getCorrJetNodeName()  {return m_corrjetnode_name;}
 
   private:
 
@@ -276,6 +284,7 @@ class SCorrelatorJetTree : public SubsysReco {
     void initializeTrees();
     void saveOutput();
     int  createJetNode(PHCompositeNode* topNode);
+    int  createCorrJetNodes(PHCompositeNode* topNode);
     void resetTreeVariables();
 
     // F4A histogram manager
@@ -316,12 +325,17 @@ class SCorrelatorJetTree : public SubsysReco {
     fastjet::RecombinationScheme  m_recomb_scheme;
     JetMapv1                     *m_jetMap;
     JetMapv1                     *m_truth_jetMap;
+    // in-memory jets (owned by the node tree)
+    SCorrelatorJets              *m_recJets;
+    SCorrelatorJets              *m_truJets;
     // i/o parameters
     std::string  m_outfilename;
     std::string  m_jetcontainer_name;
+    std::string  m_corrjetnode_name;
     bool         m_doQualityPlots;
     bool         m_save_dst;
     bool         m_save_truth_dst;
+    bool         m_save_trees;
     bool         m_ismc;
     bool         m_doDebug;
 
@@ -180,8 +180,10 @@ void SCorrelatorJetTree::findJets(PHCompositeNode *topNode) {
   m_recPartonMomZ[0] = -9999.;
   m_recPartonMomZ[1] = -9999.;
 
-  // fill object tree
-  m_recTree -> Fill();
+  // fill object tree (the jets stay available on the node tree either way)
+  if (m_save_trees) {
+    m_recTree -> Fill();
+  }
   return;
 
 }  // end 'findJets(PHCompositeNode*)'
@@ -341,8 +343,10 @@ void SCorrelatorJetTree::findMcJets(PHCompositeNode *topNode) {
   m_truPartonMomZ[0] = -9999.;
   m_truPartonMomZ[1] = -9999.; 
 
-  // fill output tree
-  m_truTree -> Fill();
+  // fill output tree (the jets stay available on the node tree either way)
+  if (m_save_trees) {
+    m_truTree -> Fill();
+  }
   return;
 
 }  // end 'findMcJets(PHCompositeNode*)'
@@ -56,6 +56,10 @@ void SCorrelatorJetTree::initializeVariables() {
   m_recomb_scheme        = pt_scheme;
   m_doQualityPlots       = true;
   m_save_dst             = false;
+  m_save_trees           = true;
+  m_corrjetnode_name     = "CorrelatorJets";
+  m_recJets              = nullptr;
+  m_truJets              = nullptr;
   m_recNumJets           = 0;
   m_recPartonID[0]       = -9999;
   m_recPartonID[1]       = -9999;
@@ -345,6 +349,76 @@ int SCorrelatorJetTree::createJetNode(PHCompositeNode* topNode) {
 
 
 
+int SCorrelatorJetTree::createCorrJetNodes(PHCompositeNode* topNode) {
+
+  // print debug statement
+  if (m_doDebug) {
+    cout << "SCorrelatorJetTree::createCorrJetNodes(PHCompositeNode *topNode) Creating in-memory jet nodes..." << endl;
+  }
+
+  // create iterator & DST node
+  PHNodeIterator   iter(topNode);
+  PHCompositeNode *lowerNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!lowerNode) {
+    lowerNode = new PHCompositeNode("DST");
+    topNode   -> addNode(lowerNode);
+    cout << "DST node added" << endl;
+  }
+
+  // point reco jets at the tree buffers
+  m_recJets             = new SCorrelatorJets();
+  m_recJets -> numJets  = &m_recNumJets;
+  m_recJets -> jetNCst  = &m_recJetNCst;
+  m_recJets -> jetId    = &m_recJetId;
+  m_recJets -> jetTruId = &m_recJetTruId;
+  m_recJets -> jetE     = &m_recJetE;
+  m_recJets -> jetPt    = &m_recJetPt;
+  m_recJets -> jetEta   = &m_recJetEta;
+  m_recJets -> jetPhi   = &m_recJetPhi;
+  m_recJets -> jetArea  = &m_recJetArea;
+  m_recJets -> cstZ     = &m_recCstZ;
+  m_recJets -> cstDr    = &m_recCstDr;
+  m_recJets -> cstE     = &m_recCstE;
+  m_recJets -> cstJt    = &m_recCstJt;
+  m_recJets -> cstEta   = &m_recCstEta;
+  m_recJets -> cstPhi   = &m_recCstPhi;
+
+  // transient nodes: not written out by DST output managers
+  const string recNodeName = m_corrjetnode_name + "_Reco";
+  PHDataNode<SCorrelatorJets> *recNode = new PHDataNode<SCorrelatorJets>(m_recJets, recNodeName.c_str());
+  lowerNode -> addNode(recNode);
+  cout << recNodeName << " node added" << endl;
+
+  // add truth jets if needed
+  if (m_ismc) {
+    m_truJets             = new SCorrelatorJets();
+    m_truJets -> numJets  = &m_truNumJets;
+    m_truJets -> jetNCst  = &m_truJetNCst;
+    m_truJets -> jetId    = &m_truJetId;
+    m_truJets -> jetTruId = &m_truJetTruId;
+    m_truJets -> jetE     = &m_truJetE;
+    m_truJets -> jetPt    = &m_truJetPt;
+    m_truJets -> jetEta   = &m_truJetEta;
+    m_truJets -> jetPhi   = &m_truJetPhi;
+    m_truJets -> jetArea  = &m_truJetArea;
+    m_truJets -> cstZ     = &m_truCstZ;
+    m_truJets -> cstDr    = &m_truCstDr;
+    m_truJets -> cstE     = &m_truCstE;
+    m_truJets -> cstJt    = &m_truCstJt;
+    m_truJets -> cstEta   = &m_truCstEta;
+    m_truJets -> cstPhi   = &m_truCstPhi;
+
+    const string truNodeName = m_corrjetnode_name + "_Truth";
+    PHDataNode<SCorrelatorJets> *truNode = new PHDataNode<SCorrelatorJets>(m_truJets, truNodeName.c_str());
+    lowerNode -> addNode(truNode);
+    cout << truNodeName << " node added" << endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+
+}  // end 'createCorrJetNodes(PHCompositeNode*)'
+
+
+
 void  SCorrelatorJetTree::saveOutput() {
 
   // print debug statement
@@ -431,9 +505,11 @@ void  SCorrelatorJetTree::saveOutput() {
   }
 
   // save output trees
-  m_outFile -> cd();
-  m_recTree -> Write();
-  m_truTree -> Write();
+  if (m_save_trees) {
+    m_outFile -> cd();
+    m_recTree -> Write();
+    m_truTree -> Write();
+  }
   return;
 
 }  // end 'saveOutput()'
@@ -0,0 +1,46 @@
+// 'SCorrelatorJets.h'
+// Derek Anderson
+// 03.01.2023
+//
+// In-memory view of the jets and
+// constituents found in an event,
+// published on the node tree so
+// downstream modules (e.g. the
+// SEnergyCorrelator in complex
+// mode) can use them without
+// going through the output tree.
+
+#ifndef SCORRELATORJETS_H
+#define SCORRELATORJETS_H
+
+// standard c include
+#include <vector>
+
+
+
+// SCorrelatorJets definition -------------------------------------------------
+
+// points to the buffers SCorrelatorJetTree fills every event (the same ones
+// that back the branches of the output trees), so nothing is copied; the
+// buffers are owned by SCorrelatorJetTree and valid until the end of the run
+struct SCorrelatorJets {
+  unsigned long                     *numJets  = nullptr;
+  std::vector<unsigned long>        *jetNCst  = nullptr;
+  std::vector<unsigned int>         *jetId    = nullptr;
+  std::vector<unsigned int>         *jetTruId = nullptr;
+  std::vector<double>               *jetE     = nullptr;
+  std::vector<double>               *jetPt    = nullptr;
+  std::vector<double>               *jetEta   = nullptr;
+  std::vector<double>               *jetPhi   = nullptr;
+  std::vector<double>               *jetArea  = nullptr;
+  std::vector<std::vector<double>>  *cstZ     = nullptr;
+  std::vector<std::vector<double>>  *cstDr    = nullptr;
+  std::vector<std::vector<double>>  *cstE     = nullptr;
+  std::vector<std::vector<double>>  *cstJt    = nullptr;
+  std::vector<std::vector<double>>  *cstEta   = nullptr;
+  std::vector<std::vector<double>>  *cstPhi   = nullptr;
+};
+
+#endif
+
+// end ------------------------------------------------------------------------
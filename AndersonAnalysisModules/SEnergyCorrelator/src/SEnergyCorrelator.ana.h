@@ -81,7 +81,7 @@ void SEnergyCorrelator::ExtractHistsFromCorr() {
 
       // check if bin is good & set content/error
       const bool areBinValuesNans = (isnan(binContent) || isnan(binError));
-      if (!areBinValuesNans) {
+      if (areBinValuesNans) {
         PrintError(13, 0, iDrBin);
       } else {
         m_outHistDrAxis[iPtBin]   -> SetBinContent(iDrBin, binContent);
@@ -145,4 +145,190 @@ uint32_t SEnergyCorrelator::GetJetPtBin(const double ptJet) {
 
 }  // end 'GetJetPtBin(double)'
 
+
+
+void SEnergyCorrelator::DoCorrelatorCalculation(const SCorrelatorInput &input, vector<EECLongSide*> &corrs, vector<PseudoJet> &cstVector) {
+
+  // print debug statement
+  if (m_inDebugMode && (m_verbosity > 7)) PrintDebug(29);
+
+  // jet loop
+  const uint64_t nJets = (uint64_t) input.evtNumJets;
+  for (uint64_t iJet = 0; iJet < nJets; iJet++) {
+
+    // clear vector for correlator
+    cstVector.clear();
+
+    // get jet info
+    const uint64_t nCsts   = (*input.jetNumCst)[iJet];
+    const double   ptJet   = (*input.jetPt)[iJet];
+    const double   etaJet  = (*input.jetEta)[iJet];
+    const double   phiJet  = (*input.jetPhi)[iJet];
+    const double   pxJet   = ptJet * cos(phiJet);
+    const double   pyJet   = ptJet * sin(phiJet);
+    const double   pzJet   = ptJet * sinh(etaJet);
+    const double   pTotJet = sqrt((pxJet * pxJet) + (pyJet * pyJet) + (pzJet * pzJet));
+
+    // select jet pt bin & apply jet cuts
+    const uint32_t  iPtJetBin = GetJetPtBin(ptJet);
+    const bool      isGoodJet = ApplyJetCuts(ptJet, etaJet);
+    if (!isGoodJet) continue;
+
+    // grab constituent info for this jet once
+    const vector<double> &zCsts   = (*input.cstZ)[iJet];
+    const vector<double> &drCsts  = (*input.cstDr)[iJet];
+    const vector<double> &etaCsts = (*input.cstEta)[iJet];
+    const vector<double> &phiCsts = (*input.cstPhi)[iJet];
+
+    // constituent loop
+    for (uint64_t iCst = 0; iCst < nCsts; iCst++) {
+
+      // get cst info
+      const double zCst    = zCsts[iCst];
+      const double drCst   = drCsts[iCst];
+      const double etaCst  = etaCsts[iCst];
+      const double phiCst  = phiCsts[iCst];
+      const double pTotCst = zCst * pTotJet;
+      const double pxCst   = pTotCst * cosh(etaCst) * cos(phiCst);
+      const double pyCst   = pTotCst * cosh(etaCst) * sin(phiCst);
+      const double pzCst   = pTotCst * sinh(etaCst);
+
+      // apply cst cuts
+      const bool isGoodCst = ApplyCstCuts(pTotCst, drCst);
+      if (!isGoodCst) continue;
+
+      // create pseudojet & add to list
+      PseudoJet constituent(pxCst, pyCst, pzCst, pTotCst);
+      constituent.set_user_index(iCst);
+      cstVector.push_back(constituent);
+
+    }  // end cst loop
+
+    // run eec computation
+    corrs[iPtJetBin] -> compute(cstVector);
+
+  }  // end jet loop
+  return;
+
+}  // end 'DoCorrelatorCalculation(SCorrelatorInput&, vector<EECLongSide*>&, vector<PseudoJet>&)'
+
+
+
+void SEnergyCorrelator::AnalyzeParallel() {
+
+  // print debug statement
+  if (m_inDebugMode) PrintDebug(30);
+
+  // announce start of event loop
+  const uint64_t nEvts = m_inTree -> GetEntries();
+  PrintMessage(15, nEvts);
+
+  // each thread reads its own copy of the tree
+  ROOT::EnableThreadSafety();
+
+  // thread-local correlators for each jet pt bin
+  vector<vector<EECLongSide*>> threadCorrs(m_nThreads);
+  for (uint32_t iThread = 0; iThread < m_nThreads; iThread++) {
+    for (size_t iPtBin = 0; iPtBin < m_nBinsJetPt; iPtBin++) {
+      threadCorrs[iThread].push_back(new EECLongSide(m_nPointCorr, m_nBinsDr, {m_drBinRange[0], m_drBinRange[1]}));
+    }
+  }
+
+  // split entries into contiguous ranges
+  const uint64_t nEvtsPerThread = (nEvts + m_nThreads - 1) / m_nThreads;
+
+  vector<thread> threads;
+  for (uint32_t iThread = 0; iThread < m_nThreads; iThread++) {
+    const uint64_t firstEvt = iThread * nEvtsPerThread;
+    const uint64_t lastEvt  = min(nEvts, firstEvt + nEvtsPerThread);
+    if (firstEvt >= lastEvt) break;
+    threads.emplace_back(&SEnergyCorrelator::AnalyzeEntryRange, this, firstEvt, lastEvt, ref(threadCorrs[iThread]));
+  }
+  for (thread &worker : threads) {
+    worker.join();
+  }
+
+  // merge thread-local correlators
+  for (uint32_t iThread = 0; iThread < m_nThreads; iThread++) {
+    for (size_t iPtBin = 0; iPtBin < m_nBinsJetPt; iPtBin++) {
+      *(m_eecLongSide[iPtBin]) += *(threadCorrs[iThread][iPtBin]);
+      delete threadCorrs[iThread][iPtBin];
+    }
+  }
+  threadCorrs.clear();
+
+  // announce end of parallel loop
+  PrintMessage(16);
+  return;
+
+}  // end 'AnalyzeParallel()'
+
+
+
+void SEnergyCorrelator::AnalyzeEntryRange(const uint64_t firstEvt, const uint64_t lastEvt, vector<EECLongSide*> &corrs) {
+
+  // print debug statement
+  if (m_inDebugMode && (m_verbosity > 5)) PrintDebug(31);
+
+  // open a private copy of the input tree
+  TFile *file = TFile::Open(m_inFileName.data(), "read");
+  if (!file || file -> IsZombie()) {
+    PrintError(6);
+    assert(file && !(file -> IsZombie()));
+  }
+
+  TTree *tree = 0x0;
+  file -> GetObject(m_inTreeName.data(), tree);
+  if (!tree) {
+    PrintError(7);
+    assert(tree);
+  }
+
+  // buffers owned by this thread
+  vector<unsigned long>  jetNumCst;
+  vector<double>         jetPt;
+  vector<double>         jetEta;
+  vector<double>         jetPhi;
+  vector<vector<double>> cstZ;
+  vector<vector<double>> cstDr;
+  vector<vector<double>> cstEta;
+  vector<vector<double>> cstPhi;
+
+  SCorrelatorInput input;
+  input.jetNumCst = &jetNumCst;
+  input.jetPt     = &jetPt;
+  input.jetEta    = &jetEta;
+  input.jetPhi    = &jetPhi;
+  input.cstZ      = &cstZ;
+  input.cstDr     = &cstDr;
+  input.cstEta    = &cstEta;
+  input.cstPhi    = &cstPhi;
+
+  tree -> SetMakeClass(1);
+  tree -> SetBranchAddress("EvtNumJets", &input.evtNumJets);
+  tree -> SetBranchAddress("JetNumCst",  &input.jetNumCst);
+  tree -> SetBranchAddress("JetPt",      &input.jetPt);
+  tree -> SetBranchAddress("JetEta",     &input.jetEta);
+  tree -> SetBranchAddress("JetPhi",     &input.jetPhi);
+  tree -> SetBranchAddress("CstZ",       &input.cstZ);
+  tree -> SetBranchAddress("CstDr",      &input.cstDr);
+  tree -> SetBranchAddress("CstEta",     &input.cstEta);
+  tree -> SetBranchAddress("CstPhi",     &input.cstPhi);
+  SetActiveBranches(tree);
+
+  // event loop
+  vector<PseudoJet> cstVector;
+  for (uint64_t iEvt = firstEvt; iEvt < lastEvt; iEvt++) {
+    const int64_t bytes = tree -> GetEntry(iEvt);
+    if (bytes <= 0) break;
+    DoCorrelatorCalculation(input, corrs, cstVector);
+  }
+
+  tree -> ResetBranchAddresses();
+  file -> Close();
+  delete file;
+  return;
+
+}  // end 'AnalyzeEntryRange(uint64_t, uint64_t, vector<EECLongSide*>&)'
+
 // end ------------------------------------------------------------------------
@@ -23,8 +23,7 @@ using namespace fastjet;
 
 // ctor/dtor ------------------------------------------------------------------
 
-//SEnergyCorrelator::SEnergyCorrelator(const string &name, const bool isComplex, const bool doDebug) : SubsysReco(name) {
-SEnergyCorrelator::SEnergyCorrelator(const string &name, const bool isComplex, const bool doDebug, const bool inBatch) {
+SEnergyCorrelator::SEnergyCorrelator(const string &name, const bool isComplex, const bool doDebug, const bool inBatch) : SubsysReco(name) {
 
   // initialize internal variables
   InitializeMembers();
@@ -39,11 +38,9 @@ SEnergyCorrelator::SEnergyCorrelator(const string &name, const bool isComplex, c
   }
 
   // set verbosity in complex mode
-/* TODO add back in complex mode
   if (m_inComplexMode) {
     m_verbosity = Verbosity();
   }
-*/
 
   // set debug/batch mode & print debug statement
   m_inDebugMode = doDebug;
@@ -54,7 +51,7 @@ SEnergyCorrelator::SEnergyCorrelator(const string &name, const bool isComplex, c
   m_moduleName = name;
   if (m_inStandaloneMode) PrintMessage(0);
 
-}  // end ctor(string, bool, bool)
+}  // end ctor(string, bool, bool, bool)
 
 
 
@@ -86,7 +83,82 @@ SEnergyCorrelator::~SEnergyCorrelator() {
 
 // F4A methods ----------------------------------------------------------------
 
-/* TODO F4A methods will go here */
+int SEnergyCorrelator::Init(PHCompositeNode *topNode) {
+
+  // print debug statement
+  if (m_inDebugMode) PrintDebug(2);
+
+  // make sure complex mode is on & open output
+  if (m_inStandaloneMode) {
+    PrintError(0);
+    assert(m_inComplexMode);
+  }
+  OpenOutputFile();
+
+  // announce input node & output file
+  PrintMessage(17);
+
+  // initialize output & correlators (jets are read from the node tree)
+  InitializeHists();
+  InitializeCorrs();
+  return Fun4AllReturnCodes::EVENT_OK;
+
+}  // end 'Init(PHCompositeNode*)'
+
+
+
+int SEnergyCorrelator::process_event(PHCompositeNode *topNode) {
+
+  // print debug statement
+  if (m_inDebugMode) PrintDebug(7);
+
+  // make sure complex mode is on
+  if (m_inStandaloneMode) {
+    PrintError(3);
+    assert(m_inComplexMode);
+  }
+
+  // grab the jets SCorrelatorJetTree found in this event
+  GrabInputNode(topNode);
+
+  // run eec computation on each jet
+  SCorrelatorInput input;
+  input.evtNumJets = (int) m_inJets -> jetPt -> size();
+  input.jetNumCst  = m_inJets -> jetNCst;
+  input.jetPt      = m_inJets -> jetPt;
+  input.jetEta     = m_inJets -> jetEta;
+  input.jetPhi     = m_inJets -> jetPhi;
+  input.cstZ       = m_inJets -> cstZ;
+  input.cstDr      = m_inJets -> cstDr;
+  input.cstEta     = m_inJets -> cstEta;
+  input.cstPhi     = m_inJets -> cstPhi;
+  DoCorrelatorCalculation(input, m_eecLongSide, m_jetCstVector);
+  return Fun4AllReturnCodes::EVENT_OK;
+
+}  // end 'process_event(PHCompositeNode*)'
+
+
+
+int SEnergyCorrelator::End(PHCompositeNode *topNode) {
+
+  // print debug statement
+  if (m_inDebugMode) PrintDebug(8);
+
+  // make sure complex mode is on
+  if (m_inStandaloneMode) {
+    PrintError(4);
+    assert(m_inComplexMode);
+  }
+
+  // translate correlators into root hists & save output
+  ExtractHistsFromCorr();
+  SaveOutput();
+
+  // announce end
+  PrintMessage(11);
+  return Fun4AllReturnCodes::EVENT_OK;
+
+}  // end 'End(PHCompositeNode*)'
 
 
 
@@ -130,76 +202,45 @@ void SEnergyCorrelator::Analyze() {
     assert(m_inStandaloneMode);
   }
 
-  // announce start of event loop
-  const uint64_t nEvts = m_inTree -> GetEntriesFast();
-  PrintMessage(7, nEvts);
-
-  // event loop
-  uint64_t nBytes = 0;
-  for (uint64_t iEvt = 0; iEvt < nEvts; iEvt++) {
-
-    const uint64_t entry = LoadTree(iEvt);
-    if (entry < 0) break;
-
-    const uint64_t bytes = GetEntry(iEvt);
-    if (bytes < 0) {
-      break;
-    } else {
-      nBytes += bytes;
-      PrintMessage(8, nEvts, iEvt);
-    }
-
-    // jet loop
-    uint64_t nJets = (int) m_evtNumJets;
-    for (uint64_t iJet = 0; iJet < nJets; iJet++) {
-
-      // clear vector for correlator
-      m_jetCstVector.clear();
-
-      // get jet info
-      const uint64_t nCsts   = m_jetNumCst -> at(iJet);
-      const double   ptJet   = m_jetPt     -> at(iJet);
-      const double   etaJet  = m_jetEta    -> at(iJet);
-      const double   phiJet  = m_jetPhi    -> at(iJet);
-      const double   pxJet   = ptJet * cos(phiJet);
-      const double   pyJet   = ptJet * sin(phiJet);
-      const double   pzJet   = ptJet * sinh(etaJet);
-      const double   pTotJet = sqrt((pxJet * pxJet) + (pyJet * pyJet) + (pzJet * pzJet));
-
-      // select jet pt bin & apply jet cuts
-      const uint32_t  iPtJetBin = GetJetPtBin(ptJet);
-      const bool      isGoodJet = ApplyJetCuts(ptJet, etaJet);
-      if (!isGoodJet) continue;
-
-      // constituent loop
-      for (uint64_t iCst = 0; iCst < nCsts; iCst++) {
-
-        // get cst info
-        const double zCst    = (m_cstZ   -> at(iJet)).at(iCst);
-        const double drCst   = (m_cstDr  -> at(iJet)).at(iCst);
-        const double etaCst  = (m_cstEta -> at(iJet)).at(iCst);
-        const double phiCst  = (m_cstEta -> at(iJet)).at(iCst);
-        const double pTotCst = zCst * pTotJet;
-        const double pxCst   = pTotCst * cosh(etaCst) * cos(phiCst);
-        const double pyCst   = pTotCst * cosh(etaCst) * sin(phiCst);
-        const double pzCst   = pTotCst * sinh(etaCst);
-
-        // apply cst cuts
-        const bool isGoodCst = ApplyCstCuts(pTotCst, drCst);
-        if (!isGoodCst) continue;
-
-        // create pseudojet & add to list
-        PseudoJet constituent(pxCst, pyCst, pzCst, pTotCst);
-        constituent.set_user_index(iCst);
-        m_jetCstVector.push_back(constituent);
-
-      }  // end cst loop
-
-      // run eec computation
-      m_eecLongSide[iPtJetBin] -> compute(m_jetCstVector);
-
-    }  // end jet loop
-  }  // end event loop
+  // split entries across threads if requested
+  if (m_nThreads > 1) {
+    AnalyzeParallel();
+  } else {
+
+    // announce start of event loop
+    const uint64_t nEvts = m_inTree -> GetEntriesFast();
+    PrintMessage(7, nEvts);
+
+    // event loop
+    SCorrelatorInput input;
+    uint64_t nBytes = 0;
+    for (uint64_t iEvt = 0; iEvt < nEvts; iEvt++) {
+
+      const uint64_t entry = LoadTree(iEvt);
+      if (entry < 0) break;
+
+      const uint64_t bytes = GetEntry(iEvt);
+      if (bytes < 0) {
+        break;
+      } else {
+        nBytes += bytes;
+        PrintMessage(8, nEvts, iEvt);
+      }
+
+      // run eec computation on each jet (vectors are allocated by the tree on first read)
+      input.evtNumJets = m_evtNumJets;
+      input.jetNumCst  = m_jetNumCst;
+      input.jetPt      = m_jetPt;
+      input.jetEta     = m_jetEta;
+      input.jetPhi     = m_jetPhi;
+      input.cstZ       = m_cstZ;
+      input.cstDr      = m_cstDr;
+      input.cstEta     = m_cstEta;
+      input.cstPhi     = m_cstPhi;
+      DoCorrelatorCalculation(input, m_eecLongSide, m_jetCstVector);
+
+    }  // end event loop
+  }
   PrintMessage(13);
 
   // translate correlators into root hists
@@ -19,6 +19,8 @@
 #include <sstream>
 #include <cstdlib>
 #include <utility>
+#include <thread>
+#include <functional>
 // root includes
 #include <TH1.h>
 #include <TROOT.h>
@@ -27,6 +29,14 @@
 #include <TMath.h>
 #include <TString.h>
 #include <TDirectory.h>
+// f4a includes
+#include <fun4all/SubsysReco.h>
+#include <fun4all/Fun4AllReturnCodes.h>
+// phool includes
+#include <phool/getClass.h>
+#include <phool/PHCompositeNode.h>
+// jet tree includes
+#include <scorrelatorjettree/SCorrelatorJets.h>
 // fastjet includes
 #include <fastjet/PseudoJet.hh>
 // eec include
@@ -35,26 +45,35 @@
 using namespace std;
 using namespace fastjet;
 
-// global constants
-static const size_t NRange     = 2;
-static const size_t NMaxPtBins = 10;
-
 
 
 // SEnergyCorrelator definition -----------------------------------------------
 
-//class SEnergyCorrelator : public SubsysReco {
-class SEnergyCorrelator {
+// input-tree buffers needed by the correlator calculation
+struct SCorrelatorInput {
+  int                     evtNumJets = 0;
+  vector<unsigned long>  *jetNumCst  = 0x0;
+  vector<double>         *jetPt      = 0x0;
+  vector<double>         *jetEta     = 0x0;
+  vector<double>         *jetPhi     = 0x0;
+  vector<vector<double>> *cstZ       = 0x0;
+  vector<vector<double>> *cstDr      = 0x0;
+  vector<vector<double>> *cstEta     = 0x0;
+  vector<vector<double>> *cstPhi     = 0x0;
+};
+
+class SEnergyCorrelator : public SubsysReco {
 
   public:
 
     // ctor/dtor
     SEnergyCorrelator(const string &name = "SEnergyCorrelator", const bool isComplex = false, const bool doDebug = false, const bool inBatch = false);
-    //~SEnergyCorrelator() override;
-    ~SEnergyCorrelator();
+    ~SEnergyCorrelator() override;
 
     // F4A methods
-    /* TODO F4A methods will go here */
+    int Init(PHCompositeNode *topNode)          override;
+    int process_event(PHCompositeNode *topNode) override;
+    int End(PHCompositeNode *topNode)           override;
 
     // standalone-only methods
     void Init();
@@ -66,6 +85,7 @@ class SEnergyCorrelator {
     void SetInputNode(const string &iNodeName)  {m_inNodeName  = iNodeName;}
     void SetInputFile(const string &iFileName)  {m_inFileName  = iFileName;}
     void SetOutputFile(const string &oFileName) {m_outFileName = oFileName;}
+    void SetNumThreads(const uint32_t nThreads) {m_nThreads    = nThreads;}
 
     // setters (*.io.h)
     void SetInputTree(const string &iTreeName, const bool isTruthTree = false);
@@ -82,6 +102,7 @@ class SEnergyCorrelator {
     string   GetInputNodeName()    {return m_inNodeName;}
     string   GetInputTreeName()    {return m_inTreeName;}
     string   GetOutputFileName()   {return m_outFileName;}
+    uint32_t GetNumThreads()       {return m_nThreads;}
 
     // correlator getters
     double   GetMinDrBin()   {return m_drBinRange[0];}
@@ -101,8 +122,15 @@ class SEnergyCorrelator {
 
   private:
 
+    // constants (class scope, so the header can be included next to
+    // SCorrelatorJetTree.h, which defines its own NRange)
+    static const size_t NRange     = 2;
+    static const size_t NMaxPtBins = 10;
+
+    typedef contrib::eec::EECLongestSide<contrib::eec::hist::axis::log> EECLongSide;
+
     // io methods (*.io.h)
-    void GrabInputNode();
+    void GrabInputNode(PHCompositeNode *topNode);
     void OpenInputFile();
     void OpenOutputFile();
     void SaveOutput();
@@ -118,12 +146,16 @@ class SEnergyCorrelator {
     bool    CheckCriticalParameters();
     int64_t LoadTree(const uint64_t entry);
     int64_t GetEntry(const uint64_t entry);
+    void    SetActiveBranches(TTree *tree);
 
     // analysis methods (*.ana.h)
     void     ExtractHistsFromCorr();
     bool     ApplyJetCuts(const double ptJet, const double etaJet);
     bool     ApplyCstCuts(const double momCst, const double drCst);
     uint32_t GetJetPtBin(const double ptJet);
+    void     DoCorrelatorCalculation(const SCorrelatorInput &input, vector<EECLongSide*> &corrs, vector<PseudoJet> &cstVector);
+    void     AnalyzeParallel();
+    void     AnalyzeEntryRange(const uint64_t firstEvt, const uint64_t lastEvt, vector<EECLongSide*> &corrs);
 
     // io members
     TFile         *m_outFile;
@@ -132,19 +164,23 @@ class SEnergyCorrelator {
     vector<TH1D*>  m_outHistDrAxis;
     vector<TH1D*>  m_outHistLnDrAxis;
 
+    // complex-mode input (owned by the node tree)
+    SCorrelatorJets *m_inJets;
+
     // system members
-    int    m_fCurrent;
-    int    m_verbosity;
-    bool   m_inDebugMode;
-    bool   m_inBatchMode;
-    bool   m_inComplexMode;
-    bool   m_inStandaloneMode;
-    bool   m_isInputTreeTruth;
-    string m_moduleName;
-    string m_inFileName;
-    string m_inNodeName;
-    string m_inTreeName;
-    string m_outFileName;
+    int      m_fCurrent;
+    int      m_verbosity;
+    uint32_t m_nThreads;
+    bool     m_inDebugMode;
+    bool     m_inBatchMode;
+    bool     m_inComplexMode;
+    bool     m_inStandaloneMode;
+    bool     m_isInputTreeTruth;
+    string   m_moduleName;
+    string   m_inFileName;
+    string   m_inNodeName;
+    string   m_inTreeName;
+    string   m_outFileName;
 
     // jet, cst, correlator parameters
     uint32_t                     m_nPointCorr;
@@ -159,7 +195,7 @@ class SEnergyCorrelator {
     vector<pair<double, double>> m_ptJetBins;
 
     // correlators
-    vector<contrib::eec::EECLongestSide<contrib::eec::hist::axis::log>*> m_eecLongSide;
+    vector<EECLongSide*> m_eecLongSide;
 
     // input truth tree address members
     int    m_truParton3_ID;
@@ -88,15 +88,20 @@ void SEnergyCorrelator::SetCorrelatorParameters(const uint32_t nPointCorr, const
 
 
 
-void SEnergyCorrelator::GrabInputNode() {
+void SEnergyCorrelator::GrabInputNode(PHCompositeNode *topNode) {
 
   // print debug statement
-  if (m_inDebugMode) PrintDebug(3);
+  if (m_inDebugMode && (m_verbosity > 5)) PrintDebug(3);
 
-  /* TODO method goes here */
+  // jets & constituents published by SCorrelatorJetTree
+  m_inJets = findNode::getClass<SCorrelatorJets>(topNode, m_inNodeName);
+  if (!m_inJets) {
+    PrintError(1);
+    assert(m_inJets);
+  }
   return;
 
-}  // end 'GrabInputNode()'
+}  // end 'GrabInputNode(PHCompositeNode*)'
 
 
 
@@ -22,9 +22,11 @@ void SEnergyCorrelator::InitializeMembers() {
 
   m_inFile            = 0x0;
   m_inTree            = 0x0;
+  m_inJets            = 0x0;
   m_outFile           = 0x0;
   m_fCurrent          = 0;
   m_verbosity         = 0;
+  m_nThreads          = 1;
   m_inDebugMode       = false;
   m_inBatchMode       = false;
   m_inComplexMode     = false;
@@ -172,6 +174,9 @@ void SEnergyCorrelator::InitializeTree() {
   m_inTree -> SetBranchAddress("CstEta",     &m_cstEta,     &m_brCstEta);
   m_inTree -> SetBranchAddress("CstPhi",     &m_cstPhi,     &m_brCstPhi);
 
+  // only read what the correlator calculation needs
+  SetActiveBranches(m_inTree);
+
   // announce tree setting
   if (m_inStandaloneMode) PrintMessage(2);
   return;
@@ -299,6 +304,20 @@ void SEnergyCorrelator::PrintMessage(const uint32_t code, const uint64_t nEvts,
     case 14:
       cout << "    Extracted output histograms from correlators." << endl;
       break;
+    case 15:
+      cout << "    Beginning parallel event loop: " << nEvts << " to process on " << m_nThreads << " threads..." << endl;
+      break;
+    case 16:
+      cout << "    Merged correlators from all threads." << endl;
+      break;
+    case 17:
+      cout << "\n  Running correlator calculation in complex mode...\n"
+           << "    Set name & nodes:\n"
+           << "      module name = " << m_moduleName.data()  << "\n"
+           << "      input node  = " << m_inNodeName.data()  << "\n"
+           << "      output      = " << m_outFileName.data()
+           << endl;
+      break;
   }
   return;
 
@@ -317,13 +336,13 @@ void SEnergyCorrelator::PrintDebug(const uint32_t code) {
       cout << "SEnergyCorrelator::InitializeMembers() initializing internal variables..." << endl;
       break;
     case 1:
-      cout << "SEnergyCorrelator::SEnergyCorrelator(string, bool, bool) calling ctor..." << endl;
+      cout << "SEnergyCorrelator::SEnergyCorrelator(string, bool, bool, bool) calling ctor..." << endl;
       break;
     case 2:
       cout << "SEnergyCorrelator::Init(PHCompositeNode*) initializing..." << endl;
       break;
     case 3:
-      cout << "SEnergyCorrelator::GrabInputNode() grabbing input node..." << endl;
+      cout << "SEnergyCorrelator::GrabInputNode(PHCompositeNode*) grabbing input node..." << endl;
       break;
     case 4:
       cout << "SEnergyCorrelator::InitializeTree() initializing input tree..." << endl;
@@ -400,6 +419,18 @@ void SEnergyCorrelator::PrintDebug(const uint32_t code) {
     case 28:
       cout << "SEnergyCorrelator::GetJetPtBin(double) getting jet pT bin..." << endl;
       break;
+    case 29:
+      cout << "SEnergyCorrelator::DoCorrelatorCalculation(SCorrelatorInput&, vector<EECLongSide*>&, vector<PseudoJet>&) running correlators on jets..." << endl;
+      break;
+    case 30:
+      cout << "SEnergyCorrelator::AnalyzeParallel() analyzing input on multiple threads..." << endl;
+      break;
+    case 31:
+      cout << "SEnergyCorrelator::AnalyzeEntryRange(uint64_t, uint64_t, vector<EECLongSide*>&) analyzing range of entries..." << endl;
+      break;
+    case 32:
+      cout << "SEnergyCorrelator::SetActiveBranches(TTree*) setting branch status..." << endl;
+      break;
   }
   return;
 
@@ -422,7 +453,7 @@ void SEnergyCorrelator::PrintError(const uint32_t code, const size_t nDrBinEdges
       break;
     case 1:
       if (m_inComplexMode) {
-        cerr << "SEnergyCorrelator::GrabInputNode() PANIC: couldn't grab node \"" << m_inNodeName << "\"! Aborting!" << endl;
+        cerr << "SEnergyCorrelator::GrabInputNode(PHCompositeNode*) PANIC: couldn't grab node \"" << m_inNodeName << "\"! Aborting!" << endl;
       } else {
         cerr << "PANIC: couldn't grab node \"" << m_inNodeName << "\"! Aborting!" << endl;
       }
@@ -572,4 +603,25 @@ int64_t SEnergyCorrelator::LoadTree(const uint64_t entry) {
 
 }  // end 'LoadTree(uint64_t)'
 
+
+
+void SEnergyCorrelator::SetActiveBranches(TTree *tree) {
+
+  // print debugging statement
+  if (m_inDebugMode && (m_verbosity > 5)) PrintDebug(32);
+
+  tree -> SetBranchStatus("*",          0);
+  tree -> SetBranchStatus("EvtNumJets", 1);
+  tree -> SetBranchStatus("JetNumCst",  1);
+  tree -> SetBranchStatus("JetPt",      1);
+  tree -> SetBranchStatus("JetEta",     1);
+  tree -> SetBranchStatus("JetPhi",     1);
+  tree -> SetBranchStatus("CstZ",       1);
+  tree -> SetBranchStatus("CstDr",      1);
+  tree -> SetBranchStatus("CstEta",     1);
+  tree -> SetBranchStatus("CstPhi",     1);
+  return;
+
+}  // end 'SetActiveBranches(TTree*)'
+
 // end ------------------------------------------------------------------------
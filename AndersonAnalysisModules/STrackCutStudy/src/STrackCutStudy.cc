@@ -13,6 +13,7 @@
 
 // header file
 #include "STrackCutStudy.h"
+#include "STrackCutStudy.columnar.h"
 
 using namespace std;
 
@@ -28,6 +29,9 @@ STrackCutStudy::STrackCutStudy() {
   normalPtFracMax = 9999.;
   qualityMin      = 0.;
   qualityMax      = 9999.;
+  inColumnarMode  = false;
+  nColThreads     = 1;
+  nColBlock       = NBlockDefault;
   cout << "\n  Beginning track cut study."  << endl;
 
 }  // end ctor
@@ -124,6 +128,45 @@ void STrackCutStudy::SetTrackCuts(const Double_t trkVzMin, const Double_t trkVzM
 
 
 
+void STrackCutStudy::SetColumnarMode(const Bool_t columnar, const UInt_t nThreads, const UInt_t blockSize) {
+
+  inColumnarMode = columnar;
+  nColThreads    = (nThreads  > 0) ? nThreads  : 1;
+  nColBlock      = (blockSize > 0) ? blockSize : NBlockDefault;
+  if (inColumnarMode) {
+    cout << "    Using columnar backend:\n"
+         << "      threads    = " << nColThreads << "\n"
+         << "      block size = " << nColBlock
+         << endl;
+  }
+  return;
+
+}  // end 'SetColumnarMode(bool, uint, uint)'
+
+
+
+UInt_t STrackCutStudy::AddCutSet(const STrackCuts &cuts) {
+
+  if (cutSets.size() >= NCutSetMax) {
+    cerr << "WARNING: can't scan more than " << NCutSetMax << " cut sets! Ignoring cut set." << endl;
+    return cutSets.size();
+  }
+
+  const UInt_t iCut = cutSets.size();
+  cutSets.push_back(cuts);
+  cout << "    Added cut set #" << iCut << ":\n"
+       << "      z-vertex = (" << cuts.vzRange[0]      << ", " << cuts.vzRange[1]      << ")\n"
+       << "      quality  = (" << cuts.qualityRange[0] << ", " << cuts.qualityRange[1] << ")\n"
+       << "      dca xy   = (" << cuts.dcaXYRange[0]   << ", " << cuts.dcaXYRange[1]   << ")\n"
+       << "      dca z    = (" << cuts.dcaZRange[0]    << ", " << cuts.dcaZRange[1]    << ")\n"
+       << "      min. mms, mvtx, intt, tpc hits = " << cuts.nMmsMin << ", " << cuts.nMapsMin << ", " << cuts.nInttMin << ", " << cuts.nTpcMin
+       << endl;
+  return iCut;
+
+}  // end 'AddCutSet(STrackCuts&)'
+
+
+
 void STrackCutStudy::Init() {
 
   // announce method
@@ -147,18 +190,39 @@ void STrackCutStudy::Analyze() {
          << endl;
     assert(doTuplesExist);
   }
+
+  // create cut-set histograms (filled alongside the nominal ones)
+  InitCutHists();
+
+  // the columnar backend reads each tuple once and fills every histogram,
+  // otherwise loop over the entries
+  if (inColumnarMode) {
+    AnalyzeColumnar();
+  } else {
+    AnalyzeEntries();
+  }
+
+  // normalize histograms if needed
+  if (doIntNorm) {
+    NormalizeHists();
+    for (STrackVarHists &hists : cutHists) {
+      NormalizeVarHists(hists);
+    }
+  }
+  return;
+
+}  // end Analyze()
+
+
+
+void STrackCutStudy::AnalyzeEntries() {
+
   cout << "    Analyzing:" <<endl;
 
   // prepare for embed-only entry loop
   Long64_t nEntriesEO = ntTrkEO -> GetEntries();
   cout << "      Beginning embed-only entry loop: " << nEntriesEO << " entries to process..." << endl;
 
-  // arrays for filling histograms
-  Double_t recoTrkVars[NTrkVar];
-  Double_t trueTrkVars[NTrkVar];
-  Double_t recoPhysVars[NPhysVar];
-  Double_t truePhysVars[NPhysVar];
-
   // loop over embed-only tuple entries
   Long64_t nBytesEO(0);
   for (Long64_t iEntry = 0; iEntry < nEntriesEO; iEntry++) {
@@ -173,542 +237,12 @@ void STrackCutStudy::Analyze() {
 
     // announce progress
     const Long64_t iProg = iEntry + 1;
-    if (iProg == nEntriesEO) {
+    if (((iProg % NProgress) == 0) || (iProg == nEntriesEO)) {
       cout << "        Processing embed-only entry " << iProg << "/" << nEntriesEO << "..." << endl;
-    } else {
-      cout << "        Processing embed-only entry " << iProg << "/" << nEntriesEO << "...\r" << flush;
     }
 
-    // perform calculations
-    const Float_t  glayers    = gnlmms + gnlmaps + gnlintt + gnltpc;
-    const Double_t perMms     = (Double_t) nlmms / (Double_t) gnlmms;
-    const Double_t perMaps    = (Double_t) nlmaps / (Double_t) gnlmaps;
-    const Double_t perIntt    = (Double_t) nlintt / (Double_t) gnlintt;
-    const Double_t perTpc     = (Double_t) nltpc / (Double_t) gnltpc;
-    const Double_t perTot     = (Double_t) layers / (Double_t) glayers;
-    const Double_t umDcaXY    = dca3dxy * 10000;
-    const Double_t umDcaZ     = dca3dz * 10000;
-    const Double_t deltaDcaXY = abs(dca3dxysigma / dca3dxy);
-    const Double_t deltaDcaZ  = abs(dca3dzsigma / dca3dz);
-    const Double_t deltaEta   = abs(deltaeta / eta);
-    const Double_t deltaPhi   = abs(deltaphi / phi);
-    const Double_t deltaPt    = abs(deltapt / pt);
-    const Double_t etaFrac    = eta / geta;
-    const Double_t phiFrac    = phi / gphi;
-    const Double_t ptFrac     = pt / gpt;
-    const Double_t etaDiff    = eta - geta;
-    const Double_t phiDiff    = phi - gphi;
-    const Double_t ptDiff     = pt - gpt;
-    const Double_t vxDiff     = vx - gvx;
-    const Double_t vyDiff     = vy - gvy;
-    const Double_t vzDiff     = vz - gvz;
-
-    // set reco track variables
-    recoTrkVars[TRKVAR::VX]    = vx;
-    recoTrkVars[TRKVAR::VY]    = vy;
-    recoTrkVars[TRKVAR::VZ]    = vz;
-    recoTrkVars[TRKVAR::NMMS]  = (Double_t) nlmms;
-    recoTrkVars[TRKVAR::NMAP]  = (Double_t) nlmaps;
-    recoTrkVars[TRKVAR::NINT]  = (Double_t) nlintt;
-    recoTrkVars[TRKVAR::NTPC]  = (Double_t) ntpc;
-    recoTrkVars[TRKVAR::QUAL]  = quality;
-    recoTrkVars[TRKVAR::DCAXY] = umDcaXY;
-    recoTrkVars[TRKVAR::DCAZ]  = umDcaZ;
-
-    // set true track variables
-    trueTrkVars[TRKVAR::VX]    = gvx;
-    trueTrkVars[TRKVAR::VY]    = gvy;
-    trueTrkVars[TRKVAR::VZ]    = gvz;
-    trueTrkVars[TRKVAR::NMMS]  = (Double_t) gnlmms;
-    trueTrkVars[TRKVAR::NMAP]  = (Double_t) gnlmaps;
-    trueTrkVars[TRKVAR::NINT]  = (Double_t) gnlintt;
-    trueTrkVars[TRKVAR::NTPC]  = (Double_t) gntpc;
-    trueTrkVars[TRKVAR::QUAL]  = quality;
-    trueTrkVars[TRKVAR::DCAXY] = umDcaXY;
-    trueTrkVars[TRKVAR::DCAZ]  = umDcaZ;
-
-    // set reco phys variables
-    recoPhysVars[PHYSVAR::PHI] = phi;
-    recoPhysVars[PHYSVAR::ETA] = eta;
-    recoPhysVars[PHYSVAR::PT]  = pt;
-
-    // set true phys variables
-    truePhysVars[PHYSVAR::PHI] = gphi;
-    truePhysVars[PHYSVAR::ETA] = geta;
-    truePhysVars[PHYSVAR::PT]  = gpt;
-
-    // [02.14.2023] TEST
-    const Bool_t isInMvtxCut = (nlmaps >= 2);
-    if (!isInMvtxCut) continue;
-
-    // select only primaries if need be
-    const Bool_t isPrimary = (gprimary == 1);
-    if (useOnlyPrimary && !isPrimary) continue;
-
     // fill histograms
-    FillTrackHistograms(0, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-    FillTruthHistograms(1, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-    // fill embed-only track histograms
-    hTrackNMms         -> Fill(nlmms);
-    hTrackNMap         -> Fill(nlmaps);
-    hTrackNInt         -> Fill(nlintt);
-    hTrackNTpc         -> Fill(nltpc);
-    hTrackNTot         -> Fill(layers);
-    hTrackPerMms       -> Fill(perMms);
-    hTrackPerMap       -> Fill(perMaps);
-    hTrackPerInt       -> Fill(perIntt);
-    hTrackPerTpc       -> Fill(perTpc);
-    hTrackPerTot       -> Fill(perTot);
-    hTrackChi2         -> Fill(chisq);
-    hTrackNDF          -> Fill(ndf);
-    hTrackQuality      -> Fill(quality);
-    hTrackDCAxy        -> Fill(umDcaXY);
-    hTrackDCAz         -> Fill(umDcaZ);
-    hTrackVx           -> Fill(vx);
-    hTrackVy           -> Fill(vy);
-    hTrackVz           -> Fill(vz);
-    hTrackEta          -> Fill(eta);
-    hTrackPhi          -> Fill(phi);
-    hTrackPt           -> Fill(pt);
-    hDeltaDCAxy        -> Fill(deltaDcaXY);
-    hDeltaDCAz         -> Fill(deltaDcaZ);
-    hDeltaEta          -> Fill(deltaEta);
-    hDeltaPhi          -> Fill(deltaPhi);
-    hDeltaPt           -> Fill(deltaPt);
-    hTrackPtVsNMms     -> Fill(nlmms, pt);
-    hTrackPtVsNMap     -> Fill(nlmaps, pt);
-    hTrackPtVsNInt     -> Fill(nlintt, pt);
-    hTrackPtVsNTpc     -> Fill(nltpc, pt);
-    hTrackPtVsNTot     -> Fill(layers, pt);
-    hTrackPtVsPerMms   -> Fill(perMms, pt);
-    hTrackPtVsPerMap   -> Fill(perMaps, pt);
-    hTrackPtVsPerInt   -> Fill(perIntt, pt);
-    hTrackPtVsPerTpc   -> Fill(perTpc, pt);
-    hTrackPtVsPerTot   -> Fill(perTot, pt);
-    hTrackPtVsChi2     -> Fill(chisq, pt);
-    hTrackPtVsNDF      -> Fill(ndf, pt);
-    hTrackPtVsQuality  -> Fill(quality, pt);
-    hTrackPtVsDCAxy    -> Fill(umDcaXY, pt);
-    hTrackPtVsDCAz     -> Fill(umDcaZ, pt);
-    hDeltaDCAxyVsTrkPt -> Fill(pt, deltaDcaXY);
-    hDeltaDCAzVsTrkPt  -> Fill(pt, deltaDcaZ);
-    hDeltaEtaVsTrkPt   -> Fill(pt, deltaEta);
-    hDeltaPhiVsTrkPt   -> Fill(pt, deltaPhi);
-    hDeltaPtVsTrkPt    -> Fill(pt, deltaPt);
-
-    // fill embed-only truth histograms
-    hTruthNMms         -> Fill(gnlmms);
-    hTruthNMap         -> Fill(gnlmaps);
-    hTruthNInt         -> Fill(gnlintt);
-    hTruthNTpc         -> Fill(gnltpc);
-    hTruthNTot         -> Fill(glayers);
-    hTruthEta          -> Fill(geta);
-    hTruthPhi          -> Fill(gphi);
-    hTruthPt           -> Fill(gpt);
-    hTruthVx           -> Fill(gvx);
-    hTruthVy           -> Fill(gvy);
-    hTruthVz           -> Fill(gvz);
-    hTruthEtaFrac      -> Fill(etaFrac);
-    hTruthPhiFrac      -> Fill(phiFrac);
-    hTruthPtFrac       -> Fill(ptFrac);
-    hTruthEtaDiff      -> Fill(etaDiff);
-    hTruthPhiDiff      -> Fill(phiDiff);
-    hTruthPtDiff       -> Fill(ptDiff);
-    hTruthVxDiff       -> Fill(vxDiff);
-    hTruthVyDiff       -> Fill(vyDiff);
-    hTruthVzDiff       -> Fill(vzDiff);
-    hTruthVsTrackEta   -> Fill(eta, geta);
-    hTruthVsTrackPhi   -> Fill(phi, gphi);
-    hTruthVsTrackPt    -> Fill(pt, gpt);
-    hTruthVsTrackVx    -> Fill(vx, gvx);
-    hTruthVsTrackVy    -> Fill(vy, gvy);
-    hTruthVsTrackVz    -> Fill(vz, gvz);
-    hFracVsTruthEta    -> Fill(geta, etaFrac);
-    hFracVsTruthPhi    -> Fill(gphi, phiFrac);
-    hFracVsTruthPt     -> Fill(gpt, ptFrac);
-    hDiffVsTruthEta    -> Fill(geta, etaDiff);
-    hDiffVsTruthPhi    -> Fill(gphi, phiDiff);
-    hDiffVsTruthPt     -> Fill(gpt, ptDiff);
-    hTruthPtVsNMap     -> Fill(gnlmaps, gpt);
-    hTruthPtVsNInt     -> Fill(gnlintt, gpt);
-    hTruthPtVsNTpc     -> Fill(gnltpc, gpt);
-    hTruthPtVsNTot     -> Fill(glayers, gpt);
-    hTruthPtVsNTpc     -> Fill(nltpc, gpt);
-    hTruthPtVsChi2     -> Fill(chisq, gpt);
-    hTruthPtVsNDF      -> Fill(ndf, gpt);
-    hTruthPtVsQuality  -> Fill(quality, gpt);
-    hFracPtVsQuality   -> Fill(quality, ptFrac);
-    hTruthPtVsDCAxy    -> Fill(umDcaXY, gpt);
-    hTruthPtVsDCAz     -> Fill(umDcaZ, gpt);
-    hDeltaDCAxyVsTruPt -> Fill(gpt, deltaDcaXY);
-    hDeltaDCAzVsTruPt  -> Fill(gpt, deltaDcaZ);
-    hDeltaEtaVsTruPt   -> Fill(gpt, deltaEta);
-    hDeltaPhiVsTruPt   -> Fill(gpt, deltaPhi);
-    hDeltaPtVsTruPt    -> Fill(gpt, deltaPt);
-  
-    // fill embed_only weird histograms
-    const Bool_t isWeirdTrack = ((ptFrac < normalPtFracMin) || (ptFrac > normalPtFracMax));
-    const Bool_t hasSiSeed    = (nmaps == 3);
-    const Bool_t hasTpcSeed   = (nmaps == 0);
-    if (isWeirdTrack) {
-
-      FillTrackHistograms(2, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-      // fill all weird histograms
-      hWeirdNMms            -> Fill(nlmms);
-      hWeirdNMap            -> Fill(nlmaps);
-      hWeirdNInt            -> Fill(nlintt);
-      hWeirdNTpc            -> Fill(nltpc);
-      hWeirdNTot            -> Fill(layers);
-      hWeirdPerMms          -> Fill(perMms);
-      hWeirdPerMap          -> Fill(perMaps);
-      hWeirdPerInt          -> Fill(perIntt);
-      hWeirdPerTpc          -> Fill(perTpc);
-      hWeirdPerTot          -> Fill(perTot);
-      hWeirdChi2            -> Fill(chisq);
-      hWeirdNDF             -> Fill(ndf);
-      hWeirdQuality         -> Fill(quality);
-      hWeirdDCAxy           -> Fill(umDcaXY);
-      hWeirdDCAz            -> Fill(umDcaZ);
-      hWeirdVx              -> Fill(vx);
-      hWeirdVy              -> Fill(vy);
-      hWeirdVz              -> Fill(vz);
-      hWeirdEta             -> Fill(eta);
-      hWeirdPhi             -> Fill(phi);
-      hWeirdPt              -> Fill(pt); 
-      hWeirdDeltaDCAxy      -> Fill(deltaDcaXY);
-      hWeirdDeltaDCAz       -> Fill(deltaDcaZ);
-      hWeirdDeltaEta        -> Fill(deltaEta);
-      hWeirdDeltaPhi        -> Fill(deltaPhi);
-      hWeirdDeltaPt         -> Fill(deltaPt);
-      hWeirdEtaFrac         -> Fill(etaFrac);
-      hWeirdPhiFrac         -> Fill(phiFrac);
-      hWeirdPtFrac          -> Fill(ptFrac);
-      hWeirdEtaDiff         -> Fill(etaDiff);
-      hWeirdPhiDiff         -> Fill(phiDiff);
-      hWeirdPtDiff          -> Fill(ptDiff);
-      hWeirdVxDiff          -> Fill(vxDiff);
-      hWeirdVyDiff          -> Fill(vyDiff);
-      hWeirdVzDiff          -> Fill(vzDiff);
-      hWeirdPtVsNMms        -> Fill(nlmms, pt);
-      hWeirdPtVsNMap        -> Fill(nlmaps, pt);
-      hWeirdPtVsNInt        -> Fill(nlintt, pt);
-      hWeirdPtVsNTpc        -> Fill(nltpc, pt);
-      hWeirdPtVsNTot        -> Fill(layers, pt);
-      hWeirdPtVsPerMms      -> Fill(perMms, pt);
-      hWeirdPtVsPerMap      -> Fill(perMaps, pt);
-      hWeirdPtVsPerInt      -> Fill(perIntt, pt);
-      hWeirdPtVsPerTpc      -> Fill(perTpc, pt);
-      hWeirdPtVsPerTot      -> Fill(perTot, pt);
-      hWeirdPtVsChi2        -> Fill(chisq, pt);
-      hWeirdPtVsNDF         -> Fill(ndf, pt);
-      hWeirdPtVsQuality     -> Fill(quality, pt);
-      hWeirdPtVsDCAxy       -> Fill(umDcaXY, pt);
-      hWeirdPtVsDCAz        -> Fill(umDcaZ, pt);
-      hDeltaDCAxyVsOddPt    -> Fill(pt, deltaDcaXY);
-      hDeltaDCAzVsOddPt     -> Fill(pt, deltaDcaZ);
-      hDeltaEtaVsOddPt      -> Fill(pt, deltaEta);
-      hDeltaPhiVsOddPt      -> Fill(pt, deltaPhi);
-      hDeltaPtVsOddPt       -> Fill(pt, deltaPt);
-      hTruthVsWeirdEta      -> Fill(eta, geta);
-      hTruthVsWeirdPhi      -> Fill(phi, gphi);
-      hTruthVsWeirdPt       -> Fill(pt, gpt);
-      hTruthVsWeirdVx       -> Fill(vx, gvx);
-      hTruthVsWeirdVy       -> Fill(vy, gvy);
-      hTruthVsWeirdVz       -> Fill(vz, gvz);
-      hOddFracVsTruEta      -> Fill(geta, etaFrac);
-      hOddFracVsTruPhi      -> Fill(gphi, phiFrac);
-      hOddFracVsTruPt       -> Fill(gpt, ptFrac);
-      hOddDiffVsTruEta      -> Fill(geta, etaDiff);
-      hOddDiffVsTruPhi      -> Fill(gphi, phiDiff);
-      hOddDiffVsTruPt       -> Fill(gpt, ptDiff);
-      hTruPtVsOddNMap       -> Fill(gnlmaps, gpt);
-      hTruPtVsOddNInt       -> Fill(gnlintt, gpt);
-      hTruPtVsOddNTpc       -> Fill(gnltpc, gpt);
-      hTruPtVsOddNTot       -> Fill(glayers, gpt);
-      hTruPtVsOddNTpc       -> Fill(nltpc, gpt);
-      hTruPtVsOddChi2       -> Fill(chisq, gpt);
-      hTruPtVsOddNDF        -> Fill(ndf, gpt);
-      hTruPtVsOddQuality    -> Fill(quality, gpt);
-      hFracPtVsOddQuality   -> Fill(quality, ptFrac);
-      hTruPtVsOddDCAxy      -> Fill(umDcaXY, gpt);
-      hTruPtVsOddDCAz       -> Fill(umDcaZ, gpt);
-      hOddDeltaDCAxyVsTruPt -> Fill(gpt, deltaDcaXY);
-      hOddDeltaDCAzVsTruPt  -> Fill(gpt, deltaDcaZ);
-      hOddDeltaEtaVsTruPt   -> Fill(gpt, deltaEta);
-      hOddDeltaPhiVsTruPt   -> Fill(gpt, deltaPhi);
-      hOddDeltaPtVsTruPt    -> Fill(gpt, deltaPt);
-
-      // fill si seed histograms 
-      if (hasSiSeed) {
-
-        FillTrackHistograms(3, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-        hWeirdNMms_SI            -> Fill(nlmms);
-        //hWeirdNMap_SI            -> Fill(nlmaps);
-        hWeirdNMap_SI            -> Fill(nmaps);
-        hWeirdNInt_SI            -> Fill(nlintt);
-        hWeirdNTpc_SI            -> Fill(nltpc);
-        hWeirdNTot_SI            -> Fill(layers);
-        hWeirdPerMms_SI          -> Fill(perMms);
-        hWeirdPerMap_SI          -> Fill(perMaps);
-        hWeirdPerInt_SI          -> Fill(perIntt);
-        hWeirdPerTpc_SI          -> Fill(perTpc);
-        hWeirdPerTot_SI          -> Fill(perTot);
-        hWeirdChi2_SI            -> Fill(chisq);
-        hWeirdNDF_SI             -> Fill(ndf);
-        hWeirdQuality_SI         -> Fill(quality);
-        hWeirdDCAxy_SI           -> Fill(umDcaXY);
-        hWeirdDCAz_SI            -> Fill(umDcaZ);
-        hWeirdVx_SI              -> Fill(vx);
-        hWeirdVy_SI              -> Fill(vy);
-        hWeirdVz_SI              -> Fill(vz);
-        hWeirdEta_SI             -> Fill(eta);
-        hWeirdPhi_SI             -> Fill(phi);
-        hWeirdPt_SI              -> Fill(pt); 
-        hWeirdDeltaDCAxy_SI      -> Fill(deltaDcaXY);
-        hWeirdDeltaDCAz_SI       -> Fill(deltaDcaZ);
-        hWeirdDeltaEta_SI        -> Fill(deltaEta);
-        hWeirdDeltaPhi_SI        -> Fill(deltaPhi);
-        hWeirdDeltaPt_SI         -> Fill(deltaPt);
-        hWeirdEtaFrac_SI         -> Fill(etaFrac);
-        hWeirdPhiFrac_SI         -> Fill(phiFrac);
-        hWeirdPtFrac_SI          -> Fill(ptFrac);
-        hWeirdEtaDiff_SI         -> Fill(etaDiff);
-        hWeirdPhiDiff_SI         -> Fill(phiDiff);
-        hWeirdPtDiff_SI          -> Fill(ptDiff);
-        hWeirdVxDiff_SI          -> Fill(vxDiff);
-        hWeirdVyDiff_SI          -> Fill(vyDiff);
-        hWeirdVzDiff_SI          -> Fill(vzDiff);
-        hWeirdPtVsNMms_SI        -> Fill(nlmms, pt);
-        hWeirdPtVsNMap_SI        -> Fill(nlmaps, pt);
-        hWeirdPtVsNInt_SI        -> Fill(nlintt, pt);
-        hWeirdPtVsNTpc_SI        -> Fill(nltpc, pt);
-        hWeirdPtVsNTot_SI        -> Fill(layers, pt);
-        hWeirdPtVsPerMms_SI      -> Fill(perMms, pt);
-        hWeirdPtVsPerMap_SI      -> Fill(perMaps, pt);
-        hWeirdPtVsPerInt_SI      -> Fill(perIntt, pt);
-        hWeirdPtVsPerTpc_SI      -> Fill(perTpc, pt);
-        hWeirdPtVsPerTot_SI      -> Fill(perTot, pt);
-        hWeirdPtVsChi2_SI        -> Fill(chisq, pt);
-        hWeirdPtVsNDF_SI         -> Fill(ndf, pt);
-        hWeirdPtVsQuality_SI     -> Fill(quality, pt);
-        hWeirdPtVsDCAxy_SI       -> Fill(umDcaXY, pt);
-        hWeirdPtVsDCAz_SI        -> Fill(umDcaZ, pt);
-        hDeltaDCAxyVsOddPt_SI    -> Fill(pt, deltaDcaXY);
-        hDeltaDCAzVsOddPt_SI     -> Fill(pt, deltaDcaZ);
-        hDeltaEtaVsOddPt_SI      -> Fill(pt, deltaEta);
-        hDeltaPhiVsOddPt_SI      -> Fill(pt, deltaPhi);
-        hDeltaPtVsOddPt_SI       -> Fill(pt, deltaPt);
-        hTruthVsWeirdEta_SI      -> Fill(eta, geta);
-        hTruthVsWeirdPhi_SI      -> Fill(phi, gphi);
-        hTruthVsWeirdPt_SI       -> Fill(pt, gpt);
-        hTruthVsWeirdVx_SI       -> Fill(vx, gvx);
-        hTruthVsWeirdVy_SI       -> Fill(vy, gvy);
-        hTruthVsWeirdVz_SI       -> Fill(vz, gvz);
-        hOddFracVsTruEta_SI      -> Fill(geta, etaFrac);
-        hOddFracVsTruPhi_SI      -> Fill(gphi, phiFrac);
-        hOddFracVsTruPt_SI       -> Fill(gpt, ptFrac);
-        hOddDiffVsTruEta_SI      -> Fill(geta, etaDiff);
-        hOddDiffVsTruPhi_SI      -> Fill(gphi, phiDiff);
-        hOddDiffVsTruPt_SI       -> Fill(gpt, ptDiff);
-        hTruPtVsOddNMap_SI       -> Fill(gnlmaps, gpt);
-        hTruPtVsOddNInt_SI       -> Fill(gnlintt, gpt);
-        hTruPtVsOddNTpc_SI       -> Fill(gnltpc, gpt);
-        hTruPtVsOddNTot_SI       -> Fill(glayers, gpt);
-        hTruPtVsOddNTpc_SI       -> Fill(nltpc, gpt);
-        hTruPtVsOddChi2_SI       -> Fill(chisq, gpt);
-        hTruPtVsOddNDF_SI        -> Fill(ndf, gpt);
-        hTruPtVsOddQuality_SI    -> Fill(quality, gpt);
-        hFracPtVsOddQuality_SI   -> Fill(quality, ptFrac);
-        hTruPtVsOddDCAxy_SI      -> Fill(umDcaXY, gpt);
-        hTruPtVsOddDCAz_SI       -> Fill(umDcaZ, gpt);
-        hOddDeltaDCAxyVsTruPt_SI -> Fill(gpt, deltaDcaXY);
-        hOddDeltaDCAzVsTruPt_SI  -> Fill(gpt, deltaDcaZ);
-        hOddDeltaEtaVsTruPt_SI   -> Fill(gpt, deltaEta);
-        hOddDeltaPhiVsTruPt_SI   -> Fill(gpt, deltaPhi);
-        hOddDeltaPtVsTruPt_SI    -> Fill(gpt, deltaPt);
-      }
-
-      // fill tpc seed histograms
-      if (hasTpcSeed) {
-
-        FillTrackHistograms(4, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-        hWeirdNMms_TPC            -> Fill(nlmms);
-        //hWeirdNMap_TPC            -> Fill(nlmaps);
-        hWeirdNMap_TPC            -> Fill(nmaps);
-        hWeirdNInt_TPC            -> Fill(nlintt);
-        hWeirdNTpc_TPC            -> Fill(nltpc);
-        hWeirdNTot_TPC            -> Fill(layers);
-        hWeirdPerMms_TPC          -> Fill(perMms);
-        hWeirdPerMap_TPC          -> Fill(perMaps);
-        hWeirdPerInt_TPC          -> Fill(perIntt);
-        hWeirdPerTpc_TPC          -> Fill(perTpc);
-        hWeirdPerTot_TPC          -> Fill(perTot);
-        hWeirdChi2_TPC            -> Fill(chisq);
-        hWeirdNDF_TPC             -> Fill(ndf);
-        hWeirdQuality_TPC         -> Fill(quality);
-        hWeirdDCAxy_TPC           -> Fill(umDcaXY);
-        hWeirdDCAz_TPC            -> Fill(umDcaZ);
-        hWeirdVx_TPC              -> Fill(vx);
-        hWeirdVy_TPC              -> Fill(vy);
-        hWeirdVz_TPC              -> Fill(vz);
-        hWeirdEta_TPC             -> Fill(eta);
-        hWeirdPhi_TPC             -> Fill(phi);
-        hWeirdPt_TPC              -> Fill(pt); 
-        hWeirdDeltaDCAxy_TPC      -> Fill(deltaDcaXY);
-        hWeirdDeltaDCAz_TPC       -> Fill(deltaDcaZ);
-        hWeirdDeltaEta_TPC        -> Fill(deltaEta);
-        hWeirdDeltaPhi_TPC        -> Fill(deltaPhi);
-        hWeirdDeltaPt_TPC         -> Fill(deltaPt);
-        hWeirdEtaFrac_TPC         -> Fill(etaFrac);
-        hWeirdPhiFrac_TPC         -> Fill(phiFrac);
-        hWeirdPtFrac_TPC          -> Fill(ptFrac);
-        hWeirdEtaDiff_TPC         -> Fill(etaDiff);
-        hWeirdPhiDiff_TPC         -> Fill(phiDiff);
-        hWeirdPtDiff_TPC          -> Fill(ptDiff);
-        hWeirdVxDiff_TPC          -> Fill(vxDiff);
-        hWeirdVyDiff_TPC          -> Fill(vyDiff);
-        hWeirdVzDiff_TPC          -> Fill(vzDiff);
-        hWeirdPtVsNMms_TPC        -> Fill(nlmms, pt);
-        hWeirdPtVsNMap_TPC        -> Fill(nlmaps, pt);
-        hWeirdPtVsNInt_TPC        -> Fill(nlintt, pt);
-        hWeirdPtVsNTpc_TPC        -> Fill(nltpc, pt);
-        hWeirdPtVsNTot_TPC        -> Fill(layers, pt);
-        hWeirdPtVsPerMms_TPC      -> Fill(perMms, pt);
-        hWeirdPtVsPerMap_TPC      -> Fill(perMaps, pt);
-        hWeirdPtVsPerInt_TPC      -> Fill(perIntt, pt);
-        hWeirdPtVsPerTpc_TPC      -> Fill(perTpc, pt);
-        hWeirdPtVsPerTot_TPC      -> Fill(perTot, pt);
-        hWeirdPtVsChi2_TPC        -> Fill(chisq, pt);
-        hWeirdPtVsNDF_TPC         -> Fill(ndf, pt);
-        hWeirdPtVsQuality_TPC     -> Fill(quality, pt);
-        hWeirdPtVsDCAxy_TPC       -> Fill(umDcaXY, pt);
-        hWeirdPtVsDCAz_TPC        -> Fill(umDcaZ, pt);
-        hDeltaDCAxyVsOddPt_TPC    -> Fill(pt, deltaDcaXY);
-        hDeltaDCAzVsOddPt_TPC     -> Fill(pt, deltaDcaZ);
-        hDeltaEtaVsOddPt_TPC      -> Fill(pt, deltaEta);
-        hDeltaPhiVsOddPt_TPC      -> Fill(pt, deltaPhi);
-        hDeltaPtVsOddPt_TPC       -> Fill(pt, deltaPt);
-        hTruthVsWeirdEta_TPC      -> Fill(eta, geta);
-        hTruthVsWeirdPhi_TPC      -> Fill(phi, gphi);
-        hTruthVsWeirdPt_TPC       -> Fill(pt, gpt);
-        hTruthVsWeirdVx_TPC       -> Fill(vx, gvx);
-        hTruthVsWeirdVy_TPC       -> Fill(vy, gvy);
-        hTruthVsWeirdVz_TPC       -> Fill(vz, gvz);
-        hOddFracVsTruEta_TPC      -> Fill(geta, etaFrac);
-        hOddFracVsTruPhi_TPC      -> Fill(gphi, phiFrac);
-        hOddFracVsTruPt_TPC       -> Fill(gpt, ptFrac);
-        hOddDiffVsTruEta_TPC      -> Fill(geta, etaDiff);
-        hOddDiffVsTruPhi_TPC      -> Fill(gphi, phiDiff);
-        hOddDiffVsTruPt_TPC       -> Fill(gpt, ptDiff);
-        hTruPtVsOddNMap_TPC       -> Fill(gnlmaps, gpt);
-        hTruPtVsOddNInt_TPC       -> Fill(gnlintt, gpt);
-        hTruPtVsOddNTpc_TPC       -> Fill(gnltpc, gpt);
-        hTruPtVsOddNTot_TPC       -> Fill(glayers, gpt);
-        hTruPtVsOddNTpc_TPC       -> Fill(nltpc, gpt);
-        hTruPtVsOddChi2_TPC       -> Fill(chisq, gpt);
-        hTruPtVsOddNDF_TPC        -> Fill(ndf, gpt);
-        hTruPtVsOddQuality_TPC    -> Fill(quality, gpt);
-        hFracPtVsOddQuality_TPC   -> Fill(quality, ptFrac);
-        hTruPtVsOddDCAxy_TPC      -> Fill(umDcaXY, gpt);
-        hTruPtVsOddDCAz_TPC       -> Fill(umDcaZ, gpt);
-        hOddDeltaDCAxyVsTruPt_TPC -> Fill(gpt, deltaDcaXY);
-        hOddDeltaDCAzVsTruPt_TPC  -> Fill(gpt, deltaDcaZ);
-        hOddDeltaEtaVsTruPt_TPC   -> Fill(gpt, deltaEta);
-        hOddDeltaPhiVsTruPt_TPC   -> Fill(gpt, deltaPhi);
-        hOddDeltaPtVsTruPt_TPC    -> Fill(gpt, deltaPt);
-      }
-    } else {
-
-      FillTrackHistograms(5, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-      hNormalNMms            -> Fill(nlmms);
-      hNormalNMap            -> Fill(nlmaps);
-      hNormalNInt            -> Fill(nlintt);
-      hNormalNTpc            -> Fill(nltpc);
-      hNormalNTot            -> Fill(layers);
-      hNormalPerMms          -> Fill(perMms);
-      hNormalPerMap          -> Fill(perMaps);
-      hNormalPerInt          -> Fill(perIntt);
-      hNormalPerTpc          -> Fill(perTpc);
-      hNormalPerTot          -> Fill(perTot);
-      hNormalChi2            -> Fill(chisq);
-      hNormalNDF             -> Fill(ndf);
-      hNormalQuality         -> Fill(quality);
-      hNormalDCAxy           -> Fill(umDcaXY);
-      hNormalDCAz            -> Fill(umDcaZ);
-      hNormalVx              -> Fill(vx);
-      hNormalVy              -> Fill(vy);
-      hNormalVz              -> Fill(vz);
-      hNormalEta             -> Fill(eta);
-      hNormalPhi             -> Fill(phi);
-      hNormalPt              -> Fill(pt); 
-      hNormalDeltaDCAxy      -> Fill(deltaDcaXY);
-      hNormalDeltaDCAz       -> Fill(deltaDcaZ);
-      hNormalDeltaEta        -> Fill(deltaEta);
-      hNormalDeltaPhi        -> Fill(deltaPhi);
-      hNormalDeltaPt         -> Fill(deltaPt);
-      hNormalEtaFrac         -> Fill(etaFrac);
-      hNormalPhiFrac         -> Fill(phiFrac);
-      hNormalPtFrac          -> Fill(ptFrac);
-      hNormalEtaDiff         -> Fill(etaDiff);
-      hNormalPhiDiff         -> Fill(phiDiff);
-      hNormalPtDiff          -> Fill(ptDiff);
-      hNormalVxDiff          -> Fill(vxDiff);
-      hNormalVyDiff          -> Fill(vyDiff);
-      hNormalVzDiff          -> Fill(vzDiff);
-      hNormalPtVsNMms        -> Fill(nlmms, pt);
-      hNormalPtVsNMap        -> Fill(nlmaps, pt);
-      hNormalPtVsNInt        -> Fill(nlintt, pt);
-      hNormalPtVsNTpc        -> Fill(nltpc, pt);
-      hNormalPtVsNTot        -> Fill(layers, pt);
-      hNormalPtVsPerMms      -> Fill(perMms, pt);
-      hNormalPtVsPerMap      -> Fill(perMaps, pt);
-      hNormalPtVsPerInt      -> Fill(perIntt, pt);
-      hNormalPtVsPerTpc      -> Fill(perTpc, pt);
-      hNormalPtVsPerTot      -> Fill(perTot, pt);
-      hNormalPtVsChi2        -> Fill(chisq, pt);
-      hNormalPtVsNDF         -> Fill(ndf, pt);
-      hNormalPtVsQuality     -> Fill(quality, pt);
-      hNormalPtVsDCAxy       -> Fill(umDcaXY, pt);
-      hNormalPtVsDCAz        -> Fill(umDcaZ, pt);
-      hDeltaDCAxyVsNormPt    -> Fill(pt, deltaDcaXY);
-      hDeltaDCAzVsNormPt     -> Fill(pt, deltaDcaZ);
-      hDeltaEtaVsNormPt      -> Fill(pt, deltaEta);
-      hDeltaPhiVsNormPt      -> Fill(pt, deltaPhi);
-      hDeltaPtVsNormPt       -> Fill(pt, deltaPt);
-      hTruthVsNormalEta      -> Fill(eta, geta);
-      hTruthVsNormalPhi      -> Fill(phi, gphi);
-      hTruthVsNormalPt       -> Fill(pt, gpt);
-      hTruthVsNormalVx       -> Fill(vx, gvx);
-      hTruthVsNormalVy       -> Fill(vy, gvy);
-      hTruthVsNormalVz       -> Fill(vz, gvz);
-      hNormFracVsTruEta      -> Fill(geta, etaFrac);
-      hNormFracVsTruPhi      -> Fill(gphi, phiFrac);
-      hNormFracVsTruPt       -> Fill(gpt, ptFrac);
-      hNormDiffVsTruEta      -> Fill(geta, etaDiff);
-      hNormDiffVsTruPhi      -> Fill(gphi, phiDiff);
-      hNormDiffVsTruPt       -> Fill(gpt, ptDiff);
-      hTruPtVsNormNMap       -> Fill(gnlmaps, gpt);
-      hTruPtVsNormNInt       -> Fill(gnlintt, gpt);
-      hTruPtVsNormNTpc       -> Fill(gnltpc, gpt);
-      hTruPtVsNormNTot       -> Fill(glayers, gpt);
-      hTruPtVsNormNTpc       -> Fill(nltpc, gpt);
-      hTruPtVsNormChi2       -> Fill(chisq, gpt);
-      hTruPtVsNormNDF        -> Fill(ndf, gpt);
-      hTruPtVsNormQuality    -> Fill(quality, gpt);
-      hFracPtVsNormQuality   -> Fill(quality, ptFrac);
-      hTruPtVsNormDCAxy      -> Fill(umDcaXY, gpt);
-      hTruPtVsNormDCAz       -> Fill(umDcaZ, gpt);
-      hNormDeltaDCAxyVsTruPt -> Fill(gpt, deltaDcaXY);
-      hNormDeltaDCAzVsTruPt  -> Fill(gpt, deltaDcaZ);
-      hNormDeltaEtaVsTruPt   -> Fill(gpt, deltaEta);
-      hNormDeltaPhiVsTruPt   -> Fill(gpt, deltaPhi);
-      hNormDeltaPtVsTruPt    -> Fill(gpt, deltaPt);
-    }
+    FillEmbedOnlyEntry();
   }  // end embed-only entry loop
   cout << "      Finished embed-only entry loop." << endl;
 
@@ -730,230 +264,785 @@ void STrackCutStudy::Analyze() {
 
     // announce progress
     const Long64_t iProg = iEntry + 1;
-    if (iProg == nEntriesPU) {
+    if (((iProg % NProgress) == 0) || (iProg == nEntriesPU)) {
       cout << "        Processing with-pileup entry " << iProg << "/" << nEntriesPU << "..." << endl;
-    } else {
-      cout << "        Processing with-pileup entry " << iProg << "/" << nEntriesPU << "...\r" << flush;
     }
 
-    // perform calculations
-    const Float_t  pu_glayers = pu_gnlmms + pu_gnlmaps + pu_gnlintt + pu_gnltpc;
-    const Double_t perMms     = (Double_t) pu_nlmms / (Double_t) pu_gnlmms;
-    const Double_t perMaps    = (Double_t) pu_nlmaps / (Double_t) pu_gnlmaps;
-    const Double_t perIntt    = (Double_t) pu_nlintt / (Double_t) pu_gnlintt;
-    const Double_t perTpc     = (Double_t) pu_nltpc / (Double_t) pu_gnltpc;
-    const Double_t perTot     = (Double_t) pu_layers / (Double_t) pu_glayers;
-    const Double_t umDcaXY    = pu_dca3dxy * 10000;
-    const Double_t umDcaZ     = pu_dca3dz * 10000;
-    const Double_t deltaDcaXY = abs(pu_dca3dxysigma / pu_dca3dxy);
-    const Double_t deltaDcaZ  = abs(pu_dca3dzsigma / pu_dca3dz);
-    const Double_t deltaEta   = abs(pu_deltaeta / pu_eta);
-    const Double_t deltaPhi   = abs(pu_deltaphi / pu_phi);
-    const Double_t deltaPt    = abs(pu_deltapt / pu_pt);
-
-    // check if values are defined & if primary or not
-    const Bool_t thereAreNans = (isnan(pu_dca3dxy) || isnan(pu_dca3dz) || isnan(pu_eta) || isnan(pu_phi) || isnan(pu_pt));
-    const Bool_t isPrimary    = (pu_gprimary == 1);
-    if (thereAreNans) continue;
-
-    // set reco track variables
-    recoTrkVars[TRKVAR::VX]    = pu_vx;
-    recoTrkVars[TRKVAR::VY]    = pu_vy;
-    recoTrkVars[TRKVAR::VZ]    = pu_vz;
-    recoTrkVars[TRKVAR::NMMS]  = (Double_t) pu_nlmms;
-    recoTrkVars[TRKVAR::NMAP]  = (Double_t) pu_nlmaps;
-    recoTrkVars[TRKVAR::NINT]  = (Double_t) pu_nlintt;
-    recoTrkVars[TRKVAR::NTPC]  = (Double_t) pu_ntpc;
-    recoTrkVars[TRKVAR::QUAL]  = pu_quality;
-    recoTrkVars[TRKVAR::DCAXY] = umDcaXY;
-    recoTrkVars[TRKVAR::DCAZ]  = umDcaZ;
-
-    // set true track variables
-    trueTrkVars[TRKVAR::VX]    = pu_gvx;
-    trueTrkVars[TRKVAR::VY]    = pu_gvy;
-    trueTrkVars[TRKVAR::VZ]    = pu_gvz;
-    trueTrkVars[TRKVAR::NMMS]  = (Double_t) pu_gnlmms;
-    trueTrkVars[TRKVAR::NMAP]  = (Double_t) pu_gnlmaps;
-    trueTrkVars[TRKVAR::NINT]  = (Double_t) pu_gnlintt;
-    trueTrkVars[TRKVAR::NTPC]  = (Double_t) pu_gntpc;
-    trueTrkVars[TRKVAR::QUAL]  = pu_quality;
-    trueTrkVars[TRKVAR::DCAXY] = umDcaXY;
-    trueTrkVars[TRKVAR::DCAZ]  = umDcaZ;
-
-    // set reco phys variables
-    recoPhysVars[PHYSVAR::PHI] = pu_phi;
-    recoPhysVars[PHYSVAR::ETA] = pu_eta;
-    recoPhysVars[PHYSVAR::PT]  = pu_pt;
-
-    // set true phys variables
-    truePhysVars[PHYSVAR::PHI] = gphi;
-    truePhysVars[PHYSVAR::ETA] = geta;
-    truePhysVars[PHYSVAR::PT]  = gpt;
-
-    // [02.14.2023] TEST
-    const Bool_t isInMvtxCut = (pu_nlmaps >= 2);
-    if (!isInMvtxCut) continue;
-
     // fill histograms
-    FillTrackHistograms(6, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-
-    // fill with-pileup track histograms
-    hTrackNMms_PU         -> Fill(pu_nlmms);
-    hTrackNMap_PU         -> Fill(pu_nlmaps);
-    hTrackNInt_PU         -> Fill(pu_nlintt);
-    hTrackNTpc_PU         -> Fill(pu_nltpc);
-    hTrackNTot_PU         -> Fill(pu_layers);
-    hTrackPerMms_PU       -> Fill(perMms);
-    hTrackPerMap_PU       -> Fill(perMaps);
-    hTrackPerInt_PU       -> Fill(perIntt);
-    hTrackPerTpc_PU       -> Fill(perTpc);
-    hTrackPerTot_PU       -> Fill(perTot);
-    hTrackChi2_PU         -> Fill(pu_chisq);
-    hTrackNDF_PU          -> Fill(pu_ndf);
-    hTrackQuality_PU      -> Fill(pu_quality);
-    hTrackDCAxy_PU        -> Fill(umDcaXY);
-    hTrackDCAz_PU         -> Fill(umDcaZ);
-    hTrackVx_PU           -> Fill(pu_vx);
-    hTrackVy_PU           -> Fill(pu_vy);
-    hTrackVz_PU           -> Fill(pu_vz);
-    hTrackEta_PU          -> Fill(pu_eta);
-    hTrackPhi_PU          -> Fill(pu_phi);
-    hTrackPt_PU           -> Fill(pu_pt);
-    hDeltaDCAxy_PU        -> Fill(deltaDcaXY);
-    hDeltaDCAz_PU         -> Fill(deltaDcaZ);
-    hDeltaEta_PU          -> Fill(deltaEta);
-    hDeltaPhi_PU          -> Fill(deltaPhi);
-    hDeltaPt_PU           -> Fill(deltaPt);
-    hTrackPtVsNMms_PU     -> Fill(pu_nlmaps, pu_pt);
-    hTrackPtVsNMap_PU     -> Fill(pu_nlmaps, pu_pt);
-    hTrackPtVsNInt_PU     -> Fill(pu_nlintt, pu_pt);
-    hTrackPtVsNTpc_PU     -> Fill(pu_nltpc, pu_pt);
-    hTrackPtVsNTot_PU     -> Fill(pu_layers, pu_pt);
-    hTrackPtVsPerMms_PU   -> Fill(perMms, pu_pt);
-    hTrackPtVsPerMap_PU   -> Fill(perMaps, pu_pt);
-    hTrackPtVsPerInt_PU   -> Fill(perIntt, pu_pt);
-    hTrackPtVsPerTpc_PU   -> Fill(perTpc, pu_pt);
-    hTrackPtVsPerTot_PU   -> Fill(perTot, pu_pt);
-    hTrackPtVsChi2_PU     -> Fill(pu_chisq, pu_pt);
-    hTrackPtVsNDF_PU      -> Fill(pu_ndf, pu_pt);
-    hTrackPtVsQuality_PU  -> Fill(pu_quality, pu_pt);
-    hTrackPtVsDCAxy_PU    -> Fill(umDcaXY, pu_pt);
-    hTrackPtVsDCAz_PU     -> Fill(umDcaZ, pu_pt);
-    hDeltaDCAxyVsTrkPt_PU -> Fill(pu_pt, deltaDcaXY);
-    hDeltaDCAzVsTrkPt_PU  -> Fill(pu_pt, deltaDcaZ);
-    hDeltaEtaVsTrkPt_PU   -> Fill(pu_pt, deltaEta);
-    hDeltaPhiVsTrkPt_PU   -> Fill(pu_pt, deltaPhi);
-    hDeltaPtVsTrkPt_PU    -> Fill(pu_pt, deltaPt);
-    if (isPrimary) {
-
-      FillTrackHistograms(7, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-      hPrimaryNMms_PU        -> Fill(pu_nlmms);
-      hPrimaryNMap_PU        -> Fill(pu_nlmaps);
-      hPrimaryNInt_PU        -> Fill(pu_nlintt);
-      hPrimaryNTpc_PU        -> Fill(pu_nltpc);
-      hPrimaryNTot_PU        -> Fill(pu_layers);
-      hPrimaryPerMms_PU      -> Fill(perMms);
-      hPrimaryPerMap_PU      -> Fill(perMaps);
-      hPrimaryPerInt_PU      -> Fill(perIntt);
-      hPrimaryPerTpc_PU      -> Fill(perTpc);
-      hPrimaryPerTot_PU      -> Fill(perTot);
-      hPrimaryChi2_PU        -> Fill(pu_chisq);
-      hPrimaryNDF_PU         -> Fill(pu_ndf);
-      hPrimaryQuality_PU     -> Fill(pu_quality);
-      hPrimaryDCAxy_PU       -> Fill(umDcaXY);
-      hPrimaryDCAz_PU        -> Fill(umDcaZ);
-      hPrimaryVx_PU          -> Fill(pu_vx);
-      hPrimaryVy_PU          -> Fill(pu_vy);
-      hPrimaryVz_PU          -> Fill(pu_vz);
-      hPrimaryEta_PU         -> Fill(pu_eta);
-      hPrimaryPhi_PU         -> Fill(pu_phi);
-      hPrimaryPt_PU          -> Fill(pu_pt);
-      hDeltaPrimDCAxy_PU     -> Fill(deltaDcaXY);
-      hDeltaPrimDCAz_PU      -> Fill(deltaDcaZ);
-      hDeltaPrimEta_PU       -> Fill(deltaEta);
-      hDeltaPrimPhi_PU       -> Fill(deltaPhi);
-      hDeltaPrimPt_PU        -> Fill(deltaPt);
-      hPrimaryPtVsNMms_PU    -> Fill(pu_nlmaps, pu_pt);
-      hPrimaryPtVsNMap_PU    -> Fill(pu_nlmaps, pu_pt);
-      hPrimaryPtVsNInt_PU    -> Fill(pu_nlintt, pu_pt);
-      hPrimaryPtVsNTpc_PU    -> Fill(pu_nltpc, pu_pt);
-      hPrimaryPtVsNTot_PU    -> Fill(pu_layers, pu_pt);
-      hPrimaryPtVsPerMms_PU  -> Fill(perMms, pu_pt);
-      hPrimaryPtVsPerMap_PU  -> Fill(perMaps, pu_pt);
-      hPrimaryPtVsPerInt_PU  -> Fill(perIntt, pu_pt);
-      hPrimaryPtVsPerTpc_PU  -> Fill(perTpc, pu_pt);
-      hPrimaryPtVsPerTot_PU  -> Fill(perTot, pu_pt);
-      hPrimaryPtVsChi2_PU    -> Fill(pu_chisq, pu_pt);
-      hPrimaryPtVsNDF_PU     -> Fill(pu_ndf, pu_pt);
-      hPrimaryPtVsQuality_PU -> Fill(pu_quality, pu_pt);
-      hPrimaryPtVsDCAxy_PU   -> Fill(umDcaXY, pu_pt);
-      hPrimaryPtVsDCAz_PU    -> Fill(umDcaZ, pu_pt);
-      hDeltaDCAxyVsPrimPt_PU -> Fill(pu_pt, deltaDcaXY);
-      hDeltaDCAzVsPrimPt_PU  -> Fill(pu_pt, deltaDcaZ);
-      hDeltaEtaVsPrimPt_PU   -> Fill(pu_pt, deltaEta);
-      hDeltaPhiVsPrimPt_PU   -> Fill(pu_pt, deltaPhi);
-      hDeltaPtVsPrimPt_PU    -> Fill(pu_pt, deltaPt);
-    } else {
-
-      FillTrackHistograms(6, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-
-      hNonPrimNMms_PU        -> Fill(pu_nlmms);
-      hNonPrimNMap_PU        -> Fill(pu_nlmaps);
-      hNonPrimNInt_PU        -> Fill(pu_nlintt);
-      hNonPrimNTpc_PU        -> Fill(pu_nltpc);
-      hNonPrimNTot_PU        -> Fill(pu_layers);
-      hNonPrimPerMms_PU      -> Fill(perMms);
-      hNonPrimPerMap_PU      -> Fill(perMaps);
-      hNonPrimPerInt_PU      -> Fill(perIntt);
-      hNonPrimPerTpc_PU      -> Fill(perTpc);
-      hNonPrimPerTot_PU      -> Fill(perTot);
-      hNonPrimChi2_PU        -> Fill(pu_chisq);
-      hNonPrimNDF_PU         -> Fill(pu_ndf);
-      hNonPrimQuality_PU     -> Fill(pu_quality);
-      hNonPrimDCAxy_PU       -> Fill(umDcaXY);
-      hNonPrimDCAz_PU        -> Fill(umDcaZ);
-      hNonPrimVx_PU          -> Fill(pu_vx);
-      hNonPrimVy_PU          -> Fill(pu_vy);
-      hNonPrimVz_PU          -> Fill(pu_vz);
-      hNonPrimEta_PU         -> Fill(pu_eta);
-      hNonPrimPhi_PU         -> Fill(pu_phi);
-      hNonPrimPt_PU          -> Fill(pu_pt);
-      hDeltaNoPrDCAxy_PU     -> Fill(deltaDcaXY);
-      hDeltaNoPrDCAz_PU      -> Fill(deltaDcaZ);
-      hDeltaNoPrEta_PU       -> Fill(deltaEta);
-      hDeltaNoPrPhi_PU       -> Fill(deltaPhi);
-      hDeltaNoPrPt_PU        -> Fill(deltaPt);
-      hNonPrimPtVsNMms_PU    -> Fill(pu_nlmaps, pu_pt);
-      hNonPrimPtVsNMap_PU    -> Fill(pu_nlmaps, pu_pt);
-      hNonPrimPtVsNInt_PU    -> Fill(pu_nlintt, pu_pt);
-      hNonPrimPtVsNTpc_PU    -> Fill(pu_nltpc, pu_pt);
-      hNonPrimPtVsNTot_PU    -> Fill(pu_layers, pu_pt);
-      hNonPrimPtVsPerMms_PU  -> Fill(perMms, pu_pt);
-      hNonPrimPtVsPerMap_PU  -> Fill(perMaps, pu_pt);
-      hNonPrimPtVsPerInt_PU  -> Fill(perIntt, pu_pt);
-      hNonPrimPtVsPerTpc_PU  -> Fill(perTpc, pu_pt);
-      hNonPrimPtVsPerTot_PU  -> Fill(perTot, pu_pt);
-      hNonPrimPtVsChi2_PU    -> Fill(pu_chisq, pu_pt);
-      hNonPrimPtVsNDF_PU     -> Fill(pu_ndf, pu_pt);
-      hNonPrimPtVsQuality_PU -> Fill(pu_quality, pu_pt);
-      hNonPrimPtVsDCAxy_PU   -> Fill(umDcaXY, pu_pt);
-      hNonPrimPtVsDCAz_PU    -> Fill(umDcaZ, pu_pt);
-      hDeltaDCAxyVsNoPrPt_PU -> Fill(pu_pt, deltaDcaXY);
-      hDeltaDCAzVsNoPrPt_PU  -> Fill(pu_pt, deltaDcaZ);
-      hDeltaEtaVsNoPrPt_PU   -> Fill(pu_pt, deltaEta);
-      hDeltaPhiVsNoPrPt_PU   -> Fill(pu_pt, deltaPhi);
-      hDeltaPtVsNoPrPt_PU    -> Fill(pu_pt, deltaPt);
-    }
+    FillPileupEntry();
   }  // end with-pileup entry loop
   cout << "      Finished with-pileup entry loop." << endl;
+  return;
 
-  // normalize histograms if needed
-  if (doIntNorm) NormalizeHists();
+}  // end 'AnalyzeEntries()'
+
+
+
+void STrackCutStudy::FillEmbedOnlyEntry() {
+
+  // arrays for filling histograms
+  Double_t recoTrkVars[NTrkVar];
+  Double_t trueTrkVars[NTrkVar];
+  Double_t recoPhysVars[NPhysVar];
+  Double_t truePhysVars[NPhysVar];
+
+  // perform calculations
+  const Float_t  glayers    = gnlmms + gnlmaps + gnlintt + gnltpc;
+  const Double_t perMms     = (Double_t) nlmms / (Double_t) gnlmms;
+  const Double_t perMaps    = (Double_t) nlmaps / (Double_t) gnlmaps;
+  const Double_t perIntt    = (Double_t) nlintt / (Double_t) gnlintt;
+  const Double_t perTpc     = (Double_t) nltpc / (Double_t) gnltpc;
+  const Double_t perTot     = (Double_t) layers / (Double_t) glayers;
+  const Double_t umDcaXY    = dca3dxy * 10000;
+  const Double_t umDcaZ     = dca3dz * 10000;
+  const Double_t deltaDcaXY = abs(dca3dxysigma / dca3dxy);
+  const Double_t deltaDcaZ  = abs(dca3dzsigma / dca3dz);
+  const Double_t deltaEta   = abs(deltaeta / eta);
+  const Double_t deltaPhi   = abs(deltaphi / phi);
+  const Double_t deltaPt    = abs(deltapt / pt);
+  const Double_t etaFrac    = eta / geta;
+  const Double_t phiFrac    = phi / gphi;
+  const Double_t ptFrac     = pt / gpt;
+  const Double_t etaDiff    = eta - geta;
+  const Double_t phiDiff    = phi - gphi;
+  const Double_t ptDiff     = pt - gpt;
+  const Double_t vxDiff     = vx - gvx;
+  const Double_t vyDiff     = vy - gvy;
+  const Double_t vzDiff     = vz - gvz;
+
+  // set reco track variables
+  recoTrkVars[TRKVAR::VX]    = vx;
+  recoTrkVars[TRKVAR::VY]    = vy;
+  recoTrkVars[TRKVAR::VZ]    = vz;
+  recoTrkVars[TRKVAR::NMMS]  = (Double_t) nlmms;
+  recoTrkVars[TRKVAR::NMAP]  = (Double_t) nlmaps;
+  recoTrkVars[TRKVAR::NINT]  = (Double_t) nlintt;
+  recoTrkVars[TRKVAR::NTPC]  = (Double_t) ntpc;
+  recoTrkVars[TRKVAR::QUAL]  = quality;
+  recoTrkVars[TRKVAR::DCAXY] = umDcaXY;
+  recoTrkVars[TRKVAR::DCAZ]  = umDcaZ;
+
+  // set true track variables
+  trueTrkVars[TRKVAR::VX]    = gvx;
+  trueTrkVars[TRKVAR::VY]    = gvy;
+  trueTrkVars[TRKVAR::VZ]    = gvz;
+  trueTrkVars[TRKVAR::NMMS]  = (Double_t) gnlmms;
+  trueTrkVars[TRKVAR::NMAP]  = (Double_t) gnlmaps;
+  trueTrkVars[TRKVAR::NINT]  = (Double_t) gnlintt;
+  trueTrkVars[TRKVAR::NTPC]  = (Double_t) gntpc;
+  trueTrkVars[TRKVAR::QUAL]  = quality;
+  trueTrkVars[TRKVAR::DCAXY] = umDcaXY;
+  trueTrkVars[TRKVAR::DCAZ]  = umDcaZ;
+
+  // set reco phys variables
+  recoPhysVars[PHYSVAR::PHI] = phi;
+  recoPhysVars[PHYSVAR::ETA] = eta;
+  recoPhysVars[PHYSVAR::PT]  = pt;
+
+  // set true phys variables
+  truePhysVars[PHYSVAR::PHI] = gphi;
+  truePhysVars[PHYSVAR::ETA] = geta;
+  truePhysVars[PHYSVAR::PT]  = gpt;
+
+  // [02.14.2023] TEST
+  const Bool_t isInMvtxCut = (nlmaps >= 2);
+  if (!isInMvtxCut) return;
+
+  // select only primaries if need be
+  const Bool_t isPrimary = (gprimary == 1);
+  if (useOnlyPrimary && !isPrimary) return;
+
+  // fill histograms
+  FillVarHistograms(0, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  FillVarHistograms(1, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+  // fill embed-only track histograms
+  hTrackNMms         -> Fill(nlmms);
+  hTrackNMap         -> Fill(nlmaps);
+  hTrackNInt         -> Fill(nlintt);
+  hTrackNTpc         -> Fill(nltpc);
+  hTrackNTot         -> Fill(layers);
+  hTrackPerMms       -> Fill(perMms);
+  hTrackPerMap       -> Fill(perMaps);
+  hTrackPerInt       -> Fill(perIntt);
+  hTrackPerTpc       -> Fill(perTpc);
+  hTrackPerTot       -> Fill(perTot);
+  hTrackChi2         -> Fill(chisq);
+  hTrackNDF          -> Fill(ndf);
+  hTrackQuality      -> Fill(quality);
+  hTrackDCAxy        -> Fill(umDcaXY);
+  hTrackDCAz         -> Fill(umDcaZ);
+  hTrackVx           -> Fill(vx);
+  hTrackVy           -> Fill(vy);
+  hTrackVz           -> Fill(vz);
+  hTrackEta          -> Fill(eta);
+  hTrackPhi          -> Fill(phi);
+  hTrackPt           -> Fill(pt);
+  hDeltaDCAxy        -> Fill(deltaDcaXY);
+  hDeltaDCAz         -> Fill(deltaDcaZ);
+  hDeltaEta          -> Fill(deltaEta);
+  hDeltaPhi          -> Fill(deltaPhi);
+  hDeltaPt           -> Fill(deltaPt);
+  hTrackPtVsNMms     -> Fill(nlmms, pt);
+  hTrackPtVsNMap     -> Fill(nlmaps, pt);
+  hTrackPtVsNInt     -> Fill(nlintt, pt);
+  hTrackPtVsNTpc     -> Fill(nltpc, pt);
+  hTrackPtVsNTot     -> Fill(layers, pt);
+  hTrackPtVsPerMms   -> Fill(perMms, pt);
+  hTrackPtVsPerMap   -> Fill(perMaps, pt);
+  hTrackPtVsPerInt   -> Fill(perIntt, pt);
+  hTrackPtVsPerTpc   -> Fill(perTpc, pt);
+  hTrackPtVsPerTot   -> Fill(perTot, pt);
+  hTrackPtVsChi2     -> Fill(chisq, pt);
+  hTrackPtVsNDF      -> Fill(ndf, pt);
+  hTrackPtVsQuality  -> Fill(quality, pt);
+  hTrackPtVsDCAxy    -> Fill(umDcaXY, pt);
+  hTrackPtVsDCAz     -> Fill(umDcaZ, pt);
+  hDeltaDCAxyVsTrkPt -> Fill(pt, deltaDcaXY);
+  hDeltaDCAzVsTrkPt  -> Fill(pt, deltaDcaZ);
+  hDeltaEtaVsTrkPt   -> Fill(pt, deltaEta);
+  hDeltaPhiVsTrkPt   -> Fill(pt, deltaPhi);
+  hDeltaPtVsTrkPt    -> Fill(pt, deltaPt);
+
+  // fill embed-only truth histograms
+  hTruthNMms         -> Fill(gnlmms);
+  hTruthNMap         -> Fill(gnlmaps);
+  hTruthNInt         -> Fill(gnlintt);
+  hTruthNTpc         -> Fill(gnltpc);
+  hTruthNTot         -> Fill(glayers);
+  hTruthEta          -> Fill(geta);
+  hTruthPhi          -> Fill(gphi);
+  hTruthPt           -> Fill(gpt);
+  hTruthVx           -> Fill(gvx);
+  hTruthVy           -> Fill(gvy);
+  hTruthVz           -> Fill(gvz);
+  hTruthEtaFrac      -> Fill(etaFrac);
+  hTruthPhiFrac      -> Fill(phiFrac);
+  hTruthPtFrac       -> Fill(ptFrac);
+  hTruthEtaDiff      -> Fill(etaDiff);
+  hTruthPhiDiff      -> Fill(phiDiff);
+  hTruthPtDiff       -> Fill(ptDiff);
+  hTruthVxDiff       -> Fill(vxDiff);
+  hTruthVyDiff       -> Fill(vyDiff);
+  hTruthVzDiff       -> Fill(vzDiff);
+  hTruthVsTrackEta   -> Fill(eta, geta);
+  hTruthVsTrackPhi   -> Fill(phi, gphi);
+  hTruthVsTrackPt    -> Fill(pt, gpt);
+  hTruthVsTrackVx    -> Fill(vx, gvx);
+  hTruthVsTrackVy    -> Fill(vy, gvy);
+  hTruthVsTrackVz    -> Fill(vz, gvz);
+  hFracVsTruthEta    -> Fill(geta, etaFrac);
+  hFracVsTruthPhi    -> Fill(gphi, phiFrac);
+  hFracVsTruthPt     -> Fill(gpt, ptFrac);
+  hDiffVsTruthEta    -> Fill(geta, etaDiff);
+  hDiffVsTruthPhi    -> Fill(gphi, phiDiff);
+  hDiffVsTruthPt     -> Fill(gpt, ptDiff);
+  hTruthPtVsNMap     -> Fill(gnlmaps, gpt);
+  hTruthPtVsNInt     -> Fill(gnlintt, gpt);
+  hTruthPtVsNTpc     -> Fill(gnltpc, gpt);
+  hTruthPtVsNTot     -> Fill(glayers, gpt);
+  hTruthPtVsNTpc     -> Fill(nltpc, gpt);
+  hTruthPtVsChi2     -> Fill(chisq, gpt);
+  hTruthPtVsNDF      -> Fill(ndf, gpt);
+  hTruthPtVsQuality  -> Fill(quality, gpt);
+  hFracPtVsQuality   -> Fill(quality, ptFrac);
+  hTruthPtVsDCAxy    -> Fill(umDcaXY, gpt);
+  hTruthPtVsDCAz     -> Fill(umDcaZ, gpt);
+  hDeltaDCAxyVsTruPt -> Fill(gpt, deltaDcaXY);
+  hDeltaDCAzVsTruPt  -> Fill(gpt, deltaDcaZ);
+  hDeltaEtaVsTruPt   -> Fill(gpt, deltaEta);
+  hDeltaPhiVsTruPt   -> Fill(gpt, deltaPhi);
+  hDeltaPtVsTruPt    -> Fill(gpt, deltaPt);
+
+  // fill embed_only weird histograms
+  const Bool_t isWeirdTrack = ((ptFrac < normalPtFracMin) || (ptFrac > normalPtFracMax));
+  const Bool_t hasSiSeed    = (nmaps == 3);
+  const Bool_t hasTpcSeed   = (nmaps == 0);
+  if (isWeirdTrack) {
+
+    FillVarHistograms(2, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+    // fill all weird histograms
+    hWeirdNMms            -> Fill(nlmms);
+    hWeirdNMap            -> Fill(nlmaps);
+    hWeirdNInt            -> Fill(nlintt);
+    hWeirdNTpc            -> Fill(nltpc);
+    hWeirdNTot            -> Fill(layers);
+    hWeirdPerMms          -> Fill(perMms);
+    hWeirdPerMap          -> Fill(perMaps);
+    hWeirdPerInt          -> Fill(perIntt);
+    hWeirdPerTpc          -> Fill(perTpc);
+    hWeirdPerTot          -> Fill(perTot);
+    hWeirdChi2            -> Fill(chisq);
+    hWeirdNDF             -> Fill(ndf);
+    hWeirdQuality         -> Fill(quality);
+    hWeirdDCAxy           -> Fill(umDcaXY);
+    hWeirdDCAz            -> Fill(umDcaZ);
+    hWeirdVx              -> Fill(vx);
+    hWeirdVy              -> Fill(vy);
+    hWeirdVz              -> Fill(vz);
+    hWeirdEta             -> Fill(eta);
+    hWeirdPhi             -> Fill(phi);
+    hWeirdPt              -> Fill(pt); 
+    hWeirdDeltaDCAxy      -> Fill(deltaDcaXY);
+    hWeirdDeltaDCAz       -> Fill(deltaDcaZ);
+    hWeirdDeltaEta        -> Fill(deltaEta);
+    hWeirdDeltaPhi        -> Fill(deltaPhi);
+    hWeirdDeltaPt         -> Fill(deltaPt);
+    hWeirdEtaFrac         -> Fill(etaFrac);
+    hWeirdPhiFrac         -> Fill(phiFrac);
+    hWeirdPtFrac          -> Fill(ptFrac);
+    hWeirdEtaDiff         -> Fill(etaDiff);
+    hWeirdPhiDiff         -> Fill(phiDiff);
+    hWeirdPtDiff          -> Fill(ptDiff);
+    hWeirdVxDiff          -> Fill(vxDiff);
+    hWeirdVyDiff          -> Fill(vyDiff);
+    hWeirdVzDiff          -> Fill(vzDiff);
+    hWeirdPtVsNMms        -> Fill(nlmms, pt);
+    hWeirdPtVsNMap        -> Fill(nlmaps, pt);
+    hWeirdPtVsNInt        -> Fill(nlintt, pt);
+    hWeirdPtVsNTpc        -> Fill(nltpc, pt);
+    hWeirdPtVsNTot        -> Fill(layers, pt);
+    hWeirdPtVsPerMms      -> Fill(perMms, pt);
+    hWeirdPtVsPerMap      -> Fill(perMaps, pt);
+    hWeirdPtVsPerInt      -> Fill(perIntt, pt);
+    hWeirdPtVsPerTpc      -> Fill(perTpc, pt);
+    hWeirdPtVsPerTot      -> Fill(perTot, pt);
+    hWeirdPtVsChi2        -> Fill(chisq, pt);
+    hWeirdPtVsNDF         -> Fill(ndf, pt);
+    hWeirdPtVsQuality     -> Fill(quality, pt);
+    hWeirdPtVsDCAxy       -> Fill(umDcaXY, pt);
+    hWeirdPtVsDCAz        -> Fill(umDcaZ, pt);
+    hDeltaDCAxyVsOddPt    -> Fill(pt, deltaDcaXY);
+    hDeltaDCAzVsOddPt     -> Fill(pt, deltaDcaZ);
+    hDeltaEtaVsOddPt      -> Fill(pt, deltaEta);
+    hDeltaPhiVsOddPt      -> Fill(pt, deltaPhi);
+    hDeltaPtVsOddPt       -> Fill(pt, deltaPt);
+    hTruthVsWeirdEta      -> Fill(eta, geta);
+    hTruthVsWeirdPhi      -> Fill(phi, gphi);
+    hTruthVsWeirdPt       -> Fill(pt, gpt);
+    hTruthVsWeirdVx       -> Fill(vx, gvx);
+    hTruthVsWeirdVy       -> Fill(vy, gvy);
+    hTruthVsWeirdVz       -> Fill(vz, gvz);
+    hOddFracVsTruEta      -> Fill(geta, etaFrac);
+    hOddFracVsTruPhi      -> Fill(gphi, phiFrac);
+    hOddFracVsTruPt       -> Fill(gpt, ptFrac);
+    hOddDiffVsTruEta      -> Fill(geta, etaDiff);
+    hOddDiffVsTruPhi      -> Fill(gphi, phiDiff);
+    hOddDiffVsTruPt       -> Fill(gpt, ptDiff);
+    hTruPtVsOddNMap       -> Fill(gnlmaps, gpt);
+    hTruPtVsOddNInt       -> Fill(gnlintt, gpt);
+    hTruPtVsOddNTpc       -> Fill(gnltpc, gpt);
+    hTruPtVsOddNTot       -> Fill(glayers, gpt);
+    hTruPtVsOddNTpc       -> Fill(nltpc, gpt);
+    hTruPtVsOddChi2       -> Fill(chisq, gpt);
+    hTruPtVsOddNDF        -> Fill(ndf, gpt);
+    hTruPtVsOddQuality    -> Fill(quality, gpt);
+    hFracPtVsOddQuality   -> Fill(quality, ptFrac);
+    hTruPtVsOddDCAxy      -> Fill(umDcaXY, gpt);
+    hTruPtVsOddDCAz       -> Fill(umDcaZ, gpt);
+    hOddDeltaDCAxyVsTruPt -> Fill(gpt, deltaDcaXY);
+    hOddDeltaDCAzVsTruPt  -> Fill(gpt, deltaDcaZ);
+    hOddDeltaEtaVsTruPt   -> Fill(gpt, deltaEta);
+    hOddDeltaPhiVsTruPt   -> Fill(gpt, deltaPhi);
+    hOddDeltaPtVsTruPt    -> Fill(gpt, deltaPt);
+
+    // fill si seed histograms 
+    if (hasSiSeed) {
+
+      FillVarHistograms(3, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+      hWeirdNMms_SI            -> Fill(nlmms);
+      //hWeirdNMap_SI            -> Fill(nlmaps);
+      hWeirdNMap_SI            -> Fill(nmaps);
+      hWeirdNInt_SI            -> Fill(nlintt);
+      hWeirdNTpc_SI            -> Fill(nltpc);
+      hWeirdNTot_SI            -> Fill(layers);
+      hWeirdPerMms_SI          -> Fill(perMms);
+      hWeirdPerMap_SI          -> Fill(perMaps);
+      hWeirdPerInt_SI          -> Fill(perIntt);
+      hWeirdPerTpc_SI          -> Fill(perTpc);
+      hWeirdPerTot_SI          -> Fill(perTot);
+      hWeirdChi2_SI            -> Fill(chisq);
+      hWeirdNDF_SI             -> Fill(ndf);
+      hWeirdQuality_SI         -> Fill(quality);
+      hWeirdDCAxy_SI           -> Fill(umDcaXY);
+      hWeirdDCAz_SI            -> Fill(umDcaZ);
+      hWeirdVx_SI              -> Fill(vx);
+      hWeirdVy_SI              -> Fill(vy);
+      hWeirdVz_SI              -> Fill(vz);
+      hWeirdEta_SI             -> Fill(eta);
+      hWeirdPhi_SI             -> Fill(phi);
+      hWeirdPt_SI              -> Fill(pt); 
+      hWeirdDeltaDCAxy_SI      -> Fill(deltaDcaXY);
+      hWeirdDeltaDCAz_SI       -> Fill(deltaDcaZ);
+      hWeirdDeltaEta_SI        -> Fill(deltaEta);
+      hWeirdDeltaPhi_SI        -> Fill(deltaPhi);
+      hWeirdDeltaPt_SI         -> Fill(deltaPt);
+      hWeirdEtaFrac_SI         -> Fill(etaFrac);
+      hWeirdPhiFrac_SI         -> Fill(phiFrac);
+      hWeirdPtFrac_SI          -> Fill(ptFrac);
+      hWeirdEtaDiff_SI         -> Fill(etaDiff);
+      hWeirdPhiDiff_SI         -> Fill(phiDiff);
+      hWeirdPtDiff_SI          -> Fill(ptDiff);
+      hWeirdVxDiff_SI          -> Fill(vxDiff);
+      hWeirdVyDiff_SI          -> Fill(vyDiff);
+      hWeirdVzDiff_SI          -> Fill(vzDiff);
+      hWeirdPtVsNMms_SI        -> Fill(nlmms, pt);
+      hWeirdPtVsNMap_SI        -> Fill(nlmaps, pt);
+      hWeirdPtVsNInt_SI        -> Fill(nlintt, pt);
+      hWeirdPtVsNTpc_SI        -> Fill(nltpc, pt);
+      hWeirdPtVsNTot_SI        -> Fill(layers, pt);
+      hWeirdPtVsPerMms_SI      -> Fill(perMms, pt);
+      hWeirdPtVsPerMap_SI      -> Fill(perMaps, pt);
+      hWeirdPtVsPerInt_SI      -> Fill(perIntt, pt);
+      hWeirdPtVsPerTpc_SI      -> Fill(perTpc, pt);
+      hWeirdPtVsPerTot_SI      -> Fill(perTot, pt);
+      hWeirdPtVsChi2_SI        -> Fill(chisq, pt);
+      hWeirdPtVsNDF_SI         -> Fill(ndf, pt);
+      hWeirdPtVsQuality_SI     -> Fill(quality, pt);
+      hWeirdPtVsDCAxy_SI       -> Fill(umDcaXY, pt);
+      hWeirdPtVsDCAz_SI        -> Fill(umDcaZ, pt);
+      hDeltaDCAxyVsOddPt_SI    -> Fill(pt, deltaDcaXY);
+      hDeltaDCAzVsOddPt_SI     -> Fill(pt, deltaDcaZ);
+      hDeltaEtaVsOddPt_SI      -> Fill(pt, deltaEta);
+      hDeltaPhiVsOddPt_SI      -> Fill(pt, deltaPhi);
+      hDeltaPtVsOddPt_SI       -> Fill(pt, deltaPt);
+      hTruthVsWeirdEta_SI      -> Fill(eta, geta);
+      hTruthVsWeirdPhi_SI      -> Fill(phi, gphi);
+      hTruthVsWeirdPt_SI       -> Fill(pt, gpt);
+      hTruthVsWeirdVx_SI       -> Fill(vx, gvx);
+      hTruthVsWeirdVy_SI       -> Fill(vy, gvy);
+      hTruthVsWeirdVz_SI       -> Fill(vz, gvz);
+      hOddFracVsTruEta_SI      -> Fill(geta, etaFrac);
+      hOddFracVsTruPhi_SI      -> Fill(gphi, phiFrac);
+      hOddFracVsTruPt_SI       -> Fill(gpt, ptFrac);
+      hOddDiffVsTruEta_SI      -> Fill(geta, etaDiff);
+      hOddDiffVsTruPhi_SI      -> Fill(gphi, phiDiff);
+      hOddDiffVsTruPt_SI       -> Fill(gpt, ptDiff);
+      hTruPtVsOddNMap_SI       -> Fill(gnlmaps, gpt);
+      hTruPtVsOddNInt_SI       -> Fill(gnlintt, gpt);
+      hTruPtVsOddNTpc_SI       -> Fill(gnltpc, gpt);
+      hTruPtVsOddNTot_SI       -> Fill(glayers, gpt);
+      hTruPtVsOddNTpc_SI       -> Fill(nltpc, gpt);
+      hTruPtVsOddChi2_SI       -> Fill(chisq, gpt);
+      hTruPtVsOddNDF_SI        -> Fill(ndf, gpt);
+      hTruPtVsOddQuality_SI    -> Fill(quality, gpt);
+      hFracPtVsOddQuality_SI   -> Fill(quality, ptFrac);
+      hTruPtVsOddDCAxy_SI      -> Fill(umDcaXY, gpt);
+      hTruPtVsOddDCAz_SI       -> Fill(umDcaZ, gpt);
+      hOddDeltaDCAxyVsTruPt_SI -> Fill(gpt, deltaDcaXY);
+      hOddDeltaDCAzVsTruPt_SI  -> Fill(gpt, deltaDcaZ);
+      hOddDeltaEtaVsTruPt_SI   -> Fill(gpt, deltaEta);
+      hOddDeltaPhiVsTruPt_SI   -> Fill(gpt, deltaPhi);
+      hOddDeltaPtVsTruPt_SI    -> Fill(gpt, deltaPt);
+    }
+
+    // fill tpc seed histograms
+    if (hasTpcSeed) {
+
+      FillVarHistograms(4, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+      hWeirdNMms_TPC            -> Fill(nlmms);
+      //hWeirdNMap_TPC            -> Fill(nlmaps);
+      hWeirdNMap_TPC            -> Fill(nmaps);
+      hWeirdNInt_TPC            -> Fill(nlintt);
+      hWeirdNTpc_TPC            -> Fill(nltpc);
+      hWeirdNTot_TPC            -> Fill(layers);
+      hWeirdPerMms_TPC          -> Fill(perMms);
+      hWeirdPerMap_TPC          -> Fill(perMaps);
+      hWeirdPerInt_TPC          -> Fill(perIntt);
+      hWeirdPerTpc_TPC          -> Fill(perTpc);
+      hWeirdPerTot_TPC          -> Fill(perTot);
+      hWeirdChi2_TPC            -> Fill(chisq);
+      hWeirdNDF_TPC             -> Fill(ndf);
+      hWeirdQuality_TPC         -> Fill(quality);
+      hWeirdDCAxy_TPC           -> Fill(umDcaXY);
+      hWeirdDCAz_TPC            -> Fill(umDcaZ);
+      hWeirdVx_TPC              -> Fill(vx);
+      hWeirdVy_TPC              -> Fill(vy);
+      hWeirdVz_TPC              -> Fill(vz);
+      hWeirdEta_TPC             -> Fill(eta);
+      hWeirdPhi_TPC             -> Fill(phi);
+      hWeirdPt_TPC              -> Fill(pt); 
+      hWeirdDeltaDCAxy_TPC      -> Fill(deltaDcaXY);
+      hWeirdDeltaDCAz_TPC       -> Fill(deltaDcaZ);
+      hWeirdDeltaEta_TPC        -> Fill(deltaEta);
+      hWeirdDeltaPhi_TPC        -> Fill(deltaPhi);
+      hWeirdDeltaPt_TPC         -> Fill(deltaPt);
+      hWeirdEtaFrac_TPC         -> Fill(etaFrac);
+      hWeirdPhiFrac_TPC         -> Fill(phiFrac);
+      hWeirdPtFrac_TPC          -> Fill(ptFrac);
+      hWeirdEtaDiff_TPC         -> Fill(etaDiff);
+      hWeirdPhiDiff_TPC         -> Fill(phiDiff);
+      hWeirdPtDiff_TPC          -> Fill(ptDiff);
+      hWeirdVxDiff_TPC          -> Fill(vxDiff);
+      hWeirdVyDiff_TPC          -> Fill(vyDiff);
+      hWeirdVzDiff_TPC          -> Fill(vzDiff);
+      hWeirdPtVsNMms_TPC        -> Fill(nlmms, pt);
+      hWeirdPtVsNMap_TPC        -> Fill(nlmaps, pt);
+      hWeirdPtVsNInt_TPC        -> Fill(nlintt, pt);
+      hWeirdPtVsNTpc_TPC        -> Fill(nltpc, pt);
+      hWeirdPtVsNTot_TPC        -> Fill(layers, pt);
+      hWeirdPtVsPerMms_TPC      -> Fill(perMms, pt);
+      hWeirdPtVsPerMap_TPC      -> Fill(perMaps, pt);
+      hWeirdPtVsPerInt_TPC      -> Fill(perIntt, pt);
+      hWeirdPtVsPerTpc_TPC      -> Fill(perTpc, pt);
+      hWeirdPtVsPerTot_TPC      -> Fill(perTot, pt);
+      hWeirdPtVsChi2_TPC        -> Fill(chisq, pt);
+      hWeirdPtVsNDF_TPC         -> Fill(ndf, pt);
+      hWeirdPtVsQuality_TPC     -> Fill(quality, pt);
+      hWeirdPtVsDCAxy_TPC       -> Fill(umDcaXY, pt);
+      hWeirdPtVsDCAz_TPC        -> Fill(umDcaZ, pt);
+      hDeltaDCAxyVsOddPt_TPC    -> Fill(pt, deltaDcaXY);
+      hDeltaDCAzVsOddPt_TPC     -> Fill(pt, deltaDcaZ);
+      hDeltaEtaVsOddPt_TPC      -> Fill(pt, deltaEta);
+      hDeltaPhiVsOddPt_TPC      -> Fill(pt, deltaPhi);
+      hDeltaPtVsOddPt_TPC       -> Fill(pt, deltaPt);
+      hTruthVsWeirdEta_TPC      -> Fill(eta, geta);
+      hTruthVsWeirdPhi_TPC      -> Fill(phi, gphi);
+      hTruthVsWeirdPt_TPC       -> Fill(pt, gpt);
+      hTruthVsWeirdVx_TPC       -> Fill(vx, gvx);
+      hTruthVsWeirdVy_TPC       -> Fill(vy, gvy);
+      hTruthVsWeirdVz_TPC       -> Fill(vz, gvz);
+      hOddFracVsTruEta_TPC      -> Fill(geta, etaFrac);
+      hOddFracVsTruPhi_TPC      -> Fill(gphi, phiFrac);
+      hOddFracVsTruPt_TPC       -> Fill(gpt, ptFrac);
+      hOddDiffVsTruEta_TPC      -> Fill(geta, etaDiff);
+      hOddDiffVsTruPhi_TPC      -> Fill(gphi, phiDiff);
+      hOddDiffVsTruPt_TPC       -> Fill(gpt, ptDiff);
+      hTruPtVsOddNMap_TPC       -> Fill(gnlmaps, gpt);
+      hTruPtVsOddNInt_TPC       -> Fill(gnlintt, gpt);
+      hTruPtVsOddNTpc_TPC       -> Fill(gnltpc, gpt);
+      hTruPtVsOddNTot_TPC       -> Fill(glayers, gpt);
+      hTruPtVsOddNTpc_TPC       -> Fill(nltpc, gpt);
+      hTruPtVsOddChi2_TPC       -> Fill(chisq, gpt);
+      hTruPtVsOddNDF_TPC        -> Fill(ndf, gpt);
+      hTruPtVsOddQuality_TPC    -> Fill(quality, gpt);
+      hFracPtVsOddQuality_TPC   -> Fill(quality, ptFrac);
+      hTruPtVsOddDCAxy_TPC      -> Fill(umDcaXY, gpt);
+      hTruPtVsOddDCAz_TPC       -> Fill(umDcaZ, gpt);
+      hOddDeltaDCAxyVsTruPt_TPC -> Fill(gpt, deltaDcaXY);
+      hOddDeltaDCAzVsTruPt_TPC  -> Fill(gpt, deltaDcaZ);
+      hOddDeltaEtaVsTruPt_TPC   -> Fill(gpt, deltaEta);
+      hOddDeltaPhiVsTruPt_TPC   -> Fill(gpt, deltaPhi);
+      hOddDeltaPtVsTruPt_TPC    -> Fill(gpt, deltaPt);
+    }
+  } else {
+
+    FillVarHistograms(5, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+    hNormalNMms            -> Fill(nlmms);
+    hNormalNMap            -> Fill(nlmaps);
+    hNormalNInt            -> Fill(nlintt);
+    hNormalNTpc            -> Fill(nltpc);
+    hNormalNTot            -> Fill(layers);
+    hNormalPerMms          -> Fill(perMms);
+    hNormalPerMap          -> Fill(perMaps);
+    hNormalPerInt          -> Fill(perIntt);
+    hNormalPerTpc          -> Fill(perTpc);
+    hNormalPerTot          -> Fill(perTot);
+    hNormalChi2            -> Fill(chisq);
+    hNormalNDF             -> Fill(ndf);
+    hNormalQuality         -> Fill(quality);
+    hNormalDCAxy           -> Fill(umDcaXY);
+    hNormalDCAz            -> Fill(umDcaZ);
+    hNormalVx              -> Fill(vx);
+    hNormalVy              -> Fill(vy);
+    hNormalVz              -> Fill(vz);
+    hNormalEta             -> Fill(eta);
+    hNormalPhi             -> Fill(phi);
+    hNormalPt              -> Fill(pt); 
+    hNormalDeltaDCAxy      -> Fill(deltaDcaXY);
+    hNormalDeltaDCAz       -> Fill(deltaDcaZ);
+    hNormalDeltaEta        -> Fill(deltaEta);
+    hNormalDeltaPhi        -> Fill(deltaPhi);
+    hNormalDeltaPt         -> Fill(deltaPt);
+    hNormalEtaFrac         -> Fill(etaFrac);
+    hNormalPhiFrac         -> Fill(phiFrac);
+    hNormalPtFrac          -> Fill(ptFrac);
+    hNormalEtaDiff         -> Fill(etaDiff);
+    hNormalPhiDiff         -> Fill(phiDiff);
+    hNormalPtDiff          -> Fill(ptDiff);
+    hNormalVxDiff          -> Fill(vxDiff);
+    hNormalVyDiff          -> Fill(vyDiff);
+    hNormalVzDiff          -> Fill(vzDiff);
+    hNormalPtVsNMms        -> Fill(nlmms, pt);
+    hNormalPtVsNMap        -> Fill(nlmaps, pt);
+    hNormalPtVsNInt        -> Fill(nlintt, pt);
+    hNormalPtVsNTpc        -> Fill(nltpc, pt);
+    hNormalPtVsNTot        -> Fill(layers, pt);
+    hNormalPtVsPerMms      -> Fill(perMms, pt);
+    hNormalPtVsPerMap      -> Fill(perMaps, pt);
+    hNormalPtVsPerInt      -> Fill(perIntt, pt);
+    hNormalPtVsPerTpc      -> Fill(perTpc, pt);
+    hNormalPtVsPerTot      -> Fill(perTot, pt);
+    hNormalPtVsChi2        -> Fill(chisq, pt);
+    hNormalPtVsNDF         -> Fill(ndf, pt);
+    hNormalPtVsQuality     -> Fill(quality, pt);
+    hNormalPtVsDCAxy       -> Fill(umDcaXY, pt);
+    hNormalPtVsDCAz        -> Fill(umDcaZ, pt);
+    hDeltaDCAxyVsNormPt    -> Fill(pt, deltaDcaXY);
+    hDeltaDCAzVsNormPt     -> Fill(pt, deltaDcaZ);
+    hDeltaEtaVsNormPt      -> Fill(pt, deltaEta);
+    hDeltaPhiVsNormPt      -> Fill(pt, deltaPhi);
+    hDeltaPtVsNormPt       -> Fill(pt, deltaPt);
+    hTruthVsNormalEta      -> Fill(eta, geta);
+    hTruthVsNormalPhi      -> Fill(phi, gphi);
+    hTruthVsNormalPt       -> Fill(pt, gpt);
+    hTruthVsNormalVx       -> Fill(vx, gvx);
+    hTruthVsNormalVy       -> Fill(vy, gvy);
+    hTruthVsNormalVz       -> Fill(vz, gvz);
+    hNormFracVsTruEta      -> Fill(geta, etaFrac);
+    hNormFracVsTruPhi      -> Fill(gphi, phiFrac);
+    hNormFracVsTruPt       -> Fill(gpt, ptFrac);
+    hNormDiffVsTruEta      -> Fill(geta, etaDiff);
+    hNormDiffVsTruPhi      -> Fill(gphi, phiDiff);
+    hNormDiffVsTruPt       -> Fill(gpt, ptDiff);
+    hTruPtVsNormNMap       -> Fill(gnlmaps, gpt);
+    hTruPtVsNormNInt       -> Fill(gnlintt, gpt);
+    hTruPtVsNormNTpc       -> Fill(gnltpc, gpt);
+    hTruPtVsNormNTot       -> Fill(glayers, gpt);
+    hTruPtVsNormNTpc       -> Fill(nltpc, gpt);
+    hTruPtVsNormChi2       -> Fill(chisq, gpt);
+    hTruPtVsNormNDF        -> Fill(ndf, gpt);
+    hTruPtVsNormQuality    -> Fill(quality, gpt);
+    hFracPtVsNormQuality   -> Fill(quality, ptFrac);
+    hTruPtVsNormDCAxy      -> Fill(umDcaXY, gpt);
+    hTruPtVsNormDCAz       -> Fill(umDcaZ, gpt);
+    hNormDeltaDCAxyVsTruPt -> Fill(gpt, deltaDcaXY);
+    hNormDeltaDCAzVsTruPt  -> Fill(gpt, deltaDcaZ);
+    hNormDeltaEtaVsTruPt   -> Fill(gpt, deltaEta);
+    hNormDeltaPhiVsTruPt   -> Fill(gpt, deltaPhi);
+    hNormDeltaPtVsTruPt    -> Fill(gpt, deltaPt);
+  }
   return;
 
-}  // end Analyze()
+}  // end 'FillEmbedOnlyEntry()'
+
+
+
+void STrackCutStudy::FillPileupEntry() {
+
+  // arrays for filling histograms
+  Double_t recoTrkVars[NTrkVar];
+  Double_t trueTrkVars[NTrkVar];
+  Double_t recoPhysVars[NPhysVar];
+  Double_t truePhysVars[NPhysVar];
+
+  // perform calculations
+  const Float_t  pu_glayers = pu_gnlmms + pu_gnlmaps + pu_gnlintt + pu_gnltpc;
+  const Double_t perMms     = (Double_t) pu_nlmms / (Double_t) pu_gnlmms;
+  const Double_t perMaps    = (Double_t) pu_nlmaps / (Double_t) pu_gnlmaps;
+  const Double_t perIntt    = (Double_t) pu_nlintt / (Double_t) pu_gnlintt;
+  const Double_t perTpc     = (Double_t) pu_nltpc / (Double_t) pu_gnltpc;
+  const Double_t perTot     = (Double_t) pu_layers / (Double_t) pu_glayers;
+  const Double_t umDcaXY    = pu_dca3dxy * 10000;
+  const Double_t umDcaZ     = pu_dca3dz * 10000;
+  const Double_t deltaDcaXY = abs(pu_dca3dxysigma / pu_dca3dxy);
+  const Double_t deltaDcaZ  = abs(pu_dca3dzsigma / pu_dca3dz);
+  const Double_t deltaEta   = abs(pu_deltaeta / pu_eta);
+  const Double_t deltaPhi   = abs(pu_deltaphi / pu_phi);
+  const Double_t deltaPt    = abs(pu_deltapt / pu_pt);
+
+  // check if values are defined & if primary or not
+  const Bool_t thereAreNans = (isnan(pu_dca3dxy) || isnan(pu_dca3dz) || isnan(pu_eta) || isnan(pu_phi) || isnan(pu_pt));
+  const Bool_t isPrimary    = (pu_gprimary == 1);
+  if (thereAreNans) return;
+
+  // set reco track variables
+  recoTrkVars[TRKVAR::VX]    = pu_vx;
+  recoTrkVars[TRKVAR::VY]    = pu_vy;
+  recoTrkVars[TRKVAR::VZ]    = pu_vz;
+  recoTrkVars[TRKVAR::NMMS]  = (Double_t) pu_nlmms;
+  recoTrkVars[TRKVAR::NMAP]  = (Double_t) pu_nlmaps;
+  recoTrkVars[TRKVAR::NINT]  = (Double_t) pu_nlintt;
+  recoTrkVars[TRKVAR::NTPC]  = (Double_t) pu_ntpc;
+  recoTrkVars[TRKVAR::QUAL]  = pu_quality;
+  recoTrkVars[TRKVAR::DCAXY] = umDcaXY;
+  recoTrkVars[TRKVAR::DCAZ]  = umDcaZ;
+
+  // set true track variables
+  trueTrkVars[TRKVAR::VX]    = pu_gvx;
+  trueTrkVars[TRKVAR::VY]    = pu_gvy;
+  trueTrkVars[TRKVAR::VZ]    = pu_gvz;
+  trueTrkVars[TRKVAR::NMMS]  = (Double_t) pu_gnlmms;
+  trueTrkVars[TRKVAR::NMAP]  = (Double_t) pu_gnlmaps;
+  trueTrkVars[TRKVAR::NINT]  = (Double_t) pu_gnlintt;
+  trueTrkVars[TRKVAR::NTPC]  = (Double_t) pu_gntpc;
+  trueTrkVars[TRKVAR::QUAL]  = pu_quality;
+  trueTrkVars[TRKVAR::DCAXY] = umDcaXY;
+  trueTrkVars[TRKVAR::DCAZ]  = umDcaZ;
+
+  // set reco phys variables
+  recoPhysVars[PHYSVAR::PHI] = pu_phi;
+  recoPhysVars[PHYSVAR::ETA] = pu_eta;
+  recoPhysVars[PHYSVAR::PT]  = pu_pt;
+
+  // set true phys variables
+  truePhysVars[PHYSVAR::PHI] = pu_gphi;
+  truePhysVars[PHYSVAR::ETA] = pu_geta;
+  truePhysVars[PHYSVAR::PT]  = pu_gpt;
+
+  // [02.14.2023] TEST
+  const Bool_t isInMvtxCut = (pu_nlmaps >= 2);
+  if (!isInMvtxCut) return;
+
+  // fill histograms
+  FillVarHistograms(6, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+
+  // fill with-pileup track histograms
+  hTrackNMms_PU         -> Fill(pu_nlmms);
+  hTrackNMap_PU         -> Fill(pu_nlmaps);
+  hTrackNInt_PU         -> Fill(pu_nlintt);
+  hTrackNTpc_PU         -> Fill(pu_nltpc);
+  hTrackNTot_PU         -> Fill(pu_layers);
+  hTrackPerMms_PU       -> Fill(perMms);
+  hTrackPerMap_PU       -> Fill(perMaps);
+  hTrackPerInt_PU       -> Fill(perIntt);
+  hTrackPerTpc_PU       -> Fill(perTpc);
+  hTrackPerTot_PU       -> Fill(perTot);
+  hTrackChi2_PU         -> Fill(pu_chisq);
+  hTrackNDF_PU          -> Fill(pu_ndf);
+  hTrackQuality_PU      -> Fill(pu_quality);
+  hTrackDCAxy_PU        -> Fill(umDcaXY);
+  hTrackDCAz_PU         -> Fill(umDcaZ);
+  hTrackVx_PU           -> Fill(pu_vx);
+  hTrackVy_PU           -> Fill(pu_vy);
+  hTrackVz_PU           -> Fill(pu_vz);
+  hTrackEta_PU          -> Fill(pu_eta);
+  hTrackPhi_PU          -> Fill(pu_phi);
+  hTrackPt_PU           -> Fill(pu_pt);
+  hDeltaDCAxy_PU        -> Fill(deltaDcaXY);
+  hDeltaDCAz_PU         -> Fill(deltaDcaZ);
+  hDeltaEta_PU          -> Fill(deltaEta);
+  hDeltaPhi_PU          -> Fill(deltaPhi);
+  hDeltaPt_PU           -> Fill(deltaPt);
+  hTrackPtVsNMms_PU     -> Fill(pu_nlmaps, pu_pt);
+  hTrackPtVsNMap_PU     -> Fill(pu_nlmaps, pu_pt);
+  hTrackPtVsNInt_PU     -> Fill(pu_nlintt, pu_pt);
+  hTrackPtVsNTpc_PU     -> Fill(pu_nltpc, pu_pt);
+  hTrackPtVsNTot_PU     -> Fill(pu_layers, pu_pt);
+  hTrackPtVsPerMms_PU   -> Fill(perMms, pu_pt);
+  hTrackPtVsPerMap_PU   -> Fill(perMaps, pu_pt);
+  hTrackPtVsPerInt_PU   -> Fill(perIntt, pu_pt);
+  hTrackPtVsPerTpc_PU   -> Fill(perTpc, pu_pt);
+  hTrackPtVsPerTot_PU   -> Fill(perTot, pu_pt);
+  hTrackPtVsChi2_PU     -> Fill(pu_chisq, pu_pt);
+  hTrackPtVsNDF_PU      -> Fill(pu_ndf, pu_pt);
+  hTrackPtVsQuality_PU  -> Fill(pu_quality, pu_pt);
+  hTrackPtVsDCAxy_PU    -> Fill(umDcaXY, pu_pt);
+  hTrackPtVsDCAz_PU     -> Fill(umDcaZ, pu_pt);
+  hDeltaDCAxyVsTrkPt_PU -> Fill(pu_pt, deltaDcaXY);
+  hDeltaDCAzVsTrkPt_PU  -> Fill(pu_pt, deltaDcaZ);
+  hDeltaEtaVsTrkPt_PU   -> Fill(pu_pt, deltaEta);
+  hDeltaPhiVsTrkPt_PU   -> Fill(pu_pt, deltaPhi);
+  hDeltaPtVsTrkPt_PU    -> Fill(pu_pt, deltaPt);
+  if (isPrimary) {
+
+    FillVarHistograms(7, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+    hPrimaryNMms_PU        -> Fill(pu_nlmms);
+    hPrimaryNMap_PU        -> Fill(pu_nlmaps);
+    hPrimaryNInt_PU        -> Fill(pu_nlintt);
+    hPrimaryNTpc_PU        -> Fill(pu_nltpc);
+    hPrimaryNTot_PU        -> Fill(pu_layers);
+    hPrimaryPerMms_PU      -> Fill(perMms);
+    hPrimaryPerMap_PU      -> Fill(perMaps);
+    hPrimaryPerInt_PU      -> Fill(perIntt);
+    hPrimaryPerTpc_PU      -> Fill(perTpc);
+    hPrimaryPerTot_PU      -> Fill(perTot);
+    hPrimaryChi2_PU        -> Fill(pu_chisq);
+    hPrimaryNDF_PU         -> Fill(pu_ndf);
+    hPrimaryQuality_PU     -> Fill(pu_quality);
+    hPrimaryDCAxy_PU       -> Fill(umDcaXY);
+    hPrimaryDCAz_PU        -> Fill(umDcaZ);
+    hPrimaryVx_PU          -> Fill(pu_vx);
+    hPrimaryVy_PU          -> Fill(pu_vy);
+    hPrimaryVz_PU          -> Fill(pu_vz);
+    hPrimaryEta_PU         -> Fill(pu_eta);
+    hPrimaryPhi_PU         -> Fill(pu_phi);
+    hPrimaryPt_PU          -> Fill(pu_pt);
+    hDeltaPrimDCAxy_PU     -> Fill(deltaDcaXY);
+    hDeltaPrimDCAz_PU      -> Fill(deltaDcaZ);
+    hDeltaPrimEta_PU       -> Fill(deltaEta);
+    hDeltaPrimPhi_PU       -> Fill(deltaPhi);
+    hDeltaPrimPt_PU        -> Fill(deltaPt);
+    hPrimaryPtVsNMms_PU    -> Fill(pu_nlmaps, pu_pt);
+    hPrimaryPtVsNMap_PU    -> Fill(pu_nlmaps, pu_pt);
+    hPrimaryPtVsNInt_PU    -> Fill(pu_nlintt, pu_pt);
+    hPrimaryPtVsNTpc_PU    -> Fill(pu_nltpc, pu_pt);
+    hPrimaryPtVsNTot_PU    -> Fill(pu_layers, pu_pt);
+    hPrimaryPtVsPerMms_PU  -> Fill(perMms, pu_pt);
+    hPrimaryPtVsPerMap_PU  -> Fill(perMaps, pu_pt);
+    hPrimaryPtVsPerInt_PU  -> Fill(perIntt, pu_pt);
+    hPrimaryPtVsPerTpc_PU  -> Fill(perTpc, pu_pt);
+    hPrimaryPtVsPerTot_PU  -> Fill(perTot, pu_pt);
+    hPrimaryPtVsChi2_PU    -> Fill(pu_chisq, pu_pt);
+    hPrimaryPtVsNDF_PU     -> Fill(pu_ndf, pu_pt);
+    hPrimaryPtVsQuality_PU -> Fill(pu_quality, pu_pt);
+    hPrimaryPtVsDCAxy_PU   -> Fill(umDcaXY, pu_pt);
+    hPrimaryPtVsDCAz_PU    -> Fill(umDcaZ, pu_pt);
+    hDeltaDCAxyVsPrimPt_PU -> Fill(pu_pt, deltaDcaXY);
+    hDeltaDCAzVsPrimPt_PU  -> Fill(pu_pt, deltaDcaZ);
+    hDeltaEtaVsPrimPt_PU   -> Fill(pu_pt, deltaEta);
+    hDeltaPhiVsPrimPt_PU   -> Fill(pu_pt, deltaPhi);
+    hDeltaPtVsPrimPt_PU    -> Fill(pu_pt, deltaPt);
+  } else {
+
+    FillVarHistograms(8, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+    hNonPrimNMms_PU        -> Fill(pu_nlmms);
+    hNonPrimNMap_PU        -> Fill(pu_nlmaps);
+    hNonPrimNInt_PU        -> Fill(pu_nlintt);
+    hNonPrimNTpc_PU        -> Fill(pu_nltpc);
+    hNonPrimNTot_PU        -> Fill(pu_layers);
+    hNonPrimPerMms_PU      -> Fill(perMms);
+    hNonPrimPerMap_PU      -> Fill(perMaps);
+    hNonPrimPerInt_PU      -> Fill(perIntt);
+    hNonPrimPerTpc_PU      -> Fill(perTpc);
+    hNonPrimPerTot_PU      -> Fill(perTot);
+    hNonPrimChi2_PU        -> Fill(pu_chisq);
+    hNonPrimNDF_PU         -> Fill(pu_ndf);
+    hNonPrimQuality_PU     -> Fill(pu_quality);
+    hNonPrimDCAxy_PU       -> Fill(umDcaXY);
+    hNonPrimDCAz_PU        -> Fill(umDcaZ);
+    hNonPrimVx_PU          -> Fill(pu_vx);
+    hNonPrimVy_PU          -> Fill(pu_vy);
+    hNonPrimVz_PU          -> Fill(pu_vz);
+    hNonPrimEta_PU         -> Fill(pu_eta);
+    hNonPrimPhi_PU         -> Fill(pu_phi);
+    hNonPrimPt_PU          -> Fill(pu_pt);
+    hDeltaNoPrDCAxy_PU     -> Fill(deltaDcaXY);
+    hDeltaNoPrDCAz_PU      -> Fill(deltaDcaZ);
+    hDeltaNoPrEta_PU       -> Fill(deltaEta);
+    hDeltaNoPrPhi_PU       -> Fill(deltaPhi);
+    hDeltaNoPrPt_PU        -> Fill(deltaPt);
+    hNonPrimPtVsNMms_PU    -> Fill(pu_nlmaps, pu_pt);
+    hNonPrimPtVsNMap_PU    -> Fill(pu_nlmaps, pu_pt);
+    hNonPrimPtVsNInt_PU    -> Fill(pu_nlintt, pu_pt);
+    hNonPrimPtVsNTpc_PU    -> Fill(pu_nltpc, pu_pt);
+    hNonPrimPtVsNTot_PU    -> Fill(pu_layers, pu_pt);
+    hNonPrimPtVsPerMms_PU  -> Fill(perMms, pu_pt);
+    hNonPrimPtVsPerMap_PU  -> Fill(perMaps, pu_pt);
+    hNonPrimPtVsPerInt_PU  -> Fill(perIntt, pu_pt);
+    hNonPrimPtVsPerTpc_PU  -> Fill(perTpc, pu_pt);
+    hNonPrimPtVsPerTot_PU  -> Fill(perTot, pu_pt);
+    hNonPrimPtVsChi2_PU    -> Fill(pu_chisq, pu_pt);
+    hNonPrimPtVsNDF_PU     -> Fill(pu_ndf, pu_pt);
+    hNonPrimPtVsQuality_PU -> Fill(pu_quality, pu_pt);
+    hNonPrimPtVsDCAxy_PU   -> Fill(umDcaXY, pu_pt);
+    hNonPrimPtVsDCAz_PU    -> Fill(umDcaZ, pu_pt);
+    hDeltaDCAxyVsNoPrPt_PU -> Fill(pu_pt, deltaDcaXY);
+    hDeltaDCAzVsNoPrPt_PU  -> Fill(pu_pt, deltaDcaZ);
+    hDeltaEtaVsNoPrPt_PU   -> Fill(pu_pt, deltaEta);
+    hDeltaPhiVsNoPrPt_PU   -> Fill(pu_pt, deltaPhi);
+    hDeltaPtVsNoPrPt_PU    -> Fill(pu_pt, deltaPt);
+  }
+  return;
+
+}  // end 'FillPileupEntry()'
 
 
 
@@ -964,6 +1053,7 @@ void STrackCutStudy::End() {
   SetHistStyles();
   CreatePlots();
   SaveHists();
+  if (!cutHists.empty()) SaveCutHists();
 
   // close files
   fOut  -> cd();
@@ -14755,6 +14845,79 @@ void STrackCutStudy::FillTruthHistograms(const Int_t type, const Double_t recoTr
 
 
 
+  // per-type histograms are filled in bulk by the columnar backend (FillBlock)
+
+  // per-type histograms are filled by the columnar backend if it ran
+  if (inColumnarMode) return;
+
+  // fill nominal histograms
+  if (type == TYPE::TRUTH) {
+    FillTruthHistograms(type, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  } else {
+    FillTrackHistograms(type, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  }
+
+  // fill histograms of each cut set the track passes
+  for (size_t iCut = 0; iCut < cutSets.size(); iCut++) {
+    if (!ApplyCutSet(cutSets[iCut], recoTrkVars)) continue;
+    FillVarHists(cutHists[iCut], type, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  }
+  return;
+
+}  // end 'FillVarHistograms(Int_t, Double_t[], Double_t[], Double_t[], Double_t[])'
+
+
+
+void STrackCutStudy::FillVarHists(STrackVarHists &hists, const Int_t type, const Double_t recoTrkVars[], const Double_t trueTrkVars[], const Double_t recoPhysVars[], const Double_t truePhysVars[]) {
+
+  // grab 2d x-axes
+  const auto nTpc   = recoTrkVars[TRKVAR::NTPC];
+  const auto ptRec  = recoPhysVars[PHYSVAR::PT];
+  const auto ptTrue = truePhysVars[PHYSVAR::PT];
+  const auto ptFrac = ptRec / ptTrue;
+
+  // truth type is filled with true values (cf. FillTruthHistograms)
+  const Bool_t useTruth = (type == TYPE::TRUTH);
+  for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+
+    const Bool_t   isTrkVar = (iVar < NTrkVar);
+    const Double_t reco     = isTrkVar ? recoTrkVars[iVar] : recoPhysVars[iVar - NTrkVar];
+    const Double_t truth    = isTrkVar ? trueTrkVars[iVar] : truePhysVars[iVar - NTrkVar];
+    const Double_t value    = useTruth ? truth : reco;
+
+    // fill hists
+    hists.hVar[type][iVar]      -> Fill(value);
+    hists.hDiff[type][iVar]     -> Fill(reco - truth);
+    hists.hFrac[type][iVar]     -> Fill(reco / truth);
+    hists.hVsNTpc[type][iVar]   -> Fill(nTpc,   value);
+    hists.hVsPtReco[type][iVar] -> Fill(ptRec,  value);
+    hists.hVsPtTrue[type][iVar] -> Fill(ptTrue, value);
+    hists.hVsPtFrac[type][iVar] -> Fill(ptFrac, value);
+  }
+  return;
+
+}  // end 'FillVarHists(STrackVarHists&, Int_t, Double_t[], Double_t[], Double_t[], Double_t[])'
+
+
+
+void STrackCutStudy::InitCutHists() {
+
+  // cut-set histograms are empty clones of the nominal per-type ones
+  STrackVarHists outHists;
+  LinkVarHists(outHists);
+
+  cutHists.resize(cutSets.size());
+  for (size_t iCut = 0; iCut < cutSets.size(); iCut++) {
+    TString sSuffix("_cut");
+    sSuffix += iCut;
+    CloneVarHists(outHists, cutHists[iCut], sSuffix);
+  }
+  return;
+
+}  // end 'InitCutHists()'
+
+
+
 Bool_t STrackCutStudy::ApplyCuts(const Double_t trkVz, const Double_t trkQuality) {
 
   const Bool_t isInVzCut   = ((trkVz > vzMin) && (trkVz < vzMax));
@@ -14764,4 +14927,21 @@ Bool_t STrackCutStudy::ApplyCuts(const Double_t trkVz, const Double_t trkQuality
 
 }  // end 'ApplyCuts(Double_t)'
 
+
+
+Bool_t STrackCutStudy::ApplyCutSet(const STrackCuts &cuts, const Double_t recoTrkVars[]) {
+
+  const Double_t vz      = recoTrkVars[TRKVAR::VZ];
+  const Double_t quality = recoTrkVars[TRKVAR::QUAL];
+  const Double_t dcaXY   = recoTrkVars[TRKVAR::DCAXY];
+  const Double_t dcaZ    = recoTrkVars[TRKVAR::DCAZ];
+
+  const Bool_t isInVzCut   = ((vz      > cuts.vzRange[0])      && (vz      < cuts.vzRange[1]));
+  const Bool_t isInQualCut = ((quality > cuts.qualityRange[0]) && (quality < cuts.qualityRange[1]));
+  const Bool_t isInDcaCut  = ((dcaXY   > cuts.dcaXYRange[0])   && (dcaXY   < cuts.dcaXYRange[1]) && (dcaZ > cuts.dcaZRange[0]) && (dcaZ < cuts.dcaZRange[1]));
+  const Bool_t isInHitCut  = ((recoTrkVars[TRKVAR::NMMS] >= cuts.nMmsMin) && (recoTrkVars[TRKVAR::NMAP] >= cuts.nMapsMin) && (recoTrkVars[TRKVAR::NINT] >= cuts.nInttMin) && (recoTrkVars[TRKVAR::NTPC] >= cuts.nTpcMin));
+  return (isInVzCut && isInQualCut && isInDcaCut && isInHitCut);
+
+}  // end 'ApplyCutSet(STrackCuts&, Double_t[])'
+
 // end ------------------------------------------------------------------------
@@ -0,0 +1,570 @@
+// ----------------------------------------------------------------------------
+// 'STrackCutStudy.columnar.h'
+// Derek Anderson
+// 12.15.2022
+//
+// Columnar backend for the track cut study: entries are read in blocks
+// into per-leaf columns, derived quantities and track types are computed
+// over whole columns, and the per-type histograms are filled in bulk.
+// Any registered cut sets are evaluated in the same pass, and the named
+// histograms are filled row by row from the same blocks, so each tuple
+// is read only once.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+using namespace std;
+
+
+
+void STrackCutStudy::AnalyzeColumnar() {
+
+  cout << "    Analyzing (columnar):" << endl;
+
+  // each worker opens its own copy of the input files
+  if (nColThreads > 1) ROOT::EnableThreadSafety();
+
+  // link output histograms: slot 0 holds the nominal histograms,
+  // slot 1 + i those of cut set i (see InitCutHists())
+  STrackVarHists outHists;
+  LinkVarHists(outHists);
+
+  vector<STrackVarHists> allHists(1, outHists);
+  allHists.insert(allHists.end(), cutHists.begin(), cutHists.end());
+
+  // the named histograms and leaf members are shared by all threads
+  mutex entryMutex;
+
+  for (UInt_t iTuple = 0; iTuple < 2; iTuple++) {
+
+    const Bool_t   isPileup = (iTuple == 1);
+    const Long64_t nEntries = isPileup ? ntTrkPU -> GetEntries() : ntTrkEO -> GetEntries();
+    const TString  sTuple   = isPileup ? "with-pileup" : "embed-only";
+    cout << "      Beginning " << sTuple.Data() << " block loop: " << nEntries << " entries to process..." << endl;
+
+    // single thread fills output histograms directly
+    if (nColThreads == 1) {
+      ProcessEntryRange(isPileup, 0, nEntries, allHists, entryMutex);
+      cout << "      Finished " << sTuple.Data() << " block loop." << endl;
+      continue;
+    }
+
+    // otherwise give each thread its own histograms
+    vector<vector<STrackVarHists>> threadHists(nColThreads, vector<STrackVarHists>(allHists.size()));
+    for (UInt_t iThread = 0; iThread < nColThreads; iThread++) {
+      TString sSuffix("_thread");
+      sSuffix += iThread;
+      for (size_t iHists = 0; iHists < allHists.size(); iHists++) {
+        CloneVarHists(allHists[iHists], threadHists[iThread][iHists], sSuffix);
+      }
+    }
+
+    // split entries into contiguous ranges
+    const Long64_t nPerThread = (nEntries + nColThreads - 1) / nColThreads;
+
+    vector<thread> threads;
+    for (UInt_t iThread = 0; iThread < nColThreads; iThread++) {
+      const Long64_t firstEntry = iThread * nPerThread;
+      const Long64_t lastEntry  = min(nEntries, firstEntry + nPerThread);
+      if (firstEntry >= lastEntry) break;
+      threads.emplace_back(&STrackCutStudy::ProcessEntryRange, this, isPileup, firstEntry, lastEntry, ref(threadHists[iThread]), ref(entryMutex));
+    }
+    for (thread &worker : threads) {
+      worker.join();
+    }
+
+    // merge thread-local histograms
+    for (UInt_t iThread = 0; iThread < nColThreads; iThread++) {
+      for (size_t iHists = 0; iHists < allHists.size(); iHists++) {
+        MergeVarHists(threadHists[iThread][iHists], allHists[iHists]);
+      }
+    }
+    cout << "      Finished " << sTuple.Data() << " block loop." << endl;
+  }
+
+  return;
+
+}  // end 'AnalyzeColumnar()'
+
+
+
+void STrackCutStudy::ProcessEntryRange(const Bool_t isPileup, const Long64_t firstEntry, const Long64_t lastEntry, vector<STrackVarHists> &hists, mutex &entryMutex) {
+
+  // leaves used by the columnar backend (same names in both tuples)
+  const TString sLeaves[NLeaf] = {
+    "vx",
+    "vy",
+    "vz",
+    "nlmms",
+    "nlmaps",
+    "nlintt",
+    "ntpc",
+    "quality",
+    "dca3dxy",
+    "dca3dz",
+    "phi",
+    "eta",
+    "pt",
+    "gvx",
+    "gvy",
+    "gvz",
+    "gnlmms",
+    "gnlmaps",
+    "gnlintt",
+    "gntpc",
+    "gphi",
+    "geta",
+    "gpt",
+    "gprimary",
+    "nmaps"
+  };
+
+  // open a private copy of the input tuple
+  const TString sFile  = isPileup ? sInFilePU  : sInFileEO;
+  const TString sTuple = isPileup ? sInTuplePU : sInTupleEO;
+
+  TFile *file = TFile::Open(sFile.Data(), "read");
+  if (!file || file -> IsZombie()) {
+    cerr << "PANIC: couldn't open input file '" << sFile.Data() << "' for columnar loop!" << endl;
+    assert(file && !(file -> IsZombie()));
+  }
+
+  TNtuple *tuple = (TNtuple*) file -> Get(sTuple.Data());
+  if (!tuple) {
+    cerr << "PANIC: couldn't grab input Ntuple '" << sTuple.Data() << "' for columnar loop!" << endl;
+    assert(tuple);
+  }
+
+  // read every column the entry loops read (i.e. which has a leaf
+  // member on the input tuple) and remember where that member is
+  TNtuple  *input    = isPileup ? ntTrkPU : ntTrkEO;
+  TObjArray *columns = tuple -> GetListOfBranches();
+  const Int_t nCols  = columns -> GetEntries();
+
+  vector<Float_t>  row(nCols);
+  vector<Float_t*> members(nCols, nullptr);
+  tuple -> SetBranchStatus("*", 0);
+  for (Int_t iCol = 0; iCol < nCols; iCol++) {
+    const char *sCol    = columns -> At(iCol) -> GetName();
+    TBranch    *bMember = input -> GetBranch(sCol);
+    if (!bMember || !(bMember -> GetAddress())) continue;
+    members[iCol] = (Float_t*) bMember -> GetAddress();
+    tuple -> SetBranchStatus(sCol, 1);
+    tuple -> SetBranchAddress(sCol, &row[iCol]);
+  }
+
+  // leaves used by the columnar calculations
+  Int_t leafCol[NLeaf];
+  for (Ssiz_t iLeaf = 0; iLeaf < NLeaf; iLeaf++) {
+    leafCol[iLeaf] = columns -> IndexOf(tuple -> GetBranch(sLeaves[iLeaf].Data()));
+    if ((leafCol[iLeaf] < 0) || !members[leafCol[iLeaf]]) {
+      cerr << "PANIC: leaf '" << sLeaves[iLeaf].Data() << "' is not read by the entry loops!" << endl;
+      assert((leafCol[iLeaf] >= 0) && members[leafCol[iLeaf]]);
+    }
+  }
+  tuple -> SetCacheSize(-1);
+  tuple -> SetCacheEntryRange(firstEntry, lastEntry);
+
+  // reserve block columns once
+  STrackBlock block;
+  for (Ssiz_t iLeaf = 0; iLeaf < NLeaf; iLeaf++) {
+    block.leaf[iLeaf].resize(nColBlock);
+  }
+  block.nCols = nCols;
+  block.rows.resize((size_t) nColBlock * nCols);
+
+  // loop over blocks of entries
+  for (Long64_t iStart = firstEntry; iStart < lastEntry; iStart += nColBlock) {
+
+    const Long64_t iStop = min(lastEntry, iStart + (Long64_t) nColBlock);
+
+    // transpose entries into columns, keep the rows for the named histograms
+    size_t nRead = 0;
+    for (Long64_t iEntry = iStart; iEntry < iStop; iEntry++) {
+      const Long64_t bytes = tuple -> GetEntry(iEntry);
+      if (bytes < 0.) {
+        cerr << "WARNING: something wrong with entry #" << iEntry << "! Aborting block!" << endl;
+        break;
+      }
+      for (Ssiz_t iLeaf = 0; iLeaf < NLeaf; iLeaf++) {
+        block.leaf[iLeaf][nRead] = row[leafCol[iLeaf]];
+      }
+      copy(row.begin(), row.end(), block.rows.begin() + nRead * nCols);
+      ++nRead;
+    }
+    block.nTrks = nRead;
+
+    ComputeBlock(block, isPileup);
+    FillBlock(block, hists[0]);
+    for (size_t iCut = 0; iCut < cutSets.size(); iCut++) {
+      FillBlock(block, hists[iCut + 1], iCut);
+    }
+
+    // named histograms are filled from the leaf members, one row at a time
+    // (the per-type histograms were filled above, FillVarHistograms skips them)
+    {
+      lock_guard<mutex> lock(entryMutex);
+      for (size_t iTrk = 0; iTrk < nRead; iTrk++) {
+        const Float_t *values = &block.rows[iTrk * nCols];
+        for (Int_t iCol = 0; iCol < nCols; iCol++) {
+          if (members[iCol]) *members[iCol] = values[iCol];
+        }
+        if (isPileup) {
+          FillPileupEntry();
+        } else {
+          FillEmbedOnlyEntry();
+        }
+      }
+    }
+  }  // end block loop
+
+  // tuple is owned by the file
+  file -> Close();
+  delete file;
+  return;
+
+}  // end 'ProcessEntryRange(Bool_t, Long64_t, Long64_t, vector<STrackVarHists>&)'
+
+
+
+void STrackCutStudy::ComputeBlock(STrackBlock &block, const Bool_t isPileup) {
+
+  const size_t nTrks = block.nTrks;
+  for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+    block.reco[iVar].resize(nTrks);
+    block.truth[iVar].resize(nTrks);
+  }
+  block.ptFrac.resize(nTrks);
+  block.typeMask.resize(nTrks);
+  block.cutMask.assign(nTrks, 0);
+
+  // map leaves onto reco & true variables
+  const LEAF recoLeaf[NVar] = {
+    L_VX,
+    L_VY,
+    L_VZ,
+    L_NLMMS,
+    L_NLMAPS,
+    L_NLINTT,
+    L_NTPC,
+    L_QUAL,
+    L_DCAXY,
+    L_DCAZ,
+    L_PHI,
+    L_ETA,
+    L_PT
+  };
+  const LEAF trueLeaf[NVar] = {
+    L_GVX,
+    L_GVY,
+    L_GVZ,
+    L_GNLMMS,
+    L_GNLMAPS,
+    L_GNLINTT,
+    L_GNTPC,
+    L_QUAL,
+    L_DCAXY,
+    L_DCAZ,
+    L_GPHI,
+    L_GETA,
+    L_GPT
+  };
+  for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+    const Float_t *reco  = block.leaf[recoLeaf[iVar]].data();
+    const Float_t *truth = block.leaf[trueLeaf[iVar]].data();
+    Double_t      *out   = block.reco[iVar].data();
+    Double_t      *gOut  = block.truth[iVar].data();
+    for (size_t iTrk = 0; iTrk < nTrks; iTrk++) {
+      out[iTrk]  = (Double_t) reco[iTrk];
+      gOut[iTrk] = (Double_t) truth[iTrk];
+    }
+  }
+
+  // dca's are in um (scaled in single precision, as in the entry loops)
+  for (const Ssiz_t iVar : {(Ssiz_t) TRKVAR::DCAXY, (Ssiz_t) TRKVAR::DCAZ}) {
+    const Float_t *dca   = block.leaf[recoLeaf[iVar]].data();
+    Double_t      *reco  = block.reco[iVar].data();
+    Double_t      *truth = block.truth[iVar].data();
+    for (size_t iTrk = 0; iTrk < nTrks; iTrk++) {
+      reco[iTrk]  = (Double_t) (dca[iTrk] * 10000.f);
+      truth[iTrk] = reco[iTrk];
+    }
+  }
+
+  // pt fraction
+  const Double_t *ptReco = block.reco[NTrkVar + PHYSVAR::PT].data();
+  const Double_t *ptTrue = block.truth[NTrkVar + PHYSVAR::PT].data();
+  Double_t       *ptFrac = block.ptFrac.data();
+  for (size_t iTrk = 0; iTrk < nTrks; iTrk++) {
+    ptFrac[iTrk] = ptReco[iTrk] / ptTrue[iTrk];
+  }
+
+  // assign track types, same selection as the entry loops in Analyze()
+  const Float_t *nlmaps   = block.leaf[L_NLMAPS].data();
+  const Float_t *nmaps    = block.leaf[L_NMAPS].data();
+  const Float_t *gprimary = block.leaf[L_GPRIM].data();
+  UInt_t        *mask     = block.typeMask.data();
+  if (isPileup) {
+    const Float_t *dcaXY = block.leaf[L_DCAXY].data();
+    const Float_t *dcaZ  = block.leaf[L_DCAZ].data();
+    const Float_t *eta   = block.leaf[L_ETA].data();
+    const Float_t *phi   = block.leaf[L_PHI].data();
+    const Float_t *pt    = block.leaf[L_PT].data();
+    for (size_t iTrk = 0; iTrk < nTrks; iTrk++) {
+      const Bool_t thereAreNans = (isnan(dcaXY[iTrk]) || isnan(dcaZ[iTrk]) || isnan(eta[iTrk]) || isnan(phi[iTrk]) || isnan(pt[iTrk]));
+      const Bool_t isSelected   = (!thereAreNans && (nlmaps[iTrk] >= 2));
+      const Bool_t isPrimary    = (gprimary[iTrk] == 1);
+      const UInt_t typeMask     = (1 << TYPE::PILEUP) | (isPrimary ? (1 << TYPE::PRIMARY) : (1 << TYPE::NONPRIM));
+      mask[iTrk] = isSelected ? typeMask : 0;
+    }
+  } else {
+    // weird tracks are selected on the single-precision pt fraction, as in the entry loop
+    const Float_t *pt  = block.leaf[L_PT].data();
+    const Float_t *gpt = block.leaf[L_GPT].data();
+    for (size_t iTrk = 0; iTrk < nTrks; iTrk++) {
+      const Float_t ptFracF     = pt[iTrk] / gpt[iTrk];
+      const Bool_t isPrimary    = (gprimary[iTrk] == 1);
+      const Bool_t isSelected   = ((nlmaps[iTrk] >= 2) && (!useOnlyPrimary || isPrimary));
+      const Bool_t isWeirdTrack = ((ptFracF < normalPtFracMin) || (ptFracF > normalPtFracMax));
+      const UInt_t weirdMask    = (1 << TYPE::WEIRD_ALL) | ((nmaps[iTrk] == 3) ? (1 << TYPE::WEIRD_SI) : 0) | ((nmaps[iTrk] == 0) ? (1 << TYPE::WEIRD_TPC) : 0);
+      const UInt_t typeMask     = (1 << TYPE::TRACK) | (1 << TYPE::TRUTH) | (isWeirdTrack ? weirdMask : (1 << TYPE::NORMAL));
+      mask[iTrk] = isSelected ? typeMask : 0;
+    }
+  }
+
+  // evaluate each cut set, bit i of the cut mask is set if a track passes cut set i
+  const Double_t *vz      = block.reco[TRKVAR::VZ].data();
+  const Double_t *quality = block.reco[TRKVAR::QUAL].data();
+  const Double_t *dcaXY   = block.reco[TRKVAR::DCAXY].data();
+  const Double_t *dcaZ    = block.reco[TRKVAR::DCAZ].data();
+  const Double_t *nMms    = block.reco[TRKVAR::NMMS].data();
+  const Double_t *nMaps   = block.reco[TRKVAR::NMAP].data();
+  const Double_t *nIntt   = block.reco[TRKVAR::NINT].data();
+  const Double_t *nTpc    = block.reco[TRKVAR::NTPC].data();
+  UInt_t         *cutMask = block.cutMask.data();
+  for (size_t iCut = 0; iCut < cutSets.size(); iCut++) {
+    const STrackCuts &cuts = cutSets[iCut];
+    const UInt_t      bit  = (1u << iCut);
+    for (size_t iTrk = 0; iTrk < nTrks; iTrk++) {
+      const Bool_t isInVzCut   = ((vz[iTrk]      > cuts.vzRange[0])      && (vz[iTrk]      < cuts.vzRange[1]));
+      const Bool_t isInQualCut = ((quality[iTrk] > cuts.qualityRange[0]) && (quality[iTrk] < cuts.qualityRange[1]));
+      const Bool_t isInDcaCut  = ((dcaXY[iTrk]   > cuts.dcaXYRange[0])   && (dcaXY[iTrk]   < cuts.dcaXYRange[1]) && (dcaZ[iTrk] > cuts.dcaZRange[0]) && (dcaZ[iTrk] < cuts.dcaZRange[1]));
+      const Bool_t isInHitCut  = ((nMms[iTrk] >= cuts.nMmsMin) && (nMaps[iTrk] >= cuts.nMapsMin) && (nIntt[iTrk] >= cuts.nInttMin) && (nTpc[iTrk] >= cuts.nTpcMin));
+      cutMask[iTrk] |= (isInVzCut && isInQualCut && isInDcaCut && isInHitCut) ? bit : 0;
+    }
+  }
+  return;
+
+}  // end 'ComputeBlock(STrackBlock&, Bool_t)'
+
+
+
+void STrackCutStudy::FillBlock(STrackBlock &block, STrackVarHists &hists, const Int_t iCut) {
+
+  const size_t nTrks = block.nTrks;
+  block.select.resize(nTrks);
+  block.bufVal.resize(nTrks);
+  block.bufDiff.resize(nTrks);
+  block.bufFrac.resize(nTrks);
+  block.bufNTpc.resize(nTrks);
+  block.bufPtReco.resize(nTrks);
+  block.bufPtTrue.resize(nTrks);
+  block.bufPtFrac.resize(nTrks);
+
+  const Double_t *nTpc   = block.reco[TRKVAR::NTPC].data();
+  const Double_t *ptReco = block.reco[NTrkVar + PHYSVAR::PT].data();
+  const Double_t *ptTrue = block.truth[NTrkVar + PHYSVAR::PT].data();
+  const Double_t *ptFrac = block.ptFrac.data();
+  const UInt_t   *mask   = block.typeMask.data();
+  const UInt_t   *cuts   = block.cutMask.data();
+  const UInt_t    cutBit = (iCut < 0) ? 0 : (1u << iCut);
+  for (Ssiz_t iType = 0; iType < NType; iType++) {
+
+    // collect tracks of this type (passing the cut set, if any)
+    const UInt_t bit  = (1 << iType);
+    UInt_t      *sel  = block.select.data();
+    Int_t        nSel = 0;
+    for (size_t iTrk = 0; iTrk < nTrks; iTrk++) {
+      sel[nSel] = iTrk;
+      nSel     += (((mask[iTrk] & bit) != 0) && ((cuts[iTrk] & cutBit) == cutBit));
+    }
+    if (nSel == 0) continue;
+
+    // gather 2d x-axes
+    for (Int_t iSel = 0; iSel < nSel; iSel++) {
+      block.bufNTpc[iSel]   = nTpc[sel[iSel]];
+      block.bufPtReco[iSel] = ptReco[sel[iSel]];
+      block.bufPtTrue[iSel] = ptTrue[sel[iSel]];
+      block.bufPtFrac[iSel] = ptFrac[sel[iSel]];
+    }
+
+    // truth type is filled with true values (cf. FillTruthHistograms)
+    const Bool_t useTruth = (iType == TYPE::TRUTH);
+    for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+
+      const Double_t *reco  = block.reco[iVar].data();
+      const Double_t *truth = block.truth[iVar].data();
+      const Double_t *value = useTruth ? truth : reco;
+      for (Int_t iSel = 0; iSel < nSel; iSel++) {
+        const UInt_t iTrk   = sel[iSel];
+        block.bufVal[iSel]  = value[iTrk];
+        block.bufDiff[iSel] = reco[iTrk] - truth[iTrk];
+        block.bufFrac[iSel] = reco[iTrk] / truth[iTrk];
+      }
+
+      // fill hists
+      hists.hVar[iType][iVar]      -> FillN(nSel, block.bufVal.data(),  nullptr);
+      hists.hDiff[iType][iVar]     -> FillN(nSel, block.bufDiff.data(), nullptr);
+      hists.hFrac[iType][iVar]     -> FillN(nSel, block.bufFrac.data(), nullptr);
+      hists.hVsNTpc[iType][iVar]   -> FillN(nSel, block.bufNTpc.data(),   block.bufVal.data(), nullptr);
+      hists.hVsPtReco[iType][iVar] -> FillN(nSel, block.bufPtReco.data(), block.bufVal.data(), nullptr);
+      hists.hVsPtTrue[iType][iVar] -> FillN(nSel, block.bufPtTrue.data(), block.bufVal.data(), nullptr);
+      hists.hVsPtFrac[iType][iVar] -> FillN(nSel, block.bufPtFrac.data(), block.bufVal.data(), nullptr);
+    }
+  }  // end type loop
+  return;
+
+}  // end 'FillBlock(STrackBlock&, STrackVarHists&, Int_t)'
+
+
+
+void STrackCutStudy::LinkVarHists(STrackVarHists &hists) {
+
+  for (Ssiz_t iType = 0; iType < NType; iType++) {
+    for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+      hists.hVar[iType][iTrkVar]      = hTrkVar[iType][iTrkVar];
+      hists.hDiff[iType][iTrkVar]     = hTrkVarDiff[iType][iTrkVar];
+      hists.hFrac[iType][iTrkVar]     = hTrkVarFrac[iType][iTrkVar];
+      hists.hVsNTpc[iType][iTrkVar]   = hTrkVarVsNTpc[iType][iTrkVar];
+      hists.hVsPtReco[iType][iTrkVar] = hTrkVarVsPtReco[iType][iTrkVar];
+      hists.hVsPtTrue[iType][iTrkVar] = hTrkVarVsPtTrue[iType][iTrkVar];
+      hists.hVsPtFrac[iType][iTrkVar] = hTrkVarVsPtFrac[iType][iTrkVar];
+    }
+    for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+      const Ssiz_t iVar = NTrkVar + iPhysVar;
+      hists.hVar[iType][iVar]      = hPhysVar[iType][iPhysVar];
+      hists.hDiff[iType][iVar]     = hPhysVarDiff[iType][iPhysVar];
+      hists.hFrac[iType][iVar]     = hPhysVarFrac[iType][iPhysVar];
+      hists.hVsNTpc[iType][iVar]   = hPhysVarVsNTpc[iType][iPhysVar];
+      hists.hVsPtReco[iType][iVar] = hPhysVarVsPtReco[iType][iPhysVar];
+      hists.hVsPtTrue[iType][iVar] = hPhysVarVsPtTrue[iType][iPhysVar];
+      hists.hVsPtFrac[iType][iVar] = hPhysVarVsPtFrac[iType][iPhysVar];
+    }
+  }
+  return;
+
+}  // end 'LinkVarHists(STrackVarHists&)'
+
+
+
+void STrackCutStudy::CloneVarHists(const STrackVarHists &source, STrackVarHists &clone, const TString sSuffix) {
+
+  for (Ssiz_t iType = 0; iType < NType; iType++) {
+    for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+      clone.hVar[iType][iVar]      = (TH1D*) source.hVar[iType][iVar]      -> Clone(TString(source.hVar[iType][iVar]      -> GetName()) + sSuffix);
+      clone.hDiff[iType][iVar]     = (TH1D*) source.hDiff[iType][iVar]     -> Clone(TString(source.hDiff[iType][iVar]     -> GetName()) + sSuffix);
+      clone.hFrac[iType][iVar]     = (TH1D*) source.hFrac[iType][iVar]     -> Clone(TString(source.hFrac[iType][iVar]     -> GetName()) + sSuffix);
+      clone.hVsNTpc[iType][iVar]   = (TH2D*) source.hVsNTpc[iType][iVar]   -> Clone(TString(source.hVsNTpc[iType][iVar]   -> GetName()) + sSuffix);
+      clone.hVsPtReco[iType][iVar] = (TH2D*) source.hVsPtReco[iType][iVar] -> Clone(TString(source.hVsPtReco[iType][iVar] -> GetName()) + sSuffix);
+      clone.hVsPtTrue[iType][iVar] = (TH2D*) source.hVsPtTrue[iType][iVar] -> Clone(TString(source.hVsPtTrue[iType][iVar] -> GetName()) + sSuffix);
+      clone.hVsPtFrac[iType][iVar] = (TH2D*) source.hVsPtFrac[iType][iVar] -> Clone(TString(source.hVsPtFrac[iType][iVar] -> GetName()) + sSuffix);
+
+      // clones are empty and detached from the output file
+      for (TH1 *hist : {(TH1*) clone.hVar[iType][iVar], (TH1*) clone.hDiff[iType][iVar], (TH1*) clone.hFrac[iType][iVar], (TH1*) clone.hVsNTpc[iType][iVar], (TH1*) clone.hVsPtReco[iType][iVar], (TH1*) clone.hVsPtTrue[iType][iVar], (TH1*) clone.hVsPtFrac[iType][iVar]}) {
+        hist -> SetDirectory(0);
+        hist -> Reset();
+      }
+    }
+  }
+  return;
+
+}  // end 'CloneVarHists(STrackVarHists&, STrackVarHists&, TString)'
+
+
+
+void STrackCutStudy::MergeVarHists(STrackVarHists &source, STrackVarHists &target) {
+
+  for (Ssiz_t iType = 0; iType < NType; iType++) {
+    for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+      target.hVar[iType][iVar]      -> Add(source.hVar[iType][iVar]);
+      target.hDiff[iType][iVar]     -> Add(source.hDiff[iType][iVar]);
+      target.hFrac[iType][iVar]     -> Add(source.hFrac[iType][iVar]);
+      target.hVsNTpc[iType][iVar]   -> Add(source.hVsNTpc[iType][iVar]);
+      target.hVsPtReco[iType][iVar] -> Add(source.hVsPtReco[iType][iVar]);
+      target.hVsPtTrue[iType][iVar] -> Add(source.hVsPtTrue[iType][iVar]);
+      target.hVsPtFrac[iType][iVar] -> Add(source.hVsPtFrac[iType][iVar]);
+      delete source.hVar[iType][iVar];
+      delete source.hDiff[iType][iVar];
+      delete source.hFrac[iType][iVar];
+      delete source.hVsNTpc[iType][iVar];
+      delete source.hVsPtReco[iType][iVar];
+      delete source.hVsPtTrue[iType][iVar];
+      delete source.hVsPtFrac[iType][iVar];
+    }
+  }
+  return;
+
+}  // end 'MergeVarHists(STrackVarHists&, STrackVarHists&)'
+
+
+
+void STrackCutStudy::NormalizeVarHists(STrackVarHists &hists) {
+
+  for (Ssiz_t iType = 0; iType < NType; iType++) {
+    for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+      for (TH1 *hist : {(TH1*) hists.hVar[iType][iVar], (TH1*) hists.hDiff[iType][iVar], (TH1*) hists.hFrac[iType][iVar], (TH1*) hists.hVsNTpc[iType][iVar], (TH1*) hists.hVsPtReco[iType][iVar], (TH1*) hists.hVsPtTrue[iType][iVar], (TH1*) hists.hVsPtFrac[iType][iVar]}) {
+        const Double_t integral = hist -> Integral();
+        if (integral > 0.) hist -> Scale(1. / integral);
+      }
+    }
+  }
+  return;
+
+}  // end 'NormalizeVarHists(STrackVarHists&)'
+
+
+
+void STrackCutStudy::SaveCutHists() {
+
+  // directory parameters
+  const TString sOutDirN[NType] = {"Track", "Truth", "AllWeird", "SiWeird", "TpcWeird", "Normal", "AllPileup", "PrimePileup", "NonPrimePileup"};
+
+  for (size_t iCut = 0; iCut < cutHists.size(); iCut++) {
+
+    // create output directories
+    TString sCutDir("Cut");
+    sCutDir += iCut;
+
+    fOut -> cd();
+    TDirectory *dCut = (TDirectory*) fOut -> mkdir(sCutDir.Data());
+
+    // record cut values
+    const STrackCuts &cuts = cutSets[iCut];
+    TString sCuts = TString::Format("vz = (%g, %g), quality = (%g, %g), dcaXY = (%g, %g), dcaZ = (%g, %g), nMms >= %g, nMaps >= %g, nIntt >= %g, nTpc >= %g",
+                                    cuts.vzRange[0], cuts.vzRange[1], cuts.qualityRange[0], cuts.qualityRange[1], cuts.dcaXYRange[0], cuts.dcaXYRange[1],
+                                    cuts.dcaZRange[0], cuts.dcaZRange[1], cuts.nMmsMin, cuts.nMapsMin, cuts.nInttMin, cuts.nTpcMin);
+    dCut -> cd();
+    TNamed nCuts("cuts", sCuts.Data());
+    nCuts.Write();
+
+    // save histograms
+    for (Ssiz_t iType = 0; iType < NType; iType++) {
+      TDirectory *dType = (TDirectory*) dCut -> mkdir(sOutDirN[iType].Data());
+      dType -> cd();
+      for (Ssiz_t iVar = 0; iVar < NVar; iVar++) {
+        cutHists[iCut].hVar[iType][iVar]      -> Write();
+        cutHists[iCut].hDiff[iType][iVar]     -> Write();
+        cutHists[iCut].hFrac[iType][iVar]     -> Write();
+        cutHists[iCut].hVsNTpc[iType][iVar]   -> Write();
+        cutHists[iCut].hVsPtReco[iType][iVar] -> Write();
+        cutHists[iCut].hVsPtTrue[iType][iVar] -> Write();
+        cutHists[iCut].hVsPtFrac[iType][iVar] -> Write();
+      }
+    }
+  }
+  cout << "      Saved cut-set histograms." << endl;
+  return;
+
+}  // end 'SaveCutHists()'
+
+// end ------------------------------------------------------------------------
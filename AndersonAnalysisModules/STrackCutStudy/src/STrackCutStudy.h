@@ -14,15 +14,21 @@
 
 // standard c includes
 #include <cmath>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <cassert>
 #include <iostream>
+#include <functional>
 // root includes
 #include <TH1.h>
 #include <TH2.h>
 #include <TPad.h>
+#include <TNamed.h>
+#include <TBranch.h>
 #include <TFile.h>
 #include <TMath.h>
+#include <TROOT.h>
 #include <TError.h>
 #include <TNtuple.h>
 #include <TString.h>
@@ -41,7 +47,62 @@ static const Ssiz_t NTrkVar(10);
 static const Ssiz_t NPhysVar(3);
 static const Ssiz_t NRange(2);
 static const Ssiz_t NPanel(2);
+static const Ssiz_t NVar(NTrkVar + NPhysVar);
+static const Ssiz_t NLeaf(25);
 static const UInt_t FTxt(42);
+static const UInt_t NBlockDefault(10000);
+static const UInt_t NCutSetMax(32);
+static const Long64_t NProgress(100000);
+
+
+
+// per-type histograms of the track (0 - NTrkVar - 1) and physics
+// (NTrkVar - NVar - 1) variables, used by the columnar backend and
+// the cut scan
+struct STrackVarHists {
+  TH1D *hVar[NType][NVar];
+  TH1D *hDiff[NType][NVar];
+  TH1D *hFrac[NType][NVar];
+  TH2D *hVsNTpc[NType][NVar];
+  TH2D *hVsPtReco[NType][NVar];
+  TH2D *hVsPtTrue[NType][NVar];
+  TH2D *hVsPtFrac[NType][NVar];
+};
+
+// a track cut configuration for the multi-cut scan, ranges are
+// exclusive (as in ApplyCuts) and dca's are in um
+struct STrackCuts {
+  Double_t vzRange[2]      = {-9999., 9999.};
+  Double_t qualityRange[2] = {-9999., 9999.};
+  Double_t dcaXYRange[2]   = {-1.e9, 1.e9};
+  Double_t dcaZRange[2]    = {-1.e9, 1.e9};
+  Double_t nMmsMin         = 0.;
+  Double_t nMapsMin        = 0.;
+  Double_t nInttMin        = 0.;
+  Double_t nTpcMin         = 0.;
+};
+
+// a block of ntuple entries stored column-wise
+struct STrackBlock {
+  size_t           nTrks = 0;
+  size_t           nCols = 0;
+  vector<Float_t>  leaf[NLeaf];
+  vector<Float_t>  rows;  // all columns read by the entry loops, row-wise
+  vector<Double_t> reco[NVar];
+  vector<Double_t> truth[NVar];
+  vector<Double_t> ptFrac;
+  vector<UInt_t>   typeMask;
+  vector<UInt_t>   cutMask;
+  // gather buffers for bulk filling
+  vector<UInt_t>   select;
+  vector<Double_t> bufVal;
+  vector<Double_t> bufDiff;
+  vector<Double_t> bufFrac;
+  vector<Double_t> bufNTpc;
+  vector<Double_t> bufPtReco;
+  vector<Double_t> bufPtTrue;
+  vector<Double_t> bufPtFrac;
+};
 
 
 
@@ -67,6 +128,33 @@ class STrackCutStudy {
       ETA = 1,
       PT  = 2
     };
+    enum LEAF {
+      L_VX      = 0,
+      L_VY      = 1,
+      L_VZ      = 2,
+      L_NLMMS   = 3,
+      L_NLMAPS  = 4,
+      L_NLINTT  = 5,
+      L_NTPC    = 6,
+      L_QUAL    = 7,
+      L_DCAXY   = 8,
+      L_DCAZ    = 9,
+      L_PHI     = 10,
+      L_ETA     = 11,
+      L_PT      = 12,
+      L_GVX     = 13,
+      L_GVY     = 14,
+      L_GVZ     = 15,
+      L_GNLMMS  = 16,
+      L_GNLMAPS = 17,
+      L_GNLINTT = 18,
+      L_GNTPC   = 19,
+      L_GPHI    = 20,
+      L_GETA    = 21,
+      L_GPT     = 22,
+      L_GPRIM   = 23,
+      L_NMAPS   = 24
+    };
     enum TYPE {
       TRACK     = 0,
       TRUTH     = 1,
@@ -88,6 +176,8 @@ class STrackCutStudy {
     void SetInputTuples(const TString sEmbedOnlyTuple, const TString sPileupTuple);
     void SetStudyParameters(const Bool_t intNorm, const Bool_t onlyPrim, const Double_t weirdFracMin, const Double_t weirdFracMax);
     void SetTrackCuts(const Double_t trkVzMin, const Double_t trkVzMax, const Double_t trkQualMin, const Double_t trkQualMax);
+    void SetColumnarMode(const Bool_t columnar, const UInt_t nThreads = 1, const UInt_t blockSize = NBlockDefault);
+    UInt_t AddCutSet(const STrackCuts &cuts);
     void Init();
     void Analyze();
     void End();
@@ -712,6 +802,15 @@ class STrackCutStudy {
     Double_t normalPtFracMin;
     Double_t normalPtFracMax;
 
+    // columnar backend parameters
+    Bool_t inColumnarMode;
+    UInt_t nColThreads;
+    UInt_t nColBlock;
+
+    // cut configurations to scan and their histograms
+    vector<STrackCuts>     cutSets;
+    vector<STrackVarHists> cutHists;
+
     // track cuts
     Double_t vzMin;
     Double_t vzMax;
@@ -926,7 +1025,25 @@ class STrackCutStudy {
     void   SaveHists();
     void   FillTrackHistograms(const Int_t type, const Double_t recoTrkVars[], const Double_t trueTrkVars[], const Double_t recoPhysVars[], const Double_t truePhysVars[]);
     void   FillTruthHistograms(const Int_t type, const Double_t recoTrkVars[], const Double_t trueTrkVars[], const Double_t recoPhysVars[], const Double_t truePhysVars[]);
+    void   FillVarHistograms(const Int_t type, const Double_t recoTrkVars[], const Double_t trueTrkVars[], const Double_t recoPhysVars[], const Double_t truePhysVars[]);
+    void   FillVarHists(STrackVarHists &hists, const Int_t type, const Double_t recoTrkVars[], const Double_t trueTrkVars[], const Double_t recoPhysVars[], const Double_t truePhysVars[]);
+    void   InitCutHists();
+    void   AnalyzeEntries();
+    void   FillEmbedOnlyEntry();
+    void   FillPileupEntry();
     Bool_t ApplyCuts(const Double_t trkVz, const Double_t trkQuality);
+    Bool_t ApplyCutSet(const STrackCuts &cuts, const Double_t recoTrkVars[]);
+
+    // columnar backend (STrackCutStudy.columnar.h)
+    void AnalyzeColumnar();
+    void ProcessEntryRange(const Bool_t isPileup, const Long64_t firstEntry, const Long64_t lastEntry, vector<STrackVarHists> &hists, mutex &entryMutex);
+    void ComputeBlock(STrackBlock &block, const Bool_t isPileup);
+    void FillBlock(STrackBlock &block, STrackVarHists &hists, const Int_t iCut = -1);
+    void LinkVarHists(STrackVarHists &hists);
+    void CloneVarHists(const STrackVarHists &source, STrackVarHists &clone, const TString sSuffix);
+    void MergeVarHists(STrackVarHists &source, STrackVarHists &target);
+    void NormalizeVarHists(STrackVarHists &hists);
+    void SaveCutHists();
 
 };  // end STrackCutStudy definition
 
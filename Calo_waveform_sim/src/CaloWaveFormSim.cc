@@ -1,4 +1,5 @@
 #include "CaloWaveFormSim.h"
+#include "CaloWaveformSynthesizer.h"
 
 // G4Hits includes
 #include <g4main/PHG4Hit.h>
@@ -38,6 +39,7 @@
 #include <TFile.h>
 #include <TNtuple.h>
 #include <TMath.h>
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -82,7 +84,15 @@ CaloWaveFormSim::CaloWaveFormSim(const std::string& name, const std::string& fil
   , hm(nullptr)
   , outfile(nullptr)
   , g4hitntuple(nullptr)
-
+  , noise_file_emcal("/gpfs/mnt/gpfs02/sphenix/user/trinn/sPHENIX_emcal_cosmics_sector0/noise_waveforms/medium_raddmgnoise.csv")
+  , noise_file_ihcal("/gpfs/mnt/gpfs02/sphenix/user/trinn/sPHENIX_emcal_cosmics_sector0/noise_waveforms/low_raddmgnoise.csv")
+  , noise_file_ohcal("/gpfs/mnt/gpfs02/sphenix/user/trinn/sPHENIX_emcal_cosmics_sector0/noise_waveforms/no_raddmgnoise.csv")
+  , synth_emcal(nullptr)
+  , synth_ihcal(nullptr)
+  , synth_ohcal(nullptr)
+  , _shiftval(0)
+  , _shiftval_ihcal(0)
+  , _shiftval_ohcal(0)
 {
 }
 
@@ -90,33 +100,15 @@ CaloWaveFormSim::~CaloWaveFormSim()
 {
   delete hm;
   delete g4hitntuple;
+  delete synth_emcal;
+  delete synth_ihcal;
+  delete synth_ohcal;
 }
 
 int CaloWaveFormSim::Init(PHCompositeNode*)
 {
   rnd = new TRandom3(0);
-  //----------------------------------------------------------------------------------------------------
-  //Read in the noise file, this currently points to a tim local area file, 
-  //but a copy of this file is in the git repository.
-  //----------------------------------------------------------------------------------------------------
-  noise_midrad = new TTree("noise_midrad", "tree");
-  // noise->ReadFile("/gpfs/mnt/gpfs02/sphenix/user/trinn/fitting_algorithm_playing/slowneutronsignals/CaloAna/noise.csv", "a1:a2:a3:a4:a5:a6:a7:a8:a9:a10:a11:a12:a13:a14:a15:a16:a17:a18:a19:a20:a21:a22:a23:a24:a25:a26:a27:a28:a29:a30:a31");
-  noise_midrad->ReadFile("/gpfs/mnt/gpfs02/sphenix/user/trinn/sPHENIX_emcal_cosmics_sector0/noise_waveforms/medium_raddmgnoise.csv", "a1:a2:a3:a4:a5:a6:a7:a8:a9:a10:a11:a12:a13:a14:a15:a16:a17:a18:a19:a20:a21:a22:a23:a24:a25:a26:a27:a28:a29:a30:a31");
-
-  noise_lowrad = new TTree("noise_lowrad", "tree");
-  noise_lowrad->ReadFile("/gpfs/mnt/gpfs02/sphenix/user/trinn/sPHENIX_emcal_cosmics_sector0/noise_waveforms/low_raddmgnoise.csv", "a1:a2:a3:a4:a5:a6:a7:a8:a9:a10:a11:a12:a13:a14:a15:a16:a17:a18:a19:a20:a21:a22:a23:a24:a25:a26:a27:a28:a29:a30:a31");
-
-
-  noise_norad = new TTree("noise_norad", "tree");
-  noise_norad->ReadFile("/gpfs/mnt/gpfs02/sphenix/user/trinn/sPHENIX_emcal_cosmics_sector0/noise_waveforms/no_raddmgnoise.csv", "a1:a2:a3:a4:a5:a6:a7:a8:a9:a10:a11:a12:a13:a14:a15:a16:a17:a18:a19:a20:a21:a22:a23:a24:a25:a26:a27:a28:a29:a30:a31");
 
-  for (int i = 0; i < 31;i++)
-    {
-      noise_midrad->SetBranchAddress(Form("a%d",i+1),&noise_val_midrad[i]);
-      noise_lowrad->SetBranchAddress(Form("a%d",i+1),&noise_val_lowrad[i]);
-      noise_norad->SetBranchAddress(Form("a%d",i+1),&noise_val_norad[i]);
-    }
-  
   hm = new Fun4AllHistoManager(Name());
   outfile = new TFile(outfilename.c_str(), "RECREATE");
   g4hitntuple = new TTree("tree", "tree");
@@ -167,6 +159,32 @@ int CaloWaveFormSim::Init(PHCompositeNode*)
 
   h_template_ohcal = static_cast<TProfile*>(fin3->Get("waveform_template"));
 
+  //----------------------------------------------------------------------------------------------------
+  //Tabulate the templates once for waveform generation and set the timing
+  //of the prompt signal peak to be 4 time samples into the waveform
+  //----------------------------------------------------------------------------------------------------
+  synth_emcal = new CaloWaveformSynthesizer(h_template, 24576, 16);
+  synth_ihcal = new CaloWaveformSynthesizer(h_template_ihcal, 1536, 16);
+  synth_ohcal = new CaloWaveformSynthesizer(h_template_ohcal, 1536, 16);
+
+  _shiftval = 4 - synth_emcal->template_maximum_x(0, 31);
+  _shiftval_ihcal = 4 - synth_ihcal->template_maximum_x(0, 31);
+  _shiftval_ohcal = 4 - synth_ohcal->template_maximum_x(0, 31);
+
+  //----------------------------------------------------------------------------------------------------
+  //Read in the noise files once, these currently point to a tim local area file,
+  //but a copy of this file is in the git repository. Noise is rescaled around
+  //the 1500 ADC pedestal since the cosmic data gain is too high.
+  //----------------------------------------------------------------------------------------------------
+  bool noise_ok = synth_emcal->load_noise(noise_file_emcal, 31, 1500, 1. / 16);
+  noise_ok = synth_ihcal->load_noise(noise_file_ihcal, 31, 1500, 1. / 16) && noise_ok;
+  noise_ok = synth_ohcal->load_noise(noise_file_ohcal, 31, 1500, 1. / 16) && noise_ok;
+  assert(noise_ok);
+
+  waveforms_emcal.assign(24576, std::vector<float>(16));
+  waveforms_ihcal.assign(1536, std::vector<float>(16));
+  waveforms_ohcal.assign(1536, std::vector<float>(16));
+
 
   WaveformProcessing = new CaloWaveformProcessing();
   WaveformProcessing->set_processing_type(CaloWaveformProcessing::TEMPLATE);
@@ -227,74 +245,21 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   PHG4CylinderCellGeom *geo_raw = seggeo->GetFirstLayerCellGeom();
   PHG4CylinderCellGeom_Spacalv1 *geo = dynamic_cast<PHG4CylinderCellGeom_Spacalv1 *>(geo_raw);
 
-  float waveform[24576][16];
-  float waveform_ihcal[1536][16];
-  float waveform_ohcal[1536][16];
+  //---------------------------------------------------------
+  //Waveforms are accumulated sparsely by the synthesizers
+  //and fully overwritten below, only the per-tower sums
+  //need to be cleared here
+  //---------------------------------------------------------
   float tedep[24576];
   float tedep_ihcal[1536];
   float tedep_ohcal[1536];
-  for (int i = 0; i < 24576;i++)
-    {
-      for (int j = 0; j < 16;j++)
-	{
-	  m_waveform[i][j] = 0.0;
-	  waveform[i][j] = 0.0;
-	}     
-      m_extractedadc[i] = 0;
-      m_extractedtime[i] = 0;
-      m_toweradc[i] = 0;
-      m_ndep[i] = 0.0;
-      m_tedep[i] = 0.0;
-      tedep[i] = 0.0;
-    }
-
-
-  for (int i = 0; i < 1536;i++)
-    {
-      tedep_ihcal[i] = 0.0;  
-      m_extractedadc_ihcal[i] = 0;
-      m_extractedtime_ihcal[i] = 0;
-      tedep_ohcal[i] = 0.0;  
-      m_extractedadc_ohcal[i] = 0;
-      m_extractedtime_ohcal[i] = 0; 
-      m_toweradc_ihcal[i] = 0.0;
-      m_toweradc_ohcal[i] = 0.0;
-      for (int j = 0; j < 16;j++)
-	{
-	  m_waveform_ihcal[i][j] = 0;
-	  waveform_ihcal[i][j] = 0;
-	  m_waveform_ohcal[i][j] = 0;
-	  waveform_ohcal[i][j] = 0;
-	}
-    }
-
-  //---------------------------------------------------------
-  //Load in the template function as a TF1
-  //for use in waveform generation
-  //---------------------------------------------------------
-
-  TF1* f_fit = new TF1("f_fit",template_function,0,31,3);
-  f_fit->SetParameters(1,0,0);
-
-  TF1* f_fit_ihcal = new TF1("f_fit_ihcal",template_function_ihcal,0,31,3);
-  f_fit_ihcal->SetParameters(1,0,0);
-
-  TF1* f_fit_ohcal = new TF1("f_fit_ohcal",template_function_ohcal,0,31,3);
-  f_fit_ohcal->SetParameters(1,0,0);
-
-  //-----------------------------------------------------
-  //Set the timeing in of the prompt 
-  //signal peak to be 4 time samples into
-  //the waveform
-  //------------------------------------------------------
-  float _shiftval = 4-f_fit->GetMaximumX();
-  f_fit->SetParameters(1,_shiftval,0);
-
-  float _shiftval_ihcal = 4-f_fit_ihcal->GetMaximumX();
-  f_fit_ihcal->SetParameters(1,_shiftval_ihcal,0);
-
-  float _shiftval_ohcal = 4-f_fit_ohcal->GetMaximumX();
-  f_fit_ohcal->SetParameters(1,_shiftval_ohcal,0);
+  std::fill_n(tedep, 24576, 0.f);
+  std::fill_n(m_ndep, 24576, 0);
+  std::fill_n(m_toweradc, 24576, 0.f);
+  std::fill_n(tedep_ihcal, 1536, 0.f);
+  std::fill_n(tedep_ohcal, 1536, 0.f);
+  std::fill_n(m_toweradc_ihcal, 1536, 0.f);
+  std::fill_n(m_toweradc_ohcal, 1536, 0.f);
 
 
   ostringstream nodename;
@@ -385,7 +350,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
       float t0 = (hit_iter->second->get_t(0)) / 16.66667;   //Place waveform at the starting time of the G4hit, avoids issues caused by excessively long lived g4hits
       float tmax = 16.667*16;
       float tmin = -20;
-      f_fit->SetParameters(light_yield*26000,_shiftval+t0,0);            //Set the waveform template to match the expected signal from such a hit
       if (hit_iter->second->get_t(1) >= tmin && hit_iter->second->get_t(0) <= tmax) {
 	tedep[towernumber] += light_yield*26000;    // add g4hit adc deposition to the total deposition  
       }
@@ -394,10 +358,7 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
        //-------------------------------------------------------------------------------------------------------------
      if (hit_iter->second->get_edep()*26000 > 1 && hit_iter->second->get_t(1) >= tmin && hit_iter->second->get_t(0) <= tmax)
 	{
-	  for (int j = 0; j < 16;j++) // 16 is the number of time samples
-	    {
-	      waveform[towernumber][j] +=f_fit->Eval(j);
-	    }
+	  synth_emcal->add_pulse(towernumber, light_yield*26000, _shiftval+t0);   //Add the waveform template matching the expected signal from such a hit
 	  m_ndep[towernumber] +=1;
 	}
       m_phibin.push_back(phibin);
@@ -455,7 +416,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
       float t0 = (hit_iter->second->get_t(0)) / 16.66667;   //Place waveform at the starting time of the G4hit, avoids issues caused by excessively long lived g4hits
       float tmax = 16.667*16;
       float tmin = -20;
-      f_fit_ihcal->SetParameters(light_yield*2600,_shiftval_ihcal+t0,0);            //Set the waveform template to match the expected signal from such a hit
       if (hit_iter->second->get_t(1) >= tmin && hit_iter->second->get_t(0) <= tmax) {
 	tedep_ihcal[towernumber] += light_yield*2600;    // add g4hit adc deposition to the total deposition
       }
@@ -464,10 +424,7 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
        //-------------------------------------------------------------------------------------------------------------
      if (hit_iter->second->get_edep()*2600 > 1 &&hit_iter->second->get_t(1) >= tmin && hit_iter->second->get_t(0) <= tmax )
 	{
-	  for (int j = 0; j < 16;j++) // 16 is the number of time samples
-	    {
-	      waveform_ihcal[towernumber][j] +=f_fit_ihcal->Eval(j);
-	    }
+	  synth_ihcal->add_pulse(towernumber, light_yield*2600, _shiftval_ihcal+t0);   //Add the waveform template matching the expected signal from such a hit
 	}
     }
   }
@@ -526,7 +483,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
       float t0 = (hit_iter->second->get_t(0)) / 16.66667;   //Place waveform at the starting time of the G4hit, avoids issues caused by excessively long lived g4hits
       float tmax =16.667*16 ;
       float tmin = -20;
-      f_fit_ohcal->SetParameters(light_yield*5000,_shiftval_ohcal+t0,0);            //Set the waveform template to match the expected signal from such a hit
       if (hit_iter->second->get_t(0) < tmax && hit_iter->second->get_t(1) > tmin) {
 	  {
 	    tedep_ohcal[towernumber] += light_yield*5000;    // add g4hit adc deposition to the total deposition 
@@ -538,10 +494,7 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
 
      if (hit_iter->second->get_edep()*5000 > 1 && hit_iter->second->get_t(1) >= tmin && hit_iter->second->get_t(0) <= tmax)
 	{
-	  for (int j = 0; j < 16;j++) // 16 is the number of time samples
-	    {
-	      waveform_ohcal[towernumber][j] +=f_fit_ohcal->Eval(j);
-	    }
+	  synth_ohcal->add_pulse(towernumber, light_yield*5000, _shiftval_ohcal+t0);   //Add the waveform template matching the expected signal from such a hit
 	}
     }
   }
@@ -557,13 +510,13 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   //-----------------------------
   for (int i = 0; i < 24576;i++)
     {
-      int noise_waveform  = (int)rnd->Uniform(0,1990);
-      noise_midrad->GetEntry(noise_waveform);
+      const float* waveform = synth_emcal->waveform(i);
+      const float* noise = synth_emcal->random_noise(rnd);
       m_tedep[i] = tedep[i];
       for (int k = 0; k < 16;k++)
 	{
-	  m_waveform[i][k] = waveform[i][k]+(noise_val_midrad[k]-1500)/16.0+1500;
-	  // m_waveform[i][k] = waveform[i][k]+1500;
+	  m_waveform[i][k] = waveform[k]+noise[k];
+	  // m_waveform[i][k] = waveform[k]+1500;
 	}
     }
   //---------------------------
@@ -571,13 +524,13 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   //---------------------------
   for (int i = 0; i < 1536;i++)
     {
-      int noise_waveform  = (int)rnd->Uniform(0,1990);
-      noise_lowrad->GetEntry(noise_waveform);     
+      const float* waveform = synth_ihcal->waveform(i);
+      const float* noise = synth_ihcal->random_noise(rnd);
       m_tedep_ihcal[i] = tedep_ihcal[i];
       for (int k = 0; k < 16;k++)
 	{
-	   m_waveform_ihcal[i][k] = waveform_ihcal[i][k]+(noise_val_lowrad[k]-1500)/16.0+1500;
-	  // m_waveform_ihcal[i][k] = waveform_ihcal[i][k]+1500;
+	   m_waveform_ihcal[i][k] = waveform[k]+noise[k];
+	  // m_waveform_ihcal[i][k] = waveform[k]+1500;
 	}
     }
   //---------------------------
@@ -585,14 +538,13 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   //---------------------------
   for (int i = 0; i < 1536;i++)
     {
-      int noise_waveform  = (int)rnd->Uniform(0,1990);
-      noise_norad->GetEntry(noise_waveform);
-      
+      const float* waveform = synth_ohcal->waveform(i);
+      const float* noise = synth_ohcal->random_noise(rnd);
       m_tedep_ohcal[i] = tedep_ohcal[i];
       for (int k = 0; k < 16;k++)
 	{
-	  m_waveform_ohcal[i][k] = waveform_ohcal[i][k]+(noise_val_norad[k]-1500)/16.0+1500;
-	  // m_waveform_ohcal[i][k] = waveform_ohcal[i][k]+1500;
+	  m_waveform_ohcal[i][k] = waveform[k]+noise[k];
+	  // m_waveform_ohcal[i][k] = waveform[k]+1500;
 	}
     }
   std::vector<std::vector<float>> fitresults;
@@ -602,16 +554,10 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   //Process Waveforms:  EMCal
   //------------------------------------------
   {
-    std::vector<std::vector<float>> waveforms;
+    std::vector<std::vector<float>>& waveforms = waveforms_emcal;
     for (int i = 0; i < 24576;i++)
       {
-	std::vector<float>tmp;
-	for (int j = 0; j < 16;j++)
-	  {
-	    tmp.push_back(m_waveform[i][j]);
-	  }
-	waveforms.push_back(tmp);
-	tmp.clear();
+	std::copy(m_waveform[i], m_waveform[i] + 16, waveforms[i].begin());
       }
     fitresults =  WaveformProcessing->process_waveform(waveforms);
     for (int i = 0; i < 24576;i++)
@@ -619,7 +565,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
 	m_extractedadc[i] = fitresults.at(i).at(0);
 	m_extractedtime[i] = fitresults.at(i).at(1) - _shiftval;
       }
-    waveforms.clear();
   }
 
 
@@ -628,15 +573,11 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   //Process Waveforms:  IHCal
   //------------------------------------------
   {
-    std::vector<std::vector<float>> waveforms;
+    std::vector<std::vector<float>>& waveforms = waveforms_ihcal;
     for (int i = 0; i < 1536;i++)
       {
-	std::vector<float>tmp;
-	for (int j = 0; j < 16;j++)
-	  {
-	    tmp.push_back(m_waveform_ihcal[i][j]);
-	  }
-	waveforms.push_back(tmp);
+	std::vector<float>& tmp = waveforms[i];
+	std::copy(m_waveform_ihcal[i], m_waveform_ihcal[i] + 16, tmp.begin());
 
 	// int size2 = tmp.size();
 	// int n_peak = 0;
@@ -651,7 +592,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
 
 
 
-	tmp.clear();
       }
     fitresults_ihcal =  WaveformProcessing_ihcal->process_waveform(waveforms);
     for (int i = 0; i < 1536;i++)
@@ -659,7 +599,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
 	m_extractedadc_ihcal[i] = fitresults_ihcal.at(i).at(0);
 	m_extractedtime_ihcal[i] = fitresults_ihcal.at(i).at(1) - _shiftval_ihcal;
       }
-    waveforms.clear();
   }
 
 
@@ -668,15 +607,11 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   //Process Waveforms:  OHCal
   //------------------------------------------
   {
-    std::vector<std::vector<float>> waveforms;
+    std::vector<std::vector<float>>& waveforms = waveforms_ohcal;
     for (int i = 0; i < 1536;i++)
       {
-	std::vector<float>tmp;
-	for (int j = 0; j < 16;j++)
-	  {
-	    tmp.push_back(m_waveform_ohcal[i][j]);
-	  }
-	waveforms.push_back(tmp);
+	std::vector<float>& tmp = waveforms[i];
+	std::copy(m_waveform_ohcal[i], m_waveform_ohcal[i] + 16, tmp.begin());
 
 	
 	// int size2 = tmp.size();
@@ -690,7 +625,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
 	//   }
 
 	// m_npeaks_ohcal[i] = n_peak;
-	tmp.clear();
       }
 
 
@@ -702,7 +636,6 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
 	m_extractedadc_ohcal[i] = fitresults_ohcal.at(i).at(0);
 	m_extractedtime_ohcal[i] = fitresults_ohcal.at(i).at(1) - _shiftval_ohcal;
       }
-    waveforms.clear();
   }
 
 
@@ -768,6 +701,9 @@ int CaloWaveFormSim::process_g4hits(PHCompositeNode* topNode)
   m_primphi.clear();
   m_etabin.clear();
   m_phibin.clear();
+  synth_emcal->reset();
+  synth_ihcal->reset();
+  synth_ohcal->reset();
 
 
 
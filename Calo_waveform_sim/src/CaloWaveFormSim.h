@@ -8,6 +8,7 @@
 #include <g4detectors/PHG4CylinderGeomContainer.h>
 #include <g4detectors/PHG4FullProjSpacalCellReco.h>
 // Forward declarations
+class CaloWaveformSynthesizer;
 class Fun4AllHistoManager;
 class PHCompositeNode;
 class TFile;
@@ -42,6 +43,14 @@ class CaloWaveFormSim : public SubsysReco
 
   void Detector(const std::string &name) { detector = name; }
 
+  //! noise waveform files, text (.csv) or binary pools written by CaloWaveformSynthesizer::save_noise (.bin)
+  void set_noise_files(const std::string &emcal, const std::string &ihcal, const std::string &ohcal)
+  {
+    noise_file_emcal = emcal;
+    noise_file_ihcal = ihcal;
+    noise_file_ohcal = ohcal;
+  }
+
  protected:
   std::string detector;
   std::string outfilename;
@@ -105,14 +114,22 @@ class CaloWaveFormSim : public SubsysReco
   CaloWaveformProcessing* WaveformProcessing_ohcal;
 
   PHG4FullProjSpacalCellReco::LightCollectionModel light_collection_model;
-  TTree* noise_midrad;
-  TTree* noise_lowrad;
-  TTree* noise_norad;
-  float noise_val_midrad[31];
-  float noise_val_lowrad[31];
-  float noise_val_norad[31];
+  std::string noise_file_emcal;
+  std::string noise_file_ihcal;
+  std::string noise_file_ohcal;
   TRandom3* rnd;
 
+  CaloWaveformSynthesizer* synth_emcal;
+  CaloWaveformSynthesizer* synth_ihcal;
+  CaloWaveformSynthesizer* synth_ohcal;
+  float _shiftval;
+  float _shiftval_ihcal;
+  float _shiftval_ohcal;
+
+  std::vector<std::vector<float>> waveforms_emcal;
+  std::vector<std::vector<float>> waveforms_ihcal;
+  std::vector<std::vector<float>> waveforms_ohcal;
+
 };
 
 #endif
@@ -0,0 +1,213 @@
+#include "CaloWaveformSynthesizer.h"
+
+#include <TProfile.h>
+#include <TRandom.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+CaloWaveformSynthesizer::CaloWaveformSynthesizer(const TProfile *h_template, int nchannels, int nsamples, int oversample)
+  : _nchannels(nchannels)
+  , _nsamples(nsamples)
+  , _oversample(std::max(oversample, 1))
+  , _bin_x0(0)
+  , _bin_dx(1)
+  , _table_length(0)
+  , _table_x0(0)
+  , _noise_stride(0)
+  , _noise_size(0)
+{
+  assert(h_template);
+
+  const int nbins = h_template->GetNbinsX();
+  _bins.resize(nbins);
+  for (int i = 0; i < nbins; i++)
+  {
+    _bins[i] = h_template->GetBinContent(i + 1);
+  }
+  _bin_x0 = h_template->GetBinCenter(1);
+  _bin_dx = h_template->GetBinWidth(1);
+
+  // tabulate one sample beyond the first and last bin center, outside
+  // of that the template is constant and handled by template_value()
+  const double xlast = h_template->GetBinCenter(nbins);
+  _table_x0 = _bin_x0 - 1;
+  _table_length = static_cast<int>(std::ceil(xlast - _bin_x0)) + 3;
+  _table.resize((size_t) (_oversample + 1) * _table_length);
+  for (int p = 0; p <= _oversample; p++)
+  {
+    for (int i = 0; i < _table_length; i++)
+    {
+      _table[(size_t) p * _table_length + i] = template_value(_table_x0 + i + (double) p / _oversample);
+    }
+  }
+
+  _waveforms.assign((size_t) _nchannels * _nsamples, 0);
+  _is_touched.assign(_nchannels, 0);
+  _touched.reserve(_nchannels);
+}
+
+float CaloWaveformSynthesizer::template_value(double x) const
+{
+  const int nbins = _bins.size();
+  const double u = (x - _bin_x0) / _bin_dx;
+  if (!(u > 0)) return _bins[0];
+  if (u >= nbins - 1) return _bins[nbins - 1];
+
+  const int i = static_cast<int>(u);
+  const double f = u - i;
+  return _bins[i] + f * (_bins[i + 1] - _bins[i]);
+}
+
+double CaloWaveformSynthesizer::template_maximum_x(double xmin, double xmax) const
+{
+  const int nsteps = static_cast<int>((xmax - xmin) * _oversample);
+  double xbest = xmin;
+  float best = template_value(xmin);
+  for (int i = 1; i <= nsteps; i++)
+  {
+    const double x = xmin + (double) i / _oversample;
+    const float v = template_value(x);
+    if (v > best)
+    {
+      best = v;
+      xbest = x;
+    }
+  }
+  return xbest;
+}
+
+void CaloWaveformSynthesizer::add_pulse(float *waveform, float amplitude, double shift) const
+{
+  // fine-grid position of sample 0
+  const double c = (-shift - _table_x0) * _oversample;
+  const double k = std::floor(c);
+  const double base = std::floor(k / _oversample);
+
+  if (base >= 0 && base + _nsamples <= _table_length)
+  {
+    const int ibase = static_cast<int>(base);
+    const int phase = static_cast<int>(k - base * _oversample);
+    const float f = c - k;
+
+    const float *__restrict r0 = &_table[(size_t) phase * _table_length + ibase];
+    const float *__restrict r1 = &_table[(size_t) (phase + 1) * _table_length + ibase];
+    float *__restrict w = waveform;
+    const float a0 = amplitude * (1 - f);
+    const float a1 = amplitude * f;
+    for (int j = 0; j < _nsamples; j++)
+    {
+      w[j] += a0 * r0[j] + a1 * r1[j];
+    }
+    return;
+  }
+
+  // pulse (partly) outside of the tabulated range
+  for (int j = 0; j < _nsamples; j++)
+  {
+    waveform[j] += amplitude * template_value(j - shift);
+  }
+}
+
+void CaloWaveformSynthesizer::add_pulse(int channel, float amplitude, double shift)
+{
+  assert(channel >= 0 && channel < _nchannels);
+  if (!_is_touched[channel])
+  {
+    _is_touched[channel] = 1;
+    _touched.push_back(channel);
+  }
+  add_pulse(&_waveforms[(size_t) channel * _nsamples], amplitude, shift);
+}
+
+void CaloWaveformSynthesizer::reset()
+{
+  for (int channel : _touched)
+  {
+    std::fill_n(&_waveforms[(size_t) channel * _nsamples], _nsamples, 0.f);
+    _is_touched[channel] = 0;
+  }
+  _touched.clear();
+}
+
+bool CaloWaveformSynthesizer::load_noise(const std::string &filename, int nsamples_per_line, float offset, float scale)
+{
+  _noise.clear();
+  _noise_size = 0;
+
+  const bool is_binary = (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0);
+  if (is_binary)
+  {
+    std::ifstream fin(filename, std::ios::binary);
+    int32_t header[2] = {0, 0};
+    if (!fin.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] <= 0 || header[1] < 0)
+    {
+      std::cout << __PRETTY_FUNCTION__ << " could not read noise pool " << filename << std::endl;
+      return false;
+    }
+    _noise_stride = header[0];
+    _noise.resize((size_t) header[0] * header[1]);
+    if (!fin.read(reinterpret_cast<char *>(_noise.data()), _noise.size() * sizeof(float)))
+    {
+      std::cout << __PRETTY_FUNCTION__ << " truncated noise pool " << filename << std::endl;
+      _noise.clear();
+      return false;
+    }
+    _noise_size = header[1];
+  }
+  else
+  {
+    std::ifstream fin(filename);
+    if (!fin.is_open())
+    {
+      std::cout << __PRETTY_FUNCTION__ << " could not open noise file " << filename << std::endl;
+      return false;
+    }
+    _noise_stride = nsamples_per_line;
+    std::vector<float> line_values(nsamples_per_line);
+    std::string line;
+    while (std::getline(fin, line))
+    {
+      std::replace(line.begin(), line.end(), ',', ' ');
+      std::istringstream iss(line);
+      int n = 0;
+      while (n < nsamples_per_line && iss >> line_values[n]) n++;
+      if (n < nsamples_per_line) continue;  // header or malformed line
+
+      for (int i = 0; i < nsamples_per_line; i++)
+      {
+        _noise.push_back(offset + scale * (line_values[i] - offset));
+      }
+      _noise_size++;
+    }
+  }
+
+  if (_noise_stride < _nsamples)
+  {
+    std::cout << __PRETTY_FUNCTION__ << " noise waveforms in " << filename << " have "
+              << _noise_stride << " samples, need " << _nsamples << std::endl;
+    _noise.clear();
+    _noise_size = 0;
+    return false;
+  }
+  return _noise_size > 0;
+}
+
+bool CaloWaveformSynthesizer::save_noise(const std::string &filename) const
+{
+  std::ofstream fout(filename, std::ios::binary);
+  const int32_t header[2] = {_noise_stride, _noise_size};
+  fout.write(reinterpret_cast<const char *>(header), sizeof(header));
+  fout.write(reinterpret_cast<const char *>(_noise.data()), _noise.size() * sizeof(float));
+  return fout.good();
+}
+
+const float *CaloWaveformSynthesizer::random_noise(TRandom *rng) const
+{
+  return &_noise[(size_t) rng->Integer(_noise_size) * _noise_stride];
+}
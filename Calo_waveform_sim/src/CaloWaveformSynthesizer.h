@@ -0,0 +1,80 @@
+#ifndef CALOWAVEFORMSYNTHESIZER_H__
+#define CALOWAVEFORMSYNTHESIZER_H__
+
+#include <string>
+#include <vector>
+
+class TProfile;
+class TRandom;
+
+//! Waveform synthesis for one calorimeter.
+//!
+//! The pulse template is tabulated once on a fine time grid (1/oversample of
+//! a sample), stored phase-major so that a pulse at an arbitrary time shift
+//! is a contiguous shift-and-scale of two table rows. Waveforms of all
+//! channels live in one flat buffer; only channels that received a hit are
+//! touched and reset between events. Noise waveforms are read once into a
+//! contiguous in-memory pool.
+class CaloWaveformSynthesizer
+{
+ public:
+  CaloWaveformSynthesizer(const TProfile *h_template, int nchannels, int nsamples = 16, int oversample = 64);
+  virtual ~CaloWaveformSynthesizer() {}
+
+  int get_nchannels() const { return _nchannels; }
+  int get_nsamples() const { return _nsamples; }
+
+  //! template value at x (in samples), same convention as TProfile::Interpolate
+  float template_value(double x) const;
+
+  //! position of the template maximum within [xmin, xmax], on the fine grid
+  double template_maximum_x(double xmin, double xmax) const;
+
+  //! add amplitude * T(j - shift) to samples j = 0 .. nsamples - 1 of a channel
+  void add_pulse(int channel, float amplitude, double shift);
+
+  //! add amplitude * T(j - shift) to an external waveform of nsamples samples
+  void add_pulse(float *waveform, float amplitude, double shift) const;
+
+  //! zero the channels touched since the last reset
+  void reset();
+
+  const float *waveform(int channel) const { return &_waveforms[(size_t) channel * _nsamples]; }
+  const std::vector<int> &touched_channels() const { return _touched; }
+
+  //! load noise waveforms from a comma or blank separated text file, or from
+  //! a raw float file written by save_noise() if the name ends in ".bin".
+  //! Stored samples are offset + scale * (value - offset).
+  bool load_noise(const std::string &filename, int nsamples_per_line = 31, float offset = 1500, float scale = 1);
+  bool save_noise(const std::string &filename) const;
+  int get_noise_pool_size() const { return _noise_size; }
+
+  //! random noise waveform from the pool, the pool must not be empty
+  const float *random_noise(TRandom *rng) const;
+
+ private:
+  int _nchannels;
+  int _nsamples;
+  int _oversample;
+
+  // template bin contents, interpolated linearly between bin centers
+  std::vector<float> _bins;
+  double _bin_x0;
+  double _bin_dx;
+
+  // fine-grid template, _table[p * _table_length + i] = T(_table_x0 + i + p / oversample)
+  // for phases p = 0 .. oversample; phase oversample equals phase 0 shifted by one sample
+  std::vector<float> _table;
+  int _table_length;
+  double _table_x0;
+
+  std::vector<float> _waveforms;
+  std::vector<int> _touched;
+  std::vector<char> _is_touched;
+
+  std::vector<float> _noise;
+  int _noise_stride;
+  int _noise_size;
+};
+
+#endif
@@ -10,6 +10,7 @@
 /* STL includes */
 #include <math.h>
 #include <map>
+#include <vector>
 
 /*HepMC include */
 #include <phhepmc/PHHepMCGenEvent.h>
@@ -115,6 +116,52 @@ private:
    * output ROOT Tree */
   std::map< std::string , float > _map_event_branches;
 
+  /** Tower above threshold with position looked up once per event */
+  struct TowerInfo
+  {
+    RawTowerDefs::CalorimeterId calo;
+    float eta;
+    float phi;
+    float energy;
+  };
+
+  /** Tower near a jet axis */
+  struct ConeTower
+  {
+    float delta_R;
+    float energy;
+    bool emcal;
+
+    bool operator<( const ConeTower& other ) const
+    {
+      return delta_R < other.delta_R;
+    }
+  };
+
+  /** Towers of all calorimeters in this event, in calorimeter and tower order */
+  std::vector< TowerInfo > _towers;
+
+  /** Indices of _towers per eta-phi cell, cells are at least _tower_grid_size wide */
+  std::vector< std::vector< unsigned > > _tower_grid;
+  float _tower_grid_size;
+  int _tower_grid_neta;
+  int _tower_grid_nphi;
+  float _tower_grid_etamin;
+
+  /** Collect towers above energy threshold and sort them into the eta-phi grid */
+  void IndexTowers( type_map_cdata*, float );
+
+  /** Towers within delta_R_max (up to the grid cell size) of eta, phi, sorted by delta R */
+  void GetConeTowers( float, float, float, std::vector< ConeTower >& );
+
+  /** Energy in cones, energy weighted mean and rms delta R and radius containing
+   * the fraction e_frac of e_ref, from towers sorted by delta R. The radius is
+   * found in n_steps steps up to the largest cone. */
+  void CalculateJetShape( const std::vector< ConeTower >&, bool emcal_only,
+                          const std::vector< float >& cones, std::vector< float >& e_cones,
+                          float e_ref, float e_frac, int n_steps,
+                          float& r_frac, float& radius, float& rms );
+
   int AddTrueTauTag( type_map_tcan&, PHHepMCGenEventMap* );
 
   int AddJetInformation( type_map_tcan&, JetMap*, type_map_cdata* );
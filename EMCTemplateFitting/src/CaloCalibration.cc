@@ -1,5 +1,6 @@
 #include "CaloCalibration.h"
 
+#include "CaloPulseShapeFitter.h"
 #include "PROTOTYPE4_FEM.h"
 #include "RawTower_Prototype4.h"
 
@@ -44,10 +45,18 @@ CaloCalibration::CaloCalibration(const std::string &name)
   , _raw_tower_node_prefix("RAW")
   , _calib_params(name)
   , _fit_type(kPowerLawDoubleExpWithGlobalFitConstraint)
+  , _fast_fit(false)
+  , _nthreads(1)
+  , _fitter(nullptr)
 {
   SetDefaultParameters(_calib_params);
 }
 
+CaloCalibration::~CaloCalibration()
+{
+  delete _fitter;
+}
+
 //_____________________________________
 int CaloCalibration::InitRun(PHCompositeNode *topNode)
 {
@@ -60,6 +69,16 @@ int CaloCalibration::InitRun(PHCompositeNode *topNode)
     _calib_params.Print();
   }
 
+  delete _fitter;
+  _fitter = nullptr;
+  if (_fast_fit and _fit_type != kPeakSample)
+  {
+    _fitter = new CaloPulseShapeFitter(_fit_type == kPowerLawExp
+                                           ? CaloPulseShapeFitter::kPowerLawExp
+                                           : CaloPulseShapeFitter::kPowerLawDoubleExp,
+                                       _nthreads);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -139,9 +158,22 @@ int CaloCalibration::process_event(PHCompositeNode *topNode)
       double pedstal = NAN;
       map<int, double> parameters_io;
 
-      PROTOTYPE4_FEM::SampleFit_PowerLawDoubleExp(vec_signal_samples, peak,
-                                                  peak_sample, pedstal,
-                                                  parameters_io, Verbosity());
+      if (_fitter)
+      {
+        CaloPulseShapeFitter::Result result;
+        _fitter->release_parameters();
+        _fitter->FitChannel(vec_signal_samples.data(), result);
+        for (int i = 0; i < _fitter->get_nparameters(); ++i)
+        {
+          parameters_io[i] = result.parameters[i];
+        }
+      }
+      else
+      {
+        PROTOTYPE4_FEM::SampleFit_PowerLawDoubleExp(vec_signal_samples, peak,
+                                                    peak_sample, pedstal,
+                                                    parameters_io, Verbosity());
+      }
       //    std::map<int, double> &parameters_io,  //! IO for fullset of
       //    parameters. If a parameter exist and not an NAN, the fit parameter
       //    will be fixed to that value. The order of the parameters are
@@ -184,14 +216,20 @@ int CaloCalibration::process_event(PHCompositeNode *topNode)
     }
   }
 
+  if (_fitter)
+  {
+    FastFit(parameters_constraints);
+  }
+
   const double calib_const_scale =
       _calib_params.get_double_param("calib_const_scale");
   const bool use_chan_calibration =
       _calib_params.get_int_param("use_chan_calibration") > 0;
 
+  int towernumber = 0;
   RawTowerContainer::Range begin_end = _raw_towers->getTowers();
   RawTowerContainer::Iterator rtiter;
-  for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+  for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter, ++towernumber)
   {
     RawTowerDefs::keytype key = rtiter->first;
     RawTower_Prototype4 *raw_tower =
@@ -225,42 +263,52 @@ int CaloCalibration::process_event(PHCompositeNode *topNode)
     double peak_sample = NAN;
     double pedstal = NAN;
 
-    switch (_fit_type)
+    if (_fitter)
     {
-    case kPowerLawExp:
-      PROTOTYPE4_FEM::SampleFit_PowerLawExp(vec_signal_samples, peak,
-                                            peak_sample, pedstal, Verbosity());
-      break;
+      const CaloPulseShapeFitter::Result &result = _fit_results[towernumber];
+      peak = result.peak;
+      peak_sample = result.peak_sample;
+      pedstal = result.pedestal;
+    }
+    else
+    {
+      switch (_fit_type)
+      {
+      case kPowerLawExp:
+        PROTOTYPE4_FEM::SampleFit_PowerLawExp(vec_signal_samples, peak,
+                                              peak_sample, pedstal, Verbosity());
+        break;
 
-    case kPeakSample:
-      PROTOTYPE4_FEM::SampleFit_PeakSample(vec_signal_samples, peak,
-                                           peak_sample, pedstal, Verbosity());
-      break;
+      case kPeakSample:
+        PROTOTYPE4_FEM::SampleFit_PeakSample(vec_signal_samples, peak,
+                                             peak_sample, pedstal, Verbosity());
+        break;
 
-    case kPowerLawDoubleExp:
-    {
-      map<int, double> parameters_io;
+      case kPowerLawDoubleExp:
+      {
+        map<int, double> parameters_io;
 
-      PROTOTYPE4_FEM::SampleFit_PowerLawDoubleExp(vec_signal_samples, peak,
-                                                  peak_sample, pedstal,
-                                                  parameters_io, Verbosity());
-    }
-    break;
+        PROTOTYPE4_FEM::SampleFit_PowerLawDoubleExp(vec_signal_samples, peak,
+                                                    peak_sample, pedstal,
+                                                    parameters_io, Verbosity());
+      }
+      break;
 
-    case kPowerLawDoubleExpWithGlobalFitConstraint:
-    {
-      map<int, double> parameters_io(parameters_constraints);
+      case kPowerLawDoubleExpWithGlobalFitConstraint:
+      {
+        map<int, double> parameters_io(parameters_constraints);
 
-      PROTOTYPE4_FEM::SampleFit_PowerLawDoubleExp(vec_signal_samples, peak,
-                                                  peak_sample, pedstal,
-                                                  parameters_io, Verbosity());
-    }
-    break;
-    default:
-      cout << __PRETTY_FUNCTION__ << " - FATAL error - unkown fit type "
-           << _fit_type << endl;
-      exit(3);
+        PROTOTYPE4_FEM::SampleFit_PowerLawDoubleExp(vec_signal_samples, peak,
+                                                    peak_sample, pedstal,
+                                                    parameters_io, Verbosity());
+      }
       break;
+      default:
+        cout << __PRETTY_FUNCTION__ << " - FATAL error - unkown fit type "
+             << _fit_type << endl;
+        exit(3);
+        break;
+      }
     }
 
     // store the result - raw_tower
@@ -303,6 +351,38 @@ int CaloCalibration::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+//_______________________________________
+void CaloCalibration::FastFit(const map<int, double> &parameters_constraints)
+{
+  _fitter->release_parameters();
+  if (_fit_type == kPowerLawDoubleExpWithGlobalFitConstraint)
+  {
+    _fitter->fix_parameters(parameters_constraints);
+  }
+
+  const int nsamples = RawTower_Prototype4::NSAMPLES;
+  const int ntowers = _raw_towers->size();
+  _waveform_block.resize((size_t) ntowers * nsamples);
+  _fit_results.resize(ntowers);
+
+  float *block = _waveform_block.data();
+  RawTowerContainer::Range begin_end = _raw_towers->getTowers();
+  RawTowerContainer::Iterator rtiter;
+  for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+  {
+    RawTower_Prototype4 *raw_tower =
+        dynamic_cast<RawTower_Prototype4 *>(rtiter->second);
+    assert(raw_tower);
+    for (int i = 0; i < nsamples; i++)
+    {
+      block[i] = raw_tower->get_signal_samples(i);
+    }
+    block += nsamples;
+  }
+
+  _fitter->Fit(_waveform_block.data(), ntowers, _fit_results.data());
+}
+
 //_______________________________________
 void CaloCalibration::CreateNodeTree(PHCompositeNode *topNode)
 {
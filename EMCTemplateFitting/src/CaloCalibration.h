@@ -6,11 +6,14 @@
 //* Unpacks raw HCAL PRDF files *//
 // Abhisek Sen
 
+#include "CaloPulseShapeFitter.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <phparameter/PHParameters.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class RawTowerContainer;
@@ -19,6 +22,7 @@ class CaloCalibration : public SubsysReco
 {
  public:
   CaloCalibration(const std::string &name);
+  virtual ~CaloCalibration();
 
   int InitRun(PHCompositeNode *topNode);
 
@@ -79,6 +83,14 @@ class CaloCalibration : public SubsysReco
 
   void SetFitType(FitMethodType t) { _fit_type = t; }
 
+  //! fit kPowerLawExp, kPowerLawDoubleExp and
+  //! kPowerLawDoubleExpWithGlobalFitConstraint with CaloPulseShapeFitter
+  //! (analytic gradients, all towers in one batch) instead of TGraph::Fit
+  void set_fast_fit(bool fast) { _fast_fit = fast; }
+
+  //! threads for the batch fit of set_fast_fit
+  void set_nthreads(int nthreads) { _nthreads = nthreads; }
+
  private:
   RawTowerContainer *_calib_towers;
   RawTowerContainer *_raw_towers;
@@ -94,6 +106,16 @@ class CaloCalibration : public SubsysReco
 
   FitMethodType _fit_type;
 
+  bool _fast_fit;
+  int _nthreads;
+  CaloPulseShapeFitter *_fitter;
+  //! [tower][sample] waveforms and fit results, reused across events
+  std::vector<float> _waveform_block;
+  std::vector<CaloPulseShapeFitter::Result> _fit_results;
+
+  //! batch fit of all raw towers into _fit_results, in tower order
+  void FastFit(const std::map<int, double> &parameters_constraints);
+
   //! load the default parameter to param
   void SetDefaultParameters(PHParameters &param);
 };
@@ -0,0 +1,540 @@
+#include "CaloPulseShapeFitter.h"
+
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+  //! solve a * x = b for the n x n system, Gaussian elimination with partial pivoting
+  bool solve(int n, double a[][CaloPulseShapeFitter::NPARAMETERS], double *b, double *x)
+  {
+    for (int k = 0; k < n; k++)
+    {
+      int pivot = k;
+      for (int i = k + 1; i < n; i++)
+      {
+        if (std::fabs(a[i][k]) > std::fabs(a[pivot][k])) pivot = i;
+      }
+      if (a[pivot][k] == 0 || !std::isfinite(a[pivot][k])) return false;
+      if (pivot != k)
+      {
+        for (int j = 0; j < n; j++) std::swap(a[k][j], a[pivot][j]);
+        std::swap(b[k], b[pivot]);
+      }
+      for (int i = k + 1; i < n; i++)
+      {
+        const double f = a[i][k] / a[k][k];
+        for (int j = k; j < n; j++) a[i][j] -= f * a[k][j];
+        b[i] -= f * b[k];
+      }
+    }
+    for (int i = n - 1; i >= 0; i--)
+    {
+      double sum = b[i];
+      for (int j = i + 1; j < n; j++) sum -= a[i][j] * x[j];
+      x[i] = sum / a[i][i];
+    }
+    return true;
+  }
+
+  //! drop point if touching max or low limit on ADCs, as in PROTOTYPE4_FEM
+  template <typename T>
+  bool valid_sample(T y)
+  {
+    return y > 10 and y < ((1 << 14) - 10) and std::isnormal(static_cast<double>(y));
+  }
+}  // namespace
+
+CaloPulseShapeFitter::CaloPulseShapeFitter(ShapeType shape, int nthreads)
+  : _shape(shape)
+  , _nthreads(std::max(nthreads, 1))
+  , _max_iterations(200)
+  , _tolerance(1e-10)
+{
+  release_parameters();
+
+  _workspaces.resize(_nthreads);
+  for (auto &ws : _workspaces)
+  {
+    ws.x.resize(NSAMPLES);
+    ws.y.resize(NSAMPLES);
+  }
+
+  if (_nthreads > 1)
+  {
+    _executor.reset(new ROOT::TThreadExecutor(_nthreads));
+  }
+}
+
+CaloPulseShapeFitter::~CaloPulseShapeFitter() = default;
+
+void CaloPulseShapeFitter::fix_parameter(int ipar, double value)
+{
+  assert(ipar >= 0);
+  assert(ipar < NPARAMETERS);
+  _fixed[ipar] = true;
+  _fixed_values[ipar] = value;
+}
+
+void CaloPulseShapeFitter::fix_parameters(const std::map<int, double> &parameters)
+{
+  for (const auto &p : parameters)
+  {
+    fix_parameter(p.first, p.second);
+  }
+}
+
+void CaloPulseShapeFitter::release_parameters()
+{
+  std::fill(_fixed, _fixed + NPARAMETERS, false);
+  std::fill(_fixed_values, _fixed_values + NPARAMETERS, 0.);
+}
+
+double CaloPulseShapeFitter::shape_value(ShapeType shape, double x, const double *par,
+                                         double *gradient)
+{
+  const int npar = shape == kPowerLawExp ? 5 : 7;
+  const double pedestal = par[4];
+  const double d = x - par[1];
+  if (gradient)
+  {
+    std::fill(gradient, gradient + npar, 0.);
+    gradient[4] = 1;
+  }
+  if (d <= 0) return pedestal;
+
+  const double logd = std::log(d);
+  const double power = par[2];
+
+  if (shape == kPowerLawExp)
+  {
+    // par[0] * d^par[2] * exp(-d * par[3])
+    const double shape0 = std::exp(power * logd - d * par[3]);
+    const double signal = par[0] * shape0;
+    if (gradient)
+    {
+      gradient[0] = shape0;
+      gradient[1] = signal * (par[3] - power / d);
+      gradient[2] = signal * logd;
+      gradient[3] = -signal * d;
+    }
+    return pedestal + signal;
+  }
+
+  // each exponential normalized to 1 at its peak time par[3] / par[6]:
+  // h_i = exp(power * (1 + log(d) - log(tau_i) - d / tau_i))
+  const double ratio = par[5];
+  const double tau1 = par[3];
+  const double tau2 = par[6];
+  const double u1 = 1 + logd - std::log(tau1) - d / tau1;
+  const double u2 = 1 + logd - std::log(tau2) - d / tau2;
+  const double h1 = std::exp(power * u1);
+  const double h2 = std::exp(power * u2);
+  const double g1 = (1. - ratio) * h1;
+  const double g2 = ratio * h2;
+  const double signal = par[0] * (g1 + g2);
+  if (gradient)
+  {
+    gradient[0] = g1 + g2;
+    gradient[1] = -par[0] * power * (g1 * (1. / d - 1. / tau1) + g2 * (1. / d - 1. / tau2));
+    gradient[2] = par[0] * (g1 * u1 + g2 * u2);
+    gradient[3] = par[0] * g1 * power * (d / (tau1 * tau1) - 1. / tau1);
+    gradient[5] = par[0] * (h2 - h1);
+    gradient[6] = par[0] * g2 * power * (d / (tau2 * tau2) - 1. / tau2);
+  }
+  return pedestal + signal;
+}
+
+double CaloPulseShapeFitter::chi2(const Workspace &ws, int npoints, const double *par) const
+{
+  double sum = 0;
+  for (int i = 0; i < npoints; i++)
+  {
+    const double r = ws.y[i] - shape_value(_shape, ws.x[i], par);
+    sum += r * r;
+  }
+  return sum;
+}
+
+template <typename T>
+int CaloPulseShapeFitter::initialize(const T *samples, Workspace &ws, double *par,
+                                     double *lower, double *upper) const
+{
+  int npoints = 0;
+  double pedestal = 0;
+  double peakval = 0;
+  int peakPos = 0;
+
+  if (_shape == kPowerLawExp)
+  {
+    // guesses from all samples, then drop the invalid ones
+    pedestal = samples[0];
+    peakval = pedestal;
+    for (int i = 0; i < NSAMPLES; i++)
+    {
+      if (std::fabs(samples[i] - pedestal) > std::fabs(peakval - pedestal))
+      {
+        peakval = samples[i];
+        peakPos = i;
+      }
+    }
+    peakval -= pedestal;
+
+    const double risetime = 4;
+    par[0] = peakval;
+    par[1] = std::max(peakPos - risetime, 0.);
+    par[2] = 4.;
+    par[3] = 1.5;
+    par[4] = pedestal;
+    lower[0] = peakval * 0.5;
+    upper[0] = peakval * 10;
+    lower[1] = 0;
+    upper[1] = NSAMPLES;
+    lower[2] = 0;
+    upper[2] = 10.;
+    lower[3] = 0;
+    upper[3] = 10;
+    lower[4] = pedestal - std::fabs(peakval);
+    upper[4] = pedestal + std::fabs(peakval);
+
+    for (int i = 0; i < NSAMPLES; i++)
+    {
+      if (!valid_sample(samples[i])) continue;
+      ws.x[npoints] = i;
+      ws.y[npoints] = samples[i];
+      ++npoints;
+    }
+  }
+  else
+  {
+    // drop the invalid samples, then guesses from the remaining ones
+    for (int i = 0; i < NSAMPLES; i++)
+    {
+      if (!valid_sample(samples[i])) continue;
+      ws.x[npoints] = i;
+      ws.y[npoints] = samples[i];
+      ++npoints;
+    }
+    if (npoints == 0) return 0;
+
+    const double risetime = 2;
+    pedestal = ws.y[0];
+    peakval = pedestal;
+    const int nsearch = std::min(npoints, static_cast<int>(NSAMPLES - risetime * 3));
+    for (int i = 0; i < nsearch; i++)
+    {
+      if (std::fabs(ws.y[i] - pedestal) > std::fabs(peakval - pedestal))
+      {
+        peakval = ws.y[i];
+        peakPos = i;
+      }
+    }
+    peakval -= pedestal;
+
+    par[0] = peakval * .7;
+    lower[0] = peakval * -1.5;
+    upper[0] = peakval * 1.5;
+    par[1] = peakPos - risetime;
+    lower[1] = peakPos - 3 * risetime;
+    upper[1] = peakPos + risetime;
+    par[2] = 2.;
+    lower[2] = 1;
+    upper[2] = 5.;
+    par[3] = 5;
+    lower[3] = risetime * .5;
+    upper[3] = risetime * 4;
+    par[4] = pedestal;
+    lower[4] = pedestal - std::fabs(peakval);
+    upper[4] = pedestal + std::fabs(peakval);
+    par[5] = .3;
+    lower[5] = 0;
+    upper[5] = 1;
+    par[6] = 5;
+    lower[6] = risetime * .5;
+    upper[6] = risetime * 4;
+  }
+
+  for (int i = 0; i < get_nparameters(); i++)
+  {
+    if (lower[i] > upper[i]) std::swap(lower[i], upper[i]);
+    if (_fixed[i])
+    {
+      par[i] = lower[i] = upper[i] = _fixed_values[i];
+    }
+    else
+    {
+      par[i] = std::min(std::max(par[i], lower[i]), upper[i]);
+    }
+  }
+  return npoints;
+}
+
+double CaloPulseShapeFitter::find_peak(const double *par, double xmin, double xmax) const
+{
+  if (!(xmax > xmin)) return xmin;
+
+  // extremum in the direction of the amplitude
+  const double sign = par[0] > 0 ? 1 : -1;
+  auto f = [&](double x) { return sign * shape_value(_shape, x, par); };
+
+  // coarse scan with the TF1 default of 100 points, then golden section
+  static const int npx = 100;
+  const double dx = (xmax - xmin) / npx;
+  int ibest = 0;
+  double fbest = f(xmin);
+  for (int i = 1; i <= npx; i++)
+  {
+    const double fi = f(xmin + i * dx);
+    if (fi > fbest)
+    {
+      fbest = fi;
+      ibest = i;
+    }
+  }
+
+  double a = std::max(xmin, xmin + (ibest - 1) * dx);
+  double b = std::min(xmax, xmin + (ibest + 1) * dx);
+  static const double golden = 0.5 * (std::sqrt(5.) - 1);
+  double c = b - golden * (b - a);
+  double d = a + golden * (b - a);
+  double fc = f(c);
+  double fd = f(d);
+  while (b - a > 1e-10 * std::max(1., std::fabs(a)))
+  {
+    if (fc > fd)
+    {
+      b = d;
+      d = c;
+      fd = fc;
+      c = b - golden * (b - a);
+      fc = f(c);
+    }
+    else
+    {
+      a = c;
+      c = d;
+      fc = fd;
+      d = a + golden * (b - a);
+      fd = f(d);
+    }
+  }
+  return 0.5 * (a + b);
+}
+
+int CaloPulseShapeFitter::minimize(const Workspace &ws, int npoints, double *par,
+                                   const double *lower, const double *upper,
+                                   double &chi2_min) const
+{
+  const int npar = get_nparameters();
+
+  int nfree = 0;
+  int free_index[NPARAMETERS];
+  for (int i = 0; i < npar; i++)
+  {
+    if (lower[i] < upper[i]) free_index[nfree++] = i;
+  }
+
+  double current_chi2 = npoints > 0 ? chi2(ws, npoints, par) : NAN;
+  int status = npoints > nfree ? 1 : -1;
+
+  double lambda = 1e-3;
+  for (int iter = 0; status == 1 && iter < _max_iterations; iter++)
+  {
+    // normal equations J^T J and J^T r over the free parameters
+    double jtj[NPARAMETERS][NPARAMETERS] = {{0}};
+    double jtr[NPARAMETERS] = {0};
+    double gradient[NPARAMETERS];
+    for (int i = 0; i < npoints; i++)
+    {
+      const double r = ws.y[i] - shape_value(_shape, ws.x[i], par, gradient);
+      for (int a = 0; a < nfree; a++)
+      {
+        const double ja = gradient[free_index[a]];
+        jtr[a] += ja * r;
+        for (int b = a; b < nfree; b++)
+        {
+          jtj[a][b] += ja * gradient[free_index[b]];
+        }
+      }
+    }
+    for (int a = 0; a < nfree; a++)
+    {
+      for (int b = 0; b < a; b++) jtj[a][b] = jtj[b][a];
+    }
+
+    // parameters sitting on a limit and pulled across it are held for this step
+    int nactive = 0;
+    int active[NPARAMETERS];
+    for (int a = 0; a < nfree; a++)
+    {
+      const int i = free_index[a];
+      if ((par[i] <= lower[i] && jtr[a] < 0) || (par[i] >= upper[i] && jtr[a] > 0)) continue;
+      active[nactive++] = a;
+    }
+    if (nactive == 0)
+    {
+      status = 0;
+      break;
+    }
+
+    bool improved = false;
+    double trial_chi2 = current_chi2;
+    for (int attempt = 0; attempt < 12 && !improved; attempt++)
+    {
+      double damped[NPARAMETERS][NPARAMETERS];
+      double rhs[NPARAMETERS];
+      double step[NPARAMETERS];
+      for (int a = 0; a < nactive; a++)
+      {
+        for (int b = 0; b < nactive; b++) damped[a][b] = jtj[active[a]][active[b]];
+        damped[a][a] += lambda * std::max(jtj[active[a]][active[a]], 1e-12);
+        rhs[a] = jtr[active[a]];
+      }
+      if (!solve(nactive, damped, rhs, step))
+      {
+        lambda *= 10;
+        continue;
+      }
+
+      // projected step: parameters stay within their limits, as with MINUIT
+      double trial[NPARAMETERS];
+      std::copy(par, par + NPARAMETERS, trial);
+      for (int a = 0; a < nactive; a++)
+      {
+        const int i = free_index[active[a]];
+        trial[i] = std::min(std::max(par[i] + step[a], lower[i]), upper[i]);
+      }
+      trial_chi2 = chi2(ws, npoints, trial);
+      if (trial_chi2 <= current_chi2)
+      {
+        improved = true;
+        std::copy(trial, trial + NPARAMETERS, par);
+        lambda = std::max(lambda / 10., 1e-12);
+      }
+      else
+      {
+        lambda *= 10;
+      }
+    }
+
+    if (!improved)
+    {
+      // no downhill step left: we are at the minimum within precision
+      status = 0;
+      break;
+    }
+    const double dchi2 = current_chi2 - trial_chi2;
+    current_chi2 = trial_chi2;
+    if (dchi2 <= _tolerance * std::max(current_chi2, 1.))
+    {
+      status = 0;
+    }
+  }
+
+
+  chi2_min = current_chi2;
+  return status;
+}
+
+template <typename T>
+void CaloPulseShapeFitter::fit(const T *samples, Result &result, int ithread)
+{
+  Workspace &ws = _workspaces[ithread];
+
+  double par[NPARAMETERS] = {0};
+  double lower[NPARAMETERS] = {0};
+  double upper[NPARAMETERS] = {0};
+  const int npoints = initialize(samples, ws, par, lower, upper);
+
+  double start[NPARAMETERS];
+  std::copy(par, par + NPARAMETERS, start);
+  double current_chi2 = NAN;
+  int status = minimize(ws, npoints, par, lower, upper, current_chi2);
+
+  // both peak times start equal, which is a saddle in the amplitude ratio,
+  // and the chi2 has local minima where one exponential takes over or a
+  // peak time sits on its limit. Fit again from peak times spread over
+  // their range and keep the lowest chi2
+  if (_shape == kPowerLawDoubleExp && status >= 0 && lower[3] < upper[3] && lower[6] < upper[6])
+  {
+    // (peak time 1, peak time 2) as fractions of their range
+    static const int nstarts = 4;
+    static const double tau_start[nstarts][2] = {{0.5, 0.05}, {0.35, 0.8}, {0.35, 0.2}, {0.05, 0.2}};
+    for (int istart = 0; istart < nstarts; istart++)
+    {
+      double retry[NPARAMETERS];
+      std::copy(start, start + NPARAMETERS, retry);
+      retry[3] = lower[3] + tau_start[istart][0] * (upper[3] - lower[3]);
+      retry[6] = lower[6] + tau_start[istart][1] * (upper[6] - lower[6]);
+      double retry_chi2 = NAN;
+      const int retry_status = minimize(ws, npoints, retry, lower, upper, retry_chi2);
+      if (retry_chi2 < current_chi2)
+      {
+        std::copy(retry, retry + NPARAMETERS, par);
+        current_chi2 = retry_chi2;
+        status = retry_status;
+      }
+    }
+  }
+
+  std::copy(par, par + NPARAMETERS, result.parameters);
+  result.pedestal = par[4];
+  result.chi2 = current_chi2;
+  result.status = status;
+
+  if (_shape == kPowerLawExp)
+  {
+    // exact peak height is (p0*Power(p2/p3,p2))/Power(E,p2)
+    result.peak = par[0] * std::pow(par[2] / par[3], par[2]) / std::exp(par[2]);
+    result.peak_sample = par[1] + par[2] / par[3];
+  }
+  else
+  {
+    double max_peakpos = par[1] + std::max(par[3], par[6]);
+    if (max_peakpos > NSAMPLES - 1) max_peakpos = NSAMPLES - 1;
+    result.peak_sample = find_peak(par, par[1], max_peakpos);
+    result.peak = shape_value(_shape, result.peak_sample, par) - result.pedestal;
+  }
+}
+
+void CaloPulseShapeFitter::FitChannel(const float *samples, Result &result, int ithread)
+{
+  fit(samples, result, ithread);
+}
+
+void CaloPulseShapeFitter::FitChannel(const double *samples, Result &result, int ithread)
+{
+  fit(samples, result, ithread);
+}
+
+void CaloPulseShapeFitter::Fit(const float *waveforms, int nchannels, Result *results, int stride)
+{
+  if (nchannels <= 0) return;
+  if (stride <= 0) stride = NSAMPLES;
+  assert(stride >= NSAMPLES);
+
+  if (!_executor || nchannels < 2 * _nthreads)
+  {
+    for (int ich = 0; ich < nchannels; ich++)
+    {
+      fit(waveforms + (size_t) ich * stride, results[ich], 0);
+    }
+    return;
+  }
+
+  // contiguous channel ranges, one per thread and workspace
+  const int chunk = (nchannels + _nthreads - 1) / _nthreads;
+  auto fit_range = [&](unsigned int ithread) {
+    const int first = ithread * chunk;
+    const int last = std::min(nchannels, first + chunk);
+    for (int ich = first; ich < last; ich++)
+    {
+      fit(waveforms + (size_t) ich * stride, results[ich], ithread);
+    }
+  };
+  _executor->Foreach(fit_range, ROOT::TSeqU(_nthreads));
+}
@@ -0,0 +1,125 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef PROTOTYPE4_CALOPULSESHAPEFITTER_H
+#define PROTOTYPE4_CALOPULSESHAPEFITTER_H
+
+#include "PROTOTYPE4_FEM.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace ROOT
+{
+  class TThreadExecutor;
+}
+
+//! Batch fit of the PROTOTYPE4_FEM pulse shapes with analytic gradients.
+//!
+//! Same model, parameters, initial guesses, limits and sample selection as
+//! PROTOTYPE4_FEM::SampleFit_PowerLawExp and SampleFit_PowerLawDoubleExp,
+//! the un-weighted chi2 ("W") is minimized with a bounded Levenberg-Marquardt
+//! step on the analytic derivatives of SignalShape_PowerLawExp /
+//! SignalShape_PowerLawDoubleExp instead of MINUIT on a TGraph / TF1.
+//! The peak and peak sample are derived from the fit as in the FEM functions.
+//! The double-exp fit is repeated from four more pairs of peak times and the
+//! lowest chi2 is kept, since a single start often ends in a local minimum.
+//!
+//! Fixed parameters (e.g. the shape of a global fit, see
+//! CaloCalibration::kPowerLawDoubleExpWithGlobalFitConstraint) apply to all
+//! channels of a batch. Scratch memory is allocated per thread in the
+//! constructor; Fit() itself does not allocate.
+class CaloPulseShapeFitter
+{
+ public:
+  enum ShapeType
+  {
+    //! PROTOTYPE4_FEM::SignalShape_PowerLawExp, 5 parameters
+    kPowerLawExp,
+    //! PROTOTYPE4_FEM::SignalShape_PowerLawDoubleExp, 7 parameters
+    kPowerLawDoubleExp
+  };
+
+  enum
+  {
+    NPARAMETERS = 7,
+    NSAMPLES = PROTOTYPE4_FEM::NSAMPLES
+  };
+
+  struct Result
+  {
+    double peak;
+    double peak_sample;
+    double pedestal;
+    double chi2;
+    int status;  //! 0: converged, 1: max iterations reached, -1: too few valid samples
+    //! fit parameters, same order as the parameters_io of SampleFit_PowerLawDoubleExp
+    double parameters[NPARAMETERS];
+  };
+
+  CaloPulseShapeFitter(ShapeType shape, int nthreads = 1);
+  virtual ~CaloPulseShapeFitter();
+
+  ShapeType get_shape() const { return _shape; }
+  int get_nparameters() const { return _shape == kPowerLawExp ? 5 : 7; }
+  int get_nthreads() const { return _nthreads; }
+
+  void set_max_iterations(int n) { _max_iterations = n; }
+  void set_tolerance(double tol) { _tolerance = tol; }
+
+  //! fix parameter ipar to value for all following fits
+  void fix_parameter(int ipar, double value);
+  //! fix all parameters in the map, e.g. parameters_io of a global fit
+  void fix_parameters(const std::map<int, double> &parameters);
+  void release_parameters();
+
+  //! shape value at x and, if gradient is not null, its derivatives with
+  //! respect to the parameters
+  static double shape_value(ShapeType shape, double x, const double *par,
+                            double *gradient = nullptr);
+
+  //! fit nchannels waveforms of NSAMPLES samples stored as [channel][sample],
+  //! channels stride samples apart (default: NSAMPLES)
+  void Fit(const float *waveforms, int nchannels, Result *results, int stride = 0);
+
+  //! fit a single waveform using the workspace of thread ithread
+  void FitChannel(const float *samples, Result &result, int ithread = 0);
+  void FitChannel(const double *samples, Result &result, int ithread = 0);
+
+ private:
+  struct Workspace
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+  };
+
+  template <typename T>
+  void fit(const T *samples, Result &result, int ithread);
+
+  //! initial values and limits, as in the PROTOTYPE4_FEM fit functions
+  template <typename T>
+  int initialize(const T *samples, Workspace &ws, double *par, double *lower,
+                 double *upper) const;
+
+  double chi2(const Workspace &ws, int npoints, const double *par) const;
+
+  //! bounded Levenberg-Marquardt from par, returns the status of Result
+  int minimize(const Workspace &ws, int npoints, double *par, const double *lower,
+               const double *upper, double &chi2_min) const;
+
+  //! position of the extremum of the fitted shape, as TF1::GetMaximumX / GetMinimumX
+  double find_peak(const double *par, double xmin, double xmax) const;
+
+  ShapeType _shape;
+  int _nthreads;
+  int _max_iterations;
+  double _tolerance;
+
+  bool _fixed[NPARAMETERS];
+  double _fixed_values[NPARAMETERS];
+
+  std::vector<Workspace> _workspaces;
+  std::unique_ptr<ROOT::TThreadExecutor> _executor;
+};
+
+#endif
@@ -1,7 +1,9 @@
 #include "CaloTemplateFit.h"
 
+#include "CaloWaveformFitter.h"
 #include "PROTOTYPE4_FEM.h"
 #include "RawTower_Prototype4.h"
+#include "RawWaveformBlock.h"
 
 #include <calobase/RawTower.h>  // for RawTower
 #include <calobase/RawTowerContainer.h>
@@ -193,6 +195,65 @@ std::vector<float> CaloTemplateFit::calo_processing_singlethread(std::vector<flo
   
 }
 
+void CaloTemplateFit::calo_processing_fast()
+{
+  const int nsamples = _fitter->get_nsamples();
+  const int ntowers = _raw_towers->size();
+  _waveform_block.resize((size_t) ntowers * nsamples);
+  _fit_results.resize(ntowers);
+
+  RawTowerContainer::Range begin_end = _raw_towers->getTowers();
+  RawTowerContainer::Iterator rtiter;
+  float *block = _waveform_block.data();
+  for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+    {
+      RawTower_Prototype4 *raw_tower =
+	dynamic_cast<RawTower_Prototype4 *>(rtiter->second);
+      assert(raw_tower);
+      for (int i = 0; i < nsamples; i++)
+	{
+	  block[i] = raw_tower->get_signal_samples(i);
+	}
+      block += nsamples;
+    }
+
+  _fitter->Fit(_waveform_block.data(), ntowers, _fit_results.data());
+
+  int towernumber = 0;
+  for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+    {
+      RawTower_Prototype4 *raw_tower =
+	dynamic_cast<RawTower_Prototype4 *>(rtiter->second);
+      if (std::isnan(raw_tower->get_energy()))
+	{
+	  // Raw tower was never fit, store the current fit
+	  raw_tower->set_energy(_fit_results[towernumber].amplitude);
+	  raw_tower->set_time(_fit_results[towernumber].time);
+	}
+      towernumber++;
+    }
+}
+
+void CaloTemplateFit::calo_processing_block()
+{
+  // fit straight from the unpacked [channel][sample] block, no copy
+  const int nchannels = _raw_waveforms->size();
+  _fit_results.resize(nchannels);
+  _fitter->Fit(_raw_waveforms->data(), nchannels, _fit_results.data(),
+	       _raw_waveforms->get_nsamples());
+
+  for (int ich = 0; ich < nchannels; ich++)
+    {
+      RawTower *raw_tower = _raw_towers->getTower(_raw_waveforms->get_key(ich));
+      if (raw_tower && std::isnan(raw_tower->get_energy()))
+	{
+	  // Raw tower was never fit, store the current fit
+	  raw_tower->set_energy(_fit_results[ich].amplitude);
+	  raw_tower->set_time(_fit_results[ich].time);
+	}
+    }
+}
+
 //TProfile for the template
 TProfile* CaloTemplateFit::h_template = nullptr;
 
@@ -203,6 +264,7 @@ CaloTemplateFit::CaloTemplateFit(const std::string &name)
   : SubsysReco(string("CaloCalibration_") + name)
   , _calib_towers(nullptr)
   , _raw_towers(nullptr)
+  , _raw_waveforms(nullptr)
   , detector(name)
   , _calib_tower_node_prefix("CALIB")
   , _raw_tower_node_prefix("RAW")
@@ -211,10 +273,17 @@ CaloTemplateFit::CaloTemplateFit(const std::string &name)
   , template_input_file("/gpfs/mnt/gpfs02/sphenix/user/trinn/fitting_algorithm_playing/prdfcode/prototype/offline/packages/Prototype4/templates.root")
  , _calib_params(name)
   , _fit_type(kPowerLawDoubleExpWithGlobalFitConstraint)
+  , _fast_fit(false)
+  , _fitter(nullptr)
 {
   SetDefaultParameters(_calib_params);
 }
 
+CaloTemplateFit::~CaloTemplateFit()
+{
+  delete _fitter;
+}
+
 //_____________________________________
 int CaloTemplateFit::InitRun(PHCompositeNode *topNode)
 {
@@ -243,6 +312,14 @@ int CaloTemplateFit::InitRun(PHCompositeNode *topNode)
 
   ROOT::EnableThreadSafety();
 
+  if (_fast_fit)
+  {
+    int nsamples = RawTower_Prototype4::NSAMPLES;
+    if (_nsamples > 0 && _nsamples < nsamples) nsamples = _nsamples;
+    delete _fitter;
+    _fitter = new CaloWaveformFitter(h_template, nsamples, _nthreads);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -257,7 +334,15 @@ int CaloTemplateFit::process_event(PHCompositeNode *topNode)
 
   map<int, double> parameters_constraints;
 
-  if ( _raw_towers->size() > 1)
+  if (_fast_fit && _raw_waveforms && _raw_waveforms->size() > 1)
+    {
+      calo_processing_block();
+    }
+  else if (_fast_fit && _raw_towers->size() > 1)
+    {
+      calo_processing_fast();
+    }
+  else if ( _raw_towers->size() > 1)
     {
       if (Verbosity())
 	{
@@ -524,6 +609,11 @@ void CaloTemplateFit::CreateNodeTree(PHCompositeNode *topNode)
                              " node in RawTowerCalibration::CreateNodes");
   }
 
+  // optional, written by CaloUnpackPRDF::set_waveform_block
+  const std::string RawWaveformNodeName = "WAVEFORM_" + _raw_tower_node_prefix + "_" + detector;
+  _raw_waveforms =
+      findNode::getClass<RawWaveformBlock>(dstNode, RawWaveformNodeName.c_str());
+
   // Create the tower nodes on the tree
   PHNodeIterator dstiter(dstNode);
   PHCompositeNode *DetNode = dynamic_cast<PHCompositeNode *>(
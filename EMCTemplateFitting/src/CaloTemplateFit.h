@@ -6,6 +6,8 @@
 //* Unpacks raw HCAL PRDF files *//
 // Abhisek Sen
 
+#include "CaloWaveformFitter.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <phparameter/PHParameters.h>
@@ -20,11 +22,13 @@
 
 class PHCompositeNode;
 class RawTowerContainer;
+class RawWaveformBlock;
 
 class CaloTemplateFit : public SubsysReco
 {
  public:
   CaloTemplateFit(const std::string &name);
+  virtual ~CaloTemplateFit();
 
   int InitRun(PHCompositeNode *topNode);
 
@@ -64,6 +68,13 @@ class CaloTemplateFit : public SubsysReco
   {
     template_input_file =templatename;
   }
+  //! use CaloWaveformFitter (analytic template, Levenberg-Marquardt) instead
+  //! of one ROOT::Fit::Fitter per channel. Reads the waveform block
+  //! WAVEFORM_<raw prefix>_<detector> directly if CaloUnpackPRDF wrote one.
+  void set_fast_fit(bool fast)
+  {
+    _fast_fit = fast;
+  }
 
 
   //! Get the parameters for readonly
@@ -102,6 +113,7 @@ class CaloTemplateFit : public SubsysReco
  private:
   RawTowerContainer *_calib_towers;
   RawTowerContainer *_raw_towers;
+  RawWaveformBlock *_raw_waveforms;
 
   std::string detector;
   std::string RawTowerNodeName;
@@ -120,12 +132,20 @@ class CaloTemplateFit : public SubsysReco
   static double template_function(double *x, double *par);
   std::vector<std::vector<float>>  calo_processing_perchnl(std::vector<std::vector<float>> chnlvector);
   std::vector<float>  calo_processing_singlethread(std::vector<float> chnlvector);
+  void calo_processing_fast();
+  void calo_processing_block();
   /* ROOT::TThreadedObject<TF1> testfit; */
   std::string template_input_file;
 
   TH1F* h_data;
   TF1* f_fit;
 
+  bool _fast_fit;
+  CaloWaveformFitter *_fitter;
+  //! [tower][sample] waveforms and fit results, reused across events
+  std::vector<float> _waveform_block;
+  std::vector<CaloWaveformFitter::Result> _fit_results;
+
   PHParameters _calib_params;
 
   FitMethodType _fit_type; 
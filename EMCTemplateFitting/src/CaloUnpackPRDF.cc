@@ -2,6 +2,7 @@
 
 #include "PROTOTYPE4_FEM.h"
 #include "RawTower_Prototype4.h"
+#include "RawWaveformBlock.h"
 
 #include <calobase/RawTower.h>  // for RawTower
 #include <calobase/RawTowerContainer.h>
@@ -52,6 +53,18 @@ CaloUnpackPRDF::CaloUnpackPRDF()
   /*RawTowerContainer**/ hcalout_towers_hg(nullptr)
   ,
   /*RawTowerContainer**/ emcal_towers(nullptr)
+  ,
+  /*RawWaveformBlock**/ hcalin_waveforms_lg(nullptr)
+  ,
+  /*RawWaveformBlock**/ hcalout_waveforms_lg(nullptr)
+  ,
+  /*RawWaveformBlock**/ hcalout_waveforms_hg(nullptr)
+  ,
+  /*RawWaveformBlock**/ emcal_waveforms(nullptr)
+  ,
+  /*bool*/ _tower_samples(true)
+  ,
+  /*bool*/ _waveform_block(false)
 {
 }
 
@@ -93,112 +106,21 @@ int CaloUnpackPRDF::process_event(PHCompositeNode *topNode)
     }
     return Fun4AllReturnCodes::DISCARDEVENT;
   }
-  RawTower_Prototype4 *tower_lg = nullptr;
-  RawTower_Prototype4 *tower_hg = nullptr;
+  // HCALIN, the high gain channels are not read out
+  UnpackCalorimeter("HCALIN", PROTOTYPE4_FEM::NCH_IHCAL_ROWS,
+                    PROTOTYPE4_FEM::NCH_IHCAL_COLUMNS, hcalin_towers_lg, nullptr,
+                    hcalin_waveforms_lg, nullptr);
 
-  // HCALIN
-  assert(hcalin_towers_lg);
-  //  assert(hcalin_towers_hg);
-  for (int ibinz = 0; ibinz < PROTOTYPE4_FEM::NCH_IHCAL_ROWS; ibinz++)
-  {
-    for (int ibinphi = 0; ibinphi < PROTOTYPE4_FEM::NCH_IHCAL_COLUMNS;
-         ibinphi++)
-    {
-      tower_lg = dynamic_cast<RawTower_Prototype4 *>(
-          hcalin_towers_lg->getTower(ibinz, ibinphi));
-      if (!tower_lg)
-      {
-        tower_lg = new RawTower_Prototype4();
-        tower_lg->set_energy(NAN);
-        hcalin_towers_lg->AddTower(ibinz, ibinphi, tower_lg);
-      }
-      //      tower_hg =
-      //          dynamic_cast<RawTower_Prototype4
-      //          *>(hcalin_towers_hg->getTower(
-      //              ibinz, ibinphi));
-      //      if (!tower_hg)
-      //      {
-      //        tower_hg = new RawTower_Prototype4();
-      //        tower_hg->set_energy(NAN);
-      //        hcalin_towers_hg->AddTower(ibinz, ibinphi, tower_hg);
-      //      }
-
-      int ich = PROTOTYPE4_FEM::GetChannelNumber("HCALIN", ibinz, ibinphi);
-      tower_lg->set_HBD_channel_number(ich);
-      //      tower_hg->set_HBD_channel_number(ich);
-      for (int isamp = 0; isamp < PROTOTYPE4_FEM::NSAMPLES; isamp++)
-      {
-        //        tower_hg->set_signal_samples(isamp, _packet->iValue(isamp,
-        //        ich) & PROTOTYPE4_FEM::ADC_DATA_MASK);
-        tower_lg->set_signal_samples(isamp, _packet->iValue(isamp, ich) &
-                                                PROTOTYPE4_FEM::ADC_DATA_MASK);
-      }
-    }
-  }
-
-  // HCALOUT
-  assert(hcalout_towers_lg);
+  // HCALOUT, high gain in the channel after the low gain one
   assert(hcalout_towers_hg);
-  for (int ibinz = 0; ibinz < PROTOTYPE4_FEM::NCH_OHCAL_ROWS; ibinz++)
-  {
-    for (int ibinphi = 0; ibinphi < PROTOTYPE4_FEM::NCH_OHCAL_COLUMNS;
-         ibinphi++)
-    {
-      tower_lg = dynamic_cast<RawTower_Prototype4 *>(
-          hcalout_towers_lg->getTower(ibinz, ibinphi));
-      if (!tower_lg)
-      {
-        tower_lg = new RawTower_Prototype4();
-        tower_lg->set_energy(NAN);
-        hcalout_towers_lg->AddTower(ibinz, ibinphi, tower_lg);
-      }
-      tower_hg = dynamic_cast<RawTower_Prototype4 *>(
-          hcalout_towers_hg->getTower(ibinz, ibinphi));
-      if (!tower_hg)
-      {
-        tower_hg = new RawTower_Prototype4();
-        tower_hg->set_energy(NAN);
-        hcalout_towers_hg->AddTower(ibinz, ibinphi, tower_hg);
-      }
-      int ich = PROTOTYPE4_FEM::GetChannelNumber("HCALOUT", ibinz, ibinphi);
-      tower_lg->set_HBD_channel_number(ich);
-      tower_hg->set_HBD_channel_number(ich);
-      for (int isamp = 0; isamp < PROTOTYPE4_FEM::NSAMPLES; isamp++)
-      {
-        tower_lg->set_signal_samples(isamp, _packet->iValue(isamp, ich) &
-                                                PROTOTYPE4_FEM::ADC_DATA_MASK);
-        tower_hg->set_signal_samples(isamp, _packet->iValue(isamp, ich + 1) &
-                                                PROTOTYPE4_FEM::ADC_DATA_MASK);
-      }
-    }
-  }
+  UnpackCalorimeter("HCALOUT", PROTOTYPE4_FEM::NCH_OHCAL_ROWS,
+                    PROTOTYPE4_FEM::NCH_OHCAL_COLUMNS, hcalout_towers_lg,
+                    hcalout_towers_hg, hcalout_waveforms_lg, hcalout_waveforms_hg);
 
   // EMCAL
-  RawTower_Prototype4 *tower = nullptr;
-  assert(emcal_towers);
-  for (int ibinz = 0; ibinz < PROTOTYPE4_FEM::NCH_EMCAL_ROWS; ibinz++)
-  {
-    for (int ibinphi = 0; ibinphi < PROTOTYPE4_FEM::NCH_EMCAL_COLUMNS;
-         ibinphi++)
-    {
-      tower = dynamic_cast<RawTower_Prototype4 *>(
-          emcal_towers->getTower(ibinz, ibinphi));
-      if (!tower)
-      {
-        tower = new RawTower_Prototype4();
-        tower->set_energy(NAN);
-        emcal_towers->AddTower(ibinz, ibinphi, tower);
-      }
-
-      int ich = PROTOTYPE4_FEM::GetChannelNumber("EMCAL", ibinz, ibinphi);
-      tower->set_HBD_channel_number(ich);
-      for (int isamp = 0; isamp < PROTOTYPE4_FEM::NSAMPLES; isamp++)
-      {
-        tower->set_signal_samples(isamp, _packet->iValue(isamp, ich) &
-                                             PROTOTYPE4_FEM::ADC_DATA_MASK);
-      }
-    }
-  }
+  UnpackCalorimeter("EMCAL", PROTOTYPE4_FEM::NCH_EMCAL_ROWS,
+                    PROTOTYPE4_FEM::NCH_EMCAL_COLUMNS, emcal_towers, nullptr,
+                    emcal_waveforms, nullptr);
 
   if (Verbosity())
   {
@@ -223,6 +145,103 @@ int CaloUnpackPRDF::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+//_______________________________________
+void CaloUnpackPRDF::UnpackCalorimeter(const std::string &caloname, int nrows,
+                                       int ncolumns,
+                                       RawTowerContainer *towers_lg,
+                                       RawTowerContainer *towers_hg,
+                                       RawWaveformBlock *waveforms_lg,
+                                       RawWaveformBlock *waveforms_hg)
+{
+  assert(towers_lg);
+
+  // same channel order in the waveform blocks as in the tower loop
+  const unsigned int nchannels = nrows * ncolumns;
+  if (waveforms_lg)
+    waveforms_lg->resize(nchannels);
+  if (waveforms_hg)
+    waveforms_hg->resize(nchannels);
+
+  // samples of a channel without waveform block
+  RawWaveformBlock::signal_type buffer_lg[PROTOTYPE4_FEM::NSAMPLES];
+  RawWaveformBlock::signal_type buffer_hg[PROTOTYPE4_FEM::NSAMPLES];
+
+  unsigned int ichannel = 0;
+  for (int ibinz = 0; ibinz < nrows; ibinz++)
+  {
+    for (int ibinphi = 0; ibinphi < ncolumns; ibinphi++, ichannel++)
+    {
+      const int ich = PROTOTYPE4_FEM::GetChannelNumber(caloname, ibinz, ibinphi);
+
+      RawTower_Prototype4 *tower_lg = GetTower(towers_lg, ibinz, ibinphi);
+      tower_lg->set_HBD_channel_number(ich);
+
+      RawWaveformBlock::signal_type *samples_lg = buffer_lg;
+      if (waveforms_lg)
+      {
+        waveforms_lg->set_channel(
+            ichannel,
+            RawTowerDefs::encode_towerid(towers_lg->getCalorimeterID(), ibinz, ibinphi),
+            ich);
+        samples_lg = waveforms_lg->get_samples(ichannel);
+      }
+      UnpackChannel(ich, samples_lg);
+      if (_tower_samples)
+      {
+        for (int isamp = 0; isamp < PROTOTYPE4_FEM::NSAMPLES; isamp++)
+          tower_lg->set_signal_samples(isamp, samples_lg[isamp]);
+      }
+
+      if (!towers_hg)
+        continue;
+
+      RawTower_Prototype4 *tower_hg = GetTower(towers_hg, ibinz, ibinphi);
+      tower_hg->set_HBD_channel_number(ich);
+
+      RawWaveformBlock::signal_type *samples_hg = buffer_hg;
+      if (waveforms_hg)
+      {
+        waveforms_hg->set_channel(
+            ichannel,
+            RawTowerDefs::encode_towerid(towers_hg->getCalorimeterID(), ibinz, ibinphi),
+            ich);
+        samples_hg = waveforms_hg->get_samples(ichannel);
+      }
+      UnpackChannel(ich + 1, samples_hg);
+      if (_tower_samples)
+      {
+        for (int isamp = 0; isamp < PROTOTYPE4_FEM::NSAMPLES; isamp++)
+          tower_hg->set_signal_samples(isamp, samples_hg[isamp]);
+      }
+    }
+  }
+}
+
+//_______________________________________
+void CaloUnpackPRDF::UnpackChannel(int ich,
+                                   RawWaveformBlock::signal_type *samples) const
+{
+  for (int isamp = 0; isamp < PROTOTYPE4_FEM::NSAMPLES; isamp++)
+  {
+    samples[isamp] = _packet->iValue(isamp, ich) & PROTOTYPE4_FEM::ADC_DATA_MASK;
+  }
+}
+
+//_______________________________________
+RawTower_Prototype4 *CaloUnpackPRDF::GetTower(RawTowerContainer *towers,
+                                              int ibinz, int ibinphi)
+{
+  RawTower_Prototype4 *tower =
+      dynamic_cast<RawTower_Prototype4 *>(towers->getTower(ibinz, ibinphi));
+  if (!tower)
+  {
+    tower = new RawTower_Prototype4();
+    tower->set_energy(NAN);
+    towers->AddTower(ibinz, ibinphi, tower);
+  }
+  return tower;
+}
+
 //_______________________________________
 void CaloUnpackPRDF::CreateNodeTree(PHCompositeNode *topNode)
 {
@@ -272,4 +291,27 @@ void CaloUnpackPRDF::CreateNodeTree(PHCompositeNode *topNode)
   PHIODataNode<PHObject> *emcal_towerNode =
       new PHIODataNode<PHObject>(emcal_towers, "TOWER_RAW_CEMC", "PHObject");
   data_node->addNode(emcal_towerNode);
+
+  if (!_waveform_block)
+    return;
+
+  // Waveform blocks
+  hcalin_waveforms_lg = new RawWaveformBlock();
+  PHIODataNode<PHObject> *waveform_node = new PHIODataNode<PHObject>(
+      hcalin_waveforms_lg, "WAVEFORM_RAW_LG_HCALIN", "PHObject");
+  data_node->addNode(waveform_node);
+
+  hcalout_waveforms_lg = new RawWaveformBlock();
+  waveform_node = new PHIODataNode<PHObject>(
+      hcalout_waveforms_lg, "WAVEFORM_RAW_LG_HCALOUT", "PHObject");
+  data_node->addNode(waveform_node);
+  hcalout_waveforms_hg = new RawWaveformBlock();
+  waveform_node = new PHIODataNode<PHObject>(
+      hcalout_waveforms_hg, "WAVEFORM_RAW_HG_HCALOUT", "PHObject");
+  data_node->addNode(waveform_node);
+
+  emcal_waveforms = new RawWaveformBlock();
+  waveform_node = new PHIODataNode<PHObject>(emcal_waveforms,
+                                             "WAVEFORM_RAW_CEMC", "PHObject");
+  data_node->addNode(waveform_node);
 }
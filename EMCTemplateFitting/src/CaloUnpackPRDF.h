@@ -6,12 +6,17 @@
 //* Unpacks raw HCAL PRDF files *//
 // Abhisek Sen
 
+#include "RawWaveformBlock.h"
+
 #include <fun4all/SubsysReco.h>
 
+#include <string>
+
 class Event;
 class Packet;
 class PHCompositeNode;
 class RawTowerContainer;
+class RawTower_Prototype4;
 
 class CaloUnpackPRDF : public SubsysReco
 {
@@ -24,7 +29,31 @@ class CaloUnpackPRDF : public SubsysReco
 
   void CreateNodeTree(PHCompositeNode *topNode);
 
+  //! also unpack the samples of each calorimeter into one contiguous
+  //! RawWaveformBlock, nodes WAVEFORM_RAW_CEMC, WAVEFORM_RAW_LG_HCALIN, ...
+  //! in the same channel order as the towers. Set before InitRun.
+  void set_waveform_block(bool b) { _waveform_block = b; }
+
+  //! copy the samples into the RawTower_Prototype4 towers (default). Only
+  //! switch off together with set_waveform_block(true) when all fitters
+  //! downstream read the waveform block, e.g. CaloTemplateFit::set_fast_fit.
+  //! The towers are still created, with energy NAN, to receive the fits.
+  void set_tower_samples(bool b) { _tower_samples = b; }
+
  private:
+  void UnpackCalorimeter(const std::string &caloname, int nrows, int ncolumns,
+                         RawTowerContainer *towers_lg,
+                         RawTowerContainer *towers_hg,
+                         RawWaveformBlock *waveforms_lg,
+                         RawWaveformBlock *waveforms_hg);
+
+  //! masked ADC samples of packet channel ich
+  void UnpackChannel(int ich, RawWaveformBlock::signal_type *samples) const;
+
+  RawTower_Prototype4 *GetTower(RawTowerContainer *towers, int ibinz,
+                                int ibinphi);
+
+
   Event *_event;
   Packet *_packet;
   int _nevents;
@@ -41,6 +70,15 @@ class CaloUnpackPRDF : public SubsysReco
   RawTowerContainer *hcalout_towers_hg;
 
   RawTowerContainer *emcal_towers;
+
+  // Waveform blocks, only with _waveform_block
+  RawWaveformBlock *hcalin_waveforms_lg;
+  RawWaveformBlock *hcalout_waveforms_lg;
+  RawWaveformBlock *hcalout_waveforms_hg;
+  RawWaveformBlock *emcal_waveforms;
+
+  bool _tower_samples;
+  bool _waveform_block;
 };
 
 #endif  //**CaloUnpackPRDFF**//
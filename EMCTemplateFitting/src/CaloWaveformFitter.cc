@@ -0,0 +1,272 @@
+#include "CaloWaveformFitter.h"
+
+#include <TProfile.h>
+
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+  //! solve the symmetric 3x3 system a * x = b with Cramer's rule
+  bool solve3x3(const double a[3][3], const double b[3], double x[3])
+  {
+    const double c00 = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+    const double c01 = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+    const double c02 = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+    const double det = a[0][0] * c00 + a[0][1] * c01 + a[0][2] * c02;
+    if (det == 0 || !std::isfinite(det)) return false;
+
+    const double inv[3][3] = {
+        {c00, a[0][2] * a[2][1] - a[0][1] * a[2][2], a[0][1] * a[1][2] - a[0][2] * a[1][1]},
+        {c01, a[0][0] * a[2][2] - a[0][2] * a[2][0], a[0][2] * a[1][0] - a[0][0] * a[1][2]},
+        {c02, a[0][1] * a[2][0] - a[0][0] * a[2][1], a[0][0] * a[1][1] - a[0][1] * a[1][0]}};
+
+    for (int i = 0; i < 3; i++)
+    {
+      x[i] = (inv[i][0] * b[0] + inv[i][1] * b[1] + inv[i][2] * b[2]) / det;
+    }
+    return true;
+  }
+}  // namespace
+
+CaloWaveformFitter::CaloWaveformFitter(const TProfile *h_template, int nsamples, int nthreads)
+  : _template_x0(0)
+  , _template_dx(1)
+  , _nsamples(0)
+  , _nthreads(std::max(nthreads, 1))
+  , _max_iterations(100)
+  , _tolerance(1e-10)
+{
+  assert(h_template);
+
+  // tabulate the bin centers once so that interpolation is plain arithmetic
+  const int nbins = h_template->GetNbinsX();
+  _template.resize(nbins);
+  for (int i = 0; i < nbins; i++)
+  {
+    _template[i] = h_template->GetBinContent(i + 1);
+  }
+  _template_x0 = h_template->GetBinCenter(1);
+  _template_dx = h_template->GetBinWidth(1);
+
+  _workspaces.resize(_nthreads);
+  set_nsamples(nsamples);
+
+  if (_nthreads > 1)
+  {
+    _executor.reset(new ROOT::TThreadExecutor(_nthreads));
+  }
+}
+
+CaloWaveformFitter::~CaloWaveformFitter() = default;
+
+void CaloWaveformFitter::set_nsamples(int nsamples)
+{
+  _nsamples = nsamples;
+  for (auto &ws : _workspaces)
+  {
+    ws.x.resize(_nsamples);
+    ws.y.resize(_nsamples);
+    ws.w.resize(_nsamples);
+  }
+}
+
+double CaloWaveformFitter::template_value(double x) const
+{
+  double derivative;
+  return template_value(x, derivative);
+}
+
+double CaloWaveformFitter::template_value(double x, double &derivative) const
+{
+  // same convention as TProfile::Interpolate: linear between bin centers,
+  // constant beyond the first and last bin center
+  const int nbins = _template.size();
+  const double u = (x - _template_x0) / _template_dx;
+  derivative = 0;
+  if (u <= 0) return _template[0];
+  if (u >= nbins - 1) return _template[nbins - 1];
+
+  const int i = static_cast<int>(u);
+  const double f = u - i;
+  const double slope = _template[i + 1] - _template[i];
+  derivative = slope / _template_dx;
+  return _template[i] + f * slope;
+}
+
+double CaloWaveformFitter::chi2(const Workspace &ws, int npoints, const double *par) const
+{
+  double sum = 0;
+  for (int i = 0; i < npoints; i++)
+  {
+    const double r = ws.y[i] - (par[0] * template_value(ws.x[i] - par[1]) + par[2]);
+    sum += ws.w[i] * r * r;
+  }
+  return sum;
+}
+
+void CaloWaveformFitter::FitChannel(const float *samples, Result &result, int ithread)
+{
+  Workspace &ws = _workspaces[ithread];
+  const int n = _nsamples;
+
+  // initial guesses, as in CaloTemplateFit::calo_processing_perchnl
+  float maxheight = 0;
+  int maxbin = 0;
+  for (int i = 0; i < n; i++)
+  {
+    if (samples[i] > maxheight)
+    {
+      maxheight = samples[i];
+      maxbin = i;
+    }
+  }
+  float pedestal = 1500;
+  if (maxbin > 4)
+  {
+    pedestal = 0.5 * (samples[maxbin - 4] + samples[maxbin - 5]);
+  }
+  else if (maxbin > 3)
+  {
+    pedestal = samples[maxbin - 4];
+  }
+  else if (n > 2)
+  {
+    pedestal = 0.5 * (samples[n - 3] + samples[n - 2]);
+  }
+
+  // samples at bin centers with the Poisson-like errors of an un-weighted
+  // TH1F; empty samples carry no weight and are dropped as in ROOT::Fit::FillData
+  int npoints = 0;
+  for (int i = 0; i < n; i++)
+  {
+    if (samples[i] == 0) continue;
+    ws.x[npoints] = i + 0.5;
+    ws.y[npoints] = samples[i];
+    ws.w[npoints] = 1. / std::fabs(samples[i]);
+    ++npoints;
+  }
+
+  double par[3] = {maxheight, static_cast<double>(maxbin - 5), pedestal};
+
+  if (npoints < 3)
+  {
+    result.amplitude = par[0];
+    result.time = par[1];
+    result.pedestal = par[2];
+    result.chi2 = NAN;
+    result.status = -1;
+    return;
+  }
+
+  double lambda = 1e-3;
+  double current_chi2 = chi2(ws, npoints, par);
+  int status = 1;
+
+  for (int iter = 0; iter < _max_iterations; iter++)
+  {
+    // normal equations J^T W J and J^T W r
+    double jtj[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+    double jtr[3] = {0, 0, 0};
+    for (int i = 0; i < npoints; i++)
+    {
+      double dtemplate;
+      const double t = template_value(ws.x[i] - par[1], dtemplate);
+      const double r = ws.y[i] - (par[0] * t + par[2]);
+      const double j[3] = {t, -par[0] * dtemplate, 1.};
+      for (int a = 0; a < 3; a++)
+      {
+        jtr[a] += ws.w[i] * j[a] * r;
+        for (int b = a; b < 3; b++)
+        {
+          jtj[a][b] += ws.w[i] * j[a] * j[b];
+        }
+      }
+    }
+    jtj[1][0] = jtj[0][1];
+    jtj[2][0] = jtj[0][2];
+    jtj[2][1] = jtj[1][2];
+
+    bool improved = false;
+    double trial_chi2 = current_chi2;
+    double step[3] = {0, 0, 0};
+    for (int attempt = 0; attempt < 10 && !improved; attempt++)
+    {
+      double damped[3][3];
+      for (int a = 0; a < 3; a++)
+      {
+        for (int b = 0; b < 3; b++) damped[a][b] = jtj[a][b];
+        damped[a][a] *= (1. + lambda);
+      }
+      if (!solve3x3(damped, jtr, step))
+      {
+        lambda *= 10;
+        continue;
+      }
+      const double trial[3] = {par[0] + step[0], par[1] + step[1], par[2] + step[2]};
+      trial_chi2 = chi2(ws, npoints, trial);
+      if (trial_chi2 <= current_chi2)
+      {
+        improved = true;
+        std::copy(trial, trial + 3, par);
+        lambda = std::max(lambda / 10., 1e-12);
+      }
+      else
+      {
+        lambda *= 10;
+      }
+    }
+
+    if (!improved)
+    {
+      // no downhill step left: we are at the minimum within precision
+      status = 0;
+      break;
+    }
+    const double dchi2 = current_chi2 - trial_chi2;
+    current_chi2 = trial_chi2;
+    if (dchi2 <= _tolerance * std::max(current_chi2, 1.))
+    {
+      status = 0;
+      break;
+    }
+  }
+
+  result.amplitude = par[0];
+  result.time = par[1];
+  result.pedestal = par[2];
+  result.chi2 = current_chi2;
+  result.status = status;
+}
+
+void CaloWaveformFitter::Fit(const float *waveforms, int nchannels, Result *results, int stride)
+{
+  if (nchannels <= 0) return;
+  if (stride <= 0) stride = _nsamples;
+  assert(stride >= _nsamples);
+
+  if (!_executor || nchannels < 2 * _nthreads)
+  {
+    for (int ich = 0; ich < nchannels; ich++)
+    {
+      FitChannel(waveforms + (size_t) ich * stride, results[ich], 0);
+    }
+    return;
+  }
+
+  // contiguous channel ranges, one per thread and workspace
+  const int chunk = (nchannels + _nthreads - 1) / _nthreads;
+  auto fit_range = [&](unsigned int ithread) {
+    const int first = ithread * chunk;
+    const int last = std::min(nchannels, first + chunk);
+    for (int ich = first; ich < last; ich++)
+    {
+      FitChannel(waveforms + (size_t) ich * stride, results[ich], ithread);
+    }
+  };
+  _executor->Foreach(fit_range, ROOT::TSeqU(_nthreads));
+}
@@ -0,0 +1,85 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef PROTOTYPE4_CALOWAVEFORMFITTER_H
+#define PROTOTYPE4_CALOWAVEFORMFITTER_H
+
+#include <memory>
+#include <vector>
+
+class TProfile;
+
+namespace ROOT
+{
+  class TThreadExecutor;
+}
+
+//! Template fit engine for batches of calorimeter waveforms.
+//!
+//! Fits f(t) = amplitude * T(t - time) + pedestal, with T the linearly
+//! interpolated pulse template, using a closed-form Levenberg-Marquardt
+//! step on the 3x3 normal equations. The chi2 definition (sample at bin
+//! center, weight 1/|ADC|) and the initial guesses follow the GSLMultiFit
+//! path of CaloTemplateFit, so both converge to the same minimum.
+//! macros/CompareWaveformFits.C checks this against GSLMultiFit on toy
+//! waveforms (amplitude and pedestal within 0.1%, time within 0.05
+//! samples) and times both.
+//!
+//! All scratch memory is allocated once per thread in the constructor /
+//! set_nsamples(); Fit() itself does not allocate.
+class CaloWaveformFitter
+{
+ public:
+  struct Result
+  {
+    float amplitude;
+    float time;
+    float pedestal;
+    float chi2;
+    int status;  //! 0: converged, 1: max iterations reached, -1: no valid samples
+  };
+
+  CaloWaveformFitter(const TProfile *h_template, int nsamples, int nthreads = 1);
+  virtual ~CaloWaveformFitter();
+
+  void set_nsamples(int nsamples);
+  int get_nsamples() const { return _nsamples; }
+  int get_nthreads() const { return _nthreads; }
+
+  void set_max_iterations(int n) { _max_iterations = n; }
+  void set_tolerance(double tol) { _tolerance = tol; }
+
+  //! analytic template value and derivative, identical to TProfile::Interpolate
+  double template_value(double x) const;
+  double template_value(double x, double &derivative) const;
+
+  //! fit nchannels waveforms stored contiguously as [channel][sample],
+  //! channels stride samples apart (default: nsamples)
+  void Fit(const float *waveforms, int nchannels, Result *results, int stride = 0);
+
+  //! fit a single waveform using the workspace of thread ithread
+  void FitChannel(const float *samples, Result &result, int ithread = 0);
+
+ private:
+  struct Workspace
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> w;
+  };
+
+  double chi2(const Workspace &ws, int npoints, const double *par) const;
+
+  std::vector<double> _template;
+  double _template_x0;
+  double _template_dx;
+
+  int _nsamples;
+  int _nthreads;
+  int _max_iterations;
+  double _tolerance;
+
+  std::vector<Workspace> _workspaces;
+  std::unique_ptr<ROOT::TThreadExecutor> _executor;
+};
+
+#endif
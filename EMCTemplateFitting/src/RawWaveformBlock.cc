@@ -0,0 +1,51 @@
+#include "RawWaveformBlock.h"
+
+#include <cassert>
+
+using namespace std;
+
+RawWaveformBlock::RawWaveformBlock(int nsamples)
+  : _nsamples(nsamples)
+{
+  assert(nsamples > 0);
+}
+
+void RawWaveformBlock::Reset()
+{
+  // keep the capacity, the next event has the same channels
+  _keys.clear();
+  _HBD_channels.clear();
+  _samples.clear();
+}
+
+void RawWaveformBlock::identify(std::ostream &os) const
+{
+  os << "RawWaveformBlock: " << size() << " channels, " << _nsamples
+     << " samples per channel" << std::endl;
+}
+
+void RawWaveformBlock::resize(unsigned int nchannels)
+{
+  _keys.resize(nchannels, ~0);
+  _HBD_channels.resize(nchannels, -1);
+  _samples.resize(nchannels * _nsamples, -9999);
+}
+
+void RawWaveformBlock::set_channel(unsigned int i, RawTowerDefs::keytype key,
+                                   int hbd_channel)
+{
+  assert(i < size());
+  _keys[i] = key;
+  _HBD_channels[i] = hbd_channel;
+}
+
+RawWaveformBlock::ChannelView RawWaveformBlock::get_channel(unsigned int i) const
+{
+  assert(i < size());
+  ChannelView view;
+  view.samples = get_samples(i);
+  view.nsamples = _nsamples;
+  view.key = _keys[i];
+  view.HBD_channel = _HBD_channels[i];
+  return view;
+}
@@ -0,0 +1,73 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef PROTOTYPE4_RAWWAVEFORMBLOCK_H
+#define PROTOTYPE4_RAWWAVEFORMBLOCK_H
+
+#include "PROTOTYPE4_FEM.h"
+
+#include <calobase/RawTowerDefs.h>
+
+#include <phool/PHObject.h>
+
+#include <iostream>  // for cout, ostream
+#include <vector>
+
+//! Signal samples of all channels of one calorimeter in a single
+//! contiguous [channel][sample] buffer, filled by CaloUnpackPRDF in
+//! waveform block mode. Each channel carries the key of the matching
+//! tower in the RawTowerContainer and its HBD channel number.
+//! The buffers keep their capacity across Reset(), so after the first
+//! event unpacking does not allocate.
+class RawWaveformBlock : public PHObject
+{
+ public:
+  typedef float signal_type;
+
+  //! lightweight per-channel access into the block, valid until the
+  //! block is resized
+  struct ChannelView
+  {
+    const signal_type *samples;
+    int nsamples;
+    RawTowerDefs::keytype key;
+    int HBD_channel;
+
+    signal_type operator[](int i) const { return samples[i]; }
+  };
+
+  RawWaveformBlock(int nsamples = PROTOTYPE4_FEM::NSAMPLES);
+  virtual ~RawWaveformBlock() {}
+
+  void Reset() override;
+  int isValid() const override { return size() > 0; }
+  void identify(std::ostream &os = std::cout) const override;
+
+  int get_nsamples() const { return _nsamples; }
+  unsigned int size() const { return _keys.size(); }
+
+  //! set the number of channels, samples of new channels are -9999
+  void resize(unsigned int nchannels);
+
+  void set_channel(unsigned int i, RawTowerDefs::keytype key, int hbd_channel);
+  RawTowerDefs::keytype get_key(unsigned int i) const { return _keys[i]; }
+  int get_HBD_channel_number(unsigned int i) const { return _HBD_channels[i]; }
+
+  //! samples of channel i, nsamples consecutive values
+  signal_type *get_samples(unsigned int i) { return &_samples[i * _nsamples]; }
+  const signal_type *get_samples(unsigned int i) const { return &_samples[i * _nsamples]; }
+
+  //! the whole block, size() * get_nsamples() values
+  const signal_type *data() const { return _samples.data(); }
+
+  ChannelView get_channel(unsigned int i) const;
+
+ protected:
+  int _nsamples;
+  std::vector<RawTowerDefs::keytype> _keys;
+  std::vector<int> _HBD_channels;
+  std::vector<signal_type> _samples;
+
+  ClassDefOverride(RawWaveformBlock, 1)
+};
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <CLHEP/Vector/ThreeVector.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <sstream>
@@ -69,6 +70,7 @@ int RawClusterPositionCorrectionFull::InitRun(PHCompositeNode *topNode)
   // set bin boundaries eta
   // there are 24 blocks in eta and each block is consists of 4 towers in 2x2 form which results in 24x2=48 towers in eta
   // we further subdivide each tower into 8x8 which results in 48x8=384 correction factors in eta
+  binvals_eta.clear();
   for (int j = 0; j < bins_eta; j++)
   {
     // binvals_eta.push_back(j * tower_eta_mid /(bins_eta - 1.));
@@ -78,40 +80,209 @@ int RawClusterPositionCorrectionFull::InitRun(PHCompositeNode *topNode)
   // set bin boundaries phi
   // there are 4 blocks in phi per sector and each block is consists of 4 towers in 2x2 form which results in 4x2=8 bins in phi
   // we further subdivide each tower into 8x8 which results in 8x8=64 correction factors in phi
+  binvals_phi.clear();
   for (int j = 0; j < bins_phi; j++)
   {
     binvals_phi.push_back(sector_phi_boundary_low + j * sector_phi_boundary_width / (bins_phi - 1.));
   }
 
+  eta_binning.Set(binvals_eta);
+  phi_binning.Set(binvals_phi);
+
+  // flat tables, eta major
+  eclus_calib_constants.clear();
+  ecore_calib_constants.clear();
   for (int i = 0; i < bins_eta - 1; i++)
   {
-    std::vector<double> dumvec;
-
     for (int j = 0; j < bins_phi - 1; j++)
     {
       std::ostringstream calib_const_name;
       calib_const_name.str("");
       calib_const_name << "recalib_const_eta" << i << "_phi" << j;
-      dumvec.push_back(_eclus_calib_params.get_double_param(calib_const_name.str()));
+      eclus_calib_constants.push_back(_eclus_calib_params.get_double_param(calib_const_name.str()));
+      ecore_calib_constants.push_back(_ecore_calib_params.get_double_param(calib_const_name.str()));
     }
-    eclus_calib_constants.push_back(dumvec);
   }
 
-  for (int i = 0; i < bins_eta - 1; i++)
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void RawClusterPositionCorrectionFull::Binning::Set(const std::vector<double> &bin_edges)
+{
+  edges = bin_edges;
+  uniform = false;
+  inv_width = 0;
+  if (edges.size() < 2 || !(edges.back() > edges.front()))
   {
-    std::vector<double> dumvec;
+    return;
+  }
 
-    for (int j = 0; j < bins_phi - 1; j++)
+  const int nbins = edges.size() - 1;
+  const double width = (edges.back() - edges.front()) / nbins;
+  uniform = true;
+  for (int j = 0; j <= nbins; j++)
+  {
+    if (std::fabs(edges[j] - (edges.front() + j * width)) > 1e-9 * width)
     {
-      std::ostringstream calib_const_name;
-      calib_const_name.str("");
-      calib_const_name << "recalib_const_eta" << i << "_phi" << j;
-      dumvec.push_back(_ecore_calib_params.get_double_param(calib_const_name.str()));
+      uniform = false;
     }
-    ecore_calib_constants.push_back(dumvec);
   }
+  inv_width = 1. / width;
+}
 
-  return Fun4AllReturnCodes::EVENT_OK;
+int RawClusterPositionCorrectionFull::Binning::Find(double x) const
+{
+  if (edges.size() < 2 || !(x >= edges.front() && x < edges.back()))
+  {
+    return -1;
+  }
+
+  if (!uniform)
+  {
+    return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+  }
+
+  // the computed bin can be one off from rounding, the stored edges decide
+  const int nbins = edges.size() - 1;
+  int bin = std::min(std::max(static_cast<int>((x - edges.front()) * inv_width), 0), nbins - 1);
+  while (bin > 0 && x < edges[bin])
+  {
+    --bin;
+  }
+  while (bin < nbins - 1 && x >= edges[bin + 1])
+  {
+    ++bin;
+  }
+  return bin;
+}
+
+double RawClusterPositionCorrectionFull::FoldEta(double eta) const
+{
+  eta = std::fabs(eta);
+  // accounts for floating point error
+  if (eta >= cluster_eta_max) eta = cluster_eta_max;
+  return eta;
+}
+
+double RawClusterPositionCorrectionFull::FoldPhi(double phi) const
+{
+  // accounts for floating point error
+  if (phi >= M_PI || phi < -M_PI) phi = -M_PI;
+
+  // map phi [-pi, pi) -> [-pi/32, pi/32)
+  double fmodphi = phi + ceil((sector_phi_boundary_low - phi) / sector_phi_boundary_width) * sector_phi_boundary_width;
+
+  // accounts for floating point error
+  if (fmodphi < sector_phi_boundary_low || fmodphi >= sector_phi_boundary_high) fmodphi = sector_phi_boundary_low;
+  return fmodphi;
+}
+
+int RawClusterPositionCorrectionFull::EtaBin(double eta) const
+{
+  if (eta == cluster_eta_max) return eta_binning.Bins() - 1;
+  return eta_binning.Find(eta);
+}
+
+void RawClusterPositionCorrectionFull::InterpolationCells(double eta, double fmodphi, int index[4], double weight[4]) const
+{
+  const int netabins = eta_binning.Bins();
+  const int nphibins = phi_binning.Bins();
+
+  // eta: constant beyond the outer bin centers, |eta| is symmetric around 0
+  const int etabin = EtaBin(eta);
+  int eta0 = eta < eta_binning.Center(etabin) ? etabin - 1 : etabin;
+  int eta1 = eta0 + 1;
+  double teta = 0;
+  if (eta0 < 0)
+  {
+    eta0 = eta1 = 0;
+  }
+  else if (eta1 >= netabins)
+  {
+    eta0 = eta1 = netabins - 1;
+  }
+  else
+  {
+    teta = (eta - eta_binning.Center(eta0)) / (eta_binning.Center(eta1) - eta_binning.Center(eta0));
+  }
+
+  // phi: every sector has the same constants, continue into the neighbouring sector
+  const int phibin = phi_binning.Find(fmodphi);
+  int phi0 = fmodphi < phi_binning.Center(phibin) ? phibin - 1 : phibin;
+  int phi1 = phi0 + 1;
+  double center0 = 0;
+  double center1 = 0;
+  if (phi0 < 0)
+  {
+    phi0 = nphibins - 1;
+    center0 = phi_binning.Center(phi0) - sector_phi_boundary_width;
+    center1 = phi_binning.Center(phi1);
+  }
+  else if (phi1 >= nphibins)
+  {
+    phi1 = 0;
+    center0 = phi_binning.Center(phi0);
+    center1 = phi_binning.Center(phi1) + sector_phi_boundary_width;
+  }
+  else
+  {
+    center0 = phi_binning.Center(phi0);
+    center1 = phi_binning.Center(phi1);
+  }
+  const double tphi = (fmodphi - center0) / (center1 - center0);
+
+  index[0] = eta0 * nphibins + phi0;
+  index[1] = eta0 * nphibins + phi1;
+  index[2] = eta1 * nphibins + phi0;
+  index[3] = eta1 * nphibins + phi1;
+  weight[0] = (1 - teta) * (1 - tphi);
+  weight[1] = (1 - teta) * tphi;
+  weight[2] = teta * (1 - tphi);
+  weight[3] = teta * tphi;
+}
+
+void RawClusterPositionCorrectionFull::GetCalibConstants(size_t n, const double *eta, const double *phi,
+                                                         double *eclus_recalib, double *ecore_recalib) const
+{
+  const int nphibins = phi_binning.Bins();
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double foldeta = FoldEta(eta[i]);
+    const double fmodphi = FoldPhi(phi[i]);
+
+    eclus_recalib[i] = 1;
+    ecore_recalib[i] = 1;
+
+    const int etabin = EtaBin(foldeta);
+    const int phibin = phi_binning.Find(fmodphi);
+    if (phibin < 0 || etabin < 0)
+    {
+      if (Verbosity())
+        std::cout << "couldn't recalibrate cluster, something went wrong??" << std::endl;
+      continue;
+    }
+
+    if (!_interpolate)
+    {
+      eclus_recalib[i] = eclus_calib_constants[etabin * nphibins + phibin];
+      ecore_recalib[i] = ecore_calib_constants[etabin * nphibins + phibin];
+      continue;
+    }
+
+    int index[4];
+    double weight[4];
+    InterpolationCells(foldeta, fmodphi, index, weight);
+    double eclus = 0;
+    double ecore = 0;
+    for (int k = 0; k < 4; ++k)
+    {
+      eclus += weight[k] * eclus_calib_constants[index[k]];
+      ecore += weight[k] * ecore_calib_constants[index[k]];
+    }
+    eclus_recalib[i] = eclus;
+    ecore_recalib[i] = ecore;
+  }
 }
 
 int RawClusterPositionCorrectionFull::process_event(PHCompositeNode *topNode)
@@ -143,53 +314,36 @@ int RawClusterPositionCorrectionFull::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
-  // loop over the clusters
+  // collect the cluster positions, then look up the constants for all clusters at once
+  _batch_clusters.clear();
+  _batch_eta.clear();
+  _batch_phi.clear();
+
   RawClusterContainer::ConstRange begin_end = rawclusters->getClusters();
   RawClusterContainer::ConstIterator iter;
 
   for (iter = begin_end.first; iter != begin_end.second; ++iter)
   {
     RawCluster *cluster = iter->second;
+    _batch_clusters.push_back(cluster);
+    _batch_eta.push_back(RawClusterUtility::GetPseudorapidity(*cluster, CLHEP::Hep3Vector(0,0,0)));
+    _batch_phi.push_back(cluster->get_phi());
+  }
 
-    double clus_energy = cluster->get_energy();
-    double phi = cluster->get_phi();
-    double eta = abs(RawClusterUtility::GetPseudorapidity(*cluster, CLHEP::Hep3Vector(0,0,0)));
-    // accounts for floating point error
-    if(phi >= M_PI || phi < -M_PI) phi = -M_PI;
-    if(eta >= cluster_eta_max) eta = cluster_eta_max;
-
-    // map phi [-pi, pi) -> [-pi/32, pi/32)
-    double fmodphi = phi + ceil((sector_phi_boundary_low - phi) / sector_phi_boundary_width) * sector_phi_boundary_width;
-
-    // accounts for floating point error
-    if(fmodphi < sector_phi_boundary_low || fmodphi >= sector_phi_boundary_high) fmodphi = sector_phi_boundary_low;
-
-    int etabin = -99;
-    int phibin = -99;
-
-    for (int j = 0; j < bins_phi - 1; ++j) // TODO: Implement in binary search.
-      if (fmodphi >= binvals_phi.at(j) && fmodphi < binvals_phi.at(j + 1))
-        phibin = j;
-
-    for (int j = 0; j < bins_eta - 1; ++j)
-      if (eta >= binvals_eta.at(j) && eta < binvals_eta.at(j + 1))
-        etabin = j;
+  const size_t nclusters = _batch_clusters.size();
+  _batch_eclus_recalib.resize(nclusters);
+  _batch_ecore_recalib.resize(nclusters);
+  GetCalibConstants(nclusters, _batch_eta.data(), _batch_phi.data(),
+                    _batch_eclus_recalib.data(), _batch_ecore_recalib.data());
 
-    if(eta == cluster_eta_max) etabin = bins_eta-2;
+  for (size_t i = 0; i < nclusters; ++i)
+  {
+    RawCluster *cluster = _batch_clusters[i];
 
-    if ((phibin < 0 || etabin < 0) && Verbosity())
-    {
-      if (Verbosity())
-        std::cout << "couldn't recalibrate cluster, something went wrong??" << std::endl;
-    }
+    double clus_energy = cluster->get_energy();
+    double eclus_recalib_val = _batch_eclus_recalib[i];
+    double ecore_recalib_val = _batch_ecore_recalib[i];
 
-    double eclus_recalib_val = 1;
-    double ecore_recalib_val = 1;
-    if (phibin > -1 && etabin > -1)
-    {
-      eclus_recalib_val = eclus_calib_constants.at(etabin).at(phibin);
-      ecore_recalib_val = ecore_calib_constants.at(etabin).at(phibin);
-    }
     RawCluster *recalibcluster = dynamic_cast<RawCluster *>(cluster->CloneMe());
     assert(recalibcluster);
     recalibcluster->set_energy(clus_energy / eclus_recalib_val);
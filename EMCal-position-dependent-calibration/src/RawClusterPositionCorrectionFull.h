@@ -10,6 +10,7 @@
 #include <math.h>
 
 class PHCompositeNode;
+class RawCluster;
 class RawClusterContainer;
 
 class RawClusterPositionCorrectionFull : public SubsysReco
@@ -49,7 +50,42 @@ class RawClusterPositionCorrectionFull : public SubsysReco
     _ecore_calib_params = calib_params;
   }
 
+  // interpolate the constants bilinearly between bin centers instead of
+  // using the constant of the bin, off by default
+  void Set_Interpolation(bool interpolate)
+  {
+    _interpolate = interpolate;
+  }
+
+  // eclus and ecore recalibration constants for n clusters at eta and phi,
+  // 1 where no constant applies. Available after InitRun
+  void GetCalibConstants(size_t n, const double *eta, const double *phi,
+                         double *eclus_recalib, double *ecore_recalib) const;
+
  private:
+  // bin boundaries of one axis, the bin of a value is computed directly
+  // when the boundaries are equidistant and searched otherwise
+  struct Binning
+  {
+    std::vector<double> edges;
+    bool uniform = false;
+    double inv_width = 0;
+
+    void Set(const std::vector<double> &bin_edges);
+    // bin with edges[bin] <= x < edges[bin+1], -1 outside
+    int Find(double x) const;
+    int Bins() const { return edges.size() - 1; }
+    double Center(int bin) const { return 0.5 * (edges[bin] + edges[bin + 1]); }
+  };
+
+  // |eta| clamped to the table, phi mapped into the sector
+  double FoldEta(double eta) const;
+  double FoldPhi(double phi) const;
+  int EtaBin(double eta) const;
+
+  // bilinear weights of the (up to) four bins around eta, phi
+  void InterpolationCells(double eta, double fmodphi, int index[4], double weight[4]) const;
+
   PHParameters _eclus_calib_params;
   PHParameters _ecore_calib_params;
   void SetDefaultParameters(PHParameters &param);
@@ -65,8 +101,21 @@ class RawClusterPositionCorrectionFull : public SubsysReco
   int bins_eta, bins_phi;
   std::vector<double> binvals_eta;
   std::vector<double> binvals_phi;
-  std::vector<std::vector<double> > eclus_calib_constants;
-  std::vector<std::vector<double> > ecore_calib_constants;
+  Binning eta_binning;
+  Binning phi_binning;
+
+  // constants of bin (eta i, phi j) at i * (bins_phi - 1) + j
+  std::vector<double> eclus_calib_constants;
+  std::vector<double> ecore_calib_constants;
+
+  bool _interpolate = false;
+
+  // per event buffers of the batched correction
+  std::vector<RawCluster *> _batch_clusters;
+  std::vector<double> _batch_eta;
+  std::vector<double> _batch_phi;
+  std::vector<double> _batch_eclus_recalib;
+  std::vector<double> _batch_ecore_recalib;
 };
 
 #endif
@@ -91,6 +91,7 @@ ElectronID::ElectronID(const std::string& name, const std::string &filename) : S
   BDT_cut_n = 0.0;
   ISUSE_BDT_p =0;
   ISUSE_BDT_n =0;
+  BDT_threads = 1;
 
  // unsigned int _nlayers_maps = 3;
  // unsigned int _nlayers_intt = 4;
@@ -137,6 +138,17 @@ int ElectronID::InitRun(PHCompositeNode* topNode)
   int ret = GetNodes(topNode);
   if (ret != Fun4AllReturnCodes::EVENT_OK) return ret;
 
+  // Boosted Decision Trees, uses Adaptive Boost; weights for positive and negative particles
+  if (ISUSE_BDT_p && ISUSE_BDT_n) {
+    if (!bdt_positive.load("dataset/Weights_positive/TMVAClassification_BDT.weights.xml") ||
+        !bdt_negative.load("dataset/Weights_negative/TMVAClassification_BDT.weights.xml")) {
+      cerr << PHWHERE << " ERROR: Can not load the BDT weights." << endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    bdt_positive.setNumberOfThreads(BDT_threads);
+    bdt_negative.setNumberOfThreads(BDT_threads);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -198,59 +210,11 @@ int ElectronID::process_event(PHCompositeNode* topNode)
 // end Truth
 
 
-//MVA method setup**********************
-
-  // This loads the library
-   TMVA::Tools::Instance();
-
-   // Default MVA methods with trained + tested
-   std::map<std::string,int> Use_p;
-   std::map<std::string,int> Use_n;
-   // Boosted Decision Trees
-   Use_p["BDT"] = ISUSE_BDT_p; // uses Adaptive Boost; for positive particles
-   Use_n["BDT"] = ISUSE_BDT_n; // uses Adaptive Boost; for negative particles
-
-  // Create the Reader object
-
-   TMVA::Reader *reader_positive = new TMVA::Reader( "!Color:!Silent" );
-   TMVA::Reader *reader_negative = new TMVA::Reader( "!Color:!Silent" );
-
-   // Create a set of variables and declare them to the reader
-   // - the variable names MUST corresponds in name and type to those given in the weight file(s) used
-   Float_t var1_p, var2_p, var3_p;
-   Float_t var1_n, var2_n, var3_n;
-   reader_positive->AddVariable( "var1_p", &var1_p );
-   reader_positive->AddVariable( "var2_p", &var2_p );
-   reader_positive->AddVariable( "var3_p", &var3_p );
-
-   reader_negative->AddVariable( "var1_n", &var1_n );
-   reader_negative->AddVariable( "var2_n", &var2_n );
-   reader_negative->AddVariable( "var3_n", &var3_n );
-
-  // Book the MVA methods
-   TString dir_p, dir_n;
-   dir_p = "dataset/Weights_positive/"; // weights for positive particles
-   dir_n = "dataset/Weights_negative/"; // weights for negative particles
-   TString prefix = "TMVAClassification";
-
-   // Book method(s)
-   for (std::map<std::string,int>::iterator it = Use_p.begin(); it != Use_p.end(); it++) {
-      if (it->second) {
-         TString methodName_p = TString(it->first) + TString(" method");
-         TString weightfile_p = dir_p + prefix + TString("_") + TString(it->first) + TString(".weights.xml");
-         reader_positive->BookMVA( methodName_p, weightfile_p );
-      }
-   }
-   
-   for (std::map<std::string,int>::iterator it = Use_n.begin(); it != Use_n.end(); it++) {
-      if (it->second) {
-         TString methodName_n = TString(it->first) + TString(" method");
-         TString weightfile_n = dir_n + prefix + TString("_") + TString(it->first) + TString(".weights.xml");
-         reader_negative->BookMVA( methodName_n, weightfile_n );
-      }
-   }
-
-//end of MVA method setup*******************
+//MVA valuables; the BDTs are evaluated for all selected tracks of the event at once, after the track loop
+   Float_t var_p[3] = {0., 0., 0.};
+   Float_t var_n[3] = {0., 0., 0.};
+   std::vector<float> bdt_input_p, bdt_input_n;
+   std::vector<unsigned int> bdt_trackid;
 
   int nmvtx = 0;
   int nintt = 0;
@@ -325,27 +289,21 @@ int ElectronID::process_event(PHCompositeNode* topNode)
     //MVA valuables
      if(cemceoverp>0.0 && cemceoverp<10.0 && hcalineovercemce>0.0 && hcalineovercemce<10.0){
          if(charge>0){
-             var1_p = cemceoverp;
-             var2_p = hcalineovercemce;
-             var3_p = cemc_chi2;
+             var_p[0] = cemceoverp;
+             var_p[1] = hcalineovercemce;
+             var_p[2] = cemc_chi2;
           }
          if(charge<0){
-             var1_n = cemceoverp;
-             var2_n = hcalineovercemce;
-             var3_n = cemc_chi2;
+             var_n[0] = cemceoverp;
+             var_n[1] = hcalineovercemce;
+             var_n[2] = cemc_chi2;
           }
       }
     
-    if (Use_p["BDT"] && Use_n["BDT"] && quality < Nquality_higherlimit && nmvtx >= Nmvtx_lowerlimit && nintt >= Nintt_lowerlimit && ntpc >= Ntpc_lowerlimit && pt > Pt_lowerlimit && pt < Pt_higherlimit &&cemceoverp>0.0 && cemceoverp<10.0 && hcalineovercemce>0.0 && hcalineovercemce<10.0) {
-          float select_p=reader_positive->EvaluateMVA("BDT method");
-	  float select_n=reader_negative->EvaluateMVA("BDT method");
-          ntp[0] = select_p;
-          ntp[1] = select_n;
-	  if(output_ntuple) { ntpBDTresponse -> Fill(ntp); }
-          if(select_p>BDT_cut_p && select_n>BDT_cut_n){
-              // add to the association map
-	      _track_pid_assoc->addAssoc(TrackPidAssoc::electron, it->second->get_id());
-          }
+    if (ISUSE_BDT_p && ISUSE_BDT_n && quality < Nquality_higherlimit && nmvtx >= Nmvtx_lowerlimit && nintt >= Nintt_lowerlimit && ntpc >= Ntpc_lowerlimit && pt > Pt_lowerlimit && pt < Pt_higherlimit &&cemceoverp>0.0 && cemceoverp<10.0 && hcalineovercemce>0.0 && hcalineovercemce<10.0) {
+          bdt_input_p.insert(bdt_input_p.end(), var_p, var_p + 3);
+          bdt_input_n.insert(bdt_input_n.end(), var_n, var_n + 3);
+          bdt_trackid.push_back(it->second->get_id());
 
     }// end of BDT cut
     else{ // for traditional cuts
@@ -478,8 +436,23 @@ int ElectronID::process_event(PHCompositeNode* topNode)
 
     }//end of evet loop.
 
-  delete reader_positive;
-  delete reader_negative;
+  if(!bdt_trackid.empty()) {
+      std::vector<double> bdt_response_p, bdt_response_n;
+      bdt_positive.evaluate(bdt_input_p, bdt_response_p);
+      bdt_negative.evaluate(bdt_input_n, bdt_response_n);
+
+      for(unsigned int i = 0; i < bdt_trackid.size(); i++) {
+          float select_p = bdt_response_p[i];
+          float select_n = bdt_response_n[i];
+          ntp[0] = select_p;
+          ntp[1] = select_n;
+	  if(output_ntuple) { ntpBDTresponse -> Fill(ntp); }
+          if(select_p>BDT_cut_p && select_n>BDT_cut_n){
+              // add to the association map
+	      _track_pid_assoc->addAssoc(TrackPidAssoc::electron, bdt_trackid[i]);
+          }
+      }
+  }
   
   // Read back the association map
   if(Verbosity() > 1)
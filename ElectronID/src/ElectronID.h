@@ -25,6 +25,8 @@
 #include "TMVA/Reader.h"
 #include <TMVA/MethodCuts.h>
 
+#include <flatbdtforest/FlatBDTForest.h>
+
 // forward declarations
 class PHCompositeNode;
 class SvtxTrackMap;
@@ -74,6 +76,9 @@ public:
   /// set MVA cut
   void setBDTcut(int isuseBDT_p, int isuseBDT_n, float bdtcut_p, float bdtcut_n) {ISUSE_BDT_p= isuseBDT_p; ISUSE_BDT_n= isuseBDT_n; BDT_cut_p = bdtcut_p; BDT_cut_n = bdtcut_n;}
 
+  /// set the number of threads used to evaluate the BDT for all tracks of an event
+  void setBDTthreads(unsigned int nthreads) {BDT_threads = nthreads;}
+
 
 protected:
   bool output_ntuple;
@@ -135,6 +140,10 @@ PHG4Particle* findMCmatch(SvtxTrack* track, PHG4TruthInfoContainer* truth_contai
 /// MVA cut 
   float BDT_cut_p, BDT_cut_n;
   int ISUSE_BDT_p, ISUSE_BDT_n;//0 for no; 1 for yes
+  unsigned int BDT_threads;
+
+/// BDTs for positive and negative particles, loaded once per run
+  FlatBDTForest bdt_positive, bdt_negative;
 
   unsigned int _nlayers_maps = 3;
   unsigned int _nlayers_intt = 4;
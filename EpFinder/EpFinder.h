@@ -51,6 +51,22 @@ class TProfile2D;
  *      That takes care of the shifting weights.
  * 3) You are good to go.
  *
+ * Alternatively, call SetOnlineCalibration() and do it all in ONE pass.
+ *  The phi weights, a recentering <Q> per EventType and the shift coefficients
+ *  are then accumulated as the events come in, and applied once they are
+ *  based on at least "warmUpEvents" events:
+ *  - phi weights after warmUpEvents events in total,
+ *  - recentering after warmUpEvents phi-weighted events (i.e. after the phi
+ *    weight warm-up) of the same EventType,
+ *  - shifting after warmUpEvents recentered events of the same EventType.
+ *  In this mode PhiWeightedPsi() is the phi-weighted AND recentered plane,
+ *  and PhiWeightedAndShiftedPsi() is that plane shifted with the running
+ *  coefficients.  The accumulators can be checkpointed to a file, and are
+ *  read back from it if it exists, so that a production can be resumed;
+ *  the caller then skips the ResumedInputEvents() events already in it.
+ *  The output correction file holds the final calibration, as for the
+ *  multi-pass procedure, and Finish() removes the checkpoint.
+ *
  *
  * ------------------------------------------
  * This class creates some histograms and uses some histograms.  Since I use GetBinContent()
@@ -126,6 +142,21 @@ class EpFinder{
   /// \param MAX          maximum tile weight.  If epdHit->nMIP()>MAX then weight=MAX
   void SetMaxTileWeight(double MAX){mMax=MAX;};
 
+  /// calibrate on the fly instead of reading EpFinderCorrectionHistograms_INPUT.root
+  /// \param warmUpEvents        number of events a running correction needs before it is applied
+  /// \param CheckpointFileName  if given, calibration state is read from it (if it exists) and written by Checkpoint().
+  ///                            Finish() removes it once the output file is written, so a finished job is never resumed
+  /// \param checkpointInterval  if >0, Checkpoint() is called every checkpointInterval events
+  void SetOnlineCalibration(int warmUpEvents=500, char const* CheckpointFileName=0, int checkpointInterval=0);
+
+  /// write the running calibration state to the checkpoint file
+  /// \param inputEvents  input events the caller has read so far, i.e. how many to skip on resume (default: events seen here)
+  void Checkpoint(long inputEvents=-1);
+
+  /// input events already done by the checkpoint read in SetOnlineCalibration(), 0 on a fresh start.
+  /// The caller has to skip these, otherwise they are counted twice
+  long ResumedInputEvents() const {return mResumedInputEvents;}
+
   /// call this method at the end of your run to output correction histograms to a file (you can choose to use these or not)
   ///   and to calculate EP resolutions
   void Finish();
@@ -150,6 +181,8 @@ class EpFinder{
 
   double GetPsiInRange(double Qx, double Qy, int order);
 
+  double OnlinePhiWeight(int ix, int iy);    // running phi weight, 1 during warm up
+
   int mNumberOfEventTypeBins;                // user-defined.  Default is 10.  Used for correction histograms
 
   // tile weight = (0 if ADC< thresh), (MAX if ADC>MAX); (ADC otherwise).
@@ -172,6 +205,16 @@ class EpFinder{
   TH2D* mPhiWeightOutput;
   TH2D* mPhiAveraged;
 
+  //   online calibration: running <Q> per EventType, the running shift
+  //   coefficients are the mEpShiftOutput profiles themselves
+  bool mOnline;
+  int mWarmUpEvents;
+  int mCheckpointInterval;
+  long mNumberOfEvents;
+  long mResumedInputEvents;
+  TString mCheckpointFileName;
+  TProfile* mQRecenterOutput[_EpOrderMax][2];   // [order][x,y] vs EventTypeId
+
 };
 
 #endif
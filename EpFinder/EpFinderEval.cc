@@ -85,6 +85,10 @@ EpFinderEval::EpFinderEval(const string &name) :
 	//initialize
 	_event = 0;
 	_outfile_name = "EpFinder_Eval.root";
+	_online_warmup = -1;
+	_online_checkpoint_interval = 0;
+	_checkpoint_dir = "";
+	_skip_events = 0;
 	RpFinder = NULL; 
 	RpFinderL = NULL; 
 	RpFinderR = NULL; 
@@ -163,6 +167,25 @@ int EpFinderEval::Init(PHCompositeNode *topNode) {
 				     FPRIM_PHI_BINS, RFPRIM_ETA_BINS); 
 	cout << rfprimRpFinder->Report() << endl; 
 
+	if(_online_warmup>=0){
+	  EpFinder *finders[7] = {RpFinder, rRpFinder, RpFinderL, RpFinderR, primRpFinder, fprimRpFinder, rfprimRpFinder};
+	  const char *prefix[7] = {"", "r", "L_", "R_", "prim", "fprim", "rfprim"};
+	  string dir = _checkpoint_dir;
+	  if(!dir.empty() && dir[dir.size()-1]!='/') dir += "/";
+	  //checkpoints are written here for all finders at once, so they all resume at the same input event
+	  for(int i=0; i<7; i++){
+	    finders[i]->SetOnlineCalibration(_online_warmup, Form("%s%sEpFinderCalibrationCheckpoint.root",dir.c_str(),prefix[i]), 0);
+	  }
+	  _skip_events = finders[0]->ResumedInputEvents();
+	  for(int i=1; i<7; i++){
+	    if(finders[i]->ResumedInputEvents()!=_skip_events){
+	      cout << "EpFinderEval::Init - checkpoints in '" << dir << "' are from different events, remove them to start over" << endl;
+	      return Fun4AllReturnCodes::ABORTRUN;
+	    }
+	  }
+	  if(_skip_events>0) cout << "EpFinderEval::Init - resuming, skipping the first " << _skip_events << " events" << endl;
+	}
+
 	return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -182,13 +205,25 @@ int EpFinderEval::InitRun(PHCompositeNode *topNode) {
 int EpFinderEval::process_event(PHCompositeNode *topNode) {
 	_event++;
 
+	//already in the calibration we resumed from
+	if(_event<=_skip_events) return Fun4AllReturnCodes::ABORTEVENT;
+
 	GetNodes(topNode);
 
 	fill_tree(topNode);
 
+	if(_online_warmup>=0 && _online_checkpoint_interval>0 && (_event%_online_checkpoint_interval)==0) Checkpoint();
+
 	return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void EpFinderEval::Checkpoint() {
+	EpFinder *finders[7] = {RpFinder, rRpFinder, RpFinderL, RpFinderR, primRpFinder, fprimRpFinder, rfprimRpFinder};
+	for(int i=0; i<7; i++){
+	  finders[i]->Checkpoint(_event);
+	}
+}
+
 //----------------------------------------------------------------------------//
 //-- End():
 //--   End method, wrap everything up
@@ -205,6 +240,7 @@ int EpFinderEval::End(PHCompositeNode *topNode) {
 	RpFinderR->Finish(); 
 	primRpFinder->Finish(); 
 	fprimRpFinder->Finish(); 
+	rfprimRpFinder->Finish(); 
 	
 	delete RpFinder;
 	delete rRpFinder;
@@ -212,6 +248,7 @@ int EpFinderEval::End(PHCompositeNode *topNode) {
 	delete RpFinderR;
 	delete primRpFinder;	
 	delete fprimRpFinder;
+	delete rfprimRpFinder;
 
 	return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -44,6 +44,15 @@ class EpFinderEval: public SubsysReco
   void set_filename(const char* file)
   { if(file) _outfile_name = file; }
 
+  //Calibrate all event planes in a single pass, see EpFinder::SetOnlineCalibration
+  void set_online_calibration(int warmup_events, int checkpoint_interval = 0)
+  { _online_warmup = warmup_events; _online_checkpoint_interval = checkpoint_interval; }
+
+  //Change the directory of the online calibration checkpoint files, one
+  //<finder>EpFinderCalibrationCheckpoint.root per event plane finder (default: working directory)
+  void set_checkpoint_dir(const char* dir)
+  { if(dir) _checkpoint_dir = dir; }
+
  private:
   //output filename
   std::string _outfile_name;
@@ -51,6 +60,17 @@ class EpFinderEval: public SubsysReco
   //Event counter
   int _event;
 
+  //Online event plane calibration, off if warm-up < 0
+  int _online_warmup;
+  int _online_checkpoint_interval;
+  std::string _checkpoint_dir;
+
+  //Input events done by the checkpoints resumed from, skipped in process_event
+  long _skip_events;
+
+  //Checkpoint all event plane finders at the current input event
+  void Checkpoint();
+
   //User modules
   void fill_tree(PHCompositeNode*);
 
@@ -0,0 +1,127 @@
+#include "MixingPool.h"
+
+#include "sPHElectron.h"
+#include "sPHElectronv1.h"
+
+#include <TRandom.h>
+
+MixingPool::MixingPool(unsigned int nz, unsigned int ncent, unsigned int nep, unsigned int depth)
+  : _nz(nz)
+  , _ncent(ncent)
+  , _nep(nep)
+  , _depth(depth)
+{
+  const size_t nclass = (size_t) _nz * _ncent * _nep;
+  _storage.resize(nclass * _depth);
+  _head.assign(nclass, 0);
+  _count.assign(nclass, 0);
+}
+
+int MixingPool::get_class(unsigned int zbin, unsigned int centbin, unsigned int epbin) const
+{
+  if (zbin >= _nz || centbin >= _ncent || epbin >= _nep) return -1;
+  return (zbin * _ncent + centbin) * _nep + epbin;
+}
+
+const MixTrack& MixingPool::sample(int cls, TRandom* rng) const
+{
+  unsigned int i = rng->Integer(_count[cls]);
+  return at(cls, i);
+}
+
+void MixingPool::push(int cls, const MixTrack& trk)
+{
+  if (_depth == 0) return;
+  _storage[(size_t) cls * _depth + _head[cls]] = trk;
+  _head[cls] = (_head[cls] + 1) % _depth;
+  if (_count[cls] < _depth) _count[cls]++;
+}
+
+void MixingPool::stage(int cls, const MixTrack& trk)
+{
+  _staged.push_back(std::make_pair(cls, trk));
+}
+
+void MixingPool::commit()
+{
+  for (size_t i = 0; i < _staged.size(); i++)
+  {
+    push(_staged[i].first, _staged[i].second);
+  }
+  _staged.clear();
+}
+
+void MixingPool::clear()
+{
+  _staged.clear();
+  _head.assign(_head.size(), 0);
+  _count.assign(_count.size(), 0);
+}
+
+void MixingPool::fill(MixTrack& trk, const sPHElectron* el)
+{
+  trk.id = el->get_id();
+  trk.charge = el->get_charge();
+  trk.px = el->get_px();
+  trk.py = el->get_py();
+  trk.pz = el->get_pz();
+  trk.dphi = el->get_dphi();
+  trk.deta = el->get_deta();
+  trk.emce = el->get_emce();
+  trk.e3x3 = el->get_e3x3();
+  trk.e5x5 = el->get_e5x5();
+
+  trk.chi2 = el->get_chi2();
+  trk.ndf = el->get_ndf();
+  trk.zvtx = el->get_zvtx();
+  trk.dca2d = el->get_dca2d();
+  trk.dca2d_error = el->get_dca2d_error();
+  trk.dca3d_xy = el->get_dca3d_xy();
+  trk.dca3d_z = el->get_dca3d_z();
+
+  trk.nmvtx = el->get_nmvtx();
+  trk.ntpc = el->get_ntpc();
+
+  trk.cemc_ecore = el->get_cemc_ecore();
+  trk.cemc_chi2 = el->get_cemc_chi2();
+  trk.cemc_prob = el->get_cemc_prob();
+  trk.cemc_dphi = el->get_cemc_dphi();
+  trk.cemc_deta = el->get_cemc_deta();
+  trk.hcalin_e = el->get_hcalin_e();
+  trk.hcalin_dphi = el->get_hcalin_dphi();
+  trk.hcalin_deta = el->get_hcalin_deta();
+}
+
+void MixingPool::unpack(const MixTrack& trk, sPHElectronv1* el)
+{
+  el->set_id(trk.id);
+  el->set_charge(trk.charge);
+  el->set_px(trk.px);
+  el->set_py(trk.py);
+  el->set_pz(trk.pz);
+  el->set_dphi(trk.dphi);
+  el->set_deta(trk.deta);
+  el->set_emce(trk.emce);
+  el->set_e3x3(trk.e3x3);
+  el->set_e5x5(trk.e5x5);
+
+  el->set_chi2(trk.chi2);
+  el->set_ndf(trk.ndf);
+  el->set_zvtx(trk.zvtx);
+  el->set_dca2d(trk.dca2d);
+  el->set_dca2d_error(trk.dca2d_error);
+  el->set_dca3d_xy(trk.dca3d_xy);
+  el->set_dca3d_z(trk.dca3d_z);
+
+  el->set_nmvtx(trk.nmvtx);
+  el->set_ntpc(trk.ntpc);
+
+  el->set_cemc_ecore(trk.cemc_ecore);
+  el->set_cemc_chi2(trk.cemc_chi2);
+  el->set_cemc_prob(trk.cemc_prob);
+  el->set_cemc_dphi(trk.cemc_dphi);
+  el->set_cemc_deta(trk.cemc_deta);
+  el->set_hcalin_e(trk.hcalin_e);
+  el->set_hcalin_dphi(trk.hcalin_dphi);
+  el->set_hcalin_deta(trk.hcalin_deta);
+}
@@ -0,0 +1,101 @@
+#ifndef MIXINGPOOL_H
+#define MIXINGPOOL_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class sPHElectron;
+class sPHElectronv1;
+class TRandom;
+
+// Copy of every sPHElectronv1 quantity, so a partner unpacked from the pool
+// is identical to the electron that was pushed (the mixed-pair output uses
+// the calorimeter matching as well as the kinematics).
+// Plain data so the pool can be preallocated once and overwritten in place.
+struct MixTrack
+{
+  unsigned int id;
+  int charge;
+  double px;
+  double py;
+  double pz;
+  double dphi;
+  double deta;
+  double emce;
+  double e3x3;
+  double e5x5;
+
+  double chi2;
+  unsigned int ndf;
+  double zvtx;
+  double dca2d;
+  double dca2d_error;
+  double dca3d_xy;
+  double dca3d_z;
+
+  int nmvtx;
+  int ntpc;
+
+  double cemc_ecore;
+  double cemc_chi2;
+  double cemc_prob;
+  double cemc_dphi;
+  double cemc_deta;
+  double hcalin_e;
+  double hcalin_dphi;
+  double hcalin_deta;
+};
+
+// Fixed-capacity ring buffers of MixTrack, one per (z-vertex, centrality,
+// event-plane) class. Storage is allocated once in the constructor; once a
+// class is full the oldest entry is overwritten, so memory stays constant
+// regardless of the number of processed events.
+// All read access is const, so several mixing consumers can draw partners
+// from the same pool within one event. Tracks of the current event are
+// staged and only become visible to sample() after commit(), which the
+// owner calls once every consumer has mixed the event.
+class MixingPool
+{
+ public:
+  MixingPool(unsigned int nz, unsigned int ncent, unsigned int nep, unsigned int depth);
+  virtual ~MixingPool() {}
+
+  unsigned int get_nz() const { return _nz; }
+  unsigned int get_ncent() const { return _ncent; }
+  unsigned int get_nep() const { return _nep; }
+  unsigned int get_depth() const { return _depth; }
+
+  // returns -1 if any of the bins is out of range
+  int get_class(unsigned int zbin, unsigned int centbin, unsigned int epbin) const;
+
+  unsigned int size(int cls) const { return _count[cls]; }
+  bool is_full(int cls) const { return _count[cls] == _depth; }
+
+  const MixTrack& at(int cls, unsigned int i) const { return _storage[(size_t) cls * _depth + i]; }
+  // random entry of a class, the caller must ensure size(cls) > 0
+  const MixTrack& sample(int cls, TRandom* rng) const;
+
+  void push(int cls, const MixTrack& trk);
+  // push() deferred until commit()
+  void stage(int cls, const MixTrack& trk);
+  void commit();
+  void clear();
+
+  static void fill(MixTrack& trk, const sPHElectron* el);
+  static void unpack(const MixTrack& trk, sPHElectronv1* el);
+
+ protected:
+  unsigned int _nz;
+  unsigned int _ncent;
+  unsigned int _nep;
+  unsigned int _depth;
+
+  std::vector<MixTrack> _storage;
+  std::vector<unsigned int> _head;
+  std::vector<unsigned int> _count;
+
+  std::vector<std::pair<int, MixTrack> > _staged;
+};
+
+#endif
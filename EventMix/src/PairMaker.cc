@@ -61,6 +61,11 @@ PairMaker::PairMaker(const std::string &name, const std::string &filename) : Sub
   _multbins.push_back(9999.);
   _min_buffer_depth = 10;
   _max_buffer_depth = 50;
+  _num_mixes = 3;
+  _nep = 1;
+  _pool = nullptr;
+  _own_pool = true;
+  _fill_pool = true;
   outnodename = "ElectronPairs";
   _rng = nullptr;
   EventNumber=0;
@@ -68,12 +73,25 @@ PairMaker::PairMaker(const std::string &name, const std::string &filename) : Sub
 
 //==============================================================
 
+PairMaker::~PairMaker()
+{
+  if(_own_pool) delete _pool;
+  delete _rng;
+}
+
+//==============================================================
+
 int PairMaker::Init(PHCompositeNode *topNode) 
 {
 
   _rng = new TRandom2();
   _rng->SetSeed(0);
 
+  if(!_pool) {
+    _pool = new MixingPool(NZ, NCENT, _nep, _max_buffer_depth);
+    _own_pool = true;
+  }
+
   PHNodeIterator iter(topNode);
   PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
   if (!dstNode)
@@ -259,7 +277,6 @@ int PairMaker::process_event_test(PHCompositeNode *topNode) {
       tmpel.set_cemc_chi2(cemc_chi2);
 
       elepos.push_back(tmpel);
-      (_buffer[vtxbin][centbin]).push_back(tmpel);
 
     }
 
@@ -295,56 +312,80 @@ int PairMaker::process_event_test(PHCompositeNode *topNode) {
   }}
 */
 
-  int nmix = MakeMixedPairs(elepos, eePairs, centbin);
+  // no event-plane information is available here yet, use a single EP class
+  unsigned int epbin = 0;
+  int nmix = MakeMixedPairs(elepos, eePairs, centbin, epbin);
   cout << "number of mixed pairs = " << nmix << endl;
+  if(_fill_pool) FillMixingPool(elepos, centbin, epbin);
 
   return Fun4AllReturnCodes::EVENT_OK;
 } 
 
 //======================================================================
 
-int PairMaker::MakeMixedPairs(std::vector<sPHElectronv1> elepos, sPHElectronPairContainerv1* eePairs, unsigned int centbin) {
+int PairMaker::MakeMixedPairs(const std::vector<sPHElectronv1>& elepos, sPHElectronPairContainerv1* eePairs, unsigned int centbin, unsigned int epbin) {
   int count=0;
   double _vtxbinsize  = (_ZMAX - _ZMIN)/double(NZ);
 
   for(unsigned int k=0; k<elepos.size(); k++) {
 
-    sPHElectronv1 thisel = elepos[k];
+    const sPHElectronv1& thisel = elepos[k];
     double z = thisel.get_zvtx();
+    if(z<_ZMIN) continue;
     unsigned int vtxbin = (z - _ZMIN)/_vtxbinsize;
-    if(vtxbin<0 || vtxbin>=NZ) continue;
+    int cls = _pool->get_class(vtxbin, centbin, epbin);
+    if(cls<0) continue;
+
+    // partners are drawn from previous events only, the current event is staged and committed in ResetEvent
+    if(_pool->size(cls) < _min_buffer_depth) continue;
+
+    for(unsigned int i=0; i<_num_mixes; i++) {
+      MixingPool::unpack(_pool->sample(cls, _rng), &_mixel);
+
+      sPHElectronPairv1 pair = sPHElectronPairv1(&thisel,&_mixel);
+      int charge1 = thisel.get_charge();
+      int charge2 = _mixel.get_charge();
+      int type = 0;
+      if(charge1*charge2<0) {type = 4;}
+        else if (charge1>0 && charge2>0) {type=5;}
+          else if (charge1<0 && charge2<0) {type=6;}
+            else {cout << "ERROR: wrong charge!" << endl;}
+      pair.set_type(type);
+      eePairs->insert(&pair);
+      cout << "Inserted MIXED pair with mass = " << type << " " << pair.get_mass() << endl;
+      count++;
+    } // end i loop
 
-    unsigned int _num_mixes = 3;
-    unsigned int buffsize = (_buffer[vtxbin][centbin]).size();
+  } //end k loop over elepos entries
 
-    if(buffsize >= _min_buffer_depth) {
-      for(unsigned int i=0; i<_num_mixes; i++) {
-        double rnd = _rng->Uniform();
-        unsigned int irnd = rnd * buffsize;
-        sPHElectronv1 mixel = (_buffer[vtxbin][centbin]).at(irnd);
+  return count;
+}
 
-        sPHElectronPairv1 pair = sPHElectronPairv1(&thisel,&mixel);
-        int charge1 = thisel.get_charge();
-        int charge2 = mixel.get_charge();
-        int type = 0;
-        if(charge1*charge2<0) {type = 4;}
-          else if (charge1>0 && charge2>0) {type=5;}
-            else if (charge1<0 && charge2<0) {type=6;}
-              else {cout << "ERROR: wrong charge!" << endl;}
-        pair.set_type(type);
-        eePairs->insert(&pair);
-        cout << "Inserted MIXED pair with mass = " << type << " " << pair.get_mass() << endl;
-        count++;
-      } // end i loop
-      (_buffer[vtxbin][centbin]).push_back(elepos[k]);  // keep filling buffer
-    }
-    else {
-      (_buffer[vtxbin][centbin]).push_back(elepos[k]);  // keep filling buffer
-    }
+//======================================================================
 
-  } //end k loop over elepos entries
+void PairMaker::FillMixingPool(const std::vector<sPHElectronv1>& elepos, unsigned int centbin, unsigned int epbin) {
+  double _vtxbinsize  = (_ZMAX - _ZMIN)/double(NZ);
+  MixTrack trk;
 
-  return count;
+  for(unsigned int k=0; k<elepos.size(); k++) {
+    double z = elepos[k].get_zvtx();
+    if(z<_ZMIN) continue;
+    unsigned int vtxbin = (z - _ZMIN)/_vtxbinsize;
+    int cls = _pool->get_class(vtxbin, centbin, epbin);
+    if(cls<0) continue;
+    MixingPool::fill(trk, &elepos[k]);
+    _pool->stage(cls, trk);
+  }
+}
+
+//======================================================================
+
+int PairMaker::ResetEvent(PHCompositeNode *topNode)
+{
+  // Fun4All resets only after every module processed the event, so no
+  // consumer of a shared pool sees the tracks of its own event
+  if(_fill_pool) _pool->commit();
+  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 //======================================================================
@@ -386,13 +427,15 @@ bool PairMaker::isElectron(SvtxTrack* trk)
 int PairMaker::End(PHCompositeNode *topNode) 
 {
   cout << "END: ====================================" << endl;
-  cout << "mixing buffers: " << endl;
-  for(unsigned int i=0; i<NZ; i++) {
-    for(unsigned int j=0; j<NCENT; j++) {
-      cout << i << " " << j << "    " << (_buffer[i][j]).size() << endl;
-      (_buffer[i][j]).clear();
+  cout << "mixing buffers (depth " << _pool->get_depth() << "): " << endl;
+  for(unsigned int i=0; i<_pool->get_nz(); i++) {
+    for(unsigned int j=0; j<_pool->get_ncent(); j++) {
+      for(unsigned int k=0; k<_pool->get_nep(); k++) {
+        cout << i << " " << j << " " << k << "    " << _pool->size(_pool->get_class(i,j,k)) << endl;
+      }
     }
   }
+  if(_own_pool) _pool->clear();
   cout << "=========================================" << endl;
 
   return Fun4AllReturnCodes::EVENT_OK;
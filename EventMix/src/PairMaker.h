@@ -4,6 +4,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include "MixingPool.h"
 #include "sPHElectronv1.h"
 
 #include <vector>
@@ -20,26 +21,43 @@ class PairMaker: public SubsysReco {
 public:
 
   PairMaker(const std::string &name = "PairMaker", const std::string &filename = "test.root");
-  virtual ~PairMaker() {}
+  virtual ~PairMaker();
 
   int Init(PHCompositeNode *topNode);
   int InitRun(PHCompositeNode *topNode);
   int process_event(PHCompositeNode *topNode);
+  int ResetEvent(PHCompositeNode *topNode);
   int End(PHCompositeNode *topNode);
 
+  // depth of each (z-vertex, centrality, event-plane) mixing class
+  void set_buffer_depth(unsigned int min_depth, unsigned int max_depth) { _min_buffer_depth = min_depth; _max_buffer_depth = max_depth; }
+  void set_num_mixes(unsigned int n) { _num_mixes = n; }
+  void set_num_ep_bins(unsigned int n) { _nep = n; }
+  // use a pool owned by another module; only the owner fills it, the
+  // current event enters the pool in the owner's ResetEvent, after all
+  // consumers have mixed it
+  void set_mixing_pool(MixingPool* pool, bool fill = false) { _pool = pool; _own_pool = false; _fill_pool = fill; }
+  MixingPool* get_mixing_pool() const { return _pool; }
+
 protected:
 
   int process_event_test(PHCompositeNode *topNode);
-  int MakeMixedPairs(std::vector<sPHElectronv1> elepos, sPHElectronPairContainerv1* eePairs, unsigned int centbin);
+  int MakeMixedPairs(const std::vector<sPHElectronv1>& elepos, sPHElectronPairContainerv1* eePairs, unsigned int centbin, unsigned int epbin);
+  void FillMixingPool(const std::vector<sPHElectronv1>& elepos, unsigned int centbin, unsigned int epbin);
 
   bool isElectron(SvtxTrack*);
 
   std::string outnodename;
   static const int NZ = 2;
   static const int NCENT = 2;
-  std::vector<sPHElectronv1> _buffer[NZ][NCENT];
+  MixingPool* _pool;
+  bool _own_pool;
+  bool _fill_pool;
+  unsigned int _nep;
+  unsigned int _num_mixes;
   unsigned int _min_buffer_depth;
   unsigned int _max_buffer_depth;
+  sPHElectronv1 _mixel;
   double _ZMAX;
   double _ZMIN;
   std::vector<double> _multbins;
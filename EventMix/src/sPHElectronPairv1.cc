@@ -10,7 +10,7 @@ sPHElectronPairv1::sPHElectronPairv1()
   _e2 = sPHElectronv1();
 }
 
-sPHElectronPairv1::sPHElectronPairv1(sPHElectronv1* e1, sPHElectronv1* e2)
+sPHElectronPairv1::sPHElectronPairv1(const sPHElectronv1* e1, const sPHElectronv1* e2)
 {
   _id = e1->get_id() + e2->get_id()*100000;
   _type = 0;
@@ -12,7 +12,7 @@ class sPHElectronPairv1 : public sPHElectronPair
 {
  public:
   sPHElectronPairv1();
-  sPHElectronPairv1(sPHElectronv1* e1, sPHElectronv1* e2);
+  sPHElectronPairv1(const sPHElectronv1* e1, const sPHElectronv1* e2);
   virtual ~sPHElectronPairv1() {}
 
   virtual void identify(std::ostream& os = std::cout) const
@@ -0,0 +1,280 @@
+#include "FlatBDTForest.h"
+
+#include <TXMLEngine.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+  //Same conversion as TMVA::Tools::ReadAttr, which streams the attribute into the member type
+  template <typename T>
+  bool readAttr(TXMLEngine &xml, XMLNodePointer_t node, const char *name, T &value)
+  {
+    const char *attr = xml.GetAttr(node, name);
+    if (!attr) return false;
+    std::istringstream stream(attr);
+    stream >> value;
+    return !stream.fail();
+  }
+
+  XMLNodePointer_t findChild(TXMLEngine &xml, XMLNodePointer_t node, const std::string &name)
+  {
+    for (XMLNodePointer_t child = xml.GetChild(node); child; child = xml.GetNext(child))
+    {
+      if (name == xml.GetNodeName(child)) return child;
+    }
+    return nullptr;
+  }
+
+  //Candidates per thread below which spawning threads costs more than it saves
+  const size_t minCandidatesPerThread = 256;
+}
+
+bool FlatBDTForest::load(const std::string &weightFile)
+{
+  m_loaded = false;
+  m_useYesNoLeaf = true;
+  m_treeRoot.clear();
+  m_treeDepth.clear();
+  m_boostWeight.clear();
+  m_variable.clear();
+  m_cut.clear();
+  m_child.clear();
+  m_leafValue.clear();
+
+  TXMLEngine xml;
+  XMLDocPointer_t doc = xml.ParseFile(weightFile.c_str());
+  if (!doc)
+  {
+    std::cout << "FlatBDTForest::load - could not parse " << weightFile << std::endl;
+    return false;
+  }
+  XMLNodePointer_t root = xml.DocGetRootElement(doc);
+
+  std::string problem;
+  std::string boostType;
+  bool doPreselection = false;
+
+  XMLNodePointer_t options = findChild(xml, root, "Options");
+  for (XMLNodePointer_t option = options ? xml.GetChild(options) : nullptr; option; option = xml.GetNext(option))
+  {
+    const char *name = xml.GetAttr(option, "name");
+    const char *content = xml.GetNodeContent(option);
+    if (!name || !content) continue;
+    if (std::string(name) == "BoostType") boostType = content;
+    if (std::string(name) == "UseYesNoLeaf") m_useYesNoLeaf = std::string(content) == "True";
+    if (std::string(name) == "DoPreselection") doPreselection = std::string(content) == "True";
+  }
+
+  XMLNodePointer_t variables = findChild(xml, root, "Variables");
+  XMLNodePointer_t transformations = findChild(xml, root, "Transformations");
+  XMLNodePointer_t weights = findChild(xml, root, "Weights");
+  int nTransformations = 0;
+
+  if (boostType != "AdaBoost" && boostType != "Grad") problem = "unsupported BoostType " + boostType;
+  else if (doPreselection) problem = "preselection cuts are not supported";
+  else if (!variables || !readAttr(xml, variables, "NVar", m_nVariables) || m_nVariables == 0) problem = "no variables";
+  else if (transformations && (!readAttr(xml, transformations, "NTransformations", nTransformations) || nTransformations != 0)) problem = "variable transformations are not supported";
+  else if (!weights) problem = "no weights";
+  else if (!readAttr(xml, weights, "TreeType", m_analysisType) && !readAttr(xml, weights, "AnalysisType", m_analysisType)) problem = "unknown analysis type";
+  else if (m_analysisType != 0 && m_analysisType != 1) problem = "multiclass forests are not supported";
+
+  m_gradBoost = boostType == "Grad";
+  m_boostWeightSum = 0;
+
+  for (XMLNodePointer_t tree = problem.empty() ? xml.GetChild(weights) : nullptr; tree; tree = xml.GetNext(tree))
+  {
+    if (std::string("BinaryTree") != xml.GetNodeName(tree)) continue;
+
+    double boostWeight = 0;
+    XMLNodePointer_t top = xml.GetChild(tree);
+    while (top && std::string("Node") != xml.GetNodeName(top)) top = xml.GetNext(top);
+    if (!top || !readAttr(xml, tree, "boostWeight", boostWeight))
+    {
+      problem = "malformed tree";
+      break;
+    }
+
+    int maxDepth = 0;
+    const int treeRoot = addNode(xml, top, 0, maxDepth);
+    if (treeRoot < 0)
+    {
+      problem = "malformed or Fisher cut node";
+      break;
+    }
+
+    m_treeRoot.push_back(treeRoot);
+    m_treeDepth.push_back(maxDepth);
+    m_boostWeight.push_back(boostWeight);
+    m_boostWeightSum += boostWeight;
+  }
+
+  xml.FreeDoc(doc);
+
+  if (problem.empty() && m_treeRoot.empty()) problem = "no trees";
+  if (!problem.empty())
+  {
+    std::cout << "FlatBDTForest::load - " << weightFile << ": " << problem << std::endl;
+    return false;
+  }
+
+  m_loaded = true;
+  return true;
+}
+
+int FlatBDTForest::addNode(TXMLEngine &xml, XMLNodePointer_t node, int depth, int &maxDepth)
+{
+  const int index = m_variable.size();
+  m_variable.push_back(0);
+  m_cut.push_back(0);
+  m_child.push_back(index);
+  m_child.push_back(index);
+  m_leafValue.push_back(0);
+
+  int nCoef = 0;
+  int variable = 0;
+  float cut = 0;
+  bool cutType = true;
+  float response = 0;
+  float purity = 0;
+  int nodeType = 0;
+
+  if (readAttr(xml, node, "NCoef", nCoef) && nCoef != 0) return -1;
+  if (!readAttr(xml, node, "IVar", variable) ||
+      !readAttr(xml, node, "Cut", cut) ||
+      !readAttr(xml, node, "cType", cutType) ||
+      !readAttr(xml, node, "nType", nodeType)) return -1;
+  readAttr(xml, node, "res", response);
+  readAttr(xml, node, "purity", purity);
+
+  XMLNodePointer_t left = nullptr;
+  XMLNodePointer_t right = nullptr;
+  for (XMLNodePointer_t child = xml.GetChild(node); child; child = xml.GetNext(child))
+  {
+    const char *pos = xml.GetAttr(child, "pos");
+    if (!pos) continue;
+    if (std::string(pos) == "l") left = child;
+    if (std::string(pos) == "r") right = child;
+  }
+
+  //Leaf, as in TMVA::DecisionTree::CheckEvent
+  if (nodeType != 0)
+  {
+    if (left || right) return -1;
+    if (m_analysisType == 1) m_leafValue[index] = response;
+    else if (m_useYesNoLeaf) m_leafValue[index] = nodeType;
+    else m_leafValue[index] = purity;
+    maxDepth = std::max(maxDepth, depth);
+    return index;
+  }
+
+  if (!left || !right || variable < 0 || variable >= (int) m_nVariables) return -1;
+
+  const int leftIndex = addNode(xml, left, depth + 1, maxDepth);
+  if (leftIndex < 0) return -1;
+  const int rightIndex = addNode(xml, right, depth + 1, maxDepth);
+  if (rightIndex < 0) return -1;
+
+  //TMVA::DecisionTreeNode::GoesRight is (value >= cut), inverted for cType == 0
+  m_variable[index] = variable;
+  m_cut[index] = cut;
+  m_child[2 * index + 0] = cutType ? leftIndex : rightIndex;
+  m_child[2 * index + 1] = cutType ? rightIndex : leftIndex;
+
+  return index;
+}
+
+double FlatBDTForest::evaluate(const float *values) const
+{
+  double response = 0;
+  evaluateRange(values, 0, 1, &response);
+  return response;
+}
+
+void FlatBDTForest::evaluate(const std::vector<float> &values, std::vector<double> &responses) const
+{
+  const size_t nCandidates = m_nVariables > 0 ? values.size() / m_nVariables : 0;
+  responses.resize(nCandidates);
+  if (nCandidates == 0) return;
+
+  const size_t nThreads = std::min<size_t>(m_nThreads, std::max<size_t>(nCandidates / minCandidatesPerThread, 1));
+  if (nThreads == 1)
+  {
+    evaluateRange(values.data(), 0, nCandidates, responses.data());
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  const size_t chunk = (nCandidates + nThreads - 1) / nThreads;
+  for (size_t first = 0; first < nCandidates; first += chunk)
+  {
+    const size_t last = std::min(first + chunk, nCandidates);
+    threads.emplace_back(&FlatBDTForest::evaluateRange, this, values.data(), first, last, responses.data());
+  }
+  for (auto &thread : threads) thread.join();
+}
+
+void FlatBDTForest::evaluateRange(const float *values, size_t first, size_t last, double *responses) const
+{
+  static const size_t blockSize = 64;
+  int node[blockSize];
+  double sum[blockSize];
+
+  const int *variable = m_variable.data();
+  const float *cut = m_cut.data();
+  const int *child = m_child.data();
+  const double *leafValue = m_leafValue.data();
+  const size_t nVar = m_nVariables;
+
+  for (size_t begin = first; begin < last; begin += blockSize)
+  {
+    const size_t n = std::min(blockSize, last - begin);
+    const float *x = values + begin * nVar;
+
+    std::fill(sum, sum + n, 0.);
+
+    //Tree by tree so that the nodes of one tree stay in cache for the whole block,
+    //every candidate takes the same number of steps and the inner loops have no branches
+    for (size_t tree = 0; tree < m_treeRoot.size(); ++tree)
+    {
+      const int root = m_treeRoot[tree];
+      const int depth = m_treeDepth[tree];
+      std::fill(node, node + n, root);
+
+      for (int step = 0; step < depth; ++step)
+      {
+        for (size_t c = 0; c < n; ++c)
+        {
+          const int i = node[c];
+          node[c] = child[2 * i + (x[c * nVar + variable[i]] >= cut[i])];
+        }
+      }
+
+      if (m_gradBoost)
+      {
+        for (size_t c = 0; c < n; ++c) sum[c] += leafValue[node[c]];
+      }
+      else
+      {
+        const double boostWeight = m_boostWeight[tree];
+        for (size_t c = 0; c < n; ++c) sum[c] += boostWeight * leafValue[node[c]];
+      }
+    }
+
+    for (size_t c = 0; c < n; ++c)
+    {
+      //TMVA::Reader::EvaluateMVA returns -999 for events with a NaN input
+      bool isNaN = false;
+      for (size_t v = 0; v < nVar; ++v) isNaN |= std::isnan(x[c * nVar + v]);
+
+      if (isNaN) responses[begin + c] = -999;
+      else if (m_gradBoost) responses[begin + c] = 2.0 / (1.0 + exp(-2.0 * sum[c])) - 1;
+      else responses[begin + c] = m_boostWeightSum > std::numeric_limits<double>::epsilon() ? sum[c] / m_boostWeightSum : 0;
+    }
+  }
+}
@@ -0,0 +1,78 @@
+#ifndef FLATBDTFOREST_H
+#define FLATBDTFOREST_H
+
+/*
+ * Flattened evaluator for TMVA BDT weight files
+ *
+ * The forest of a TMVAClassification_<method>.weights.xml file is read
+ * once into contiguous node arrays and a whole event's candidates are
+ * scored in one call, tree by tree over blocks of candidates, optionally
+ * split over several threads.
+ *
+ * Cuts, node responses and boost weights are stored with the same
+ * precision as in TMVA::DecisionTreeNode / TMVA::MethodBDT and summed in
+ * the same order, so the responses are identical to
+ * TMVA::Reader::EvaluateMVA. Weight files that this class can not
+ * reproduce exactly (variable transformations, Fisher cuts, preselection,
+ * boost types other than AdaBoost and Grad) are refused by load().
+ *
+ * Shared by ElectronID and HF-Particle/HFTrigger, link with -lflatbdtforest.
+ * macros/CompareFlatBDTForest.C checks a weight file against TMVA::Reader.
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class TXMLEngine;
+
+class FlatBDTForest
+{
+ public:
+  FlatBDTForest() {}
+
+  virtual ~FlatBDTForest() {}
+
+  //! read the forest, returns false if the file can not be evaluated by this class
+  bool load(const std::string &weightFile);
+
+  bool isLoaded() const { return m_loaded; }
+
+  unsigned int nVariables() const { return m_nVariables; }
+
+  unsigned int nTrees() const { return m_treeRoot.size(); }
+
+  void setNumberOfThreads(unsigned int nThreads) { m_nThreads = nThreads > 0 ? nThreads : 1; }
+
+  //! response for a single candidate of nVariables() values
+  double evaluate(const float *values) const;
+
+  //! responses for all candidates, values are [nCandidates][nVariables()]
+  void evaluate(const std::vector<float> &values, std::vector<double> &responses) const;
+
+ private:
+  int addNode(TXMLEngine &xml, void *node, int depth, int &maxDepth);
+
+  void evaluateRange(const float *values, size_t first, size_t last, double *responses) const;
+
+  bool m_loaded = false;
+  bool m_gradBoost = false;
+  unsigned int m_nVariables = 0;
+  unsigned int m_nThreads = 1;
+  int m_analysisType = 0;
+  bool m_useYesNoLeaf = true;
+  double m_boostWeightSum = 0;
+
+  //per tree
+  std::vector<int> m_treeRoot;
+  std::vector<int> m_treeDepth;
+  std::vector<double> m_boostWeight;
+
+  //per node, leaves point back to themselves so every tree is walked a fixed number of steps
+  std::vector<int> m_variable;
+  std::vector<float> m_cut;
+  std::vector<int> m_child;  //[2*node + (value >= cut)]
+  std::vector<double> m_leafValue;
+};
+
+#endif  //FLATBDTFOREST_H
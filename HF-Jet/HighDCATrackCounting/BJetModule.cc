@@ -59,6 +59,9 @@ BJetModule::BJetModule(const string &name, const string &out)
   , _recojetmap_name("AntiKt_Tower_r04")
   , _trackmap_name("SvtxTrackMap")
   , _vertexmap_name("SvtxVertexMap")
+  , _max_truthjets(10)
+  , _max_particles(1000)
+  , _max_tracks(1000)
   , _embedding_id(1)
 {
 }
@@ -210,12 +213,14 @@ int BJetModule::process_event(PHCompositeNode *topNode)
   PHG4TruthInfoContainer *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
 
   PHG4VtxPoint *first_point = truthinfo->GetPrimaryVtx(truthinfo->GetPrimaryVertexIndex());
-  _b_truth_vertex_n = 0;
-  _b_truth_vertex_x[_b_truth_vertex_n] = first_point->get_x();
-  _b_truth_vertex_y[_b_truth_vertex_n] = first_point->get_y();
-  _b_truth_vertex_z[_b_truth_vertex_n] = first_point->get_z();
+  int ivertex = _truth_vertices->append();
+  if (ivertex >= 0)
+  {
+    _b_truth_vertex_x[ivertex] = first_point->get_x();
+    _b_truth_vertex_y[ivertex] = first_point->get_y();
+    _b_truth_vertex_z[ivertex] = first_point->get_z();
+  }
   TVector3 truth_primary_vertex(first_point->get_x(), first_point->get_y(), first_point->get_z());
-  ++_b_truth_vertex_n;
 
   auto jet_eval_stack = unique_ptr<JetEvalStack>(new JetEvalStack(topNode, _recojetmap_name, _truthjetmap_name));
   if (!jet_eval_stack)
@@ -234,7 +239,6 @@ int BJetModule::process_event(PHCompositeNode *topNode)
   JetMap *truth_jets = findNode::getClass<JetMap>(topNode, _truthjetmap_name);
   JetMap *reco_jets = findNode::getClass<JetMap>(topNode, _recojetmap_name);
  
-  _b_truthjet_n = 0;
   for (JetMap::Iter iter = truth_jets->begin(); iter != truth_jets->end();
        ++iter)
   {
@@ -242,19 +246,23 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     if (truth_jet->get_pt() < 10 || fabs(truth_jet->get_eta()) > 2)
       continue;
 
-    _b_truthjet_pt[_b_truthjet_n] = truth_jet->get_pt();
-    _b_truthjet_phi[_b_truthjet_n] = truth_jet->get_phi();
-    _b_truthjet_eta[_b_truthjet_n] = truth_jet->get_eta();
+    int ijet = _truthjets->append();
+    if (ijet < 0)
+      continue;
+
+    _b_truthjet_pt[ijet] = truth_jet->get_pt();
+    _b_truthjet_phi[ijet] = truth_jet->get_phi();
+    _b_truthjet_eta[ijet] = truth_jet->get_eta();
 
     int jet_flavor = -999;
 
     jet_flavor = truth_jet->get_property(static_cast<Jet::PROPERTY>(prop_JetPartonFlavor));
     if (abs(jet_flavor) < 100)
-      _b_truthjet_parton_flavor[_b_truthjet_n] = jet_flavor;
+      _b_truthjet_parton_flavor[ijet] = jet_flavor;
 
     jet_flavor = truth_jet->get_property(static_cast<Jet::PROPERTY>(prop_JetHadronFlavor));
     if (abs(jet_flavor) < 100)
-      _b_truthjet_hadron_flavor[_b_truthjet_n] = jet_flavor;
+      _b_truthjet_hadron_flavor[ijet] = jet_flavor;
     //cout << "DEBUG: " << __LINE__ << endl;
     //auto reco_jet = unique_ptr<Jet>(jet_reco_eval->best_jet_from(truth_jet));
     Jet *reco_jet = jet_reco_eval->best_jet_from(truth_jet);
@@ -282,32 +290,29 @@ int BJetModule::process_event(PHCompositeNode *topNode)
        
       if(matchedjet)
 	{
-	  _b_recojet_valid[_b_truthjet_n] = 1;
-	  _b_recojet_pt[_b_truthjet_n] = matchedjet->get_pt();
-	  _b_recojet_phi[_b_truthjet_n] = matchedjet->get_phi();
-	  _b_recojet_eta[_b_truthjet_n] = matchedjet->get_eta();
+	  _b_recojet_valid[ijet] = 1;
+	  _b_recojet_pt[ijet] = matchedjet->get_pt();
+	  _b_recojet_phi[ijet] = matchedjet->get_phi();
+	  _b_recojet_eta[ijet] = matchedjet->get_eta();
 	}
       else
 	{
-	  _b_recojet_valid[_b_truthjet_n] = 0;
+	  _b_recojet_valid[ijet] = 0;
 	}
     }
     else
     {
-      _b_recojet_valid[_b_truthjet_n] = 1;
-      _b_recojet_pt[_b_truthjet_n] = reco_jet->get_pt();
-      _b_recojet_phi[_b_truthjet_n] = reco_jet->get_phi();
-      _b_recojet_eta[_b_truthjet_n] = reco_jet->get_eta();
+      _b_recojet_valid[ijet] = 1;
+      _b_recojet_pt[ijet] = reco_jet->get_pt();
+      _b_recojet_phi[ijet] = reco_jet->get_phi();
+      _b_recojet_eta[ijet] = reco_jet->get_eta();
     }
-
-    _b_truthjet_n++;
     //cout << "DEBUG: " << __LINE__ << endl;
   }
 
   PHG4TruthInfoContainer::Range range = truthinfo->GetPrimaryParticleRange();
   //PHG4TruthInfoContainer::Range range = truthinfo->GetParticleRange();
 
-  _b_particle_n = 0;
   for (auto iter = range.first; iter != range.second; ++iter)
   {
     PHG4Particle *g4particle = iter->second;  // You may ask yourself, why second?
@@ -342,16 +347,20 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     if (!(abs(truth_pid) == 211 || abs(truth_pid) == 321 || abs(truth_pid) == 2212 || abs(truth_pid) == 11 || abs(truth_pid) == 13))
       continue;
 
-    _b_particle_pid[_b_particle_n] = truth_pid;
-    _b_particle_pt[_b_particle_n] = truth_pt;
-    _b_particle_eta[_b_particle_n] = truth_eta;
-    _b_particle_phi[_b_particle_n] = truth_phi;
-    _b_particle_embed[_b_particle_n] = embed_id;
+    int iparticle = _particles->append();
+    if (iparticle < 0)
+      continue;
+
+    _b_particle_pid[iparticle] = truth_pid;
+    _b_particle_pt[iparticle] = truth_pt;
+    _b_particle_eta[iparticle] = truth_eta;
+    _b_particle_phi[iparticle] = truth_phi;
+    _b_particle_embed[iparticle] = embed_id;
 
     PHG4VtxPoint *point = truthinfo->GetVtx(g4particle->get_vtx_id());
-    _b_particle_vertex_x[_b_particle_n] = point->get_x();
-    _b_particle_vertex_y[_b_particle_n] = point->get_y();
-    _b_particle_vertex_z[_b_particle_n] = point->get_z();
+    _b_particle_vertex_x[iparticle] = point->get_x();
+    _b_particle_vertex_y[iparticle] = point->get_y();
+    _b_particle_vertex_z[iparticle] = point->get_z();
 
     TVector3 track_point(point->get_x(), point->get_y(), point->get_z());
     TVector3 track_mom(g4particle->get_px(), g4particle->get_py(), g4particle->get_pz());
@@ -385,8 +394,8 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     }
 #endif
 
-    _b_particle_dca_xy[_b_particle_n] = truth_dca_xy;
-    _b_particle_dca_z[_b_particle_n] = truth_dca_z;
+    _b_particle_dca_xy[iparticle] = truth_dca_xy;
+    _b_particle_dca_z[iparticle] = truth_dca_z;
 
     //		for (HepMC::GenEvent::particle_const_iterator p =
     //				theEvent->particles_begin(); p != theEvent->particles_end();
@@ -403,7 +412,7 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     //				continue;
     //
     //			HepMC::GenVertex *production_vertex = (*p)->production_vertex();
-    //			_b_particle_dca_xy[_b_particle_n] = production_vertex->point3d().perp();
+    //			_b_particle_dca_xy[iparticle] = production_vertex->point3d().perp();
     //
     //			{
     //				cout
@@ -415,8 +424,6 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     //				<<endl<<endl;
     //			}
     //		}
-
-    _b_particle_n++;
   }
 
   SvtxTrackMap *trackmap = findNode::getClass<SvtxTrackMap>(topNode, _trackmap_name.c_str());
@@ -440,8 +447,6 @@ int BJetModule::process_event(PHCompositeNode *topNode)
   //	float vertex_err_y = -99;
   //float vertex_err_z = -99;
 
-  _b_track_n = 0;
-
   for (SvtxTrackMap::Iter iter = trackmap->begin(); iter != trackmap->end();
        ++iter)
   {
@@ -456,6 +461,10 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     if (fabs(track_eta) > 1.1)
       continue;
 
+    int itrack = _tracks->append();
+    if (itrack < 0)
+      continue;
+
     //std::set<PHG4Hit*> assoc_hits = trackeval->all_truth_hits(track);//TODO
     int nmaps = 0;
 
@@ -498,7 +507,7 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     int truth_pid = g4particle->get_pid();
 
     //TVector3 g4particle_mom(g4particle->get_px(),g4particle->get_py(),g4particle->get_pz());
-    //_b_track_best_pt[_b_track_n] = g4particle_mom.Pt();
+    //_b_track_best_pt[itrack] = g4particle_mom.Pt();
 
     //int truth_parent_id = g4particle->get_parent_id();
     //int truth_primary_id = g4particle->get_primary_id();
@@ -531,16 +540,16 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     //				vertex_err_x*vertex_err_x +
     //				vertex_err_y*vertex_err_y);
 
-    _b_track_pca_x[_b_track_n] = track->get_x() - vertex_x;
-    _b_track_pca_y[_b_track_n] = track->get_y() - vertex_y;
-    _b_track_pca_z[_b_track_n] = track->get_z() - vertex_z;
+    _b_track_pca_x[itrack] = track->get_x() - vertex_x;
+    _b_track_pca_y[itrack] = track->get_y() - vertex_y;
+    _b_track_pca_z[itrack] = track->get_z() - vertex_z;
 
     TVector3 dca_vector(
-        _b_track_pca_x[_b_track_n],
-        _b_track_pca_y[_b_track_n],
-        _b_track_pca_z[_b_track_n]);
+        _b_track_pca_x[itrack],
+        _b_track_pca_y[itrack],
+        _b_track_pca_z[itrack]);
 
-    _b_track_pca_phi[_b_track_n] = dca_vector.Phi();
+    _b_track_pca_phi[itrack] = dca_vector.Phi();
 
     TLorentzVector t;
     t.SetPxPyPzE(g4particle->get_px(), g4particle->get_py(),
@@ -551,9 +560,9 @@ int BJetModule::process_event(PHCompositeNode *topNode)
     float truth_phi = t.Phi();
 
     PHG4VtxPoint *point = truthinfo->GetVtx(g4particle->get_vtx_id());
-    _b_track_best_vertex_x[_b_track_n] = point->get_x();
-    _b_track_best_vertex_y[_b_track_n] = point->get_y();
-    _b_track_best_vertex_z[_b_track_n] = point->get_z();
+    _b_track_best_vertex_x[itrack] = point->get_x();
+    _b_track_best_vertex_y[itrack] = point->get_y();
+    _b_track_best_vertex_z[itrack] = point->get_z();
 
     TVector3 track_best_point(point->get_x(), point->get_y(), point->get_z());
     TVector3 track_best_mom(g4particle->get_px(), g4particle->get_py(), g4particle->get_pz());
@@ -566,10 +575,10 @@ int BJetModule::process_event(PHCompositeNode *topNode)
 
     calc_dca3d_line(truth_dca_xy, truth_dca_z, track_best_point, track_best_mom, truth_primary_vertex);
 
-    _b_track_best_dca_xy[_b_track_n] = truth_dca_xy;
-    _b_track_best_dca_z[_b_track_n] = truth_dca_z;
+    _b_track_best_dca_xy[itrack] = truth_dca_xy;
+    _b_track_best_dca_z[itrack] = truth_dca_z;
 
-    //_b_track_best_parent_pid[_b_track_n] = truthinfo->GetParticle(g4particle->get_parent_id())->get_pid();
+    //_b_track_best_parent_pid[itrack] = truthinfo->GetParticle(g4particle->get_parent_id())->get_pid();
     int truth_in = -1;
     int truth_out = -1;
     int nhepmc = 0;
@@ -595,52 +604,50 @@ int BJetModule::process_event(PHCompositeNode *topNode)
 
       HepMC::GenVertex::particles_in_const_iterator first_parent =
           production_vertex->particles_in_const_begin();
-      _b_track_best_parent_pid[_b_track_n] = (*first_parent)->pdg_id();
+      _b_track_best_parent_pid[itrack] = (*first_parent)->pdg_id();
 
       nhepmc++;
     }
 
-    _b_track_pt[_b_track_n] = track_pt;
-    _b_track_eta[_b_track_n] = track_eta;
-    _b_track_phi[_b_track_n] = track_phi;
-
-    _b_track_dca3d_xy[_b_track_n] = dca3d_xy;
-    _b_track_dca3d_xy_error[_b_track_n] = dca3d_xy_error;
+    _b_track_pt[itrack] = track_pt;
+    _b_track_eta[itrack] = track_eta;
+    _b_track_phi[itrack] = track_phi;
 
-    _b_track_dca3d_z[_b_track_n] = dca3d_z;
-    _b_track_dca3d_z_error[_b_track_n] = dca3d_z_error;
+    _b_track_dca3d_xy[itrack] = dca3d_xy;
+    _b_track_dca3d_xy_error[itrack] = dca3d_xy_error;
 
-    _b_track_dca2d_calc[_b_track_n] = dca2d_calc;
-    _b_track_dca2d_calc_truth[_b_track_n] = dca2d_calc_truth;
+    _b_track_dca3d_z[itrack] = dca3d_z;
+    _b_track_dca3d_z_error[itrack] = dca3d_z_error;
 
-    _b_track_dca3d_calc[_b_track_n] = dca3d_calc;
-    _b_track_dca3d_calc_truth[_b_track_n] = dca3d_calc_truth;
+    _b_track_dca2d_calc[itrack] = dca2d_calc;
+    _b_track_dca2d_calc_truth[itrack] = dca2d_calc_truth;
 
-    //		_b_track_pca_phi[_b_track_n] = dca_phi;
-    //		_b_track_pca_x[_b_track_n] = dca_x;
-    //		_b_track_pca_y[_b_track_n] = dca_y;
-    //		_b_track_pca_z[_b_track_n] = dca_z;
+    _b_track_dca3d_calc[itrack] = dca3d_calc;
+    _b_track_dca3d_calc_truth[itrack] = dca3d_calc_truth;
 
-    _b_track_quality[_b_track_n] = track->get_quality();
-    _b_track_chisq[_b_track_n] = track->get_chisq();
-    _b_track_ndf[_b_track_n] = track->get_ndf();
+    //		_b_track_pca_phi[itrack] = dca_phi;
+    //		_b_track_pca_x[itrack] = dca_x;
+    //		_b_track_pca_y[itrack] = dca_y;
+    //		_b_track_pca_z[itrack] = dca_z;
 
-    _b_track_nmaps[_b_track_n] = nmaps;
+    _b_track_quality[itrack] = track->get_quality();
+    _b_track_chisq[itrack] = track->get_chisq();
+    _b_track_ndf[itrack] = track->get_ndf();
 
-    _b_track_nclusters[_b_track_n] = nclusters;
-    _b_track_nclusters_by_layer[_b_track_n] = nclusters_by_layer;
+    _b_track_nmaps[itrack] = nmaps;
 
-    _b_track_best_nclusters[_b_track_n] = truth_nclusters;
-    _b_track_best_nclusters_by_layer[_b_track_n] = truth_nclusters_by_layer;
-    _b_track_best_embed[_b_track_n] = truth_embed_id;
-    _b_track_best_primary[_b_track_n] = truth_is_primary;
-    _b_track_best_pid[_b_track_n] = truth_pid;
-    _b_track_best_pt[_b_track_n] = truth_pt;
+    _b_track_nclusters[itrack] = nclusters;
+    _b_track_nclusters_by_layer[itrack] = nclusters_by_layer;
 
-    _b_track_best_in[_b_track_n] = truth_in;
-    _b_track_best_out[_b_track_n] = truth_out;
+    _b_track_best_nclusters[itrack] = truth_nclusters;
+    _b_track_best_nclusters_by_layer[itrack] = truth_nclusters_by_layer;
+    _b_track_best_embed[itrack] = truth_embed_id;
+    _b_track_best_primary[itrack] = truth_is_primary;
+    _b_track_best_pid[itrack] = truth_pid;
+    _b_track_best_pt[itrack] = truth_pt;
 
-    _b_track_n++;
+    _b_track_best_in[itrack] = truth_in;
+    _b_track_best_out[itrack] = truth_out;
   }
 
   _tree->Fill();
@@ -709,181 +716,105 @@ void BJetModule::calc3DDCA(SvtxTrack* track, SvtxVertexMap* vertexmap,
 
 int BJetModule::reset_tree_vars()
 {
-  _b_truthjet_n = 0;
-
-  for (int n = 0; n < 10; n++)
-  {
-    _b_truthjet_parton_flavor[n] = -9999;
-    _b_truthjet_hadron_flavor[n] = -9999;
-
-    _b_truthjet_pt[n] = -99;
-    _b_truthjet_eta[n] = -99;
-    _b_truthjet_phi[n] = -99;
-
-    _b_recojet_valid[n] = 0;
-    _b_truthjet_pt[n] = -99;
-    _b_truthjet_eta[n] = -99;
-    _b_truthjet_phi[n] = -99;
-  }
-
-  _b_particle_n = 0;
-  _b_track_n = 0;
-
-  for (int n = 0; n < 1000; n++)
-  {
-    _b_particle_pt[n] = -1;
-    _b_particle_eta[n] = -1;
-    _b_particle_phi[n] = -1;
-    _b_particle_pid[n] = 0;
-    _b_particle_embed[n] = 0;
-
-    _b_particle_vertex_x[n] = -1;
-    _b_particle_vertex_y[n] = -1;
-    _b_particle_vertex_z[n] = -1;
-
-    _b_particle_dca_xy[n] = -1;
-    _b_particle_dca_z[n] = -1;
-
-    _b_track_pt[n] = -1;
-    _b_track_eta[n] = -1;
-    _b_track_phi[n] = -1;
-
-    _b_track_nmaps[n] = 0;
-
-    _b_track_nclusters[n] = 0;
-    _b_track_nclusters_by_layer[n] = 0;
-
-    _b_track_dca2d[n] = -1;
-    _b_track_dca2d_error[n] = -1;
-    _b_track_dca3d_xy[n] = -1;
-    _b_track_dca3d_xy_error[n] = -1;
-    _b_track_dca3d_z[n] = -1;
-    _b_track_dca3d_z_error[n] = -1;
-    _b_track_dca2d_calc[n] = -1;
-    _b_track_dca2d_calc_truth[n] = -1;
-    _b_track_dca3d_calc[n] = -1;
-    _b_track_dca3d_calc_truth[n] = -1;
-
-    _b_track_pca_phi[n] = -99;
-    _b_track_pca_x[n] = -99;
-    _b_track_pca_y[n] = -99;
-    _b_track_pca_z[n] = -99;
-
-    _b_track_quality[n] = -99;
-    _b_track_chisq[n] = -99;
-    _b_track_ndf[n] = -99;
-
-    _b_track_best_nclusters[n] = 0;
-    _b_track_best_nclusters_by_layer[n] = 0;
-    _b_track_best_embed[n] = 0;
-    _b_track_best_primary[n] = false;
-    _b_track_best_pid[n] = 0;
-
-    _b_track_best_in[n] = 0;
-    _b_track_best_out[n] = 0;
-    _b_track_best_parent_pid[n] = 0;
-
-    _b_track_best_vertex_x[n] = -99;
-    _b_track_best_vertex_y[n] = -99;
-    _b_track_best_vertex_z[n] = -99;
-    _b_track_best_dca_xy[n] = -99;
-    _b_track_best_dca_z[n] = -99;
-  }
+  // only the counters, the rows are initialized as they are appended
+  _writer.clear();
 
   return 0;
 }
 
-
 void BJetModule::setBranches()
 {
-  
-  _tree->Branch("truth_vertex_n", &_b_truth_vertex_n, "truth_vertex_n/I");
-  _tree->Branch("truth_vertex_x", _b_truth_vertex_x, "truth_vertex_x[truth_vertex_n]/F");
-  _tree->Branch("truth_vertex_y", _b_truth_vertex_y, "truth_vertex_y[truth_vertex_n]/F");
-  _tree->Branch("truth_vertex_z", _b_truth_vertex_z, "truth_vertex_z[truth_vertex_n]/F");
-
-  _tree->Branch("truthjet_n", &_b_truthjet_n, "truthjet_n/I");
-  _tree->Branch("truthjet_parton_flavor", _b_truthjet_parton_flavor, "truthjet_parton_flavor[truthjet_n]/I");
-  _tree->Branch("truthjet_hadron_flavor", _b_truthjet_hadron_flavor, "truthjet_hadron_flavor[truthjet_n]/I");
-  _tree->Branch("truthjet_pt", _b_truthjet_pt, "truthjet_pt[truthjet_n]/F");
-  _tree->Branch("truthjet_eta", _b_truthjet_eta, "truthjet_eta[truthjet_n]/F");
-  _tree->Branch("truthjet_phi", _b_truthjet_phi, "truthjet_phi[truthjet_n]/F");
-
-  _tree->Branch("recojet_valid", _b_recojet_valid, "recojet_valid[truthjet_n]/I");
-  _tree->Branch("recojet_pt", _b_recojet_pt, "recojet_pt[truthjet_n]/F");
-  _tree->Branch("recojet_eta", _b_recojet_eta, "recojet_eta[truthjet_n]/F");
-  _tree->Branch("recojet_phi", _b_recojet_phi, "recojet_phi[truthjet_n]/F");
-
-  _tree->Branch("particle_n", &_b_particle_n, "particle_n/I");
-  _tree->Branch("particle_pt", _b_particle_pt, "particle_pt[particle_n]/F");
-  _tree->Branch("particle_eta", _b_particle_eta, "particle_eta[particle_n]/F");
-  _tree->Branch("particle_phi", _b_particle_phi, "particle_phi[particle_n]/F");
-  _tree->Branch("particle_pid", _b_particle_pid, "particle_pid[particle_n]/I");
-  _tree->Branch("particle_embed", _b_particle_embed, "particle_embed[particle_n]/i");
-
-  _tree->Branch("particle_vertex_x", _b_particle_vertex_x, "particle_vertex_x[particle_n]/F");
-  _tree->Branch("particle_vertex_y", _b_particle_vertex_y, "particle_vertex_y[particle_n]/F");
-  _tree->Branch("particle_vertex_z", _b_particle_vertex_z, "particle_vertex_z[particle_n]/F");
-  _tree->Branch("particle_dca_xy", _b_particle_dca_xy, "particle_dca_xy[particle_n]/F");
-  _tree->Branch("particle_dca_z", _b_particle_dca_z, "particle_dca_z[particle_n]/F");
-
-  _tree->Branch("track_n", &_b_track_n, "track_n/I");
-  _tree->Branch("track_pt", _b_track_pt, "track_pt[track_n]/F");
-  _tree->Branch("track_eta", _b_track_eta, "track_eta[track_n]/F");
-  _tree->Branch("track_phi", _b_track_phi, "track_phi[track_n]/F");
-
-  _tree->Branch("track_dca2d", _b_track_dca2d, "track_dca2d[track_n]/F");
-  _tree->Branch("track_dca2d_error", _b_track_dca2d_error, "track_dca2d_error[track_n]/F");
-
-  _tree->Branch("track_dca3d_xy", _b_track_dca3d_xy, "track_dca3d_xy[track_n]/F");
-  _tree->Branch("track_dca3d_xy_error", _b_track_dca3d_xy_error, "track_dca3d_xy_error[track_n]/F");
-
-  _tree->Branch("track_dca3d_z", _b_track_dca3d_z, "track_dca3d_z[track_n]/F");
-  _tree->Branch("track_dca3d_z_error", _b_track_dca3d_z_error, "track_dca3d_z_error[track_n]/F");
-
-  _tree->Branch("track_dca2d_calc", _b_track_dca2d_calc, "track_dca2d_calc[track_n]/F");
-  _tree->Branch("track_dca2d_calc_truth", _b_track_dca2d_calc_truth, "track_dca2d_calc_truth[track_n]/F");
-
-  _tree->Branch("track_dca3d_calc", _b_track_dca3d_calc, "track_dca3d_calc[track_n]/F");
-  _tree->Branch("track_dca3d_calc_truth", _b_track_dca3d_calc_truth, "track_dca3d_calc_truth[track_n]/F");
-
-  _tree->Branch("track_pca_phi", _b_track_pca_phi, "track_pca_phi[track_n]/F");
-  _tree->Branch("track_pca_x", _b_track_pca_x, "track_pca_x[track_n]/F");
-  _tree->Branch("track_pca_y", _b_track_pca_y, "track_pca_y[track_n]/F");
-  _tree->Branch("track_pca_z", _b_track_pca_z, "track_pca_z[track_n]/F");
-
-  _tree->Branch("track_quality", _b_track_quality, "track_quality[track_n]/F");
-  _tree->Branch("track_chisq", _b_track_chisq, "track_chisq[track_n]/F");
-  _tree->Branch("track_ndf", _b_track_ndf, "track_ndf[track_n]/I");
-
-  _tree->Branch("track_nmaps", _b_track_nmaps, "track_nmaps[track_n]/I");
-
-  _tree->Branch("track_nclusters", _b_track_nclusters, "track_nclusters[track_n]/i");
-  _tree->Branch("track_nclusters_by_layer", _b_track_nclusters_by_layer, "track_nclusters_by_layer[track_n]/i");
-
-  _tree->Branch("track_best_nclusters", _b_track_best_nclusters, "track_best_nclusters[track_n]/i");
-  _tree->Branch("track_best_nclusters_by_layer", _b_track_best_nclusters_by_layer, "track_best_nclusters_by_layer[track_n]/i");
-
-  _tree->Branch("track_best_embed", _b_track_best_embed, "track_best_embed[track_n]/i");
-  _tree->Branch("track_best_primary", _b_track_best_primary, "track_best_primary[track_n]/O");
-  _tree->Branch("track_best_pid", _b_track_best_pid, "track_best_pid[track_n]/I");
-  _tree->Branch("track_best_pt", _b_track_best_pt, "track_best_pt[track_n]/F");
-  _tree->Branch("track_best_in", _b_track_best_in, "track_best_in[track_n]/I");
-  _tree->Branch("track_best_out", _b_track_best_out, "track_best_out[track_n]/I");
-  _tree->Branch("track_best_parent_pid", _b_track_best_parent_pid, "track_best_parent_pid[track_n]/I");
-
-  _tree->Branch("track_best_vertex_x", _b_track_best_vertex_x, "track_best_vertex_x[track_n]/F");
-  _tree->Branch("track_best_vertex_y", _b_track_best_vertex_y, "track_best_vertex_y[track_n]/F");
-  _tree->Branch("track_best_vertex_z", _b_track_best_vertex_z, "track_best_vertex_z[track_n]/F");
-
-  _tree->Branch("track_best_dca_xy", _b_track_best_dca_xy, "track_best_dca_xy[track_n]/F");
-  _tree->Branch("track_best_dca_z", _b_track_best_dca_z, "track_best_dca_z[track_n]/F");
-
+  _truth_vertices = &_writer.add_collection("truth_vertex", 10);
+  _b_truth_vertex_x = _truth_vertices->add_column<float>("truth_vertex_x", -99);
+  _b_truth_vertex_y = _truth_vertices->add_column<float>("truth_vertex_y", -99);
+  _b_truth_vertex_z = _truth_vertices->add_column<float>("truth_vertex_z", -99);
+
+  _truthjets = &_writer.add_collection("truthjet", _max_truthjets);
+  _b_truthjet_parton_flavor = _truthjets->add_column<int>("truthjet_parton_flavor", -9999);
+  _b_truthjet_hadron_flavor = _truthjets->add_column<int>("truthjet_hadron_flavor", -9999);
+  _b_truthjet_pt = _truthjets->add_column<float>("truthjet_pt", -99);
+  _b_truthjet_eta = _truthjets->add_column<float>("truthjet_eta", -99);
+  _b_truthjet_phi = _truthjets->add_column<float>("truthjet_phi", -99);
+
+  _b_recojet_valid = _truthjets->add_column<int>("recojet_valid", 0);
+  _b_recojet_pt = _truthjets->add_column<float>("recojet_pt", -99);
+  _b_recojet_eta = _truthjets->add_column<float>("recojet_eta", -99);
+  _b_recojet_phi = _truthjets->add_column<float>("recojet_phi", -99);
+
+  _particles = &_writer.add_collection("particle", _max_particles);
+  _b_particle_pt = _particles->add_column<float>("particle_pt", -1);
+  _b_particle_eta = _particles->add_column<float>("particle_eta", -1);
+  _b_particle_phi = _particles->add_column<float>("particle_phi", -1);
+  _b_particle_pid = _particles->add_column<int>("particle_pid", 0);
+  _b_particle_embed = _particles->add_column<unsigned int>("particle_embed", 0);
+
+  _b_particle_vertex_x = _particles->add_column<float>("particle_vertex_x", -1);
+  _b_particle_vertex_y = _particles->add_column<float>("particle_vertex_y", -1);
+  _b_particle_vertex_z = _particles->add_column<float>("particle_vertex_z", -1);
+  _b_particle_dca_xy = _particles->add_column<float>("particle_dca_xy", -1);
+  _b_particle_dca_z = _particles->add_column<float>("particle_dca_z", -1);
+
+  _tracks = &_writer.add_collection("track", _max_tracks);
+  _b_track_pt = _tracks->add_column<float>("track_pt", -1);
+  _b_track_eta = _tracks->add_column<float>("track_eta", -1);
+  _b_track_phi = _tracks->add_column<float>("track_phi", -1);
+
+  _b_track_dca2d = _tracks->add_column<float>("track_dca2d", -1);
+  _b_track_dca2d_error = _tracks->add_column<float>("track_dca2d_error", -1);
+
+  _b_track_dca3d_xy = _tracks->add_column<float>("track_dca3d_xy", -1);
+  _b_track_dca3d_xy_error = _tracks->add_column<float>("track_dca3d_xy_error", -1);
+
+  _b_track_dca3d_z = _tracks->add_column<float>("track_dca3d_z", -1);
+  _b_track_dca3d_z_error = _tracks->add_column<float>("track_dca3d_z_error", -1);
+
+  _b_track_dca2d_calc = _tracks->add_column<float>("track_dca2d_calc", -1);
+  _b_track_dca2d_calc_truth = _tracks->add_column<float>("track_dca2d_calc_truth", -1);
+
+  _b_track_dca3d_calc = _tracks->add_column<float>("track_dca3d_calc", -1);
+  _b_track_dca3d_calc_truth = _tracks->add_column<float>("track_dca3d_calc_truth", -1);
+
+  _b_track_pca_phi = _tracks->add_column<float>("track_pca_phi", -99);
+  _b_track_pca_x = _tracks->add_column<float>("track_pca_x", -99);
+  _b_track_pca_y = _tracks->add_column<float>("track_pca_y", -99);
+  _b_track_pca_z = _tracks->add_column<float>("track_pca_z", -99);
+
+  _b_track_quality = _tracks->add_column<float>("track_quality", -99);
+  _b_track_chisq = _tracks->add_column<float>("track_chisq", -99);
+  _b_track_ndf = _tracks->add_column<int>("track_ndf", -99);
+
+  _b_track_nmaps = _tracks->add_column<int>("track_nmaps", 0);
+
+  _b_track_nclusters = _tracks->add_column<unsigned int>("track_nclusters", 0);
+  _b_track_nclusters_by_layer = _tracks->add_column<unsigned int>("track_nclusters_by_layer", 0);
+
+  _b_track_best_nclusters = _tracks->add_column<unsigned int>("track_best_nclusters", 0);
+  _b_track_best_nclusters_by_layer = _tracks->add_column<unsigned int>("track_best_nclusters_by_layer", 0);
+
+  _b_track_best_embed = _tracks->add_column<unsigned int>("track_best_embed", 0);
+  _b_track_best_primary = _tracks->add_column<bool>("track_best_primary", false);
+  _b_track_best_pid = _tracks->add_column<int>("track_best_pid", 0);
+  _b_track_best_pt = _tracks->add_column<float>("track_best_pt", 0);
+  _b_track_best_in = _tracks->add_column<int>("track_best_in", 0);
+  _b_track_best_out = _tracks->add_column<int>("track_best_out", 0);
+  _b_track_best_parent_pid = _tracks->add_column<int>("track_best_parent_pid", 0);
+
+  _b_track_best_vertex_x = _tracks->add_column<float>("track_best_vertex_x", -99);
+  _b_track_best_vertex_y = _tracks->add_column<float>("track_best_vertex_y", -99);
+  _b_track_best_vertex_z = _tracks->add_column<float>("track_best_vertex_z", -99);
+
+  _b_track_best_dca_xy = _tracks->add_column<float>("track_best_dca_xy", -99);
+  _b_track_best_dca_z = _tracks->add_column<float>("track_best_dca_z", -99);
+
+  _writer.branch(_tree);
 }
+
 int BJetModule::End(PHCompositeNode *topNode)
 {
   //_f->ls();
   //_tree->Write();
+  _writer.print_summary();
+
   _f->Write();
   _f->Close();
 
@@ -9,6 +9,8 @@
 #define __BJETMODULE_H__
 
 // --- need to check all these includes...
+#include "JaggedTreeWriter.h"
+
 #include <fun4all/SubsysReco.h>
 #include <vector>
 
@@ -56,6 +58,12 @@ class BJetModule : public SubsysReco
     _vertexmap_name = vertexmapName;
   }
 
+  //! maximum number of truth jets, particles and tracks stored per event,
+  //! set before Init(); the rest is dropped and counted in <prefix>_nlost
+  void set_max_truthjets(int n) { _max_truthjets = n; }
+  void set_max_particles(int n) { _max_particles = n; }
+  void set_max_tracks(int n) { _max_tracks = n; }
+
  private:
   float dR(float eta1, float eta2, float phi1, float phi2)
   {
@@ -82,6 +90,10 @@ class BJetModule : public SubsysReco
   std::string _trackmap_name;
   std::string _vertexmap_name;
 
+  int _max_truthjets;
+  int _max_particles;
+  int _max_tracks;
+
   int _ievent;
 
   TFile* _f;
@@ -89,86 +101,89 @@ class BJetModule : public SubsysReco
 
   int _b_event;
 
-  int _b_truth_vertex_n;
-  float _b_truth_vertex_x[10];
-  float _b_truth_vertex_y[10];
-  float _b_truth_vertex_z[10];
-
-  int _b_truthjet_n;
-  int _b_truthjet_parton_flavor[10];
-  int _b_truthjet_hadron_flavor[10];
-
-  float _b_truthjet_pt[10];
-  float _b_truthjet_eta[10];
-  float _b_truthjet_phi[10];
-
-  int _b_recojet_valid[10];
-  float _b_recojet_pt[10];
-  float _b_recojet_eta[10];
-  float _b_recojet_phi[10];
-
-  int _b_particle_n;
-  float _b_particle_pt[1000];
-  float _b_particle_eta[1000];
-  float _b_particle_phi[1000];
-  int _b_particle_pid[1000];
-  unsigned int _b_particle_embed[1000];
-
-  float _b_particle_vertex_x[1000];
-  float _b_particle_vertex_y[1000];
-  float _b_particle_vertex_z[1000];
-  float _b_particle_dca_xy[1000];
-  float _b_particle_dca_z[1000];
-
-  int _b_track_n;
-  float _b_track_pt[1000];
-  float _b_track_eta[1000];
-  float _b_track_phi[1000];
-
-  float _b_track_dca2d[1000];
-  float _b_track_dca2d_error[1000];
-
-  float _b_track_dca3d_xy[1000];
-  float _b_track_dca3d_xy_error[1000];
-
-  float _b_track_dca3d_z[1000];
-  float _b_track_dca3d_z_error[1000];
-
-  float _b_track_dca2d_calc[1000];
-  float _b_track_dca2d_calc_truth[1000];
-  float _b_track_dca3d_calc[1000];
-  float _b_track_dca3d_calc_truth[1000];
-
-  float _b_track_pca_phi[1000];
-  float _b_track_pca_x[1000];
-  float _b_track_pca_y[1000];
-  float _b_track_pca_z[1000];
-
-  float _b_track_quality[1000];
-  float _b_track_chisq[1000];
-  int _b_track_ndf[1000];
-
-  int _b_track_nmaps[1000];
-
-  unsigned int _b_track_nclusters[1000];
-  unsigned int _b_track_nclusters_by_layer[1000];
-  unsigned int _b_track_best_nclusters[1000];
-  unsigned int _b_track_best_nclusters_by_layer[1000];
-
-  unsigned int _b_track_best_embed[1000];
-  bool _b_track_best_primary[1000];
-  int _b_track_best_pid[1000];
-  float _b_track_best_pt[1000];
-
-  int _b_track_best_in[1000];
-  int _b_track_best_out[1000];
-  int _b_track_best_parent_pid[1000];
-
-  float _b_track_best_vertex_x[1000];
-  float _b_track_best_vertex_y[1000];
-  float _b_track_best_vertex_z[1000];
-  float _b_track_best_dca_xy[1000];
-  float _b_track_best_dca_z[1000];
+  //! per-event collections and their column buffers, see setBranches()
+  JaggedTreeWriter _writer;
+
+  JaggedTreeWriter::Collection* _truth_vertices;
+  float* _b_truth_vertex_x;
+  float* _b_truth_vertex_y;
+  float* _b_truth_vertex_z;
+
+  JaggedTreeWriter::Collection* _truthjets;
+  int* _b_truthjet_parton_flavor;
+  int* _b_truthjet_hadron_flavor;
+
+  float* _b_truthjet_pt;
+  float* _b_truthjet_eta;
+  float* _b_truthjet_phi;
+
+  int* _b_recojet_valid;
+  float* _b_recojet_pt;
+  float* _b_recojet_eta;
+  float* _b_recojet_phi;
+
+  JaggedTreeWriter::Collection* _particles;
+  float* _b_particle_pt;
+  float* _b_particle_eta;
+  float* _b_particle_phi;
+  int* _b_particle_pid;
+  unsigned int* _b_particle_embed;
+
+  float* _b_particle_vertex_x;
+  float* _b_particle_vertex_y;
+  float* _b_particle_vertex_z;
+  float* _b_particle_dca_xy;
+  float* _b_particle_dca_z;
+
+  JaggedTreeWriter::Collection* _tracks;
+  float* _b_track_pt;
+  float* _b_track_eta;
+  float* _b_track_phi;
+
+  float* _b_track_dca2d;
+  float* _b_track_dca2d_error;
+
+  float* _b_track_dca3d_xy;
+  float* _b_track_dca3d_xy_error;
+
+  float* _b_track_dca3d_z;
+  float* _b_track_dca3d_z_error;
+
+  float* _b_track_dca2d_calc;
+  float* _b_track_dca2d_calc_truth;
+  float* _b_track_dca3d_calc;
+  float* _b_track_dca3d_calc_truth;
+
+  float* _b_track_pca_phi;
+  float* _b_track_pca_x;
+  float* _b_track_pca_y;
+  float* _b_track_pca_z;
+
+  float* _b_track_quality;
+  float* _b_track_chisq;
+  int* _b_track_ndf;
+
+  int* _b_track_nmaps;
+
+  unsigned int* _b_track_nclusters;
+  unsigned int* _b_track_nclusters_by_layer;
+  unsigned int* _b_track_best_nclusters;
+  unsigned int* _b_track_best_nclusters_by_layer;
+
+  unsigned int* _b_track_best_embed;
+  bool* _b_track_best_primary;
+  int* _b_track_best_pid;
+  float* _b_track_best_pt;
+
+  int* _b_track_best_in;
+  int* _b_track_best_out;
+  int* _b_track_best_parent_pid;
+
+  float* _b_track_best_vertex_x;
+  float* _b_track_best_vertex_y;
+  float* _b_track_best_vertex_z;
+  float* _b_track_best_dca_xy;
+  float* _b_track_best_dca_z;
 
   //! The embedding ID for the HepMC subevent to be analyzed.
   //! positive ID is the embedded event of interest, e.g. jetty event from pythia
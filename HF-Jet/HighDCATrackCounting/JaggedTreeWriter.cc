@@ -0,0 +1,68 @@
+#include "JaggedTreeWriter.h"
+
+#include <TTree.h>
+
+#include <iostream>
+
+JaggedTreeWriter::Collection::Collection(const std::string &prefix, int max_size)
+  : _prefix(prefix)
+  , _max_size(max_size)
+{
+}
+
+void JaggedTreeWriter::Collection::clear()
+{
+  _n = 0;
+  _nlost = 0;
+}
+
+void JaggedTreeWriter::Collection::branch(TTree *tree)
+{
+  const std::string counter = _prefix + "_n";
+  tree->Branch(counter.c_str(), &_n, (counter + "/I").c_str());
+  tree->Branch((_prefix + "_nlost").c_str(), &_nlost, (_prefix + "_nlost/I").c_str());
+
+  for (auto &column : _columns)
+  {
+    const std::string leaflist = column->name + "[" + counter + "]/" + column->leaf_type();
+    tree->Branch(column->name.c_str(), column->address(), leaflist.c_str());
+  }
+}
+
+JaggedTreeWriter::Collection &JaggedTreeWriter::add_collection(const std::string &prefix, int max_size)
+{
+  _collections.emplace_back(new Collection(prefix, max_size));
+  return *_collections.back();
+}
+
+void JaggedTreeWriter::branch(TTree *tree)
+{
+  for (auto &collection : _collections)
+  {
+    collection->branch(tree);
+  }
+}
+
+void JaggedTreeWriter::clear()
+{
+  for (auto &collection : _collections)
+  {
+    collection->clear();
+  }
+}
+
+void JaggedTreeWriter::print_summary() const
+{
+  for (const auto &collection : _collections)
+  {
+    if (collection->get_nlost_total() == 0)
+    {
+      continue;
+    }
+    std::cout << "JaggedTreeWriter: " << collection->get_prefix() << ": "
+              << collection->get_nlost_total() << " rows dropped in "
+              << collection->get_nevents_overflow()
+              << " events above the maximum size of " << collection->max_size()
+              << ", see " << collection->get_prefix() << "_nlost" << std::endl;
+  }
+}
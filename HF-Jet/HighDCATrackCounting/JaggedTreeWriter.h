@@ -0,0 +1,170 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef JAGGEDTREEWRITER_H
+#define JAGGEDTREEWRITER_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TTree;
+
+/*!
+ *  \brief Columnar, counted variable-length branches for flat analysis trees
+ *
+ *  A collection (tracks, particles, jets, ...) owns one counter branch
+ *  "<prefix>_n" and any number of columns written as "<column>[<prefix>_n]".
+ *  Column buffers are allocated once with the maximum collection size, so the
+ *  branch addresses stay valid and nothing is cleared per event: clear() only
+ *  resets the counters and append() sets the defaults of the new row.
+ *  Only the filled rows are written to the tree.
+ *
+ *  Rows beyond the maximum size are dropped and counted, the number of rows
+ *  dropped in the event is written to "<prefix>_nlost" and summarized by
+ *  print_summary().
+ *
+ *  \code
+ *  JaggedTreeWriter writer;
+ *  JaggedTreeWriter::Collection &tracks = writer.add_collection("track", 1000);
+ *  float *pt = tracks.add_column<float>("track_pt", -1);
+ *  writer.branch(tree);
+ *  ...
+ *  writer.clear();
+ *  int i = tracks.append();
+ *  if (i >= 0) pt[i] = track->get_pt();
+ *  tree->Fill();
+ *  \endcode
+ */
+class JaggedTreeWriter
+{
+ public:
+  class Collection
+  {
+   public:
+    Collection(const std::string &prefix, int max_size);
+
+    //! column buffer of max_size() elements, valid for the lifetime of the
+    //! collection; new rows are initialized with default_value
+    template <typename T>
+    T *add_column(const std::string &name, T default_value = T());
+
+    //! add a row, returns its index or -1 if the collection is full
+    int append()
+    {
+      if (_n >= _max_size)
+      {
+        if (_nlost++ == 0)
+        {
+          ++_nevents_overflow;
+        }
+        ++_nlost_total;
+        return -1;
+      }
+      for (auto &column : _columns)
+      {
+        column->set_default(_n);
+      }
+      return _n++;
+    }
+
+    void clear();
+
+    const std::string &get_prefix() const { return _prefix; }
+    int size() const { return _n; }
+    int max_size() const { return _max_size; }
+    int get_nlost() const { return _nlost; }
+    long get_nlost_total() const { return _nlost_total; }
+    long get_nevents_overflow() const { return _nevents_overflow; }
+
+    void branch(TTree *tree);
+
+   private:
+    struct ColumnBase
+    {
+      explicit ColumnBase(const std::string &n)
+        : name(n)
+      {
+      }
+      virtual ~ColumnBase() = default;
+      virtual void set_default(int i) = 0;
+      virtual void *address() = 0;
+      virtual char leaf_type() const = 0;
+
+      std::string name;
+    };
+
+    template <typename T>
+    struct Column : public ColumnBase
+    {
+      Column(const std::string &n, int max_size, T def)
+        : ColumnBase(n)
+        , data(new T[max_size])
+        , default_value(def)
+      {
+        std::fill(data.get(), data.get() + max_size, def);
+      }
+      void set_default(int i) override { data[i] = default_value; }
+      void *address() override { return data.get(); }
+      char leaf_type() const override;
+
+      //! not a std::vector, which has no contiguous bool buffer
+      std::unique_ptr<T[]> data;
+      T default_value;
+    };
+
+    std::string _prefix;
+    int _max_size;
+
+    int _n = 0;
+    int _nlost = 0;
+    long _nlost_total = 0;
+    long _nevents_overflow = 0;
+
+    std::vector<std::unique_ptr<ColumnBase>> _columns;
+  };
+
+  JaggedTreeWriter() = default;
+  JaggedTreeWriter(const JaggedTreeWriter &) = delete;
+  JaggedTreeWriter &operator=(const JaggedTreeWriter &) = delete;
+
+  //! the returned reference stays valid for the lifetime of the writer
+  Collection &add_collection(const std::string &prefix, int max_size);
+
+  //! create the counter and column branches of all collections
+  void branch(TTree *tree);
+
+  //! start a new event
+  void clear();
+
+  //! rows dropped because a collection was full
+  void print_summary() const;
+
+ private:
+  std::vector<std::unique_ptr<Collection>> _collections;
+};
+
+template <typename T>
+T *JaggedTreeWriter::Collection::add_column(const std::string &name, T default_value)
+{
+  Column<T> *column = new Column<T>(name, _max_size, default_value);
+  _columns.emplace_back(column);
+  return column->data.get();
+}
+
+template <>
+inline char JaggedTreeWriter::Collection::Column<float>::leaf_type() const { return 'F'; }
+template <>
+inline char JaggedTreeWriter::Collection::Column<double>::leaf_type() const { return 'D'; }
+template <>
+inline char JaggedTreeWriter::Collection::Column<int>::leaf_type() const { return 'I'; }
+template <>
+inline char JaggedTreeWriter::Collection::Column<unsigned int>::leaf_type() const { return 'i'; }
+template <>
+inline char JaggedTreeWriter::Collection::Column<short>::leaf_type() const { return 'S'; }
+template <>
+inline char JaggedTreeWriter::Collection::Column<unsigned short>::leaf_type() const { return 's'; }
+template <>
+inline char JaggedTreeWriter::Collection::Column<bool>::leaf_type() const { return 'O'; }
+
+#endif
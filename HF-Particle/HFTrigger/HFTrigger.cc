@@ -100,8 +100,10 @@ bool HFTrigger::runTrigger(PHCompositeNode *topNode)
   float asymmMult = 0;
   calculateMultiplicity(topNode, meanMult, asymmMult);  
 
-  if (m_useOneTrackTrigger) triggerDecisions.find("oneTrack")->second = runOneTrackTrigger(allTracks, allVertices);
-  if (m_useTwoTrackTrigger) triggerDecisions.find("twoTrack")->second = runTwoTrackTrigger(allTracks, allVertices);
+  if (m_useOneTrackTrigger || m_useTwoTrackTrigger) fillTrackTable(allTracks, allVertices, m_trackTable);
+
+  if (m_useOneTrackTrigger) triggerDecisions.find("oneTrack")->second = runOneTrackTrigger(m_trackTable);
+  if (m_useTwoTrackTrigger) triggerDecisions.find("twoTrack")->second = runTwoTrackTrigger(m_trackTable);
   if (m_useLowMultiplicityTrigger) triggerDecisions.find("lowMultiplicity")->second = runLowMultiplicityTrigger(meanMult, asymmMult);
   if (m_useHighMultiplicityTrigger) triggerDecisions.find("highMultiplicity")->second = runHighMultiplicityTrigger(meanMult, asymmMult);
 
@@ -116,50 +118,113 @@ bool HFTrigger::runTrigger(PHCompositeNode *topNode)
   return anyTriggerFired;
 }
 
-bool HFTrigger::runOneTrackTrigger(std::vector<Track> Tracks, std::vector<Vertex> Vertices)
-{ //Can maybe use return when we get a positive trigger decision to break the loops
-  bool oneTrackTriggerDecision = false;
+void HFTrigger::fillTrackTable(const std::vector<Track>& Tracks, const std::vector<Vertex>& Vertices, TrackTable& table)
+{
+  const unsigned int nTracks = Tracks.size();
+  table.x.resize(nTracks);
+  table.y.resize(nTracks);
+  table.z.resize(nTracks);
+  table.px.resize(nTracks);
+  table.py.resize(nTracks);
+  table.pz.resize(nTracks);
+  table.pT.resize(nTracks);
+  table.phi.resize(nTracks);
+  table.eta.resize(nTracks);
+  table.minIP.assign(nTracks, FLT_MAX);
+
+  for (unsigned int i = 0; i < nTracks; i++)
+  {
+    const Track& track = Tracks[i];
+    table.x[i] = track(0,0);
+    table.y[i] = track(1,0);
+    table.z[i] = track(2,0);
+    table.px[i] = track(3,0);
+    table.py[i] = track(4,0);
+    table.pz[i] = track(5,0);
+    table.pT[i] = sqrt(pow(track(3,0), 2) + pow(track(4,0), 2));
+    table.phi[i] = atan2(track(4,0), track(3,0));
+    table.eta[i] = asinh(track(5,0)/table.pT[i]);
+  }
 
-  for (Track track : Tracks)
+  //Vertices outside, tracks inside so the DCA loop runs over contiguous arrays
+  float *minIP = table.minIP.data();
+  const float *x = table.x.data(), *y = table.y.data(), *z = table.z.data();
+  const float *px = table.px.data(), *py = table.py.data(), *pz = table.pz.data();
+  for (const Vertex& vertex : Vertices)
   {
-    float pT = sqrt(pow(track(3,0), 2) + pow(track(4,0), 2));
-    float minIP = FLT_MAX;
-    for (Vertex vertex : Vertices)
+    const float vx = vertex(0,0), vy = vertex(1,0), vz = vertex(2,0);
+    for (unsigned int i = 0; i < nTracks; i++)
     {
-      float thisIP = calcualteTrackVertexDCA(track, vertex);
-      minIP = std::min(minIP, thisIP);
+      const float dx = x[i] - vx, dy = y[i] - vy, dz = z[i] - vz;
+      const float along = (px[i]*dx + py[i]*dy + pz[i]*dz)/(px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i]);
+      const float ex = dx - along*px[i], ey = dy - along*py[i], ez = dz - along*pz[i];
+      minIP[i] = std::min(minIP[i], std::sqrt(ex*ex + ey*ey + ez*ez));
     }
-    if (pT > HFTriggerRequirement::trackPT && minIP > HFTriggerRequirement::trackVertexDCA) oneTrackTriggerDecision = true;
   }
+}
 
-  return oneTrackTriggerDecision;
+bool HFTrigger::runOneTrackTrigger(const std::vector<Track>& Tracks, const std::vector<Vertex>& Vertices)
+{
+  TrackTable table;
+  fillTrackTable(Tracks, Vertices, table);
+  return runOneTrackTrigger(table);
 }
 
-bool HFTrigger::runTwoTrackTrigger(std::vector<Track> Tracks, std::vector<Vertex> Vertices)
+bool HFTrigger::runOneTrackTrigger(const TrackTable& table)
 {
-  bool twoTrackTriggerDecision = false;
-  std::vector<Track> goodTracks;
+  for (unsigned int i = 0; i < table.pT.size(); i++)
+  {
+    if (table.pT[i] > HFTriggerRequirement::trackPT && table.minIP[i] > HFTriggerRequirement::trackVertexDCA) return true;
+  }
+
+  return false;
+}
+
+bool HFTrigger::runTwoTrackTrigger(const std::vector<Track>& Tracks, const std::vector<Vertex>& Vertices)
+{
+  TrackTable table;
+  fillTrackTable(Tracks, Vertices, table);
+  return runTwoTrackTrigger(table);
+}
 
-  for (Track track : Tracks)
+bool HFTrigger::runTwoTrackTrigger(const TrackTable& table)
+{
+  m_goodTracks.clear();
+  for (unsigned int i = 0; i < table.pT.size(); i++)
+  {
+    if (table.pT[i] > HFTriggerRequirement::trackPT && table.minIP[i] > HFTriggerRequirement::trackVertexDCA) m_goodTracks.push_back(i);
+  }
+
+  if (m_goodTracks.size() < 2) return false; //We need at least two good track to start a two track trigger
+
+  const bool useEtaWindow = m_pairMaxDeltaEta > 0;
+  const bool usePhiWindow = m_pairMaxDeltaPhi > 0;
+
+  //Sorted in eta, the partners of a track within the eta window are the next tracks in the list
+  if (useEtaWindow)
   {
-    std::vector<Track> singleTrack = {track};
-    bool oneTrackTriggerDecision = runOneTrackTrigger(singleTrack, Vertices);
-    if (oneTrackTriggerDecision) goodTracks.push_back(track);
+    std::sort(m_goodTracks.begin(), m_goodTracks.end(),
+              [&table](unsigned int a, unsigned int b) { return table.eta[a] < table.eta[b]; });
   }
 
-  if (goodTracks.size() > 1) //We need at least two good track to start a two track trigger
+  for (unsigned int i = 0; i < m_goodTracks.size(); i++)
   {
-    for (unsigned int i = 0; i < goodTracks.size(); i++)
+    const unsigned int one = m_goodTracks[i];
+    for (unsigned int j = i + 1; j < m_goodTracks.size(); j++)
     {
-      for (unsigned int j = i + 1; j < goodTracks.size(); j++)
+      const unsigned int two = m_goodTracks[j];
+      if (useEtaWindow && table.eta[two] - table.eta[one] > m_pairMaxDeltaEta) break;
+      if (usePhiWindow)
       {
-        float trackDCA = calcualteTrackTrackDCA(goodTracks[i], goodTracks[j]);
-        if (trackDCA < HFTriggerRequirement::trackTrackDCA) twoTrackTriggerDecision = true;
-      } 
+        const float deltaPhi = std::abs(std::remainder(table.phi[two] - table.phi[one], 2*M_PI));
+        if (deltaPhi > m_pairMaxDeltaPhi) continue;
+      }
+
+      if (calcualteTrackTrackDCA(table, one, two) < HFTriggerRequirement::trackTrackDCA) return true;
     }
   }
 
-  return twoTrackTriggerDecision;
+  return false;
 }
 
 void HFTrigger::calculateMultiplicity(PHCompositeNode *topNode, float& meanMultiplicity, float& asymmetryMultiplicity)
@@ -263,7 +328,7 @@ std::vector<Track> HFTrigger::makeAllTracks(PHCompositeNode *topNode)
   return tracks;
 }
 
-int HFTrigger::decomposeTrack(Track track, TrackX& trackPosition, TrackP& trackMomentum)
+int HFTrigger::decomposeTrack(const Track& track, TrackX& trackPosition, TrackP& trackMomentum)
 {
   for (unsigned int i = 0; i < 3; i++)
   {
@@ -274,7 +339,7 @@ int HFTrigger::decomposeTrack(Track track, TrackX& trackPosition, TrackP& trackM
   return 0;
 }
 
-float HFTrigger::calcualteTrackVertex2DDCA(Track track, Vertex vertex)
+float HFTrigger::calcualteTrackVertex2DDCA(const Track& track, const Vertex& vertex)
 {
   TrackX pos;
   TrackP mom;
@@ -289,7 +354,7 @@ float HFTrigger::calcualteTrackVertex2DDCA(Track track, Vertex vertex)
   return twoD_DCA;
 }
 
-float HFTrigger::calcualteTrackVertexDCA(Track track, Vertex vertex)
+float HFTrigger::calcualteTrackVertexDCA(const Track& track, const Vertex& vertex)
 {
   TrackX pos;
   TrackP mom;
@@ -302,7 +367,7 @@ float HFTrigger::calcualteTrackVertexDCA(Track track, Vertex vertex)
   return std::abs(dcaVertex.norm());
 }
 
-float HFTrigger::calcualteTrackTrackDCA(Track trackOne, Track trackTwo)
+float HFTrigger::calcualteTrackTrackDCA(const Track& trackOne, const Track& trackTwo)
 {
   TrackX posOne;
   TrackP momOne;
@@ -320,6 +385,19 @@ float HFTrigger::calcualteTrackTrackDCA(Track trackOne, Track trackTwo)
   return dcaTrackSize;
 }
 
+float HFTrigger::calcualteTrackTrackDCA(const TrackTable& table, unsigned int i, unsigned int j)
+{
+  const float nx = table.py[i]*table.pz[j] - table.pz[i]*table.py[j];
+  const float ny = table.pz[i]*table.px[j] - table.px[i]*table.pz[j];
+  const float nz = table.px[i]*table.py[j] - table.py[i]*table.px[j];
+
+  const float dx = table.x[i] - table.x[j];
+  const float dy = table.y[i] - table.y[j];
+  const float dz = table.z[i] - table.z[j];
+
+  return std::abs((nx*dx + ny*dy + nz*dz)/std::sqrt(nx*nx + ny*ny + nz*nz));
+}
+
 void HFTrigger::printTrigger()
 {
   std::cout << "\n---------------HFTrigger information---------------" << std::endl;
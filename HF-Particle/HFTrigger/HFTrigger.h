@@ -52,9 +52,23 @@ class HFTrigger : public SubsysReco
 
   bool runTrigger(PHCompositeNode *topNode);
 
-  bool runOneTrackTrigger(std::vector<Track> Tracks, std::vector<Vertex> Vertices);
+  //Per event track quantities, one array per quantity, computed once and shared by the track triggers
+  struct TrackTable
+  {
+    std::vector<float> x, y, z, px, py, pz;
+    std::vector<float> pT, phi, eta;
+    std::vector<float> minIP; //3D DCA to the closest primary vertex
+  };
 
-  bool runTwoTrackTrigger(std::vector<Track> Tracks, std::vector<Vertex> Vertices);
+  void fillTrackTable(const std::vector<Track>& Tracks, const std::vector<Vertex>& Vertices, TrackTable& table);
+
+  bool runOneTrackTrigger(const std::vector<Track>& Tracks, const std::vector<Vertex>& Vertices);
+
+  bool runOneTrackTrigger(const TrackTable& table);
+
+  bool runTwoTrackTrigger(const std::vector<Track>& Tracks, const std::vector<Vertex>& Vertices);
+
+  bool runTwoTrackTrigger(const TrackTable& table);
 
   void calculateMultiplicity(PHCompositeNode *topNode, float& meanMultiplicity, float& asymmetryMultiplicity);
 
@@ -70,13 +84,15 @@ class HFTrigger : public SubsysReco
 
   std::vector<Track> makeAllTracks(PHCompositeNode *topNode);
 
-  int decomposeTrack(Track track, TrackX& trackPosition, TrackP& trackMomentum);
+  int decomposeTrack(const Track& track, TrackX& trackPosition, TrackP& trackMomentum);
 
-  float calcualteTrackVertex2DDCA(Track track, Vertex vertex);
+  float calcualteTrackVertex2DDCA(const Track& track, const Vertex& vertex);
 
-  float calcualteTrackVertexDCA(Track track, Vertex vertex);
+  float calcualteTrackVertexDCA(const Track& track, const Vertex& vertex);
 
-  float calcualteTrackTrackDCA(Track trackOne, Track trackTwo);
+  float calcualteTrackTrackDCA(const Track& trackOne, const Track& trackTwo);
+
+  float calcualteTrackTrackDCA(const TrackTable& table, unsigned int i, unsigned int j);
 
   void printTrigger();
 
@@ -85,6 +101,8 @@ class HFTrigger : public SubsysReco
   void requireTwoTrackTrigger(bool useTrigger) { m_useTwoTrackTrigger = useTrigger; }
   void requireLowMultiplicityTrigger(bool useTrigger) { m_useLowMultiplicityTrigger = useTrigger; }
   void requireHighMultiplicityTrigger(bool useTrigger) { m_useHighMultiplicityTrigger = useTrigger; }
+  //Only test the DCA of track pairs within this opening in phi and eta, <= 0 tests all pairs (default)
+  void setTwoTrackPairWindow(float maxDeltaPhi, float maxDeltaEta) { m_pairMaxDeltaPhi = maxDeltaPhi; m_pairMaxDeltaEta = maxDeltaEta; }
 
  private:
 
@@ -93,6 +111,12 @@ class HFTrigger : public SubsysReco
   bool m_useLowMultiplicityTrigger = false;
   bool m_useHighMultiplicityTrigger = false;
 
+  float m_pairMaxDeltaPhi = 0;
+  float m_pairMaxDeltaEta = 0;
+
+  TrackTable m_trackTable;
+  std::vector<unsigned int> m_goodTracks;
+
   SvtxVertexMap *m_dst_vertexmap = nullptr;
   SvtxTrackMap *m_dst_trackmap = nullptr;
   SvtxVertex *m_dst_vertex = nullptr;
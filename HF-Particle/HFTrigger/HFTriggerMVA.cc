@@ -65,16 +65,22 @@ int HFTriggerMVA::Init(PHCompositeNode *topNode)
   {
     std::string algorithmFile = path + "wCalo/TMVAClassification_" + mvaType + ".weights.xml";
     std::tie(wCaloReader, wCaloFloats) = initMVA(varListwCalo, mvaType, algorithmFile);
+    wCaloForest.setNumberOfThreads(m_mvaThreads);
+    if (!wCaloForest.load(algorithmFile)) std::cout << "wCalo: using TMVA::Reader for every track pair" << std::endl;
   }
   if (m_useMVAwoutCaloTrigger)
   {
     std::string algorithmFile = path + "woutCalo/TMVAClassification_" + mvaType + ".weights.xml";
     std::tie(woutCaloReader, woutCaloFloats) = initMVA(varListwoutCalo, mvaType, algorithmFile);
+    woutCaloForest.setNumberOfThreads(m_mvaThreads);
+    if (!woutCaloForest.load(algorithmFile)) std::cout << "woutCalo: using TMVA::Reader for every track pair" << std::endl;
   }
   if (m_useMVAwoutCaloAndMinTrackTrigger)
   {
     std::string algorithmFile = path + "woutCaloAndMinTrack/TMVAClassification_" + mvaType + ".weights.xml";
     std::tie(woutCaloAndMinTrackReader, woutCaloAndMinTrackFloats) = initMVA(varListwoutCaloAndMinTrack, mvaType, algorithmFile);
+    woutCaloAndMinTrackForest.setNumberOfThreads(m_mvaThreads);
+    if (!woutCaloAndMinTrackForest.load(algorithmFile)) std::cout << "woutCaloAndMinTrack: using TMVA::Reader for every track pair" << std::endl;
   }
 
   return 0;
@@ -143,6 +149,10 @@ bool HFTriggerMVA::runTrigger(PHCompositeNode *topNode)
 
   float maxEMCalEnergy = getMaxEMCalEnergy(topNode);
 
+  wCaloCandidates.clear();
+  woutCaloCandidates.clear();
+  woutCaloAndMinTrackCandidates.clear();
+
   for (unsigned int k = 0; k < allVertices.size(); k++)
   {
     for (unsigned int i = 0; i < allTracks.size(); i++)
@@ -183,26 +193,30 @@ bool HFTriggerMVA::runTrigger(PHCompositeNode *topNode)
           if (trigger) triggerDecisionsMVA.find("cutsWithoutCalo")->second = true;
         }
 
-        if (m_useMVAwCaloTrigger)
-        {
-          bool trigger = runMVATrigger(wCaloReader, mvaType, wCaloFloats, MVA_wCaloResponse);
-          if (trigger) triggerDecisionsMVA.find("MVAWithCalo")->second = true;
-        }
+        if (m_useMVAwCaloTrigger) wCaloCandidates.insert(wCaloCandidates.end(), wCaloFloats.begin(), wCaloFloats.end());
+        if (m_useMVAwoutCaloTrigger) woutCaloCandidates.insert(woutCaloCandidates.end(), woutCaloFloats.begin(), woutCaloFloats.end());
+        if (m_useMVAwoutCaloAndMinTrackTrigger) woutCaloAndMinTrackCandidates.insert(woutCaloAndMinTrackCandidates.end(), woutCaloAndMinTrackFloats.begin(), woutCaloAndMinTrackFloats.end());
+      }
+    }
+  }
 
-        if (m_useMVAwoutCaloTrigger)
-        {
-          bool trigger = runMVATrigger(woutCaloReader, mvaType, woutCaloFloats, MVA_woutCaloResponse);
-          if (trigger) triggerDecisionsMVA.find("MVAWithoutCalo")->second = true;
-        }
+  //The MVAs are evaluated once for all vertex/track pair combinations of the event
+  if (m_useMVAwCaloTrigger)
+  {
+    bool trigger = runMVATrigger(wCaloForest, wCaloReader, mvaType, wCaloCandidates, MVA_wCaloResponse);
+    if (trigger) triggerDecisionsMVA.find("MVAWithCalo")->second = true;
+  }
 
-        if (m_useMVAwoutCaloAndMinTrackTrigger)
-        {
-          bool trigger = runMVATrigger(woutCaloAndMinTrackReader, mvaType, woutCaloAndMinTrackFloats, MVA_woutCaloOrMinTrackResponse);
-          if (trigger) triggerDecisionsMVA.find("MVAWithoutCaloAndMinTrack")->second = true;
-        }
+  if (m_useMVAwoutCaloTrigger)
+  {
+    bool trigger = runMVATrigger(woutCaloForest, woutCaloReader, mvaType, woutCaloCandidates, MVA_woutCaloResponse);
+    if (trigger) triggerDecisionsMVA.find("MVAWithoutCalo")->second = true;
+  }
 
-      }
-    }
+  if (m_useMVAwoutCaloAndMinTrackTrigger)
+  {
+    bool trigger = runMVATrigger(woutCaloAndMinTrackForest, woutCaloAndMinTrackReader, mvaType, woutCaloAndMinTrackCandidates, MVA_woutCaloOrMinTrackResponse);
+    if (trigger) triggerDecisionsMVA.find("MVAWithoutCaloAndMinTrack")->second = true;
   }
 
   if (Verbosity() >= VERBOSITY_MORE) printTrigger();
@@ -236,6 +250,29 @@ bool HFTriggerMVA::runMVATrigger(TMVA::Reader* reader, std::string method, std::
   return mvaResponse >= cut;
 }
 
+bool HFTriggerMVA::runMVATrigger(const FlatBDTForest& forest, TMVA::Reader* reader, std::string method, const std::vector<float>& candidates, float cut)
+{
+  if (!forest.isLoaded())
+  {
+    const unsigned int nVariables = reader->DataInfo().GetNVariables();
+    for (unsigned int i = 0; i + nVariables <= candidates.size(); i += nVariables)
+    {
+      std::vector<float> inputValues(candidates.begin() + i, candidates.begin() + i + nVariables);
+      if (runMVATrigger(reader, method, inputValues, cut)) return true;
+    }
+    return false;
+  }
+
+  std::vector<double> mvaResponses;
+  forest.evaluate(candidates, mvaResponses);
+
+  for (double mvaResponse : mvaResponses)
+  {
+    if ((Float_t) mvaResponse >= cut) return true;
+  }
+  return false;
+}
+
 void HFTriggerMVA::calculateMultiplicity(PHCompositeNode *topNode, float& meanMultiplicity, float& asymmetryMultiplicity)
 {
   TrkrHitSetContainer* hitContainer = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
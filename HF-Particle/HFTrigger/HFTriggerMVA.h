@@ -16,6 +16,8 @@
 #include <g4eval/SvtxEvalStack.h>
 #include <g4eval/SvtxTrackEval.h>
 
+#include <flatbdtforest/FlatBDTForest.h>
+
 //ROOT stuff
 #include <TMVA/Reader.h>
 #include <TMVA/Tools.h>
@@ -63,6 +65,8 @@ class HFTriggerMVA : public SubsysReco
 
   bool runMVATrigger(TMVA::Reader* reader, std::string method, std::vector<float> inputValues, float cut);
 
+  bool runMVATrigger(const FlatBDTForest& forest, TMVA::Reader* reader, std::string method, const std::vector<float>& candidates, float cut);
+
   void calculateMultiplicity(PHCompositeNode *topNode, float& meanMultiplicity, float& asymmetryMultiplicity);
 
   float getMaxEMCalEnergy(PHCompositeNode *topNode);
@@ -104,6 +108,7 @@ class HFTriggerMVA : public SubsysReco
   void setMVA_wCaloResponse(float value) { MVA_wCaloResponse = value; }
   void setMVA_woutCaloResponse(float value) { MVA_woutCaloResponse = value; }
   void setMVA_woutCaloOrMinTrackResponse(float value) { MVA_woutCaloOrMinTrackResponse = value; }
+  void setMVAThreads(unsigned int value) { m_mvaThreads = value; }
  
  protected:
   SvtxEvalStack *m_svtx_evalstack = nullptr;
@@ -176,6 +181,11 @@ class HFTriggerMVA : public SubsysReco
 
   TMVA::Reader *wCaloReader, *woutCaloReader, *woutCaloAndMinTrackReader;
   std::vector<float> wCaloFloats, woutCaloFloats, woutCaloAndMinTrackFloats;
+
+  //Same forests, flattened, to score all track pairs of an event in one call
+  FlatBDTForest wCaloForest, woutCaloForest, woutCaloAndMinTrackForest;
+  std::vector<float> wCaloCandidates, woutCaloCandidates, woutCaloAndMinTrackCandidates;
+  unsigned int m_mvaThreads = 1;
 };
 
 #endif  //HFTRIGGERMVA_H
@@ -9,9 +9,11 @@
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
 #include "fastjet/ClusterSequenceArea.hh"
+#include "fastjet/ClusterSequenceActiveAreaExplicitGhosts.hh"
 #include "fastjet/AreaDefinition.hh"
 #include "fastjet/Selector.hh"
 #include "fastjet/tools/BackgroundEstimatorBase.hh"
+#include "fastjet/tools/GridMedianBackgroundEstimator.hh"
 #include "fastjet/tools/JetMedianBackgroundEstimator.hh"
 
 #include <phool/PHCompositeNode.h>
@@ -101,6 +103,10 @@ int CaloJetRhoEst::Init(PHCompositeNode* topNode)
   m_T->Branch("id",          &m_id);
   m_T->Branch("rho",         &m_rho);
   m_T->Branch("rho_sigma",   &m_rho_sigma);
+  if (m_useGridRho && m_validateGridRho) {
+    m_T->Branch("rho_ktmedian",       &m_rho_ktmedian);
+    m_T->Branch("rho_ktmedian_sigma", &m_rho_ktmedian_sigma);
+  }
   m_T->Branch("centrality",  &m_centrality);
   m_T->Branch("impactparam", &m_impactparam);
 
@@ -130,6 +136,13 @@ int CaloJetRhoEst::End(PHCompositeNode* topNode)
   /* m_hInclusivePhi->Write(); */
   m_T->Write();
 
+  if (m_nValidated > 0) {
+    const double mean = m_sumRhoDiff / m_nValidated;
+    const double rms  = sqrt(std::max(0., m_sumRhoDiff2 / m_nValidated - mean * mean));
+    cout << "CaloJetRhoEst::End - grid median rho - kt median rho over " << m_nValidated
+         << " events: mean " << mean << " GeV, rms " << rms << " GeV" << endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -146,6 +159,7 @@ int CaloJetRhoEst::process_event(PHCompositeNode* topNode)
   /* cout << "Verbosity: " << Verbosity() << endl; */
   // statistics on how the program is doing
   print_stats.call();
+  print_stats.stage("input");
   //interface to truth jets
   JetMap* jetsMC = findNode::getClass<JetMap>(topNode, m_truthJetName);
   if (!jetsMC )
@@ -171,7 +185,8 @@ int CaloJetRhoEst::process_event(PHCompositeNode* topNode)
   auto& particles=inputs;
 
   // /direct/sphenix+u/dstewart/vv/coresoftware/offline/packages/jetbackground/FastJetAlgoSub.cc ::58
-  std::vector<fastjet::PseudoJet> particles_pseudojets;
+  std::vector<fastjet::PseudoJet>& particles_pseudojets = m_particles;
+  particles_pseudojets.clear();
   int   smallptcutcnt =0;//FIXME
   for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
   {
@@ -246,30 +261,67 @@ int CaloJetRhoEst::process_event(PHCompositeNode* topNode)
   }
 
   if (Verbosity()>5) cout << "Starting background density calc" << endl;
-  JetDefinition jet_def(kt_algorithm, 0.4);     //  JET DEFINITION
-
   const double ghost_max_rap { 2.0 };
   const double ghost_R = 0.01;
   const double jet_R = 0.4;
-  AreaDefinition area_def_bkgd( active_area_explicit_ghosts, GhostedAreaSpec(ghost_max_rap, 1, ghost_R));
-  JetDefinition jet_def_bkgd(kt_algorithm, jet_R); // <--
-  Selector selector_rm2 = SelectorAbsEtaMax(0.6) * (!SelectorNHardest(2)); // <--
-  fastjet::JetMedianBackgroundEstimator bge_rm2 {selector_rm2, jet_def_bkgd, area_def_bkgd};
-  bge_rm2.set_particles(particles_pseudojets);
+  GhostedAreaSpec ghost_spec(ghost_max_rap, 1, ghost_R);
+
+  // one set of explicit ghosts for both clusterings
+  double ghost_area = 0.;
+  if (m_shareGhosts) {
+    print_stats.stage("ghosts");
+    m_ghosts.clear();
+    ghost_spec.add_ghosts(m_ghosts);
+    ghost_area = ghost_spec.actual_ghost_area();
+  }
 
-  m_rho = bge_rm2.rho();
-  m_rho_sigma = bge_rm2.sigma();
+  if (!m_useGridRho || m_validateGridRho) {
+    print_stats.stage("kt rho");
+    AreaDefinition area_def_bkgd( active_area_explicit_ghosts, ghost_spec);
+    JetDefinition jet_def_bkgd(kt_algorithm, jet_R); // <--
+    Selector selector_rm2 = SelectorAbsEtaMax(0.6) * (!SelectorNHardest(2)); // <--
+    if (m_shareGhosts) {
+      ClusterSequenceActiveAreaExplicitGhosts clustSeq_kt(particles_pseudojets, jet_def_bkgd, m_ghosts, ghost_area);
+      fastjet::JetMedianBackgroundEstimator bge_rm2 {selector_rm2, clustSeq_kt};
+      m_rho_ktmedian       = bge_rm2.rho();
+      m_rho_ktmedian_sigma = bge_rm2.sigma();
+    } else {
+      fastjet::JetMedianBackgroundEstimator bge_rm2 {selector_rm2, jet_def_bkgd, area_def_bkgd};
+      bge_rm2.set_particles(particles_pseudojets);
+      m_rho_ktmedian       = bge_rm2.rho();
+      m_rho_ktmedian_sigma = bge_rm2.sigma();
+    }
+    m_rho       = m_rho_ktmedian;
+    m_rho_sigma = m_rho_ktmedian_sigma;
+  }
+
+  if (m_useGridRho) {
+    print_stats.stage("grid rho");
+    fastjet::GridMedianBackgroundEstimator bge_grid {m_gridRapMax, m_gridSpacing};
+    bge_grid.set_particles(particles_pseudojets);
+    m_rho       = bge_grid.rho();
+    m_rho_sigma = bge_grid.sigma();
+    if (m_validateGridRho) {
+      const double diff = m_rho - m_rho_ktmedian;
+      ++m_nValidated;
+      m_sumRhoDiff  += diff;
+      m_sumRhoDiff2 += diff * diff;
+      if (Verbosity()>1) cout << " rho grid: " << m_rho << " kt median: " << m_rho_ktmedian << endl;
+    }
+  }
 
   if (Verbosity()>5) cout << "Starting clustered jets" << endl;
+  print_stats.stage("anti-kt");
   // cluster the measured jets:
-  double max_rap = 2.0;
   fastjet::Selector jetrap         = fastjet::SelectorAbsEtaMax(0.6);
   fastjet::Selector not_pure_ghost = !SelectorIsPureGhost();
   fastjet::Selector selection      = jetrap && not_pure_ghost;
-  AreaDefinition area_def( active_area_explicit_ghosts, GhostedAreaSpec(max_rap, 1, ghost_R));
+  AreaDefinition area_def( active_area_explicit_ghosts, ghost_spec);
   JetDefinition jet_def_antikt(antikt_algorithm, jet_R);
-  fastjet::ClusterSequenceArea clustSeq(particles_pseudojets, jet_def_antikt, area_def);
-  vector<PseudoJet> jets = sorted_by_pt( selection( clustSeq.inclusive_jets(m_ptRange.first) ));
+  std::unique_ptr<fastjet::ClusterSequenceAreaBase> clustSeq;
+  if (m_shareGhosts) clustSeq.reset(new ClusterSequenceActiveAreaExplicitGhosts(particles_pseudojets, jet_def_antikt, m_ghosts, ghost_area));
+  else               clustSeq.reset(new fastjet::ClusterSequenceArea(particles_pseudojets, jet_def_antikt, area_def));
+  vector<PseudoJet> jets = sorted_by_pt( selection( clustSeq->inclusive_jets(m_ptRange.first) ));
   for (auto jet : jets) {
     m_CaloJetEta  .push_back( jet.eta());
     m_CaloJetPhi  .push_back( jet.phi_std());
@@ -278,8 +330,10 @@ int CaloJetRhoEst::process_event(PHCompositeNode* topNode)
     m_CaloJetArea .push_back( jet.area());
   }
 
+  print_stats.stage("output");
   m_T->Fill();
   clear_vectors();
+  print_stats.stage("");
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -10,6 +10,7 @@
 
 #include <array>
 #include <vector>
+#include <fastjet/PseudoJet.hh>
 
 class PHCompositeNode;
 class JetEvalStack;
@@ -43,6 +44,17 @@ class CaloJetRhoEst : public SubsysReco
     m_ptRange.first  = low;
     m_ptRange.second = high;
   }
+  //! generate the explicit ghosts once per event and use them for both the kt (rho) and anti-kt clusterings
+  void shareGhosts(bool b = true) { m_shareGhosts = b; }
+  //! estimate rho with a grid median (no kt clustering) instead of the kt jet median;
+  //! with validate the kt jet median is still computed and written as rho_ktmedian
+  void useGridMedianRho(bool b = true, bool validate = false, double grid_spacing = 0.5, double rap_max = 1.0)
+  {
+    m_useGridRho      = b;
+    m_validateGridRho = validate;
+    m_gridSpacing     = grid_spacing;
+    m_gridRapMax      = rap_max;
+  }
   /* void use_initial_vertex(const bool b = true) {initial_vertex = b;} */
   int Init          (PHCompositeNode *topNode);
   int InitRun       (PHCompositeNode *topNode);
@@ -65,11 +77,29 @@ class CaloJetRhoEst : public SubsysReco
   //! flag to use initial vertex in track evaluator
   bool initial_vertex = false;
 
+  //! background options
+  bool   m_shareGhosts     = false;
+  bool   m_useGridRho      = false;
+  bool   m_validateGridRho = false;
+  double m_gridSpacing     = 0.5;
+  double m_gridRapMax      = 1.0;
+
+  //! per event workspace, kept to reuse the allocations
+  std::vector<fastjet::PseudoJet> m_particles;
+  std::vector<fastjet::PseudoJet> m_ghosts;
+
+  //! grid vs. kt median validation: n, sum and sum of squares of rho_grid - rho_ktmedian
+  long long m_nValidated = 0;
+  double    m_sumRhoDiff = 0.;
+  double    m_sumRhoDiff2 = 0.;
+
   //! Output Tree variables
   TTree *m_T;
   int   m_id;
   float m_rho;
   float m_rho_sigma;
+  float m_rho_ktmedian;
+  float m_rho_ktmedian_sigma;
   float m_centrality;
   float m_impactparam;
 
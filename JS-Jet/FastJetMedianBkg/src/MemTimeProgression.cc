@@ -41,7 +41,11 @@ MemTimeProgression::MemTimeProgression(const int print_int, const int _n_total_c
     time0    {0.},
     watch    {},
     call_print_interval {print_int},
-    n_total_calls { _n_total_calls } 
+    n_total_calls { _n_total_calls },
+    stage_names {},
+    stage_times {},
+    stage_watch {},
+    current_stage {-1}
 {
     watch.Start();
     call();
@@ -79,11 +83,33 @@ string MemTimeProgression::set_stats() {
                   time.str().c_str());
     }
 
+    if (!stage_names.empty() && nCalls > 0) {
+      stats += " | ms/call:";
+      for (unsigned int i = 0; i < stage_names.size(); ++i)
+        stats += Form(" %s %.1f", stage_names[i].c_str(), 1000. * stage_times[i] / nCalls);
+    }
+
     time0=time1;
     mem0=mem1;
     return stats;
 };
 
+void MemTimeProgression::stage(const string& name) {
+    if (current_stage >= 0) stage_times[current_stage] += stage_watch.RealTime();
+    current_stage = -1;
+    if (name.empty()) return;
+
+    for (unsigned int i = 0; i < stage_names.size(); ++i) {
+      if (stage_names[i] == name) current_stage = i;
+    }
+    if (current_stage < 0) {
+      current_stage = stage_names.size();
+      stage_names.push_back(name);
+      stage_times.push_back(0.);
+    }
+    stage_watch.Start(kTRUE);
+};
+
 bool MemTimeProgression::call(){
     ++nCalls;
     if (nCalls % call_print_interval == 0) {
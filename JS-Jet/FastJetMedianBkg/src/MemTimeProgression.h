@@ -6,6 +6,7 @@
 #include "stdlib.h"
 #include "stdio.h"
 #include <string>
+#include <vector>
 #include "TStopwatch.h"
 
 int parseLine(char* line);
@@ -30,6 +31,15 @@ struct MemTimeProgression : public TObject {
     string set_stats();
     string set_get_stats();
     string stats; // populate message
+
+    // per-stage timing:
+    //  stage("name") closes the running stage and opens "name"; stage("") only closes it
+    //  -> the mean time per call of each stage is added to the stats
+    void   stage(const string& name);
+    vector<string> stage_names;
+    vector<double> stage_times;
+    TStopwatch     stage_watch;
+    int            current_stage;
     /* ClassDef (MemTimeProgression,1); */
 };
 
@@ -14,8 +14,27 @@ PIDProbabilities::PIDProbabilities()
   _poisson = new Poisson();
 }
 
+double
+PIDProbabilities::angle_window( double index ){
+
+  /* Set angle window by taking smallest difference, highest momentum in question (70 GeV) */
+  double m_pion = _pdg->GetParticle(211)->Mass();
+  double m_kaon = _pdg->GetParticle(321)->Mass();
+  double test_p = 70;
+  double windowx2 = acos( sqrt( m_pion*m_pion + test_p*test_p ) / index / test_p ) - acos( sqrt( m_kaon*m_kaon + test_p*test_p ) / index / test_p );
+
+  return windowx2/2;
+}
+
+double
+PIDProbabilities::max_counted_angle( double index ){
+
+  /* Expected angles grow with beta, so no window reaches beyond the beta = 1 angle plus the window */
+  return acos( 1/index ) + angle_window( index );
+}
+
 bool 
-PIDProbabilities::particle_probs( vector<float> angles, double momentum, double index, long double probs[4] ){
+PIDProbabilities::particle_probs( const vector<float> &angles, double momentum, double index, long double probs[4] ){
 
   bool use_reconstructed_momentum = false;
   bool use_truth_momentum = false;
@@ -31,10 +50,7 @@ PIDProbabilities::particle_probs( vector<float> angles, double momentum, double
     _pdg->GetParticle(pid[3])->Mass()
   };
 
-  /* Set angle window by taking smallest difference, highest momentum in question (70 GeV) */
-  double test_p = 70;
-  double windowx2 = acos( sqrt( m[1]*m[1] + test_p*test_p ) / index / test_p ) - acos( sqrt( m[2]*m[2] + test_p*test_p ) / index / test_p );
-  double window = windowx2/2;
+  double window = angle_window( index );
 
   /* Determine expectation value for each particle */
   double beta[4] = {
@@ -82,7 +98,7 @@ PIDProbabilities::particle_probs( vector<float> angles, double momentum, double
 
   /* Count hits within window */
   int counts[4] = {0,0,0,0};
-  for (int i=0; i<300; i++){
+  for (unsigned int i=0; i<angles.size(); i++){
     for (int j=0; j<4; j++){
       if ( angles[i] > (theta_expect[j] - window) && angles[i] < (theta_expect[j] + window) )
 	counts[j]++;
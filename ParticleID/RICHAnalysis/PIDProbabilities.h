@@ -27,7 +27,11 @@ class PIDProbabilities {
 
   PIDProbabilities();
 
-  bool particle_probs( vector<float> angles, double momentum, double index, long double probs[4] );
+  bool particle_probs( const vector<float> &angles, double momentum, double index, long double probs[4] );
+
+  double angle_window( double index ); // Half width of the window around each expected angle
+  double max_counted_angle( double index ); // Largest angle that can be counted for any particle and momentum
+
 
   /* PDG database access object */
   TDatabasePDG *_pdg;
@@ -43,6 +43,13 @@ public:
     return;
   }
 
+  /* only ray trace hits that can fall into a PID window, on by default */
+  void set_hit_preselection( bool preselect )
+  {
+    _preselect_hits = preselect;
+    return;
+  }
+
 private:
   void CreateNodes(PHCompositeNode *topNode);
 
@@ -80,6 +87,9 @@ private:
   /* Radius for track extrapolation */
   float _radius;
 
+  /* Skip hits that can not be counted for any hypothesis */
+  bool _preselect_hits;
+
 };
 
 #endif // __RICHParticleID_H__
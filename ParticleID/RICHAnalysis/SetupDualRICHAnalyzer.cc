@@ -5,14 +5,26 @@
 #include "SetupDualRICHAnalyzer.h"
 #include "dualrich_analyzer.h"
 
+#include <algorithm>
+
 using namespace std;
 
 
-SetupDualRICHAnalyzer::SetupDualRICHAnalyzer()
+SetupDualRICHAnalyzer::SetupDualRICHAnalyzer() :
+  _mirror_radius(195),
+  _bisection_steps(8)
 {
   _analyzer = new eic_dual_rich();
 }
 
+void
+SetupDualRICHAnalyzer::mirror_center( int sec, double center[3] )
+{
+  center[0] = -18.5*TMath::Sin(sec*TMath::Pi()/4); // mirror center of each octant
+  center[1] = 18.5*TMath::Cos(sec*TMath::Pi()/4);
+  center[2] = 75;
+}
+
 double
 SetupDualRICHAnalyzer::calculate_emission_angle( double m_emi[3], double momv[3], PHG4Hit * hit_i )
 {
@@ -29,15 +41,16 @@ SetupDualRICHAnalyzer::calculate_emission_angle( double m_emi[3], double momv[3]
   double vy = momv[1];
   double vz = momv[2];
 
-  int sec = hit_i->get_detid();
-  double cx = -18.5*TMath::Sin(sec*TMath::Pi()/4); // mirror center of each octant
-  double cy = 18.5*TMath::Cos(sec*TMath::Pi()/4);
-  double cz = 75;
+  double center[3];
+  mirror_center( hit_i->get_detid(), center );
+  double cx = center[0];
+  double cy = center[1];
+  double cz = center[2];
 
   int select_radiator=0;
 
   /* Set mirror parameters */
-  double R_mirror = 195; // cm
+  double R_mirror = _mirror_radius; // cm
   _analyzer->set_mirror(cx, cy, cz, R_mirror);
 
   /* Call algorithm to determine emission angle of photon i w.r.t. track j */
@@ -46,6 +59,196 @@ SetupDualRICHAnalyzer::calculate_emission_angle( double m_emi[3], double momv[3]
   return theta_c;
 }
 
+void
+SetupDualRICHAnalyzer::index_hits( PHG4HitContainer* richhits )
+{
+  for (int sec=0; sec<8; sec++)
+    _indexed_hits[sec].clear();
+
+  PHG4HitContainer::ConstRange rich_hits_begin_end = richhits->getHits();
+  PHG4HitContainer::ConstIterator rich_hits_iter;
+
+  for (rich_hits_iter = rich_hits_begin_end.first; rich_hits_iter !=  rich_hits_begin_end.second; ++rich_hits_iter)
+    {
+      PHG4Hit *hit_i = rich_hits_iter->second;
+
+      /* mirror_center is periodic in the octant number */
+      int sec = ( hit_i->get_detid() % 8 + 8 ) % 8;
+      double center[3];
+      mirror_center( sec, center );
+
+      IndexedHit indexed;
+      indexed.hit = hit_i;
+      indexed.pos[0] = hit_i->get_x(0);
+      indexed.pos[1] = hit_i->get_y(0);
+      indexed.pos[2] = hit_i->get_z(0);
+      double d = 0;
+      for (int k=0; k<3; k++)
+	{
+	  indexed.u[k] = indexed.pos[k] - center[k];
+	  d += indexed.u[k]*indexed.u[k];
+	}
+      d = sqrt( d );
+      for (int k=0; k<3; k++)
+	indexed.u[k] /= d;
+
+      _indexed_hits[sec].push_back( indexed );
+    }
+}
+
+void
+SetupDualRICHAnalyzer::select_hits( double m_emi[3], double momv[3], double theta_max, vector<PHG4Hit*> &hits )
+{
+  hits.clear();
+
+  /* small tolerance so that rounding never removes a hit at the edge */
+  double sin_max = sin( theta_max ) * 1.000001;
+  double cos_max = cos( theta_max ) * 0.999999;
+
+  for (int sec=0; sec<8; sec++)
+    {
+      if ( _indexed_hits[sec].empty() )
+	continue;
+
+      double center[3];
+      mirror_center( sec, center );
+
+      double e_unit[3];
+      double a = 0;
+      for (int k=0; k<3; k++)
+	{
+	  e_unit[k] = m_emi[k] - center[k];
+	  a += e_unit[k]*e_unit[k];
+	}
+      a = sqrt( a );
+      for (int k=0; k<3; k++)
+	e_unit[k] /= a;
+
+      for (unsigned int i=0; i<_indexed_hits[sec].size(); i++)
+	{
+	  if ( may_emit_below( m_emi, momv, center, e_unit, _indexed_hits[sec][i], sin_max, cos_max ) )
+	    hits.push_back( _indexed_hits[sec][i].hit );
+	}
+    }
+}
+
+namespace
+{
+  void cross3( const double a[3], const double b[3], double c[3] )
+  {
+    c[0] = a[1]*b[2] - a[2]*b[1];
+    c[1] = a[2]*b[0] - a[0]*b[2];
+    c[2] = a[0]*b[1] - a[1]*b[0];
+  }
+
+  double dot3( const double a[3], const double b[3] )
+  {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+  }
+
+  /* sign of the reflection condition at mirror point C + R m: zero where the normal m bisects the directions to E and D */
+  double reflection_sign( const double m[3], const double center[3], double radius, const double emi[3], const double hit[3], const double normal[3] )
+  {
+    double to_e[3];
+    double to_d[3];
+    for (int k=0; k<3; k++)
+      {
+	double s = center[k] + radius*m[k];
+	to_e[k] = emi[k] - s;
+	to_d[k] = hit[k] - s;
+      }
+    double ne = sqrt( dot3( to_e, to_e ) );
+    double nd = sqrt( dot3( to_d, to_d ) );
+    double sum[3];
+    for (int k=0; k<3; k++)
+      sum[k] = to_e[k]/ne + to_d[k]/nd;
+    double tilt[3];
+    cross3( sum, m, tilt );
+    return dot3( tilt, normal );
+  }
+}
+
+/*
+ * The emission point E, the mirror center C, the reflection point S and the
+ * hit D lie in one plane, and S lies on the mirror arc between the directions
+ * of E and of D seen from C. So the emission direction S-E calculated by
+ * ind_ray is
+ *  - at least as far from the track direction v as v is from that plane, and
+ *  - between the directions to the two ends of any arc piece that contains S.
+ * The arc is bisected on the sign of the reflection condition, using only
+ * square roots, until the emission directions of the remaining piece are
+ * all further than theta_max from v (the hit is dropped) or the step limit
+ * is reached (the hit is kept and ray traced).
+ */
+bool
+SetupDualRICHAnalyzer::may_emit_below( const double m_emi[3], const double momv[3], const double center[3], const double e_unit[3], const IndexedHit &hit, double sin_max, double cos_max )
+{
+  double normal[3];
+  cross3( e_unit, hit.u, normal );
+  double n_norm = sqrt( dot3( normal, normal ) );
+
+  /* angle to the plane */
+  if ( fabs( dot3( momv, normal ) ) > sin_max * n_norm )
+    return false;
+
+  double lo[3] = { e_unit[0], e_unit[1], e_unit[2] };
+  double hi[3] = { hit.u[0], hit.u[1], hit.u[2] };
+  double sign_lo = reflection_sign( lo, center, _mirror_radius, m_emi, hit.pos, normal );
+  double sign_hi = reflection_sign( hi, center, _mirror_radius, m_emi, hit.pos, normal );
+
+  /* no sign change, the reflection point is not bracketed */
+  if ( !( sign_lo * sign_hi < 0 ) )
+    return true;
+
+  for (int step=0; step<_bisection_steps; step++)
+    {
+      double mid[3];
+      for (int k=0; k<3; k++)
+	mid[k] = lo[k] + hi[k];
+      double mid_norm = sqrt( dot3( mid, mid ) );
+      for (int k=0; k<3; k++)
+	mid[k] /= mid_norm;
+
+      double sign_mid = reflection_sign( mid, center, _mirror_radius, m_emi, hit.pos, normal );
+      if ( sign_mid * sign_lo > 0 )
+	{
+	  for (int k=0; k<3; k++)
+	    lo[k] = mid[k];
+	  sign_lo = sign_mid;
+	}
+      else
+	{
+	  for (int k=0; k<3; k++)
+	    hi[k] = mid[k];
+	}
+
+      /* emission directions to both ends of the arc piece */
+      double p[3];
+      double q[3];
+      for (int k=0; k<3; k++)
+	{
+	  p[k] = center[k] + _mirror_radius*lo[k] - m_emi[k];
+	  q[k] = center[k] + _mirror_radius*hi[k] - m_emi[k];
+	}
+      if ( dot3( momv, p ) >= cos_max * sqrt( dot3( p, p ) ) || dot3( momv, q ) >= cos_max * sqrt( dot3( q, q ) ) )
+	continue;
+
+      /* v projects between the ends, the closest direction is the one in the plane */
+      double pq[3];
+      double pv[3];
+      double vq[3];
+      cross3( p, q, pq );
+      cross3( p, momv, pv );
+      cross3( momv, q, vq );
+      if ( dot3( pv, pq ) >= 0 && dot3( vq, pq ) >= 0 )
+	continue;
+
+      return false;
+    }
+
+  return true;
+}
+
 bool
 SetupDualRICHAnalyzer::get_true_momentum( PHG4TruthInfoContainer* truthinfo, SvtxTrack * track, double arr_mom[3] )
 {
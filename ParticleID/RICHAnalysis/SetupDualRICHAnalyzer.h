@@ -36,12 +36,38 @@ class SetupDualRICHAnalyzer {
 
   double calculate_emission_angle( double m_emi[3], double momv[3], PHG4Hit * hit ); // Calculate emission angle from IRT
 
+  void index_hits( PHG4HitContainer * richhits ); // Group this event's hits by mirror octant for select_hits
+  void select_hits( double m_emi[3], double momv[3], double theta_max, vector<PHG4Hit*> &hits ); // Indexed hits that can have an emission angle below theta_max
+
+  void mirror_center( int sec, double center[3] ); // Mirror center of octant sec
+
   bool get_true_momentum( PHG4TruthInfoContainer * truthinfo, SvtxTrack * track, double arr_mom[3] ); // Get truth momentum of track
   bool get_emission_momentum( PHG4TruthInfoContainer * truthinfo, PHG4HitContainer * richhits, SvtxTrack * track, double arr_mom[3] ); // Get momentum from emission points
 
   /* analyzer object */
   eic_dual_rich *_analyzer;
 
+ private:
+
+  /* hit with its direction u from the center of its mirror */
+  struct IndexedHit {
+    PHG4Hit *hit;
+    double pos[3];
+    double u[3];
+  };
+
+  bool may_emit_below( const double m_emi[3], const double momv[3], const double center[3], const double e_unit[3], const IndexedHit &hit, double sin_max, double cos_max );
+
+  /* hits of the current event per mirror octant, filled by index_hits */
+  vector<IndexedHit> _indexed_hits[8];
+
+  /* mirror radius in cm */
+  double _mirror_radius;
+
+  /* bisection steps on the mirror arc before a hit is kept */
+  int _bisection_steps;
+
+
 };
 
 #endif
@@ -8,15 +8,20 @@
 #include "TRandom3.h"
 #include "TGraphAsymmErrors.h"
 #include "TGraphErrors.h"
+#include "TROOT.h"
+#include "TTree.h"
 
 #include <fstream>
 #include <iostream>
 //#include <iomanip>
-//#include <vector>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
-int ccbb(double eideff, string ofname);
+int ccbb(double eideff, string ofname, int nthreads);
 
 TH1D* hcharm_pt;
 TH1D* hbottom_pt;
@@ -72,23 +77,217 @@ double norm_hf_nosupp(double* x, double* par) {
 
 
 
+//====================================================================================
+// Ntuple input.
+// Only the pairs inside the acceptance and the single electrons at |eta|<1 are
+// needed, they are read once, in parallel over entry ranges, and cached in a
+// file keyed by eID efficiency and pT cut. The suppression is applied when the
+// histograms are filled from the cached sample, so changing the suppression
+// does not read the ntuples again. Remove the cache file to read them again.
+//====================================================================================
+
+struct PairSample {
+  vector<float> mass, pt, pt1, pt2;
+  void append(const PairSample& other) {
+    mass.insert(mass.end(), other.mass.begin(), other.mass.end());
+    pt.insert(pt.end(), other.pt.begin(), other.pt.end());
+    pt1.insert(pt1.end(), other.pt1.begin(), other.pt1.end());
+    pt2.insert(pt2.end(), other.pt2.begin(), other.pt2.end());
+  }
+};
+
+struct HFInput {
+  PairSample charm, charm_ckin3_4, bottom, dy;
+  vector<float> charm_sngl, bottom_sngl;
+};
+
+// split [0,nentries) into contiguous ranges, one per thread
+void run_ranges(Long64_t nentries, int nthreads, function<void(int,Long64_t,Long64_t)> work) {
+  if(nthreads<1) nthreads=1;
+  vector<thread> threads;
+  for(int ith=0; ith<nthreads; ith++) {
+    Long64_t first = nentries*ith/nthreads;
+    Long64_t last  = nentries*(ith+1)/nthreads;
+    threads.push_back(thread(work,ith,first,last));
+  }
+  for(unsigned int ith=0; ith<threads.size(); ith++) threads[ith].join();
+}
+
+// every thread reads its range through its own chain over the same files
+TChain* copy_chain(TChain* chain) {
+  TChain* copy = new TChain(chain->GetName());
+  TObjArray* files = chain->GetListOfFiles();
+  for(int i=0; i<files->GetEntries(); i++) copy->Add(files->At(i)->GetTitle());
+  return copy;
+}
+
+void read_pairs(TChain* chain, Long64_t nentries, double ptcut, int nthreads, PairSample& sample) {
+  vector<PairSample> parts(nthreads>1 ? nthreads : 1);
+  run_ranges(nentries, nthreads, [&](int ith, Long64_t first, Long64_t last) {
+    TChain* mychain = copy_chain(chain);
+    float mass,pt,eta,pt1,pt2,eta1,eta2;
+    mychain->SetBranchAddress("mass",&mass);
+    mychain->SetBranchAddress("pt",  &pt);
+    mychain->SetBranchAddress("eta", &eta);
+    mychain->SetBranchAddress("pt1", &pt1);
+    mychain->SetBranchAddress("pt2", &pt2);
+    mychain->SetBranchAddress("eta1",&eta1);
+    mychain->SetBranchAddress("eta2",&eta2);
+    for(Long64_t j=first; j<last; j++) {
+      mychain->GetEntry(j);
+      if(ith==0 && (j-first)%20000==0) cout << "entry # " << j-first << " of " << last-first << " per thread" << endl;
+      if(pt1>ptcut && pt2>ptcut && fabs(eta1)<1.0 && fabs(eta2)<1.0) {
+        parts[ith].mass.push_back(mass);
+        parts[ith].pt.push_back(pt);
+        parts[ith].pt1.push_back(pt1);
+        parts[ith].pt2.push_back(pt2);
+      }
+    }
+    delete mychain;
+  });
+  for(unsigned int ith=0; ith<parts.size(); ith++) sample.append(parts[ith]);
+}
+
+void read_singles(TChain* chain, int nthreads, vector<float>& sample) {
+  vector<vector<float> > parts(nthreads>1 ? nthreads : 1);
+  run_ranges(chain->GetEntries(), nthreads, [&](int ith, Long64_t first, Long64_t last) {
+    TChain* mychain = copy_chain(chain);
+    float pt_sngl,eta_sngl;
+    mychain->SetBranchAddress("pt",  &pt_sngl);
+    mychain->SetBranchAddress("eta", &eta_sngl);
+    for(Long64_t j=first; j<last; j++) {
+      mychain->GetEntry(j);
+      if(ith==0 && (j-first)%100000==0) cout << "entry # " << j-first << " of " << last-first << " per thread" << endl;
+      if(fabs(eta_sngl)<1.0) parts[ith].push_back(pt_sngl);
+    }
+    delete mychain;
+  });
+  for(unsigned int ith=0; ith<parts.size(); ith++) sample.insert(sample.end(), parts[ith].begin(), parts[ith].end());
+}
+
+// pairs surviving the suppression of both electrons, in pT bins and integrated (last histogram)
+void fill_pairs(const PairSample& sample, TGraph* gsupp, TRandom* rnd, TH1D** h, int nbins, double* binlim) {
+  for(unsigned int j=0; j<sample.mass.size(); j++) {
+    if(gsupp) {
+      double random1 = rnd->Uniform(0.,1.);
+      double myraa1 = gsupp->Eval(sample.pt1[j]);
+      double random2 = rnd->Uniform(0.,1.);
+      double myraa2 = gsupp->Eval(sample.pt2[j]);
+      if(!(random1<=myraa1 && random2<=myraa2)) continue;
+    }
+    int mybin = -1;
+    for(int i=0; i<nbins; i++) { if(sample.pt[j]<binlim[i+1]) { mybin = i; break; } }
+    if(mybin>=0 && mybin<nbins) { (h[mybin])->Fill(sample.mass[j]); }
+    (h[nbins])->Fill(sample.mass[j]); // all pT
+  }
+}
+
+void fill_singles(const vector<float>& sample, TGraph* gsupp, TRandom* rnd, TH1D* h, TH1D* h_nosupp) {
+  for(unsigned int j=0; j<sample.size(); j++) {
+    h_nosupp->Fill(sample[j]);
+    double random = rnd->Uniform(0.,1.);
+    double myraa = gsupp->Eval(sample[j]);
+    if(random<=myraa) { h->Fill(sample[j]); }
+  }
+}
+
+void write_pairs(const char* name, const PairSample& sample) {
+  TTree* t = new TTree(name,"pairs in acceptance");
+  float mass,pt,pt1,pt2;
+  t->Branch("mass",&mass,"mass/F");
+  t->Branch("pt",  &pt,  "pt/F");
+  t->Branch("pt1", &pt1, "pt1/F");
+  t->Branch("pt2", &pt2, "pt2/F");
+  for(unsigned int j=0; j<sample.mass.size(); j++) {
+    mass=sample.mass[j]; pt=sample.pt[j]; pt1=sample.pt1[j]; pt2=sample.pt2[j];
+    t->Fill();
+  }
+  t->Write();
+}
+
+void write_singles(const char* name, const vector<float>& sample) {
+  TTree* t = new TTree(name,"single electrons at |eta|<1");
+  float pt;
+  t->Branch("pt",&pt,"pt/F");
+  for(unsigned int j=0; j<sample.size(); j++) { pt=sample[j]; t->Fill(); }
+  t->Write();
+}
+
+bool load_pairs(TFile* f, const char* name, PairSample& sample) {
+  TTree* t = (TTree*)f->Get(name);
+  if(!t) return false;
+  float mass,pt,pt1,pt2;
+  t->SetBranchAddress("mass",&mass);
+  t->SetBranchAddress("pt",  &pt);
+  t->SetBranchAddress("pt1", &pt1);
+  t->SetBranchAddress("pt2", &pt2);
+  for(Long64_t j=0; j<t->GetEntries(); j++) {
+    t->GetEntry(j);
+    sample.mass.push_back(mass); sample.pt.push_back(pt); sample.pt1.push_back(pt1); sample.pt2.push_back(pt2);
+  }
+  return true;
+}
+
+bool load_singles(TFile* f, const char* name, vector<float>& sample) {
+  TTree* t = (TTree*)f->Get(name);
+  if(!t) return false;
+  float pt;
+  t->SetBranchAddress("pt",&pt);
+  for(Long64_t j=0; j<t->GetEntries(); j++) { t->GetEntry(j); sample.push_back(pt); }
+  return true;
+}
+
+bool load_cache(string fname, HFInput& input) {
+  TFile* f = TFile::Open(fname.c_str());
+  if(!f || f->IsZombie()) { delete f; return false; }
+  bool ok = load_pairs(f,"charm",input.charm) && load_pairs(f,"charm_ckin3_4",input.charm_ckin3_4) &&
+            load_pairs(f,"bottom",input.bottom) && load_pairs(f,"dy",input.dy) &&
+            load_singles(f,"charm_sngl",input.charm_sngl) && load_singles(f,"bottom_sngl",input.bottom_sngl);
+  f->Close();
+  delete f;
+  if(!ok) { input = HFInput(); }
+  return ok;
+}
+
+void save_cache(string fname, const HFInput& input) {
+  TFile* f = new TFile(fname.c_str(),"RECREATE");
+  write_pairs("charm",input.charm);
+  write_pairs("charm_ckin3_4",input.charm_ckin3_4);
+  write_pairs("bottom",input.bottom);
+  write_pairs("dy",input.dy);
+  write_singles("charm_sngl",input.charm_sngl);
+  write_singles("bottom_sngl",input.bottom_sngl);
+  f->Close();
+  delete f;
+  cout << "ntuple input cached in " << fname << endl;
+}
+
+// the loops used to run while j < entries*eideff^2
+Long64_t eid_entries(TChain* chain, double eideff) {
+  return Long64_t(ceil(chain->GetEntries()*eideff*eideff));
+}
+
 //====================================================================================
 
 int main(int argc, char* argv[]) 
 {
   double eideff = 0.9;
   string ofname="ccbb.root";
+  int nthreads = thread::hardware_concurrency();
+  if(nthreads<1) nthreads = 1;
   if(argc==1) cout << argv[0] << " is running with standard parameters..." << endl;
-  if(argc==2) { eideff = atoi(argv[1]); }
-  if(argc==3) { eideff = atoi(argv[1]); ofname=argv[2]; }
+  if(argc>=2) { eideff = atof(argv[1]); }
+  if(argc>=3) { ofname=argv[2]; }
+  if(argc>=4) { nthreads = atoi(argv[3]); }
   cout << "eID efficiency = " << eideff << endl;
   cout << "output file name: " << ofname << endl;
-    return ccbb(eideff, ofname);
+  cout << "ntuple reading threads: " << nthreads << endl;
+    return ccbb(eideff, ofname, nthreads);
 }
 
 //------------------------------------------------------------------------------------
 
-int ccbb(double eideff, string ofname) {
+int ccbb(double eideff, string ofname, int nthreads) {
 
 // 0 = ppg182, min. bias AuAu
 // 1 = FONLL, p+p
@@ -109,6 +308,13 @@ double NeventsAuAu = 10.0e+09;
 TRandom* rnd = new TRandom3();
 rnd->SetSeed(0);
 
+ROOT::EnableThreadSafety();
+char cachename[999];
+sprintf(cachename,"ccbb_input_eideff%.3f_ptcut%.2f.root",eideff,ptcut);
+HFInput input;
+bool cached = load_cache(cachename,input);
+if(cached) cout << "ntuple input read from " << cachename << endl;
+
 const int nbins = 15;
 double binlim[nbins+1];
 for(int i=0; i<=nbins; i++) {binlim[i]=double(i);}
@@ -144,9 +350,6 @@ hbottom_pt_nosupp = new TH1D("hbottom_pt_nosupp","",nchanpt,startpt,stoppt);
 hcharm_pt_nosupp->Sumw2();
 hbottom_pt_nosupp->Sumw2();
 
-float mass,pt,eta,pt1,pt2,eta1,eta2;
-float pt_sngl,eta_sngl;
-
 float fitstart=2.0;
 float fitstop=8.0;
 TF1* fnorm_charm  = new TF1("fnorm_charm", norm_charm, fitstart,fitstop,1);
@@ -628,29 +831,15 @@ chain_ccbar_sngl->Add("/phenix/hhj/lebedev/sphenix/phpythia6/ntp_ccbar_norm/ccba
 chain_ccbar_sngl->Add("/phenix/hhj/lebedev/sphenix/phpythia6/ntp_ccbar_norm/ccbar_norm_13.root");
 chain_ccbar_sngl->Add("/phenix/hhj/lebedev/sphenix/phpythia6/ntp_ccbar_norm/ccbar_norm_14.root");
 
-cout << "Number of entries in CCbar chain: " << chain_ccbar->GetEntries() << endl;
-cout << "Number of entries in CCbar SINGLES chain: " << chain_ccbar_sngl->GetEntries() << endl;
-
-chain_ccbar->SetBranchAddress("mass",&mass);
-chain_ccbar->SetBranchAddress("pt",  &pt);
-chain_ccbar->SetBranchAddress("eta", &eta);
-chain_ccbar->SetBranchAddress("pt1", &pt1);
-chain_ccbar->SetBranchAddress("pt2", &pt2);
-chain_ccbar->SetBranchAddress("eta1",&eta1);
-chain_ccbar->SetBranchAddress("eta2",&eta2);
-
-chain_ccbar_sngl->SetBranchAddress("pt",  &pt_sngl);
-chain_ccbar_sngl->SetBranchAddress("eta", &eta_sngl);
+if(!cached) {
+  cout << "Number of entries in CCbar chain: " << chain_ccbar->GetEntries() << endl;
+  cout << "Number of entries in CCbar SINGLES chain: " << chain_ccbar_sngl->GetEntries() << endl;
+  read_singles(chain_ccbar_sngl,nthreads,input.charm_sngl);
+  read_pairs(chain_ccbar,eid_entries(chain_ccbar,eideff),ptcut,nthreads,input.charm);
+}
 
 // Singles for normalization
-for(int j=0; j<chain_ccbar_sngl->GetEntries(); j++){
-  chain_ccbar_sngl->GetEvent(j);
-  if(j%100000==0) cout << "entry # " << j << " " << endl;
-  if(fabs(eta_sngl)<1.0) { hcharm_pt_nosupp->Fill(pt_sngl); }
-  double random = rnd->Uniform(0.,1.);
-  double myraa = gCharmSuppression->Eval(pt_sngl);
-  if(random<=myraa) {  if(fabs(eta_sngl)<1.0) { hcharm_pt->Fill(pt_sngl); } }
-}
+fill_singles(input.charm_sngl,gCharmSuppression,rnd,hcharm_pt,hcharm_pt_nosupp);
 cout << "Number of entries in charm pT histogram = " << hcharm_pt->GetEntries() << endl;
 
 hcharm_pt->Scale(1.0/bsizept); // convert to dN/dpT
@@ -670,22 +859,7 @@ hcharm_pt_nosupp->Scale(charm_scale); // scale up to 10B most central AuAu accor
 
 
 // invariant mass distributions for CCbar
-for(int j=0; j<chain_ccbar->GetEntries()*eideff*eideff; j++){
-  chain_ccbar->GetEvent(j);
-  if(j%20000==0) cout << "entry # " << j << endl;
-  if(pt1>ptcut && pt2>ptcut && fabs(eta1)<1.0 && fabs(eta2)<1.0) {
-    double random1 = rnd->Uniform(0.,1.);
-    double myraa1 = gCharmSuppression->Eval(pt1);
-    double random2 = rnd->Uniform(0.,1.);
-    double myraa2 = gCharmSuppression->Eval(pt2);
-    if(random1<=myraa1 && random2<myraa2) {
-      int mybin = -1;
-      for(int i=0; i<nbins; i++) { if(pt<binlim[i+1]) { mybin = i; break; } }
-      if(mybin>=0 && mybin<nbins) { (hcharm[mybin])->Fill(mass); }
-      (hcharm[nbins])->Fill(mass); // all pT
-    }
-  }
-}
+fill_pairs(input.charm,gCharmSuppression,rnd,hcharm,nbins,binlim);
 
 //------------------------------------------------------------------------------------------
 // CCbar with ckin(3) = 4 from PYTHIA
@@ -710,33 +884,13 @@ chain_ccbar_ckin3_4->Add("/phenix/hhj/lebedev/sphenix/phpythia6/ntp_ccbar_ckin3_
 chain_ccbar_ckin3_4->Add("/phenix/hhj/lebedev/sphenix/phpythia6/ntp_ccbar_ckin3_4/ccbar_ckin3_4_88.root");
 
 
-cout << "Number of entries in CCbar with ckin(3) = 4 chain: " << chain_ccbar_ckin3_4->GetEntries() << endl;
-
-chain_ccbar_ckin3_4->SetBranchAddress("mass",&mass);
-chain_ccbar_ckin3_4->SetBranchAddress("pt",  &pt);
-chain_ccbar_ckin3_4->SetBranchAddress("eta", &eta);
-chain_ccbar_ckin3_4->SetBranchAddress("pt1", &pt1);
-chain_ccbar_ckin3_4->SetBranchAddress("pt2", &pt2);
-chain_ccbar_ckin3_4->SetBranchAddress("eta1",&eta1);
-chain_ccbar_ckin3_4->SetBranchAddress("eta2",&eta2);
+if(!cached) {
+  cout << "Number of entries in CCbar with ckin(3) = 4 chain: " << chain_ccbar_ckin3_4->GetEntries() << endl;
+  read_pairs(chain_ccbar_ckin3_4,eid_entries(chain_ccbar_ckin3_4,eideff),ptcut,nthreads,input.charm_ckin3_4);
+}
 
 // invariant mass distributions for CCbar with ckin(3) = 4
-for(int j=0; j<chain_ccbar_ckin3_4->GetEntries()*eideff*eideff; j++){
-  chain_ccbar_ckin3_4->GetEvent(j);
-  if(j%20000==0) cout << "entry # " << j << endl;
-  if(pt1>ptcut && pt2>ptcut && fabs(eta1)<1.0 && fabs(eta2)<1.0) {
-    double random1 = rnd->Uniform(0.,1.);
-    double myraa1 = gCharmSuppression->Eval(pt1);
-    double random2 = rnd->Uniform(0.,1.);
-    double myraa2 = gCharmSuppression->Eval(pt2);
-    if(random1<=myraa1 && random2<myraa2) {
-      int mybin = -1;
-      for(int i=0; i<nbins; i++) { if(pt<binlim[i+1]) { mybin = i; break; } }
-      if(mybin>=0 && mybin<nbins) { (hcharm_ckin3_4[mybin])->Fill(mass); }
-      (hcharm_ckin3_4[nbins])->Fill(mass); // all pT
-    }
-  }
-}
+fill_pairs(input.charm_ckin3_4,gCharmSuppression,rnd,hcharm_ckin3_4,nbins,binlim);
 
 //------------------------------------------------------------------------------------------
 // BBbar from PYTHIA
@@ -775,29 +929,15 @@ double bottom_scale = 28.4;
 TChain* chain_bbbar_sngl = new TChain("ntp1");
 chain_bbbar_sngl->Add("/phenix/hhj/lebedev/sphenix/phpythia6/ntp_bbbar_norm/bbbar_norm_0.root"); 
 
-cout << "Number of entries in BBbar chain: " << chain_bbbar->GetEntries() << endl;
-cout << "Number of entries in BBbar SINGLES chain: " << chain_bbbar_sngl->GetEntries() << endl;
-
-chain_bbbar->SetBranchAddress("mass",&mass);
-chain_bbbar->SetBranchAddress("pt",  &pt);
-chain_bbbar->SetBranchAddress("eta", &eta);
-chain_bbbar->SetBranchAddress("pt1", &pt1);
-chain_bbbar->SetBranchAddress("pt2", &pt2);
-chain_bbbar->SetBranchAddress("eta1",&eta1);
-chain_bbbar->SetBranchAddress("eta2",&eta2);
-
-chain_bbbar_sngl->SetBranchAddress("pt",  &pt_sngl);
-chain_bbbar_sngl->SetBranchAddress("eta", &eta_sngl);
+if(!cached) {
+  cout << "Number of entries in BBbar chain: " << chain_bbbar->GetEntries() << endl;
+  cout << "Number of entries in BBbar SINGLES chain: " << chain_bbbar_sngl->GetEntries() << endl;
+  read_singles(chain_bbbar_sngl,nthreads,input.bottom_sngl);
+  read_pairs(chain_bbbar,eid_entries(chain_bbbar,eideff),ptcut,nthreads,input.bottom);
+}
 
 // Singles for normalization
-for(int j=0; j<chain_bbbar_sngl->GetEntries(); j++){
-  chain_bbbar_sngl->GetEvent(j);
-  if(j%100000==0) cout << "entry # " << j << " " << endl;
-  if(fabs(eta_sngl)<1.0) { hbottom_pt_nosupp->Fill(pt_sngl); }
-  double random = rnd->Uniform(0.,1.);
-  double myraa = gBottomSuppression->Eval(pt_sngl);
-  if(random<=myraa) {  if(fabs(eta_sngl)<1.0) { hbottom_pt->Fill(pt_sngl); } }
-}
+fill_singles(input.bottom_sngl,gBottomSuppression,rnd,hbottom_pt,hbottom_pt_nosupp);
 cout << "Number of entries in bottom pT histogram = " << hbottom_pt->GetEntries() << endl;
 
 hbottom_pt->Scale(1.0/bsizept);  // convert to dN/dpT
@@ -834,22 +974,7 @@ hbottom_pt_nosupp->Scale(bottom_scale); // scale up to 10B most central AuAu acc
     cout << "HF normalization (no suppression) = " << norm_hf_nosupp << endl;
 
 // invariant mass distributions for BBbar
-for(int j=0; j<chain_bbbar->GetEntries()*eideff*eideff; j++){
-  chain_bbbar->GetEvent(j);
-  if(j%20000==0) cout << "entry # " << j << endl;
-  if(pt1>ptcut && pt2>ptcut && fabs(eta1)<1.0 && fabs(eta2)<1.0) {
-    double random1 = rnd->Uniform(0.,1.);
-    double myraa1 = gBottomSuppression->Eval(pt1);
-    double random2 = rnd->Uniform(0.,1.);
-    double myraa2 = gBottomSuppression->Eval(pt2);
-    if(random1<=myraa1 && random2<=myraa2) {
-      int mybin = -1;
-      for(int i=0; i<nbins; i++) { if(pt<binlim[i+1]) { mybin = i; break; } }
-      if(mybin>=0 && mybin<nbins) { (hbottom[mybin])->Fill(mass); }
-      (hbottom[nbins])->Fill(mass);
-    }
-  }
-}
+fill_pairs(input.bottom,gBottomSuppression,rnd,hbottom,nbins,binlim);
 
 
 //-----------------------------------------------------------------------
@@ -864,28 +989,15 @@ TChain* chain_dy = new TChain("ntp2");
 // do we need to scale up like charm and bottom?
 chain_dy->Add("/phenix/hhj/lebedev/sphenix/phpythia6/ntp_dy/dy_9550B_ppevents.root"); 
 
-cout << "Number of entries in DY chain: " << chain_dy->GetEntries() << endl;
-
-chain_dy->SetBranchAddress("mass",&mass);
-chain_dy->SetBranchAddress("pt",  &pt);
-chain_dy->SetBranchAddress("eta", &eta);
-chain_dy->SetBranchAddress("pt1", &pt1);
-chain_dy->SetBranchAddress("pt2", &pt2);
-chain_dy->SetBranchAddress("eta1",&eta1);
-chain_dy->SetBranchAddress("eta2",&eta2);
-
-// Invariant mass distributions for DY
-for(int j=0; j<chain_dy->GetEntries()*eideff*eideff; j++){
-  chain_dy->GetEvent(j);
-  if(j%20000==0) cout << "entry # " << j << endl;
-  if(pt1>ptcut && pt2>ptcut && fabs(eta1)<1.0 && fabs(eta2)<1.0) { 
-    int mybin = -1;
-    for(int i=0; i<nbins; i++) { if(pt<binlim[i+1]) { mybin = i; break; } }
-    if(mybin>=0 && mybin<nbins) { (hdy[mybin])->Fill(mass); }
-    (hdy[nbins])->Fill(mass);
-  }
+if(!cached) {
+  cout << "Number of entries in DY chain: " << chain_dy->GetEntries() << endl;
+  read_pairs(chain_dy,eid_entries(chain_dy,eideff),ptcut,nthreads,input.dy);
+  save_cache(cachename,input);
 }
 
+// Invariant mass distributions for DY (not suppressed)
+fill_pairs(input.dy,0,rnd,hdy,nbins,binlim);
+
 
 
 //----------------------------------------------------------------------
@@ -894,10 +1006,10 @@ for(int j=0; j<chain_dy->GetEntries()*eideff*eideff; j++){
 
 TFile* fout = new TFile(ofname.c_str(),"RECREATE");
 
-  TH1D* hhcharm[nbins];
-  TH1D* hhcharm_ckin3_4[nbins];
-  TH1D* hhbottom[nbins];
-  TH1D* hhdy[nbins];
+  TH1D* hhcharm[nbins+1];
+  TH1D* hhcharm_ckin3_4[nbins+1];
+  TH1D* hhbottom[nbins+1];
+  TH1D* hhdy[nbins+1];
   for(int i=0; i<nbins+1; i++) {
     sprintf(hname,"hhbottom_%d",i); hhbottom[i]  = (TH1D*)(hbottom[i])->Clone(hname);
     sprintf(hname,"hhcharm_%d",i);  hhcharm[i]   = (TH1D*)(hcharm[i])->Clone(hname);
@@ -9,6 +9,7 @@
  */
 
 #include "TPCMLDataInterface.h"
+#include "TPCMLH5Writer.h"
 
 #include <tpc/TpcDefs.h>
 
@@ -83,6 +84,8 @@ TPCMLDataInterface::TPCMLDataInterface(
   , m_saveDataStreamFile(true)
   , m_outputFileNameBase(outputfilename)
   , m_h5File(nullptr)
+  , m_appendH5Output(false)
+  , m_h5Writer(nullptr)
   , m_minLayer(minLayer)
   , m_maxLayer(m_maxLayer)
   , m_evtCounter(-1)
@@ -105,6 +108,7 @@ TPCMLDataInterface::TPCMLDataInterface(
 TPCMLDataInterface::~TPCMLDataInterface()
 {
   if (m_h5File) delete m_h5File;
+  if (m_h5Writer) delete m_h5Writer;
 }
 
 int TPCMLDataInterface::Init(PHCompositeNode* topNode)
@@ -134,6 +138,16 @@ int TPCMLDataInterface::End(PHCompositeNode* topNode)
     m_h5File = nullptr;
   }
 
+  if (m_h5Writer)
+  {
+    m_h5Writer->finish();
+    if (Verbosity() >= VERBOSITY_SOME)
+      cout << "TPCMLDataInterface::End - wrote " << m_h5Writer->nEventsWritten() << " events with "
+           << m_h5Writer->nHitsWritten() << " hits to " << m_outputFileNameBase + ".h5" << endl;
+    delete m_h5Writer;
+    m_h5Writer = nullptr;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -148,11 +162,13 @@ int TPCMLDataInterface::InitRun(PHCompositeNode* topNode)
   }
 
   int nZBins = 0;
+  vector<int> layerPhiBins;
   for (int layer = m_minLayer; layer <= m_maxLayer; ++layer)
   {
     PHG4CylinderCellGeom* layerGeom =
         seggeo->GetLayerCellGeom(layer);
     assert(layerGeom);
+    layerPhiBins.push_back(layerGeom->get_phibins());
 
     if (nZBins <= 0)
     {
@@ -263,7 +279,10 @@ int TPCMLDataInterface::InitRun(PHCompositeNode* topNode)
   if (Verbosity() >= VERBOSITY_SOME)
     cout << "TPCMLDataInterface::get_HistoManager - Making H5File " << m_outputFileNameBase + ".h5"
          << endl;
-  m_h5File = new H5File(m_outputFileNameBase + ".h5", H5F_ACC_TRUNC);
+  if (m_appendH5Output)
+    m_h5Writer = new TPCMLH5Writer(m_outputFileNameBase + ".h5", layerPhiBins, nZBins);
+  else
+    m_h5File = new H5File(m_outputFileNameBase + ".h5", H5F_ACC_TRUNC);
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -272,7 +291,7 @@ int TPCMLDataInterface::process_event(PHCompositeNode* topNode)
 {
   m_evtCounter += 1;
 
-  assert(m_h5File);
+  assert(m_h5File or m_h5Writer);
 
   Fun4AllHistoManager* hm = getHistoManager();
   assert(hm);
@@ -400,12 +419,16 @@ int TPCMLDataInterface::process_event(PHCompositeNode* topNode)
 
   }  //   for (unsigned int layer = m_minLayer; layer <= m_maxLayer; ++layer)
 
-  //H5 init
-  string h5GroupName = boost::str(boost::format("TimeFrame_%1%") % m_evtCounter);
-  unique_ptr<Group> h5Group(new Group(m_h5File->createGroup("/" + h5GroupName)));
-  h5Group->setComment(boost::str(boost::format("Collection of ADC data matrixes in Time Frame #%1%") % m_evtCounter));
-  if (Verbosity())
-    cout << "TPCMLDataInterface::process_event - save to H5 group " << h5GroupName << endl;
+  //H5 init, one group per event unless appending to common datasets
+  unique_ptr<Group> h5Group;
+  if (m_h5File)
+  {
+    string h5GroupName = boost::str(boost::format("TimeFrame_%1%") % m_evtCounter);
+    h5Group.reset(new Group(m_h5File->createGroup("/" + h5GroupName)));
+    h5Group->setComment(boost::str(boost::format("Collection of ADC data matrixes in Time Frame #%1%") % m_evtCounter));
+    if (Verbosity())
+      cout << "TPCMLDataInterface::process_event - save to H5 group " << h5GroupName << endl;
+  }
   map<int, shared_ptr<DataSet>> layerH5DataSetMap;
   map<int, shared_ptr<DataSet>> layerH5SignalBackgroundMap;
   map<int, shared_ptr<DataSpace>> layerH5DataSpaceMap;
@@ -415,11 +438,16 @@ int TPCMLDataInterface::process_event(PHCompositeNode* topNode)
   vector<uint32_t> layerWaveletDataSize(m_maxLayer + 1, 0);
   vector<hsize_t> layerSize(1);
   layerSize[0] = static_cast<hsize_t>(m_maxLayer - m_minLayer + 1);
-  shared_ptr<DataSpace> H5DataSpaceLayerWaveletDataSize(new DataSpace(1, layerSize.data()));
-  shared_ptr<DataSet> H5DataSetLayerWaveletDataSize(new DataSet(h5Group->createDataSet(
-      "sPHENIXRawDataSizeBytePerLayer",
-      PredType::NATIVE_UINT32,
-      *(H5DataSpaceLayerWaveletDataSize))));
+  shared_ptr<DataSpace> H5DataSpaceLayerWaveletDataSize;
+  shared_ptr<DataSet> H5DataSetLayerWaveletDataSize;
+  if (h5Group)
+  {
+    H5DataSpaceLayerWaveletDataSize.reset(new DataSpace(1, layerSize.data()));
+    H5DataSetLayerWaveletDataSize.reset(new DataSet(h5Group->createDataSet(
+        "sPHENIXRawDataSizeBytePerLayer",
+        PredType::NATIVE_UINT32,
+        *(H5DataSpaceLayerWaveletDataSize))));
+  }
 
   // prepreare stat. storage
   int nZBins = 0;
@@ -479,6 +507,8 @@ int TPCMLDataInterface::process_event(PHCompositeNode* topNode)
     layerDataBuffer[layer].resize(layerDataBufferSize[layer][0] * layerDataBufferSize[layer][1], 0);
     layerSignalBackgroundBuffer[layer].resize(layerSignalBackgroundDataBufferSize[layer][0] * layerSignalBackgroundDataBufferSize[layer][1], 0);
 
+    if (not h5Group) continue;
+
     static const vector<hsize_t> cdims({32, 32});
     DSetCreatPropList ds_creatplist;
     ds_creatplist.setChunk(2, cdims.data());  // then modify it for compression
@@ -747,6 +777,7 @@ int TPCMLDataInterface::process_event(PHCompositeNode* topNode)
     }  //    for (unsigned int side = 0; side < 2; ++side)
 
     // store in H5
+    if (not h5Group) continue;
 
     assert(layerH5DataSetMap[layer]);
     assert(layerH5SignalBackgroundMap[layer]);
@@ -756,6 +787,36 @@ int TPCMLDataInterface::process_event(PHCompositeNode* topNode)
 
   }  //  for (unsigned int layer = m_minLayer; layer <= m_maxLayer; ++layer)
 
+  // queue zero-suppressed hits for the appendable H5 output
+  if (m_h5Writer)
+  {
+    unique_ptr<TPCMLH5Writer::Event> h5Event(new TPCMLH5Writer::Event);
+    h5Event->eventID = m_evtCounter;
+    h5Event->layerDataSize.assign(layerWaveletDataSize.begin(), layerWaveletDataSize.begin() + (m_maxLayer - m_minLayer + 1));
+
+    for (int layer = m_minLayer; layer <= m_maxLayer; ++layer)
+    {
+      h5Event->layerOffset.push_back(h5Event->adc.size());
+
+      const vector<uint16_t>& data = layerDataBuffer[layer];
+      const vector<uint8_t>& signalBackground = layerSignalBackgroundBuffer[layer];
+      const hsize_t nZ = layerDataBufferSize[layer][1];
+      for (size_t hitindex = 0; hitindex < data.size(); ++hitindex)
+      {
+        if (data[hitindex] == 0) continue;
+
+        h5Event->layer.push_back(layer - m_minLayer);
+        h5Event->phibin.push_back(hitindex / nZ);
+        h5Event->zbin.push_back(hitindex % nZ);
+        h5Event->adc.push_back(data[hitindex]);
+        h5Event->signalBackground.push_back(signalBackground[hitindex]);
+      }
+    }
+    h5Event->layerOffset.push_back(h5Event->adc.size());
+
+    m_h5Writer->push(move(h5Event));
+  }
+
   assert(m_hWavelet);
   m_hWavelet->Fill(nWavelet);
   h_norm->Fill("TPC Wavelet", nWavelet);
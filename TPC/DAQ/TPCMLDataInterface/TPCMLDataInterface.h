@@ -20,6 +20,7 @@ class Fun4AllHistoManager;
 class SvtxEvalStack;
 class TH1;
 class TH2;
+class TPCMLH5Writer;
 namespace H5
 {
 class H5File;
@@ -62,6 +63,14 @@ class TPCMLDataInterface : public SubsysReco
     m_saveDataStreamFile = saveDataStreamFile;
   }
 
+  //! instead of one HDF5 group per event, append zero-suppressed hits of all events
+  //! to fixed-schema, chunked and compressed datasets, written from a background thread.
+  //! See TPCMLH5Writer for the layout.
+  void appendH5Output(bool appendH5Output)
+  {
+    m_appendH5Output = appendH5Output;
+  }
+
   double getEtaAcceptanceCut() const
   {
     return m_etaAcceptanceCut;
@@ -96,6 +105,8 @@ class TPCMLDataInterface : public SubsysReco
 
   std::string m_outputFileNameBase;
   H5::H5File *m_h5File;
+  bool m_appendH5Output;
+  TPCMLH5Writer *m_h5Writer;
 
   int m_minLayer;
   int m_maxLayer;
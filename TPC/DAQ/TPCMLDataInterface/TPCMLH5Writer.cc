@@ -0,0 +1,184 @@
+// $Id: $
+
+/*!
+ * \file TPCMLH5Writer.cc
+ * \brief
+ * \version $Revision:   $
+ * \date $Date: $
+ */
+
+#include "TPCMLH5Writer.h"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+using namespace H5;
+
+namespace
+{
+  //! empty dataset of rank 1 (width = 0) or rank 2, unlimited along the first dimension
+  DataSet createExtendible(H5File& file, const string& name, const PredType& type, hsize_t width, hsize_t chunkRows)
+  {
+    const int rank = width > 0 ? 2 : 1;
+    const hsize_t dims[2] = {0, width};
+    const hsize_t maxdims[2] = {H5S_UNLIMITED, width};
+    const hsize_t chunk[2] = {chunkRows, width};
+
+    DataSpace space(rank, dims, maxdims);
+    DSetCreatPropList plist;
+    plist.setChunk(rank, chunk);
+    plist.setDeflate(6);
+
+    return file.createDataSet(name, type, space, plist);
+  }
+
+  //! append nRows rows starting at row offset
+  void appendRows(DataSet& ds, const PredType& type, hsize_t offset, hsize_t nRows, hsize_t width, const void* data)
+  {
+    if (nRows == 0) return;
+
+    const int rank = width > 0 ? 2 : 1;
+    const hsize_t newsize[2] = {offset + nRows, width};
+    ds.extend(newsize);
+
+    const hsize_t start[2] = {offset, 0};
+    const hsize_t count[2] = {nRows, width};
+    DataSpace filespace = ds.getSpace();
+    filespace.selectHyperslab(H5S_SELECT_SET, count, start);
+    DataSpace memspace(rank, count);
+
+    ds.write(data, type, memspace, filespace);
+  }
+}  // namespace
+
+TPCMLH5Writer::TPCMLH5Writer(
+    const std::string& filename,
+    const std::vector<int>& layerPhiBins,
+    int nZBins,
+    unsigned int maxQueuedEvents)
+  : m_file(new H5File(filename, H5F_ACC_TRUNC))
+  , m_nLayer(layerPhiBins.size())
+  , m_nEvents(0)
+  , m_nHits(0)
+  , m_maxQueuedEvents(max(maxQueuedEvents, 1u))
+  , m_finishing(false)
+  , m_failed(false)
+{
+  assert(m_nLayer > 0);
+
+  m_file->createGroup("/Geometry");
+  m_file->createGroup("/Hits");
+  m_file->createGroup("/Events");
+
+  vector<int32_t> phiBins(layerPhiBins.begin(), layerPhiBins.end());
+  const hsize_t nLayer = m_nLayer;
+  DataSet dsPhiBins = m_file->createDataSet("/Geometry/LayerPhiBins", PredType::NATIVE_INT32, DataSpace(1, &nLayer));
+  dsPhiBins.write(phiBins.data(), PredType::NATIVE_INT32);
+  const hsize_t one = 1;
+  const int32_t zBins = nZBins;
+  DataSet dsZBins = m_file->createDataSet("/Geometry/ZBins", PredType::NATIVE_INT32, DataSpace(1, &one));
+  dsZBins.write(&zBins, PredType::NATIVE_INT32);
+
+  // 64k hits per chunk, O(10) chunks per central AuAu time frame
+  static const hsize_t hitChunk = 1 << 16;
+  m_hitLayer = createExtendible(*m_file, "/Hits/Layer", PredType::NATIVE_UINT16, 0, hitChunk);
+  m_hitPhiBin = createExtendible(*m_file, "/Hits/PhiBin", PredType::NATIVE_UINT16, 0, hitChunk);
+  m_hitZBin = createExtendible(*m_file, "/Hits/ZBin", PredType::NATIVE_UINT16, 0, hitChunk);
+  m_hitADC = createExtendible(*m_file, "/Hits/ADC", PredType::NATIVE_UINT16, 0, hitChunk);
+  m_hitSignalBackground = createExtendible(*m_file, "/Hits/SignalBackground", PredType::NATIVE_UINT8, 0, hitChunk);
+
+  static const hsize_t eventChunk = 1024;
+  m_eventID = createExtendible(*m_file, "/Events/EventID", PredType::NATIVE_INT32, 0, eventChunk);
+  m_eventHitOffset = createExtendible(*m_file, "/Events/HitOffset", PredType::NATIVE_UINT64, m_nLayer + 1, eventChunk);
+  m_eventDataSize = createExtendible(*m_file, "/Events/sPHENIXRawDataSizeBytePerLayer", PredType::NATIVE_UINT32, m_nLayer, eventChunk);
+
+  m_thread = thread(&TPCMLH5Writer::run, this);
+}
+
+TPCMLH5Writer::~TPCMLH5Writer()
+{
+  finish();
+}
+
+void TPCMLH5Writer::push(std::unique_ptr<Event> event)
+{
+  assert(event);
+  assert(event->layerOffset.size() == m_nLayer + 1);
+  assert(event->layerDataSize.size() == m_nLayer);
+
+  unique_lock<mutex> lock(m_mutex);
+  assert(not m_finishing);
+  m_queueNotFull.wait(lock, [this] { return m_queue.size() < m_maxQueuedEvents; });
+  m_queue.push_back(move(event));
+  m_queueNotEmpty.notify_one();
+}
+
+void TPCMLH5Writer::finish()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_finishing) return;
+    m_finishing = true;
+  }
+  m_queueNotEmpty.notify_one();
+  if (m_thread.joinable()) m_thread.join();
+
+  m_file->flush(H5F_SCOPE_GLOBAL);
+  m_file->close();
+}
+
+void TPCMLH5Writer::run()
+{
+  while (true)
+  {
+    unique_ptr<Event> event;
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_queueNotEmpty.wait(lock, [this] { return m_finishing or not m_queue.empty(); });
+      if (m_queue.empty()) return;  // finishing and drained
+
+      event = move(m_queue.front());
+      m_queue.pop_front();
+    }
+    m_queueNotFull.notify_one();
+
+    if (m_failed) continue;  // keep draining so that push() never blocks forever
+    try
+    {
+      append(*event);
+    }
+    catch (const H5::Exception& e)
+    {
+      cout << "TPCMLH5Writer::run - Error - failed to append event " << event->eventID
+           << ", no further event will be written: " << e.getDetailMsg() << endl;
+      m_failed = true;
+    }
+  }
+}
+
+void TPCMLH5Writer::append(const Event& event)
+{
+  const hsize_t nHit = event.adc.size();
+  assert(event.layer.size() == nHit);
+  assert(event.phibin.size() == nHit);
+  assert(event.zbin.size() == nHit);
+  assert(event.signalBackground.size() == nHit);
+
+  appendRows(m_hitLayer, PredType::NATIVE_UINT16, m_nHits, nHit, 0, event.layer.data());
+  appendRows(m_hitPhiBin, PredType::NATIVE_UINT16, m_nHits, nHit, 0, event.phibin.data());
+  appendRows(m_hitZBin, PredType::NATIVE_UINT16, m_nHits, nHit, 0, event.zbin.data());
+  appendRows(m_hitADC, PredType::NATIVE_UINT16, m_nHits, nHit, 0, event.adc.data());
+  appendRows(m_hitSignalBackground, PredType::NATIVE_UINT8, m_nHits, nHit, 0, event.signalBackground.data());
+
+  vector<uint64_t> offset(event.layerOffset);
+  for (uint64_t& o : offset) o += m_nHits;
+
+  const int32_t eventID = event.eventID;
+  appendRows(m_eventID, PredType::NATIVE_INT32, m_nEvents, 1, 0, &eventID);
+  appendRows(m_eventHitOffset, PredType::NATIVE_UINT64, m_nEvents, 1, m_nLayer + 1, offset.data());
+  appendRows(m_eventDataSize, PredType::NATIVE_UINT32, m_nEvents, 1, m_nLayer, event.layerDataSize.data());
+
+  m_nHits += nHit;
+  m_nEvents += 1;
+}
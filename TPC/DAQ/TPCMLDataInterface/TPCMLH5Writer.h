@@ -0,0 +1,101 @@
+// $Id: $
+
+/*!
+ * \file TPCMLH5Writer.h
+ * \brief Appendable HDF5 output for TPCMLDataInterface, written from a background thread
+ * \version $Revision:   $
+ * \date $Date: $
+ */
+
+#ifndef TPCMLH5WRITER_H_
+#define TPCMLH5WRITER_H_
+
+#include <H5Cpp.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*!
+ * \brief TPCMLH5Writer
+ *
+ * Fixed schema, all datasets chunked, compressed and extendible along the first dimension:
+ *
+ *   /Geometry/LayerPhiBins [nLayer]          number of phi bins per layer
+ *   /Geometry/ZBins        [1]               number of z bins
+ *   /Hits/Layer, /Hits/PhiBin, /Hits/ZBin, /Hits/ADC, /Hits/SignalBackground  [nHit]
+ *   /Events/EventID        [nEvent]
+ *   /Events/HitOffset      [nEvent][nLayer + 1]  hits of layer i in event e are
+ *                                                 HitOffset[e][i] .. HitOffset[e][i + 1] - 1
+ *   /Events/sPHENIXRawDataSizeBytePerLayer [nEvent][nLayer]
+ *
+ * Events are queued by the caller and appended to the file by a single writer thread,
+ * which is the only thread touching the HDF5 library.
+ */
+class TPCMLH5Writer
+{
+ public:
+  //! zero-suppressed hits of one event, ordered by layer
+  struct Event
+  {
+    int eventID = 0;
+    std::vector<uint16_t> layer;
+    std::vector<uint16_t> phibin;
+    std::vector<uint16_t> zbin;
+    std::vector<uint16_t> adc;
+    std::vector<uint8_t> signalBackground;
+    //! nLayer + 1 offsets relative to the first hit of this event
+    std::vector<uint64_t> layerOffset;
+    std::vector<uint32_t> layerDataSize;
+  };
+
+  TPCMLH5Writer(const std::string &filename,
+                const std::vector<int> &layerPhiBins,
+                int nZBins,
+                unsigned int maxQueuedEvents = 16);
+  virtual ~TPCMLH5Writer();
+
+  //! queue an event for writing, blocks while maxQueuedEvents are pending
+  void push(std::unique_ptr<Event> event);
+
+  //! write all pending events and close the file
+  void finish();
+
+  uint64_t nEventsWritten() const { return m_nEvents; }
+  uint64_t nHitsWritten() const { return m_nHits; }
+
+ private:
+  void run();
+  void append(const Event &event);
+
+  std::unique_ptr<H5::H5File> m_file;
+  const unsigned int m_nLayer;
+
+  H5::DataSet m_hitLayer;
+  H5::DataSet m_hitPhiBin;
+  H5::DataSet m_hitZBin;
+  H5::DataSet m_hitADC;
+  H5::DataSet m_hitSignalBackground;
+  H5::DataSet m_eventID;
+  H5::DataSet m_eventHitOffset;
+  H5::DataSet m_eventDataSize;
+
+  uint64_t m_nEvents;
+  uint64_t m_nHits;
+
+  const unsigned int m_maxQueuedEvents;
+  std::deque<std::unique_ptr<Event>> m_queue;
+  std::mutex m_mutex;
+  std::condition_variable m_queueNotEmpty;
+  std::condition_variable m_queueNotFull;
+  bool m_finishing;
+  bool m_failed;
+  std::thread m_thread;
+};
+
+#endif /* TPCMLH5WRITER_H_ */
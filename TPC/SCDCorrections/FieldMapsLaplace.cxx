@@ -6,10 +6,23 @@
 #include "TAxis.h"
 #include "TFile.h"
 #include "TMath.h"
+#include "TVectorD.h"
+#include <thread>
 
-
+//=====================
+FieldMapsLaplace::FieldMapsLaplace() :
+  FieldMaps(),
+  fUseTables(false),
+  fNThreads(1)
+{
+}
 //=====================
 void FieldMapsLaplace::ComputeE() {
+  if(fUseTables) ComputeEFromTables();
+  else ComputeEDirect();
+}
+//=====================
+void FieldMapsLaplace::ComputeEDirect() {
   const float prec=1e-8;
 
   //------------
@@ -81,3 +94,258 @@ void FieldMapsLaplace::ComputeE() {
   if(fDebug>0) printf("[DONE]\n");
   //------------
 }
+//=====================
+void FieldMapsLaplace::ComputeEFromTables() {
+  //------------
+  //STEER
+  if(fDebug>0) printf("FieldMaps is being computed from tabulated Laplace solutions... \n");
+  if(!LoadGreenTables()) {
+    MakeGreenTables();
+    SaveGreenTables();
+  }
+  int brprimeINI=0;
+  int brprimeEND=fNRadialSteps;
+  if(fRadialBin>-0.5) {
+    brprimeINI = fRadialBin;
+    brprimeEND = fRadialBin+1;
+  }
+  // constructing volume element
+  float dr = (fOutterRadius-fInnerRadius)/fNRadialSteps;
+  float dphi = TMath::TwoPi()/fNAzimuthalSteps;
+  float dz = 2.0*fHalfLength/fNLongitudinalSteps;
+
+  // charge in each source bin does not depend on the field point
+  const int nbins = fNRadialSteps*fNAzimuthalSteps*fNLongitudinalSteps;
+  std::vector<double> charge(nbins,0);
+  for(int brprime=brprimeINI; brprime!=brprimeEND; ++brprime) {
+    float rprime = fEr->GetXaxis()->GetBinCenter( brprime+1 ); //[cm]
+    for(int bphiprime=0; bphiprime!=fNAzimuthalSteps; ++bphiprime) {
+      float phiprime = fEr->GetYaxis()->GetBinCenter( bphiprime+1 );
+      for(int bzprime=0; bzprime!=fNLongitudinalSteps; ++bzprime) {
+	float zprime = fEr->GetZaxis()->GetBinCenter( bzprime+1 ); //[cm]
+	charge[(brprime*fNAzimuthalSteps+bphiprime)*fNLongitudinalSteps+bzprime] = ReadCharge(rprime,phiprime,zprime,dr,dphi,dz); // fC
+      }
+    }
+  }
+
+  // azimuthal modes are independent: share them among threads
+  std::vector< std::vector<double> > er(fNThreads, std::vector<double>(nbins,0));
+  std::vector< std::vector<double> > ez(fNThreads, std::vector<double>(nbins,0));
+  std::vector<std::thread> threads;
+  for(int it=0; it!=fNThreads; ++it) {
+    threads.emplace_back( [this,it,&charge,&er,&ez]() {
+	for(int m=it; m<NumberOfOrders; m+=fNThreads)
+	  IntegrateMode(m,charge,er[it],ez[it]);
+      } );
+  }
+  for(auto &t : threads) t.join();
+
+  float e0 = 8.854187817e+1; //[fC]/[V.cm]
+  float toVperCM = 0.155*1e-4/e0;
+  for(int br=0; br!=fNRadialSteps; ++br) {
+    float r = fEr->GetXaxis()->GetBinCenter( br+1 ); //[cm]
+    for(int bp=0; bp!=fNAzimuthalSteps; ++bp) {
+      float phi = fEr->GetYaxis()->GetBinCenter( bp+1 ); //[rad]
+      for(int bz=0; bz!=fNLongitudinalSteps; ++bz) {
+	float z = fEr->GetZaxis()->GetBinCenter( bz+1 ); //[cm]
+	if(fMirrorZ) if(z>0) continue;
+	int idx = (br*fNAzimuthalSteps+bp)*fNLongitudinalSteps+bz;
+	float intEr = 0, intEz = 0;
+	for(int it=0; it!=fNThreads; ++it) {
+	  intEr += er[it][idx];
+	  intEz += ez[it][idx];
+	}
+	fEr->Fill(r,phi,z,intEr*toVperCM); //[V/cm]
+	fEp->Fill(r,phi,z,0); //[V/cm]
+	fEz->Fill(r,phi,z,intEz*toVperCM); //[V/cm]
+      }
+    }
+  }
+  if(fDebug>0) printf("[DONE]\n");
+  //------------
+}
+//=====================
+void FieldMapsLaplace::IntegrateMode(int m, const std::vector<double> &charge, std::vector<double> &er, std::vector<double> &ez) {
+  const int NO = NumberOfOrders;
+  const int NR = fNRadialSteps;
+  const int NP = fNAzimuthalSteps;
+  const int NZ = fNLongitudinalSteps;
+  const double weight = (m==0) ? 1 : 2;
+
+  // Fourier components of the charge along phi':
+  // sum_phi' cos(m(phi-phi')) q = cos(m phi) C + sin(m phi) S
+  std::vector<double> cosm(NP), sinm(NP);
+  for(int bp=0; bp!=NP; ++bp) {
+    float phi = fEr->GetYaxis()->GetBinCenter( bp+1 );
+    cosm[bp] = cos(m*phi);
+    sinm[bp] = sin(m*phi);
+  }
+  std::vector<double> C(NR*NZ,0), S(NR*NZ,0);
+  for(int br=0; br!=NR; ++br)
+    for(int bp=0; bp!=NP; ++bp)
+      for(int bz=0; bz!=NZ; ++bz) {
+	double q = charge[(br*NP+bp)*NZ+bz];
+	C[br*NZ+bz] += cosm[bp]*q;
+	S[br*NZ+bz] += sinm[bp]*q;
+      }
+
+  // only same side along Z is integrated: side 0 (z<0), 1 (z=0), 2 (z>0);
+  // sources of side g contribute to field points of side s if (s-1)*(g-1)>=0
+  std::vector<int> side(NZ);
+  for(int bz=0; bz!=NZ; ++bz) {
+    float z = fEr->GetZaxis()->GetBinCenter( bz+1 );
+    side[bz] = (z<0) ? 0 : ((z>0) ? 2 : 1);
+  }
+
+  std::vector<double> Uc(3*NR), Us(3*NR), Vc(3*NR), Vs(3*NR);
+  std::vector<double> Yc(NZ), Ys(NZ), Wc(NZ), Ws(NZ);
+  for(int n=0; n!=NO; ++n) {
+    //--- Er: sum_z' sin(BetaN z') per side, then radial Green's function
+    const double *sinz = &fSinZ[n*NZ];
+    std::fill(Uc.begin(),Uc.end(),0);
+    std::fill(Us.begin(),Us.end(),0);
+    for(int br=0; br!=NR; ++br)
+      for(int bz=0; bz!=NZ; ++bz)
+	for(int s=0; s!=3; ++s) {
+	  if((s-1)*(side[bz]-1)<0) continue;
+	  Uc[s*NR+br] += sinz[bz]*C[br*NZ+bz];
+	  Us[s*NR+br] += sinz[bz]*S[br*NZ+bz];
+	}
+    const double *greenr = &fGreenR[(m*NO+n)*NR*NR];
+    for(int s=0; s!=3; ++s)
+      for(int br=0; br!=NR; ++br) {
+	double vc=0, vs=0;
+	for(int brprime=0; brprime!=NR; ++brprime) {
+	  vc += greenr[br*NR+brprime]*Uc[s*NR+brprime];
+	  vs += greenr[br*NR+brprime]*Us[s*NR+brprime];
+	}
+	Vc[s*NR+br] = weight*vc;
+	Vs[s*NR+br] = weight*vs;
+      }
+    for(int br=0; br!=NR; ++br)
+      for(int bp=0; bp!=NP; ++bp)
+	for(int bz=0; bz!=NZ; ++bz) {
+	  int s = side[bz];
+	  er[(br*NP+bp)*NZ+bz] += sinz[bz]*(cosm[bp]*Vc[s*NR+br] + sinm[bp]*Vs[s*NR+br]);
+	}
+
+    //--- Ez: sum_r' Rmn(r'), then longitudinal Green's function
+    const double *rmn = &fRmn[(m*NO+n)*NR];
+    for(int bz=0; bz!=NZ; ++bz) {
+      double yc=0, ys=0;
+      for(int br=0; br!=NR; ++br) {
+	yc += rmn[br]*C[br*NZ+bz];
+	ys += rmn[br]*S[br*NZ+bz];
+      }
+      Yc[bz] = yc;
+      Ys[bz] = ys;
+    }
+    const double *greenz = &fGreenZ[(m*NO+n)*NZ*NZ];
+    for(int bz=0; bz!=NZ; ++bz) {
+      double wc=0, ws=0;
+      for(int bzprime=0; bzprime!=NZ; ++bzprime) {
+	if((side[bz]-1)*(side[bzprime]-1)<0) continue;
+	wc += greenz[bz*NZ+bzprime]*Yc[bzprime];
+	ws += greenz[bz*NZ+bzprime]*Ys[bzprime];
+      }
+      Wc[bz] = wc;
+      Ws[bz] = ws;
+    }
+    const double norm = weight/(TMath::TwoPi()*fN2mn[m*NO+n]);
+    for(int br=0; br!=NR; ++br)
+      for(int bp=0; bp!=NP; ++bp)
+	for(int bz=0; bz!=NZ; ++bz)
+	  ez[(br*NP+bp)*NZ+bz] += norm*rmn[br]*(cosm[bp]*Wc[bz] + sinm[bp]*Ws[bz]);
+  }
+}
+//=====================
+void FieldMapsLaplace::MakeGreenTables() {
+  if(fDebug>0) printf("FieldMaps is tabulating Green's functions... \n");
+  LaplaceSolution *laplace_green_solution = new LaplaceSolution(fInnerRadius/100/*[m]*/,fOutterRadius/100/*[m]*/,fHalfLength/100/*[m]*/);
+  const int NO = NumberOfOrders;
+  const int NR = fNRadialSteps;
+  const int NZ = fNLongitudinalSteps;
+  std::vector<float> r(NR), z(NZ);
+  for(int br=0; br!=NR; ++br) r[br] = fEr->GetXaxis()->GetBinCenter( br+1 )/100; //[m]
+  for(int bz=0; bz!=NZ; ++bz) z[bz] = TMath::Abs(fEr->GetZaxis()->GetBinCenter( bz+1 ))/100; //[m]
+
+  fGreenR.assign(NO*NO*NR*NR,0);
+  fSinZ.assign(NO*NZ,0);
+  fRmn.assign(NO*NO*NR,0);
+  fN2mn.assign(NO*NO,0);
+  fGreenZ.assign(NO*NO*NZ*NZ,0);
+  for(int n=0; n!=NO; ++n)
+    for(int bz=0; bz!=NZ; ++bz)
+      fSinZ[n*NZ+bz] = laplace_green_solution->ErLongitudinal(n,z[bz]);
+
+  // Bessel series dominate: share the orders m among threads
+  std::vector<std::thread> threads;
+  for(int it=0; it!=fNThreads; ++it) {
+    threads.emplace_back( [&,it]() {
+	for(int m=it; m<NO; m+=fNThreads)
+	  for(int n=0; n!=NO; ++n) {
+	    int mn = m*NO+n;
+	    fN2mn[mn] = laplace_green_solution->GetN2mn(m,n);
+	    for(int br=0; br!=NR; ++br) {
+	      fRmn[mn*NR+br] = laplace_green_solution->Rmn(m,n,r[br]);
+	      for(int brprime=0; brprime!=NR; ++brprime)
+		fGreenR[(mn*NR+br)*NR+brprime] = laplace_green_solution->ErRadial(m,n,r[br],r[brprime]);
+	    }
+	    for(int bz=0; bz!=NZ; ++bz)
+	      for(int bzprime=0; bzprime!=NZ; ++bzprime)
+		fGreenZ[(mn*NZ+bz)*NZ+bzprime] = laplace_green_solution->EzLongitudinal(m,n,z[bz],z[bzprime]);
+	  }
+      } );
+  }
+  for(auto &t : threads) t.join();
+  delete laplace_green_solution;
+  if(fDebug>0) printf("[DONE]\n");
+}
+//=====================
+bool FieldMapsLaplace::LoadGreenTables() {
+  if(fLSNameRoot=="none") return false;
+  TFile *ifile = TFile::Open(fLSNameRoot.data());
+  if(!ifile || ifile->IsZombie()) {
+    delete ifile;
+    return false;
+  }
+  if(fDebug>0) printf("FieldMaps is reading Green's functions from %s... ",fLSNameRoot.data());
+  TVectorD *geo = (TVectorD*) ifile->Get("geometry");
+  bool ok = geo && geo->GetNrows()==6 &&
+    (*geo)[0]==fInnerRadius && (*geo)[1]==fOutterRadius && (*geo)[2]==fHalfLength &&
+    (*geo)[3]==fNRadialSteps && (*geo)[4]==fNLongitudinalSteps && (*geo)[5]==NumberOfOrders;
+  const char *names[5] = {"GreenR","SinZ","Rmn","N2mn","GreenZ"};
+  std::vector<double> *tables[5] = {&fGreenR,&fSinZ,&fRmn,&fN2mn,&fGreenZ};
+  for(int i=0; ok && i!=5; ++i) {
+    TVectorD *v = (TVectorD*) ifile->Get(names[i]);
+    if(!v) { ok=false; break; }
+    tables[i]->assign(v->GetMatrixArray(),v->GetMatrixArray()+v->GetNrows());
+  }
+  ifile->Close();
+  delete ifile;
+  if(fDebug>0) printf(ok?"[DONE]\n":"[GEOMETRY MISMATCH]\n");
+  return ok;
+}
+//=====================
+void FieldMapsLaplace::SaveGreenTables() {
+  if(fLSNameRoot=="none") return;
+  if(fDebug>0) printf("FieldMaps saving Green's functions into %s... ",fLSNameRoot.data());
+  TFile *ofile = new TFile(fLSNameRoot.data(),"RECREATE");
+  TVectorD geo(6);
+  geo[0] = fInnerRadius;
+  geo[1] = fOutterRadius;
+  geo[2] = fHalfLength;
+  geo[3] = fNRadialSteps;
+  geo[4] = fNLongitudinalSteps;
+  geo[5] = NumberOfOrders;
+  ofile->WriteObject(&geo,"geometry");
+  const char *names[5] = {"GreenR","SinZ","Rmn","N2mn","GreenZ"};
+  std::vector<double> *tables[5] = {&fGreenR,&fSinZ,&fRmn,&fN2mn,&fGreenZ};
+  for(int i=0; i!=5; ++i) {
+    TVectorD v(tables[i]->size(),tables[i]->data());
+    ofile->WriteObject(&v,names[i]);
+  }
+  ofile->Close();
+  delete ofile;
+  if(fDebug>0) printf("[DONE]\n");
+}
@@ -8,10 +8,36 @@
 //===========================================================
 
 #include "FieldMaps.h"
+#include <vector>
+
+class LaplaceSolution;
 
 class FieldMapsLaplace:public FieldMaps {
  public:
+  FieldMapsLaplace();
+  virtual ~FieldMapsLaplace() {}
+  /// integrate with Green's function tables (cached in LSFileName if set)
+  /// instead of evaluating the Bessel series for every pair of bins
+  void UseGreenTables(int nthreads=1) {fUseTables=true; fNThreads=nthreads>0?nthreads:1;}
   virtual void ComputeE();
+
+ protected:
+  void ComputeEDirect();
+  void ComputeEFromTables();
+  void MakeGreenTables();
+  bool LoadGreenTables();
+  void SaveGreenTables();
+  void IntegrateMode(int m, const std::vector<double> &charge, std::vector<double> &er, std::vector<double> &ez);
+
+  bool fUseTables;
+  int fNThreads;
+
+  // Green's function tables for the grid, lengths in [m], see LaplaceSolution
+  std::vector<double> fGreenR;   // ErRadial [m][n][br][br']
+  std::vector<double> fSinZ;     // ErLongitudinal [n][bz]
+  std::vector<double> fRmn;      // Rmn [m][n][br]
+  std::vector<double> fN2mn;     // N2mn [m][n]
+  std::vector<double> fGreenZ;   // EzLongitudinal [m][n][bz][bz']
 };
 
 #endif /* __FIELDMAPSLAPLACE_H__ */
@@ -1,5 +1,8 @@
 #include "Langevin.h"
 #include <string>
+#include <fstream>
+#include <thread>
+#include <cstring>
 
 #include "TH3F.h"
 #include "TFile.h"
@@ -8,6 +11,7 @@
 //=====================
 Langevin::Langevin() {
   fDebug = 0;
+  fNThreads = 1;
   fEr = NULL;
   fEp = NULL;
   fEz = NULL;
@@ -36,7 +40,6 @@ void Langevin::Make() {
   }
   if(fDebug>0) printf("Langevin solutions are being computed... \n");
 
-  const float prec=1e-8;
   const float kE0 = 400; //V/cm
   //const float kB0 = 5; //kGauss ALICE / STAR
   const float kB0 = 15; //kGauss PHENIX
@@ -59,32 +62,29 @@ void Langevin::Make() {
   if(fDebug>1) printf("c0 = %f \n",c0);
   if(fDebug>1) printf("c1 = %f \n",c1);
   if(fDebug>1) printf("c2 = %f \n",c2);
-  float dz = fEz->GetZaxis()->GetBinWidth(1);
+  FlattenFields();
+  if(fFieldZ.empty()) {
+    printf("Input fields do not match the TPC grid. A B O R T I N G\n");
+    return;
+  }
+  // columns (r,phi) are independent: share them among threads
+  const int ncol = fNRadialSteps*fNAzimuthalSteps;
+  const int nth = fNThreads<ncol ? fNThreads : ncol;
+  std::vector<std::thread> threads;
+  for(int it=0; it!=nth; ++it) {
+    int first = (long)ncol*it/nth;
+    int last = (long)ncol*(it+1)/nth;
+    threads.emplace_back( &Langevin::IntegrateColumns, this, first, last, c0, c1, kE0 );
+  }
+  for(auto &t : threads) t.join();
   for(int r=0; r!=fNRadialSteps; ++r)
     for(int p=0; p!=fNAzimuthalSteps; ++p)
       for(int z=0; z!=fNLongitudinalSteps; ++z) {
-	float intDR = 0, intRDPHI = 0;
-	// integrating over drift ditance
-	int minZ = 0;
-	int maxZ = z+1;
-	if( fEz->GetZaxis()->GetBinCenter(z+1)>0 ) {
-	  minZ=z;
-	  maxZ=fNLongitudinalSteps;
-	}
-	for(int zprime=minZ; zprime!=maxZ; ++zprime) {
-	  float dR, RdPHI;
-	  float dEz = fEz->GetBinContent( r+1, p+1, z+1 ) + kE0;
-	  dR = c0*fEr->GetBinContent( r+1, p+1, zprime+1 )/dEz;
-	  dR += c1*fEp->GetBinContent( r+1, p+1, zprime+1 )/dEz;
-	  RdPHI = -c1*fEr->GetBinContent( r+1, p+1, zprime+1 )/dEz;
-	  RdPHI += c0*fEp->GetBinContent( r+1, p+1, zprime+1 )/dEz;
-	  if(!TMath::AreEqualAbs( dR, 0, prec )) intDR += dR*dz;
-	  if(!TMath::AreEqualAbs( RdPHI, 0, prec )) intRDPHI += RdPHI*dz;
-	}
-	fDeltaR->SetBinContent( r+1, p+1, z+1, intDR );
-	fRDeltaPHI->SetBinContent( r+1, p+1, z+1, intRDPHI );
-	if(fDebug>2) printf("@{Ir,Ip,Iz}={%d,%d,%d}, deltaR=%f\n",r,p,z,intDR);
-	if(fDebug>2) printf("@{Ir,Ip,Iz}={%d,%d,%d}, RdeltaPHI=%f\n",r,p,z,intRDPHI);
+	int idx = (r*fNAzimuthalSteps+p)*fNLongitudinalSteps+z;
+	fDeltaR->SetBinContent( r+1, p+1, z+1, fMapDeltaR[idx] );
+	fRDeltaPHI->SetBinContent( r+1, p+1, z+1, fMapRDeltaPHI[idx] );
+	if(fDebug>2) printf("@{Ir,Ip,Iz}={%d,%d,%d}, deltaR=%f\n",r,p,z,fMapDeltaR[idx]);
+	if(fDebug>2) printf("@{Ir,Ip,Iz}={%d,%d,%d}, RdeltaPHI=%f\n",r,p,z,fMapRDeltaPHI[idx]);
       }
   if(fDebug>0) printf("[DONE]\n");
   //------------
@@ -92,6 +92,69 @@ void Langevin::Make() {
   SaveMaps();
 }
 //=====================
+void Langevin::FlattenFields() {
+  // one pass over the histograms, afterwards only contiguous columns are read
+  fFieldR.clear();
+  fFieldP.clear();
+  fFieldZ.clear();
+  if(fEr->GetNbinsX()!=fNRadialSteps ||
+     fEr->GetNbinsY()!=fNAzimuthalSteps ||
+     fEr->GetNbinsZ()!=fNLongitudinalSteps) return;
+  const int ntot = fNRadialSteps*fNAzimuthalSteps*fNLongitudinalSteps;
+  fFieldR.resize(ntot);
+  fFieldP.resize(ntot);
+  fFieldZ.resize(ntot);
+  for(int r=0; r!=fNRadialSteps; ++r)
+    for(int p=0; p!=fNAzimuthalSteps; ++p)
+      for(int z=0; z!=fNLongitudinalSteps; ++z) {
+	int idx = (r*fNAzimuthalSteps+p)*fNLongitudinalSteps+z;
+	fFieldR[idx] = fEr->GetBinContent( r+1, p+1, z+1 );
+	fFieldP[idx] = fEp->GetBinContent( r+1, p+1, z+1 );
+	fFieldZ[idx] = fEz->GetBinContent( r+1, p+1, z+1 );
+      }
+  fMapDeltaR.assign(ntot,0);
+  fMapRDeltaPHI.assign(ntot,0);
+}
+//=====================
+void Langevin::IntegrateColumns(int first, int last, float c0, float c1, float kE0) {
+  // For a starting point z the drift integral runs over [0,z] (z<0 half)
+  // or [z,nz) (z>0 half) and only Ez is taken at the starting point, so
+  // one running sum per column serves every starting point in it.
+  const int nz = fNLongitudinalSteps;
+  const float dz = fEz->GetZaxis()->GetBinWidth(1);
+  std::vector<int> positive(nz);
+  for(int z=0; z!=nz; ++z) positive[z] = fEz->GetZaxis()->GetBinCenter(z+1)>0;
+  std::vector<double> sumR(nz), sumP(nz);
+  for(int col=first; col!=last; ++col) {
+    const float *er = &fFieldR[col*nz];
+    const float *ep = &fFieldP[col*nz];
+    const float *ez = &fFieldZ[col*nz];
+    double accR = 0, accP = 0;
+    for(int z=0; z!=nz; ++z) { // from the negative end
+      if(positive[z]) break;
+      accR += er[z];
+      accP += ep[z];
+      sumR[z] = accR;
+      sumP[z] = accP;
+    }
+    accR = accP = 0;
+    for(int z=nz-1; z>=0; --z) { // from the positive end
+      if(!positive[z]) break;
+      accR += er[z];
+      accP += ep[z];
+      sumR[z] = accR;
+      sumP[z] = accP;
+    }
+    float *dR = &fMapDeltaR[col*nz];
+    float *RdPHI = &fMapRDeltaPHI[col*nz];
+    for(int z=0; z!=nz; ++z) {
+      double norm = dz/(ez[z] + kE0);
+      dR[z] = ( c0*sumR[z] + c1*sumP[z])*norm;
+      RdPHI[z] = (-c1*sumR[z] + c0*sumP[z])*norm;
+    }
+  }
+}
+//=====================
 void Langevin::ReadFile() {
   const char *inputfile = Form("%s_1.root",fFileNameRoot.data());
   if(fDebug>0) printf("Langevin is reading the input file %s... ",inputfile);
@@ -124,4 +187,23 @@ void Langevin::SaveMaps() {
   ofile->WriteObject(fRDeltaPHI,"mapRDeltaPHI");
   ofile->Close();
   if(fDebug>0) printf("[DONE]\n");
+
+  // same maps as plain floats, ready to be memory-mapped
+  const char *binaryfile = Form("%s_2.bin",fFileNameRoot.data());
+  if(fDebug>0) printf("Langevin saving binary distortion maps %s... ",binaryfile);
+  LangevinMapHeader header;
+  memcpy(header.magic,"SCDM",4);
+  header.version = 1;
+  header.nr = fNRadialSteps;
+  header.np = fNAzimuthalSteps;
+  header.nz = fNLongitudinalSteps;
+  header.innerRadius = fInnerRadius;
+  header.outterRadius = fOutterRadius;
+  header.halfLength = fHalfLength;
+  std::ofstream bfile(binaryfile, std::ios::binary);
+  bfile.write( (const char*) &header, sizeof(header) );
+  bfile.write( (const char*) fMapDeltaR.data(), fMapDeltaR.size()*sizeof(float) );
+  bfile.write( (const char*) fMapRDeltaPHI.data(), fMapRDeltaPHI.size()*sizeof(float) );
+  bfile.close();
+  if(fDebug>0) printf("[DONE]\n");
 }
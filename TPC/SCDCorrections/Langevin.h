@@ -8,6 +8,17 @@
 //===========================================================
 
 #include "TH3F.h"
+#include <vector>
+
+/// header of the binary distortion map written next to the ROOT file.
+/// It is followed by two float arrays, deltaR and RdeltaPHI [cm], each
+/// of nr*np*nz values with z running fastest: index = (ir*np+ip)*nz+iz.
+struct LangevinMapHeader {
+  char magic[4];  // "SCDM"
+  int version;
+  int nr, np, nz;
+  float innerRadius, outterRadius, halfLength; // [cm]
+};
 
 class Langevin {
  public:
@@ -19,11 +30,15 @@ class Langevin {
   void TPCDimensions(float irad, float orad, float hzet) {fInnerRadius=irad; fOutterRadius=orad; fHalfLength=hzet;}
   void TPCGridSize(int nr, int np, int nz) {fNRadialSteps=nr; fNAzimuthalSteps=np; fNLongitudinalSteps=nz;}
   void OutputFileName(std::string a) {fFileNameRoot=a;}
+  void SetNumberOfThreads(int n) {fNThreads=n>0?n:1;}
 
  protected:
   void InitMaps();
   void SaveMaps();
+  void FlattenFields();
+  void IntegrateColumns(int first, int last, float c0, float c1, float kE0);
   int fDebug;
+  int fNThreads;
 
   TH3F *fEr;
   TH3F *fEp;
@@ -38,6 +53,13 @@ class Langevin {
   int fNAzimuthalSteps;
   int fNLongitudinalSteps;
   std::string fFileNameRoot;
+
+  // fields and distortions as flat arrays, index (ir*np+ip)*nz+iz
+  std::vector<float> fFieldR;
+  std::vector<float> fFieldP;
+  std::vector<float> fFieldZ;
+  std::vector<float> fMapDeltaR;
+  std::vector<float> fMapRDeltaPHI;
 };
 
 #endif /* __Langevin_H__ */
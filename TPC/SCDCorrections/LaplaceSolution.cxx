@@ -300,14 +300,7 @@ double LaplaceSolution::Ez(double r, double phi, double z, double r1, double phi
 	  if (verbosity) cout << " " << term; 
 	  term *= Rmn(m,n,r)*Rmn(m,n,r1)/N2mn[m][n];
 	  if (verbosity) cout << " " << term; 
-	  if (z<z1)
-	    {
-	      term *=  cosh(Betamn[m][n]*z)*sinh(Betamn[m][n]*(L-z1))/sinh(Betamn[m][n]*L);
-	    }
-	  else
-	    {
-	      term *= -cosh(Betamn[m][n]*(L-z))*sinh(Betamn[m][n]*z1)/sinh(Betamn[m][n]*L);;
-	    }
+	  term *= EzLongitudinal(m,n,z,z1);
 	  if (verbosity) cout << " " << term; 
 	  G += term;
 	  if (verbosity) cout << " " << term << " " << G << endl;
@@ -348,23 +341,9 @@ double LaplaceSolution::Er(double r, double phi, double z, double r1, double phi
     {
       for (int n=0; n<NumberOfOrders; n++)
 	{
-	  double term = 1/(L*pi);
-
-	  term *= (2 - ((m==0)?1:0))*cos(m*(phi-phi1));
-
-	  double BetaN = (n+1)*pi/L;
-	  term *= sin(BetaN*z)*sin(BetaN*z1);
-
-	  if (r<r1)
-	    {
-	      term *= RPrime(m,n,a,r)*Rmn2(m,n,r1);
-	    }
-	  else
-	    {
-	      term *= Rmn1(m,n,r1)*RPrime(m,n,b,r);
-	    }
-
-	  term /= BesselI(m,BetaN*a)*BesselK(m,BetaN*b)-BesselI(m,BetaN*b)*BesselK(m,BetaN*a);
+	  double term = (2 - ((m==0)?1:0))*cos(m*(phi-phi1));
+	  term *= ErLongitudinal(n,z)*ErLongitudinal(n,z1);
+	  term *= ErRadial(m,n,r,r1);
 
 	  G += term;
 	}
@@ -375,6 +354,40 @@ double LaplaceSolution::Er(double r, double phi, double z, double r1, double phi
   return G;
 }
 
+double LaplaceSolution::ErRadial(int m, int n, double r, double r1)
+{
+  double term = 1/(L*pi);
+
+  double BetaN = (n+1)*pi/L;
+  if (r<r1)
+    {
+      term *= RPrime(m,n,a,r)*Rmn2(m,n,r1);
+    }
+  else
+    {
+      term *= Rmn1(m,n,r1)*RPrime(m,n,b,r);
+    }
+
+  term /= BesselI(m,BetaN*a)*BesselK(m,BetaN*b)-BesselI(m,BetaN*b)*BesselK(m,BetaN*a);
+
+  return term;
+}
+
+double LaplaceSolution::ErLongitudinal(int n, double z)
+{
+  double BetaN = (n+1)*pi/L;
+  return sin(BetaN*z);
+}
+
+double LaplaceSolution::EzLongitudinal(int m, int n, double z, double z1)
+{
+  if (z<z1)
+    {
+      return  cosh(Betamn[m][n]*z)*sinh(Betamn[m][n]*(L-z1))/sinh(Betamn[m][n]*L);
+    }
+  return -cosh(Betamn[m][n]*(L-z))*sinh(Betamn[m][n]*z1)/sinh(Betamn[m][n]*L);
+}
+
 double LaplaceSolution::Ephi(double r, double phi, double z, double r1, double phi1, double z1)
 {
   //  Check input arguments for sanity...
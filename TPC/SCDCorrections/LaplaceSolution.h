@@ -39,6 +39,16 @@ class LaplaceSolution
   double Er  (double r, double phi, double z, double r1, double phi1, double z1);
   double Ephi(double r, double phi, double z, double r1, double phi1, double z1);
 
+  //  The (m,n) terms of Er and Ez factorize into an azimuthal part,
+  //  (2-delta_m0) cos(m(phi-phi1)), and the pieces below.  They allow
+  //  tabulating the Green's functions once per grid.
+  //    Er(m,n) = ... ErLongitudinal(n,z) ErLongitudinal(n,z1) ErRadial(m,n,r,r1)
+  //    Ez(m,n) = ... Rmn(m,n,r) Rmn(m,n,r1) / (2 pi N2mn) EzLongitudinal(m,n,z,z1)
+  double ErRadial(int m, int n, double r, double r1);
+  double ErLongitudinal(int n, double z);
+  double EzLongitudinal(int m, int n, double z, double z1);
+  double GetN2mn(int m, int n) {return N2mn[m][n];}
+
  protected:
   bool fByFile;
   double a,b,L;  //  InnerRadius, OuterRadius, Length of 1/2 the TPC.
@@ -1,9 +1,10 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cstdlib>
 #include "Langevin.h"
 
-int main() {
+int main(int nvar, char ** cvar) {
   std::string kFileNameRoot="rho";
   float kInnerRadius = 30; //cm
   float kOutterRadius = 80; //cm
@@ -28,6 +29,7 @@ int main() {
   langevin->OutputFileName(kFileNameRoot);
   langevin->TPCDimensions( kInnerRadius, kOutterRadius, kHalfLength );
   langevin->TPCGridSize( kNRadialSteps, kNAzimuthalSteps, kNLongitudinalSteps );
+  if(nvar>1) langevin->SetNumberOfThreads( atoi(cvar[1]) );
   langevin->Make();
 
   delete langevin;
@@ -33,9 +33,20 @@ int main(int nvar, char ** cvar) {
     if(TMath::IsNaN(binR)) binR = -1;
   }
   std::cout << "routine for binR = " << binR << std::endl;
+  int nThreads = 0;
+  if(nvar>2) {
+    par = cvar[2];
+    nThreads = par.Atoi();
+  }
 
   FieldMaps *map;
-  map = new FieldMapsLaplace();
+  FieldMapsLaplace *laplace = new FieldMapsLaplace();
+  if(nThreads>0) {
+    std::cout << "using Green's function tables with " << nThreads << " threads" << std::endl;
+    laplace->UseGreenTables( nThreads );
+    laplace->LSFileName( kFileNameRoot+"_green.root" );
+  }
+  map = laplace;
   map->SetDebugLevel(1);
   map->OutputFileName(kFileNameRoot);
   map->TPCDimensions( kInnerRadius, kOutterRadius, kHalfLength );
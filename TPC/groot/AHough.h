@@ -0,0 +1,75 @@
+#ifndef __AHOUGH_H__
+#define __AHOUGH_H__
+
+//
+//  Hello AHough Fans:
+//
+//  AHough is the Hough transform engine for straight tracks in the
+//  pad plane.  Instead of making every PAIR of blobs (N^2 combinations),
+//  every blob votes once for each line that could pass through it.
+//  The lines are written in normal form:
+//
+//       rho = x cos(theta) + y sin(theta)
+//
+//  which stays well behaved for the nearly vertical beam tracks, where
+//  the (inverseSlope, intercept) form of FillHoughHist diverges.
+//  The accumulator is one flat array of nTheta x nRho cells with the
+//  cos/sin of every theta column tabulated once, so a vote is one
+//  multiply-add per column.  Cost per event is N x nTheta.
+//
+//  FindPeaks() returns the local maxima above a vote threshold, sorted
+//  by the number of votes, so that multi-track events come out as
+//  several peaks.  Peaks can be converted to the inverseSlope/intercept
+//  convention used everywhere else in groot.
+//
+
+#include <vector>
+
+class TH2;
+
+class AHough
+{
+public:
+  AHough(int nTheta, int nRho, double rhoMax);
+  virtual ~AHough() {}
+
+  struct Peak
+  {
+    double theta;
+    double rho;
+    int votes;
+    double InverseSlope() const; // dx/dy, as inverseSlope() in FillHoughHist
+    double Intercept() const;    // y at x=0, as intercept() in FillHoughHist
+  };
+
+  void Reset();
+  void Vote(double x, double y);
+  void Vote(const std::vector<double>& x, const std::vector<double>& y);
+  int  FindPeaks(int minVotes, int maxPeaks=10);
+
+  std::vector<Peak> thePeaks;
+
+  int    NTheta() const {return nTheta;}
+  int    NRho  () const {return nRho;}
+  double Theta(int i) const {return thetaMin + (i+0.5)*dTheta;}
+  double Rho  (int j) const {return -rhoMax + (j+0.5)*dRho;}
+  double DRho () const {return dRho;}
+  int    Votes(int i, int j) const {return cells[i*nRho + j];}
+
+  void FillHist(TH2* h) const; // copy of the accumulator for display
+
+protected:
+  int nTheta;
+  int nRho;
+  double thetaMin;
+  double dTheta;
+  double rhoMax;
+  double dRho;
+
+  std::vector<double> cosTheta;
+  std::vector<double> sinTheta;
+  std::vector<int>    cells;   // [iTheta*nRho + iRho]
+  std::vector<int>    column;  // rho bin of the current point, per theta
+};
+
+#endif /* __AHOUGH_H__ */
@@ -3,6 +3,8 @@
 
 void FillHoughHist();
 
+extern bool HoughTune; // fill the N^2 pair histograms HoughHistMC/ABS, off by default
+
 double inverseSlope(double x1, double y1, double x2, double y2);
 double intercept   (double x1, double y1, double x2, double y2);
 
@@ -12,4 +14,8 @@ double intercept   (double x1, double y1, double x2, double y2);
 #define MAD_Offset 426.528
 #define HFACTOR 5.0 // Number of MADs that go into a single hough cell, 5.0 is kinda like +/- 2 sigma.
 
+#define NHOUGHTHETA 180  // theta cells of the AHough accumulator (1 degree)
+#define NHOUGHRHO   256  // rho cells of the AHough accumulator
+#define HOUGHMINVOTES 4  // blobs needed on a line to call it a track candidate
+
 #endif /*__FILLHOUGHHIST_H__*/
@@ -7,6 +7,7 @@
 #pragma link C++ class AZigzag+;
 #pragma link C++ class ABlob;
 #pragma link C++ class ATrack+;
+#pragma link C++ class AHough;
 #pragma link C++ class groot+;
 #pragma link C++ class ATrace+;
 #pragma link C++ class Quiver+;
@@ -0,0 +1,21 @@
+#!/bin/sh
+
+source /cvmfs/sphenix.sdcc.bnl.gov/gcc-8.3/opt/sphenix/core/bin/sphenix_setup.sh -n 
+HOME_DIR="/sphenix/sim/sim01/sphnxpro/TrackingDailyBuild/$(date +"%Y")/$(date +"%d-%m")/MinBias3MHzStreamingppOutput"
+cd $HOME_DIR
+YESTERDAY_DIR="/sphenix/sim/sim01/sphnxpro/TrackingDailyBuild/$(date +"%"Y)/$(date -d 'yesterday 13:00' +'%d-%m')/MinBias3MHzStreamingppOutput"
+
+# per module timing written by the ModuleTimingRecorder, compared against the stored baseline
+# (yesterday's output if there is none) and REGRESSION lines copied to timingRegressions.txt
+TIMING_BASELINE=${TIMING_BASELINE:-/sphenix/sim/sim01/sphnxpro/TrackingDailyBuild/TimingBaseline/MinBias3MHzStreamingppDailyBuild_timing.root}
+if [ ! -f $TIMING_BASELINE ]; then
+  TIMING_BASELINE=$YESTERDAY_DIR/MinBias3MHzStreamingppDailyBuild_timing.root
+fi
+
+if ls MinBias3MHz_pythia8_Charm_dailybuild_*_timing.root > /dev/null 2>&1; then
+  hadd -k MinBias3MHzStreamingppDailyBuild_timing.root MinBias3MHz_pythia8_Charm_dailybuild_*_timing.root
+  root -b -q ~/git/analysis/Tracking/BenchmarkingTools/TimingTools/CompareModuleTiming.C\(\"$TIMING_BASELINE\",\"$HOME_DIR/MinBias3MHzStreamingppDailyBuild_timing.root\",\"$HOME_DIR/../ModuleTimingComparisons3MHz.root\"\) | tee $HOME_DIR/../ModuleTimingComparisons3MHz.txt
+  grep REGRESSION $HOME_DIR/../ModuleTimingComparisons3MHz.txt > $HOME_DIR/../timingRegressions3MHz.txt
+else
+  echo "No module timing files in $HOME_DIR, skipping the timing comparison"
+fi
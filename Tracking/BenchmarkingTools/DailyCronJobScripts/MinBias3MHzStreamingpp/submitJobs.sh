@@ -23,6 +23,16 @@ cd MinBias3MHzStreamingpp/Tracking/BenchmarkingTools/DailyCronJobScripts/MinBias
 
 mkdir logfiles
 
+# build the per module timing recorder, the jobs pick it up with setup_local.sh
+mkdir -p install moduletimer_build
+cd moduletimer_build
+../../../TimingTools/ModuleTimer/autogen.sh --prefix=$(pwd)/../install
+make -j4 install
+cd ..
+
 git clone -b QA-tracking-streamingpp https://github.com/sPHENIX-Collaboration/macros.git
 
+# register the modules of the macros through the ModuleTimingRecorder
+../../TimingTools/instrumentMacros.sh macros
+
 condor_submit Run3MHzMBStreamingpp.job
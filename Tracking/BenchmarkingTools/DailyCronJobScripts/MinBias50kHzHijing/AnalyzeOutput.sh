@@ -4,11 +4,25 @@ source /cvmfs/sphenix.sdcc.bnl.gov/gcc-8.3/opt/sphenix/core/bin/sphenix_setup.sh
 HOME_DIR="/sphenix/sim/sim01/sphnxpro/TrackingDailyBuild/$(date +"%Y")/$(date +"%d-%m")/MinBias50kHzHijingOutput"
 cd $HOME_DIR
 YESTERDAY_DIR="/sphenix/sim/sim01/sphnxpro/TrackingDailyBuild/$(date +"%"Y)/$(date -d 'yesterday 13:00' +'%d-%m')/MinBias50kHzHijingOutput"
-# creates time.txt file with aggregated timing information
-~/git/analysis/Tracking/BenchmarkingTools/TimingTools/parseTimers.sh $HOME_DIR $HOME_DIR
-
-#creates timingoutfile.root containing histogramed timing information
-root ~/git/analysis/Tracking/BenchmarkingTools/TimingTools/AnalyzeTime.C\(\"$HOME_DIR/time.txt\",\"$HOME_DIR/../timingoutfile.root\"\)
+# per module timing written by the ModuleTimingRecorder, compared against the stored baseline
+# (yesterday's output if there is none) and REGRESSION lines copied to timingRegressions.txt
+TIMING_BASELINE=${TIMING_BASELINE:-/sphenix/sim/sim01/sphnxpro/TrackingDailyBuild/TimingBaseline/MinBias50kHzHijingDailyBuild_timing.root}
+if [ ! -f $TIMING_BASELINE ]; then
+  TIMING_BASELINE=$YESTERDAY_DIR/MinBias50kHzHijingDailyBuild_timing.root
+fi
+
+if ls MinBias50kHzHijing_dailybuild_*_timing.root > /dev/null 2>&1; then
+  hadd -k MinBias50kHzHijingDailyBuild_timing.root MinBias50kHzHijing_dailybuild_*_timing.root
+  root -b -q ~/git/analysis/Tracking/BenchmarkingTools/TimingTools/CompareModuleTiming.C\(\"$TIMING_BASELINE\",\"$HOME_DIR/MinBias50kHzHijingDailyBuild_timing.root\",\"$HOME_DIR/../ModuleTimingComparisons.root\"\) | tee $HOME_DIR/../ModuleTimingComparisons.txt
+  grep REGRESSION $HOME_DIR/../ModuleTimingComparisons.txt > $HOME_DIR/../timingRegressions.txt
+else
+  # logs of macros that do not register the recorder yet
+  # creates time.txt file with aggregated timing information
+  ~/git/analysis/Tracking/BenchmarkingTools/TimingTools/parseTimers.sh $HOME_DIR $HOME_DIR
+
+  #creates timingoutfile.root containing histogramed timing information
+  root ~/git/analysis/Tracking/BenchmarkingTools/TimingTools/AnalyzeTime.C\(\"$HOME_DIR/time.txt\",\"$HOME_DIR/../timingoutfile.root\"\)
+fi
 
 #Aggregate job file output
 cd $HOME_DIR
@@ -2,6 +2,8 @@
 
 #setup default new environment for job
 source /cvmfs/sphenix.sdcc.bnl.gov/gcc-8.3/opt/sphenix/core/bin/sphenix_setup.sh -n
+# libModuleTimer built by submitJobs.sh
+source /cvmfs/sphenix.sdcc.bnl.gov/gcc-8.3/opt/sphenix/core/bin/setup_local.sh $(pwd)/install
 
 
 # input parameters
@@ -36,6 +38,9 @@ cd macros/detectors/sPHENIX
 echo "pwd is: "
 pwd
 
+# per module timing of the instrumented macros (instrumentMacros.sh), moved with the other output
+export MODULE_TIMING_FILE=${strout}timing.root
+
 root -b -q  'Fun4All_G4_sPHENIX.C('$nevents', '$runno', "'$strembed0'" ,  "'$strembed1'", "'$strembed2'", "'$strout'" )'
 
 mv $strout*.root ../../../../../../../../MinBias50kHzHijingOutput/
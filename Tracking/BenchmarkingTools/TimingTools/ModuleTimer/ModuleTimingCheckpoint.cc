@@ -0,0 +1,20 @@
+#include "ModuleTimingCheckpoint.h"
+
+#include "ModuleTimingRecorder.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+//____________________________________________________________________________..
+ModuleTimingCheckpoint::ModuleTimingCheckpoint(ModuleTimingRecorder *recorder, int index, const std::string &name)
+  : SubsysReco(name)
+  , m_recorder(recorder)
+  , m_index(index)
+{
+}
+
+//____________________________________________________________________________..
+int ModuleTimingCheckpoint::process_event(PHCompositeNode * /*topNode*/)
+{
+  m_recorder->checkpoint(m_index);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
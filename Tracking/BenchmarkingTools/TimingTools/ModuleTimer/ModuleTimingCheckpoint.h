@@ -0,0 +1,28 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef MODULETIMINGCHECKPOINT_H
+#define MODULETIMINGCHECKPOINT_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class PHCompositeNode;
+class ModuleTimingRecorder;
+
+//! Registered in front of a timed module by ModuleTimingRecorder::registerSubsystem
+class ModuleTimingCheckpoint : public SubsysReco
+{
+ public:
+  ModuleTimingCheckpoint(ModuleTimingRecorder *recorder, int index, const std::string &name);
+
+  ~ModuleTimingCheckpoint() override {}
+
+  int process_event(PHCompositeNode *topNode) override;
+
+ private:
+  ModuleTimingRecorder *m_recorder = nullptr;
+  int m_index = -1;
+};
+
+#endif  // MODULETIMINGCHECKPOINT_H
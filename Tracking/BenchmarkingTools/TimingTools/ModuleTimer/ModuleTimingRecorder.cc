@@ -0,0 +1,294 @@
+#include "ModuleTimingRecorder.h"
+
+#include "ModuleTimingCheckpoint.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+  //! branch names may only contain letters, digits and underscores
+  std::string branchName(const std::string &moduleName)
+  {
+    std::string name = moduleName;
+    for (char &c : name)
+    {
+      if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+    }
+    return name;
+  }
+
+  float percentile(const std::vector<float> &sorted, double q)
+  {
+    if (sorted.empty()) return 0;
+    return sorted[static_cast<size_t>(q * (sorted.size() - 1) + 0.5)];
+  }
+}  // namespace
+
+//____________________________________________________________________________..
+ModuleTimingRecorder::ModuleTimingRecorder(const std::string &outfilename, const std::string &name)
+  : SubsysReco(name)
+  , m_outfilename(outfilename)
+{
+  //statm is read at every checkpoint, keep it open and pread it instead of parsing /proc/self/status
+  m_statmFd = open("/proc/self/statm", O_RDONLY);
+  m_pageKB = sysconf(_SC_PAGESIZE) / 1024;
+}
+
+//____________________________________________________________________________..
+ModuleTimingRecorder::~ModuleTimingRecorder()
+{
+  if (m_statmFd >= 0) ::close(m_statmFd);
+}
+
+//____________________________________________________________________________..
+void ModuleTimingRecorder::registerSubsystem(SubsysReco *module, const std::string &topnodename)
+{
+  std::string name = branchName(module->Name());
+  const std::set<std::string> taken(m_moduleNames.begin(), m_moduleNames.end());
+  for (int copy = 2; taken.count(name); ++copy)
+  {
+    name = branchName(module->Name()) + "_" + std::to_string(copy);
+  }
+
+  const int index = m_moduleNames.size();
+  m_moduleNames.push_back(name);
+
+  Fun4AllServer *se = Fun4AllServer::instance();
+  se->registerSubsystem(new ModuleTimingCheckpoint(this, index, "ModuleTimingCheckpoint_" + name), topnodename);
+  se->registerSubsystem(module, topnodename);
+}
+
+//____________________________________________________________________________..
+void ModuleTimingRecorder::registerTimed(SubsysReco *module, const std::string &topnodename)
+{
+  //owned by Fun4AllServer once registered, one recorder per job
+  static ModuleTimingRecorder *recorder = nullptr;
+  if (!recorder)
+  {
+    const char *outfilename = std::getenv("MODULE_TIMING_FILE");
+    recorder = new ModuleTimingRecorder(outfilename ? outfilename : "ModuleTiming.root");
+    Fun4AllServer::instance()->registerSubsystem(recorder);
+  }
+  recorder->registerSubsystem(module, topnodename);
+}
+
+//____________________________________________________________________________..
+int ModuleTimingRecorder::Init(PHCompositeNode * /*topNode*/)
+{
+  //the recorder is registered before the timed modules, keep their histograms out of our file
+  TDirectory::TContext context;
+  m_outfile = new TFile(m_outfilename.c_str(), "RECREATE");
+  if (!m_outfile || m_outfile->IsZombie())
+  {
+    std::cout << "ModuleTimingRecorder::Init - could not open " << m_outfilename << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  if (m_statmFd < 0)
+  {
+    std::cout << "ModuleTimingRecorder::Init - /proc/self/statm not readable, rss will be 0" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+void ModuleTimingRecorder::createTree()
+{
+  //the module list is fixed once events are processed, the vectors must not move after this
+  const size_t nModules = m_moduleNames.size();
+  m_wall.assign(nModules, -1);
+  m_cpu.assign(nModules, -1);
+  m_rss.assign(nModules, 0);
+  m_wallHistory.assign(nModules, std::vector<float>());
+  m_cpuSum.assign(nModules, 0);
+  m_rssSum.assign(nModules, 0);
+
+  TDirectory::TContext context(m_outfile);
+  m_tree = new TTree("ModuleTiming", "per event module timing");
+  m_tree->Branch("event", &m_event, "event/I");
+  for (size_t i = 0; i < nModules; ++i)
+  {
+    const std::string &name = m_moduleNames[i];
+    m_tree->Branch((name + "_wall").c_str(), &m_wall[i], (name + "_wall/F").c_str());
+    m_tree->Branch((name + "_cpu").c_str(), &m_cpu[i], (name + "_cpu/F").c_str());
+    m_tree->Branch((name + "_rss").c_str(), &m_rss[i], (name + "_rss/F").c_str());
+  }
+}
+
+//____________________________________________________________________________..
+int ModuleTimingRecorder::process_event(PHCompositeNode * /*topNode*/)
+{
+  if (!m_tree) createTree();
+
+  //ResetEvent did not run for the previous event
+  if (m_eventOpen) fillEvent();
+
+  std::fill(m_wall.begin(), m_wall.end(), -1);
+  std::fill(m_cpu.begin(), m_cpu.end(), -1);
+  std::fill(m_rss.begin(), m_rss.end(), 0);
+  m_open = -1;
+  m_eventOpen = true;
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+ModuleTimingRecorder::Reading ModuleTimingRecorder::read() const
+{
+  Reading now;
+
+  now.wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  timespec cpu;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu) == 0)
+  {
+    now.cpu = cpu.tv_sec * 1e3 + cpu.tv_nsec * 1e-6;
+  }
+
+  if (m_statmFd >= 0)
+  {
+    char buffer[128];
+    const ssize_t n = pread(m_statmFd, buffer, sizeof(buffer) - 1, 0);
+    if (n > 0)
+    {
+      buffer[n] = '\0';
+      long size = 0;
+      long resident = 0;
+      if (sscanf(buffer, "%ld %ld", &size, &resident) == 2) now.rss = resident * m_pageKB;
+    }
+  }
+
+  return now;
+}
+
+//____________________________________________________________________________..
+void ModuleTimingRecorder::close(const Reading &now)
+{
+  if (m_open < 0) return;
+  m_wall[m_open] = now.wall - m_openReading.wall;
+  m_cpu[m_open] = now.cpu - m_openReading.cpu;
+  m_rss[m_open] = now.rss - m_openReading.rss;
+  m_open = -1;
+}
+
+//____________________________________________________________________________..
+void ModuleTimingRecorder::checkpoint(int index)
+{
+  if (!m_eventOpen) return;
+
+  const Reading now = read();
+  close(now);
+  m_open = index;
+  m_openReading = now;
+}
+
+//____________________________________________________________________________..
+int ModuleTimingRecorder::ResetEvent(PHCompositeNode * /*topNode*/)
+{
+  if (m_eventOpen)
+  {
+    close(read());
+    fillEvent();
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+void ModuleTimingRecorder::fillEvent()
+{
+  m_tree->Fill();
+  for (size_t i = 0; i < m_moduleNames.size(); ++i)
+  {
+    if (m_wall[i] < 0) continue;
+    m_wallHistory[i].push_back(m_wall[i]);
+    m_cpuSum[i] += m_cpu[i];
+    m_rssSum[i] += m_rss[i];
+  }
+  ++m_event;
+  m_eventOpen = false;
+}
+
+//____________________________________________________________________________..
+int ModuleTimingRecorder::End(PHCompositeNode * /*topNode*/)
+{
+  if (m_eventOpen)
+  {
+    close(read());
+    fillEvent();
+  }
+
+  Print();
+
+  if (m_outfile)
+  {
+    TDirectory::TContext context(m_outfile);
+    if (m_tree) m_tree->Write();
+    m_outfile->Close();
+    delete m_outfile;
+    m_outfile = nullptr;
+    m_tree = nullptr;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+void ModuleTimingRecorder::Print(const std::string & /*what*/) const
+{
+  double total = 0;
+  std::vector<double> wallSum(m_wallHistory.size(), 0);
+  for (size_t i = 0; i < m_wallHistory.size(); ++i)
+  {
+    for (float wall : m_wallHistory[i]) wallSum[i] += wall;
+    total += wallSum[i];
+  }
+
+  std::cout << "ModuleTimingRecorder - " << m_event << " events, wall and cpu time in ms, rss change in kB" << std::endl;
+  std::cout << std::left << std::setw(40) << "module" << std::right
+            << std::setw(8) << "calls"
+            << std::setw(10) << "mean"
+            << std::setw(10) << "p50"
+            << std::setw(10) << "p90"
+            << std::setw(10) << "p99"
+            << std::setw(10) << "cpu"
+            << std::setw(10) << "rss"
+            << std::setw(8) << "share" << std::endl;
+
+  //flat flame: one bar per module in the order the modules run, length is the share of the total
+  static const int barLength = 40;
+  for (size_t i = 0; i < m_wallHistory.size(); ++i)
+  {
+    std::vector<float> sorted = m_wallHistory[i];
+    std::sort(sorted.begin(), sorted.end());
+    const size_t n = sorted.size();
+    const double share = total > 0 ? wallSum[i] / total : 0;
+
+    std::cout << std::left << std::setw(40) << m_moduleNames[i] << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << n
+              << std::setw(10) << (n ? wallSum[i] / n : 0)
+              << std::setw(10) << percentile(sorted, 0.50)
+              << std::setw(10) << percentile(sorted, 0.90)
+              << std::setw(10) << percentile(sorted, 0.99)
+              << std::setw(10) << (n ? m_cpuSum[i] / n : 0)
+              << std::setw(10) << std::setprecision(0) << (n ? m_rssSum[i] / n : 0)
+              << std::setw(7) << std::setprecision(1) << 100 * share << "% "
+              << std::string(static_cast<int>(share * barLength + 0.5), '#') << std::endl;
+  }
+  std::cout.unsetf(std::ios::floatfield);
+}
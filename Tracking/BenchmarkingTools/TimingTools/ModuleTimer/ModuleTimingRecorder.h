@@ -0,0 +1,102 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef MODULETIMINGRECORDER_H
+#define MODULETIMINGRECORDER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class TFile;
+class TTree;
+
+/*
+ * Per event, per module wall time, cpu time and resident memory change
+ *
+ * Register the recorder before the modules to time and register those
+ * modules through the recorder instead of Fun4AllServer:
+ *
+ *   ModuleTimingRecorder *timing = new ModuleTimingRecorder("timing.root");
+ *   se->registerSubsystem(timing);
+ *   timing->registerSubsystem(new MvtxClusterizer);
+ *   timing->registerSubsystem(new PHCASeeding);
+ *
+ * Every timed module is preceded by a ModuleTimingCheckpoint, a reading
+ * at a checkpoint closes the interval of the module before it. Modules
+ * registered directly with Fun4AllServer in between are counted in the
+ * preceding timed module. The last interval is closed in ResetEvent, so
+ * an aborted event charges the aborting module and nothing after it.
+ *
+ * The tree ModuleTiming has one entry per event with the branches
+ * <module>_wall and <module>_cpu in ms and <module>_rss in kB, so that
+ * the files of several jobs can be hadd-ed. End() prints the mean and
+ * percentiles per module and each module's share of the total.
+ */
+class ModuleTimingRecorder : public SubsysReco
+{
+ public:
+  ModuleTimingRecorder(const std::string &outfilename = "ModuleTiming.root",
+                       const std::string &name = "ModuleTimingRecorder");
+
+  ~ModuleTimingRecorder() override;
+
+  int Init(PHCompositeNode *topNode) override;
+  int process_event(PHCompositeNode *topNode) override;
+  int ResetEvent(PHCompositeNode *topNode) override;
+  int End(PHCompositeNode *topNode) override;
+
+  //! register the module with Fun4AllServer, preceded by its checkpoint
+  void registerSubsystem(SubsysReco *module, const std::string &topnodename = "TOP");
+
+  //! register the module through the recorder of this job, which is created
+  //! and registered with Fun4AllServer on the first call and writes to
+  //! $MODULE_TIMING_FILE (default ModuleTiming.root). Macros that register
+  //! with se->registerSubsystem are switched to this by instrumentMacros.sh
+  static void registerTimed(SubsysReco *module, const std::string &topnodename = "TOP");
+
+  //! called by the checkpoint of module index, closes the open interval
+  void checkpoint(int index);
+
+  void Print(const std::string &what = "ALL") const override;
+
+ private:
+  struct Reading
+  {
+    double wall = 0;  // ms
+    double cpu = 0;   // ms
+    long rss = 0;     // kB
+  };
+
+  Reading read() const;
+  void close(const Reading &now);
+  void fillEvent();
+  void createTree();
+
+  std::string m_outfilename;
+  TFile *m_outfile = nullptr;
+  TTree *m_tree = nullptr;
+
+  std::vector<std::string> m_moduleNames;
+
+  //! this event, tree branch addresses
+  int m_event = 0;
+  std::vector<float> m_wall;
+  std::vector<float> m_cpu;
+  std::vector<float> m_rss;
+
+  //! all events, for the summary
+  std::vector<std::vector<float>> m_wallHistory;
+  std::vector<double> m_cpuSum;
+  std::vector<double> m_rssSum;
+
+  int m_open = -1;
+  Reading m_openReading;
+  bool m_eventOpen = false;
+
+  int m_statmFd = -1;
+  long m_pageKB = 4;
+};
+
+#endif  // MODULETIMINGRECORDER_H
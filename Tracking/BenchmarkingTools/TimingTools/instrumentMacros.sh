@@ -0,0 +1,29 @@
+#!/bin/sh
+
+# This script switches a checkout of the sPHENIX macros to per module timing with the ModuleTimingRecorder
+# Every se->registerSubsystem( in the Fun4All macro and the common macros it includes is replaced by
+# ModuleTimingRecorder::registerTimed(, which registers the module behind a timing checkpoint. The recorder
+# writes the file given by $MODULE_TIMING_FILE, so the job script has to export it, e.g.
+# export MODULE_TIMING_FILE=${outfile}timing.root
+# libModuleTimer has to be installed and in the environment (setup_local.sh)
+# The script takes one argument:
+# $1 the macros checkout (e.g. macros, containing common/ and detectors/sPHENIX/)
+
+if [ ! -d "$1/common" ] || [ ! -d "$1/detectors/sPHENIX" ]; then
+  echo "instrumentMacros.sh: $1 is not a macros checkout"
+  exit 1
+fi
+
+ninstrumented=0
+for macro in $1/common/*.C $1/detectors/sPHENIX/*.C; do
+  if grep -q 'se->registerSubsystem(' $macro; then
+    sed -i -e 's/se->registerSubsystem(/ModuleTimingRecorder::registerTimed(/g' \
+        -e '1i #include <moduletimer/ModuleTimingRecorder.h>\nR__LOAD_LIBRARY(libModuleTimer.so)' $macro
+    ninstrumented=$((ninstrumented + 1))
+  fi
+done
+
+echo "instrumentMacros.sh: $ninstrumented macros register their modules through the ModuleTimingRecorder"
+if [ $ninstrumented -eq 0 ]; then
+  exit 1
+fi
@@ -0,0 +1,142 @@
+#include "TruthAncestryIndex.h"
+
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+#include <phhepmc/PHHepMCGenEvent.h>
+#include <phhepmc/PHHepMCGenEventMap.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#include <HepMC/GenEvent.h>
+#include <HepMC/GenParticle.h>
+#include <HepMC/GenVertex.h>
+#pragma GCC diagnostic pop
+
+const std::vector<HepMC::GenParticle *> TruthAncestryIndex::s_noParents;
+
+//____________________________________________________________________________..
+void TruthAncestryIndex::Reset()
+{
+  m_built = false;
+  m_truthInfo = nullptr;
+  m_hepmcParticle.clear();
+  m_g4Primary.clear();
+  m_hepmcParents.clear();
+  m_topPrimary.clear();
+}
+
+//____________________________________________________________________________..
+void TruthAncestryIndex::Build(PHHepMCGenEventMap *genEventMap, PHG4TruthInfoContainer *truthInfo)
+{
+  Reset();
+  m_truthInfo = truthInfo;
+
+  if (genEventMap)
+  {
+    for (PHHepMCGenEventMap::ConstIter iter = genEventMap->begin(); iter != genEventMap->end(); ++iter)
+    {
+      const int embeddingId = iter->first;
+      HepMC::GenEvent *theEvent = iter->second ? iter->second->getEvent() : nullptr;
+      if (!theEvent) continue;
+
+      m_hepmcParticle.reserve(m_hepmcParticle.size() + theEvent->particles_size());
+      for (HepMC::GenEvent::particle_const_iterator p = theEvent->particles_begin(); p != theEvent->particles_end(); ++p)
+      {
+        m_hepmcParticle[Key(embeddingId, (*p)->barcode())] = *p;
+      }
+    }
+  }
+
+  if (truthInfo)
+  {
+    PHG4TruthInfoContainer::Range range = truthInfo->GetPrimaryParticleRange();
+    for (PHG4TruthInfoContainer::ConstIterator iter = range.first; iter != range.second; ++iter)
+    {
+      PHG4Particle *particle = iter->second;
+      m_g4Primary[Key(truthInfo->isEmbeded(particle->get_track_id()), particle->get_barcode())] = particle;
+    }
+  }
+
+  m_built = true;
+}
+
+//____________________________________________________________________________..
+HepMC::GenParticle *TruthAncestryIndex::GetHepMCParticle(int embeddingId, int barcode) const
+{
+  auto iter = m_hepmcParticle.find(Key(embeddingId, barcode));
+  return iter == m_hepmcParticle.end() ? nullptr : iter->second;
+}
+
+//____________________________________________________________________________..
+HepMC::GenParticle *TruthAncestryIndex::GetHepMCParticle(PHG4Particle *particle) const
+{
+  if (!particle) return nullptr;
+  return GetHepMCParticle(GetEmbeddingId(particle), particle->get_barcode());
+}
+
+//____________________________________________________________________________..
+PHG4Particle *TruthAncestryIndex::GetG4Particle(int embeddingId, int barcode) const
+{
+  auto iter = m_g4Primary.find(Key(embeddingId, barcode));
+  return iter == m_g4Primary.end() ? nullptr : iter->second;
+}
+
+//____________________________________________________________________________..
+const std::vector<HepMC::GenParticle *> &TruthAncestryIndex::GetHepMCParents(int embeddingId, int barcode) const
+{
+  const Key key(embeddingId, barcode);
+  auto cached = m_hepmcParents.find(key);
+  if (cached != m_hepmcParents.end()) return cached->second;
+
+  HepMC::GenParticle *particle = GetHepMCParticle(embeddingId, barcode);
+  if (!particle) return s_noParents;
+
+  std::vector<HepMC::GenParticle *> &parents = m_hepmcParents[key];
+  HepMC::GenVertex *vertex = particle->production_vertex();
+  if (vertex)
+  {
+    for (HepMC::GenVertex::particle_iterator mother = vertex->particles_begin(HepMC::parents);
+         mother != vertex->particles_end(HepMC::parents); ++mother)
+    {
+      parents.push_back(*mother);
+    }
+  }
+  return parents;
+}
+
+//____________________________________________________________________________..
+PHG4Particle *TruthAncestryIndex::GetG4Primary(PHG4Particle *particle) const
+{
+  if (!particle || !m_truthInfo) return particle;
+
+  auto cached = m_topPrimary.find(particle->get_track_id());
+  if (cached != m_topPrimary.end()) return cached->second;
+
+  //the top is the first particle without a parent, every step on the way is cached
+  std::vector<int> chain;
+  PHG4Particle *top = particle;
+  while (top->get_parent_id() != 0)
+  {
+    chain.push_back(top->get_track_id());
+    auto known = m_topPrimary.find(top->get_parent_id());
+    if (known != m_topPrimary.end())
+    {
+      top = known->second;
+      break;
+    }
+    PHG4Particle *parent = m_truthInfo->GetParticle(top->get_parent_id());
+    if (!parent) break;
+    top = parent;
+  }
+  if (chain.empty()) chain.push_back(particle->get_track_id());
+
+  for (int trackId : chain) m_topPrimary[trackId] = top;
+  return top;
+}
+
+//____________________________________________________________________________..
+int TruthAncestryIndex::GetEmbeddingId(PHG4Particle *particle) const
+{
+  if (!particle || !m_truthInfo) return 0;
+  return m_truthInfo->isEmbeded(particle->get_track_id());
+}
@@ -0,0 +1,98 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef TRUTHANCESTRYINDEX_H
+#define TRUTHANCESTRYINDEX_H
+
+/*
+ * Per event lookup tables for truth ancestry
+ *
+ * Matching a G4 particle to its generator record used to mean a loop over
+ * every particle of the HepMC::GenEvent per cluster or per truth particle.
+ * The index is built once per event from the PHHepMCGenEventMap and the
+ * PHG4TruthInfoContainer and answers in O(1):
+ *  - (embedding id, barcode) -> HepMC::GenParticle
+ *  - (embedding id, barcode) -> PHG4Particle primary
+ *  - HepMC parents at the production vertex, cached on first use
+ *  - G4 primary at the top of a G4 parent chain, cached on first use
+ *
+ * TruthAncestryIndexBuilder puts one index on the node tree for all
+ * modules that run after it.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class PHG4Particle;
+class PHG4TruthInfoContainer;
+class PHHepMCGenEventMap;
+
+namespace HepMC
+{
+  class GenParticle;
+}
+
+class TruthAncestryIndex
+{
+ public:
+  TruthAncestryIndex() {}
+
+  virtual ~TruthAncestryIndex() {}
+
+  //! index the particles of all HepMC events and the G4 primaries, either input may be null
+  void Build(PHHepMCGenEventMap *genEventMap, PHG4TruthInfoContainer *truthInfo);
+
+  void Reset();
+
+  //! HepMC particle with this barcode in the HepMC event of this embedding id, null if absent
+  HepMC::GenParticle *GetHepMCParticle(int embeddingId, int barcode) const;
+
+  //! HepMC particle of a G4 primary, looked up in the HepMC event it was embedded from
+  HepMC::GenParticle *GetHepMCParticle(PHG4Particle *particle) const;
+
+  //! G4 primary made from the HepMC particle with this barcode, null if absent
+  PHG4Particle *GetG4Particle(int embeddingId, int barcode) const;
+
+  //! parents at the production vertex of the HepMC particle, empty if it has none
+  const std::vector<HepMC::GenParticle *> &GetHepMCParents(int embeddingId, int barcode) const;
+
+  //! G4 primary at the top of the parent chain of a G4 particle
+  PHG4Particle *GetG4Primary(PHG4Particle *particle) const;
+
+  //! embedding id of the G4 particle, as PHG4TruthInfoContainer::isEmbeded
+  int GetEmbeddingId(PHG4Particle *particle) const;
+
+  bool IsBuilt() const { return m_built; }
+
+ private:
+  //! (embedding id, barcode)
+  typedef std::pair<int, int> Key;
+
+  struct KeyHash
+  {
+    size_t operator()(const Key &key) const
+    {
+      return std::hash<long long>()((static_cast<long long>(key.first) << 32) ^ static_cast<unsigned int>(key.second));
+    }
+  };
+
+  bool m_built = false;
+
+  PHG4TruthInfoContainer *m_truthInfo = nullptr;
+
+  std::unordered_map<Key, HepMC::GenParticle *, KeyHash> m_hepmcParticle;
+
+  std::unordered_map<Key, PHG4Particle *, KeyHash> m_g4Primary;
+
+  //! filled on first query, queries are frequent for the same few mothers
+  mutable std::unordered_map<Key, std::vector<HepMC::GenParticle *>, KeyHash> m_hepmcParents;
+
+  //! G4 track id -> top primary, filled on first query
+  mutable std::unordered_map<int, PHG4Particle *> m_topPrimary;
+
+  static const std::vector<HepMC::GenParticle *> s_noParents;
+};
+
+#endif  // TRUTHANCESTRYINDEX_H
@@ -0,0 +1,52 @@
+#include "TruthAncestryIndexBuilder.h"
+
+#include "TruthAncestryIndex.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+#include <phhepmc/PHHepMCGenEventMap.h>
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <iostream>
+
+//____________________________________________________________________________..
+TruthAncestryIndexBuilder::TruthAncestryIndexBuilder(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+//____________________________________________________________________________..
+int TruthAncestryIndexBuilder::InitRun(PHCompositeNode *topNode)
+{
+  PHNodeIterator iter(topNode);
+  PHDataNode<TruthAncestryIndex> *indexNode =
+      dynamic_cast<PHDataNode<TruthAncestryIndex> *>(iter.findFirst("PHDataNode", m_nodeName));
+  if (!indexNode)
+  {
+    indexNode = new PHDataNode<TruthAncestryIndex>(new TruthAncestryIndex(), m_nodeName);
+    topNode->addNode(indexNode);
+  }
+  m_index = indexNode->getData();
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int TruthAncestryIndexBuilder::process_event(PHCompositeNode *topNode)
+{
+  PHHepMCGenEventMap *genEventMap = findNode::getClass<PHHepMCGenEventMap>(topNode, "PHHepMCGenEventMap");
+  PHG4TruthInfoContainer *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+  if (!genEventMap && !truthinfo)
+  {
+    std::cout << PHWHERE << "TruthAncestryIndexBuilder::process_event Could not find PHHepMCGenEventMap or G4TruthInfo" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  m_index->Build(genEventMap, truthinfo);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,36 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef TRUTHANCESTRYINDEXBUILDER_H
+#define TRUTHANCESTRYINDEXBUILDER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class PHCompositeNode;
+class TruthAncestryIndex;
+
+//! Rebuilds the TruthAncestryIndex node once per event,
+//! register it before the analysis modules that query the index
+class TruthAncestryIndexBuilder : public SubsysReco
+{
+ public:
+  TruthAncestryIndexBuilder(const std::string &name = "TruthAncestryIndexBuilder");
+
+  ~TruthAncestryIndexBuilder() override {}
+
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  //! name of the index node, default TruthAncestryIndex
+  void setNodeName(const std::string &nodeName) { m_nodeName = nodeName; }
+
+ private:
+  std::string m_nodeName = "TruthAncestryIndex";
+
+  //! owned by the node tree
+  TruthAncestryIndex *m_index = nullptr;
+};
+
+#endif  // TRUTHANCESTRYINDEXBUILDER_H
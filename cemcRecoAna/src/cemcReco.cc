@@ -45,6 +45,7 @@
 #include </gpfs/mnt/gpfs02/sphenix/user/ahodges/macros_git/coresoftware/generators/phhepmc/PHHepMCGenEvent.h>
 #include </gpfs/mnt/gpfs02/sphenix/user/ahodges/macros_git/coresoftware/generators/phhepmc/PHHepMCGenEventMap.h>
 #include <g4main/PHG4VtxPoint.h>
+#include <truthancestry/TruthAncestryIndex.h>
 //#include <phhepmc/PHHepMCParticleSelectorDecayProductChain.h>
 #include <HepMC/GenEvent.h>
 #include <HepMC/GenParticle.h>
@@ -361,7 +362,14 @@ int cemcReco::process_event(PHCompositeNode *topNode)
       return Fun4AllReturnCodes::ABORTEVENT;
     }
    
-  HepMC::GenEvent *theEvent = genEvent -> getEvent();
+  //barcode lookups into the HepMC event, shared with the other modules if the index is on the node tree
+  TruthAncestryIndex *ancestry = findNode::getClass<TruthAncestryIndex>(topNode, "TruthAncestryIndex");
+  if(!ancestry)
+    {
+      ancestry = &localAncestry;
+      ancestry -> Build(genEventMap, truthinfo);
+    }
+  const int genEmbedId = genEvent -> get_embedding_id();
 
   CaloEvalStack caloevalstack(topNode, "CEMC");
   CaloRawClusterEval *clustereval = caloevalstack.get_rawcluster_eval();
@@ -412,38 +420,29 @@ int cemcReco::process_event(PHCompositeNode *topNode)
 	    }
 	  if(maxPrimary -> get_pid() == 22)
 	    {
-	      for(HepMC::GenEvent::particle_const_iterator p = theEvent -> particles_begin(); p != theEvent -> particles_end(); ++p)
+	      const std::vector<HepMC::GenParticle*> &mothers = ancestry -> GetHepMCParents(genEmbedId, maxPrimary -> get_barcode());
+	      for(HepMC::GenParticle *mother : mothers)
 		{
-		  assert(*p);
-	   
-		  if((*p) -> barcode() == maxPrimary -> get_barcode())
+		  HepMC::FourVector moMomentum = mother -> momentum();
+		  float e = moMomentum.e();
+		  //float eta = moMomentum.pseudoRapidity();
+		  if(mother -> pdg_id() == 22)
 		    {
-		      for(HepMC::GenVertex::particle_iterator mother = (*p)->production_vertex()->particles_begin(HepMC::parents);
-			  mother != (*p)->production_vertex()->particles_end(HepMC::parents); ++mother)
-			{
-			  HepMC::FourVector moMomentum = (*mother) -> momentum();
-			  float e = moMomentum.e();
-			  //float eta = moMomentum.pseudoRapidity();
-			  if((*mother) -> pdg_id() == 22)
-			    {
-			      dPhoChi2 -> Fill(recoCluster -> get_chi2(), clusE, e);
-			      dPhoProb -> Fill(recoCluster -> get_prob(), clusE, e);
-			    }
-			  else if((*mother) -> pdg_id() == 111)
-			    {
-			      pi0Chi2 -> Fill(recoCluster -> get_chi2(), clusE, e);
-			      pi0Prob -> Fill(recoCluster -> get_prob(), clusE, e);
-			      pi0Frac -> Fill(clusE/e, e);
-			    }
-			  else if((*mother) -> pdg_id() == 221)
-			    {
-			      etaChi2 -> Fill(recoCluster -> get_chi2(), clusE, e);
-			      etaProb -> Fill(recoCluster -> get_prob(), clusE, e);
-			      etaFrac -> Fill(clusE/e, e);
-
-			    }
-		       
-			}
+		      dPhoChi2 -> Fill(recoCluster -> get_chi2(), clusE, e);
+		      dPhoProb -> Fill(recoCluster -> get_prob(), clusE, e);
+		    }
+		  else if(mother -> pdg_id() == 111)
+		    {
+		      pi0Chi2 -> Fill(recoCluster -> get_chi2(), clusE, e);
+		      pi0Prob -> Fill(recoCluster -> get_prob(), clusE, e);
+		      pi0Frac -> Fill(clusE/e, e);
+		    }
+		  else if(mother -> pdg_id() == 221)
+		    {
+		      etaChi2 -> Fill(recoCluster -> get_chi2(), clusE, e);
+		      etaProb -> Fill(recoCluster -> get_prob(), clusE, e);
+		      etaFrac -> Fill(clusE/e, e);
+
 		    }
 		}
 	    }
@@ -555,46 +554,39 @@ int cemcReco::process_event(PHCompositeNode *topNode)
       if(truthPar -> get_pid() != 22) continue;
       if(truthinfo -> isEmbeded(truthPar -> get_track_id()) != 1) continue;
     
-      for(HepMC::GenEvent::particle_const_iterator p = theEvent -> particles_begin(); p != theEvent -> particles_end(); ++p)
+      HepMC::GenParticle *p = ancestry -> GetHepMCParticle(genEmbedId, truthPar -> get_barcode());
+      if(!p || p -> pdg_id() != 22) continue;
+
+      const std::vector<HepMC::GenParticle*> &mothers = ancestry -> GetHepMCParents(genEmbedId, truthPar -> get_barcode());
+      for(HepMC::GenParticle *mother : mothers)
 	{
-	  assert(*p);
-	  if((*p) -> pdg_id()  != 22) continue;
+	   
+	  HepMC::FourVector moMomentum = mother -> momentum();
+	  float e = moMomentum.e();
+	  float eta = moMomentum.pseudoRapidity();
+	  if(mother -> pdg_id() == 22 && abs(eta) < photonEtaMax) 
+	    {
 	      
-	  if((*p) -> barcode() == truthPar -> get_barcode())
+	      truth_dpho_E -> Fill(e);
+	      
+	    }
+	  else if(mother -> pdg_id() == 111 )
 	    {
-	        
-	      for (HepMC::GenVertex::particle_iterator mother = (*p)->production_vertex()->particles_begin(HepMC::parents);
-		   mother != (*p)->production_vertex()->particles_end(HepMC::parents); ++mother)
-		{
-		   
-		  HepMC::FourVector moMomentum = (*mother) -> momentum();
-		  float e = moMomentum.e();
-		  float eta = moMomentum.pseudoRapidity();
-		  if((*mother) -> pdg_id() == 22 && abs(eta) < photonEtaMax) 
-		    {
-		      
-		      truth_dpho_E -> Fill(e);
-		      
-		    }
-		  else if((*mother) -> pdg_id() == 111 )
-		    {
 
-		      phoPi0.push_back(truthPar);//these photons will be unique
-		      vtxIDpi0.push_back((*mother) -> production_vertex());
-		      
-		      mBarCodePi0.push_back((*mother) -> barcode());//barcodes will not be unique, as they'll be added per photon
-		    }
-		  else if((*mother) -> pdg_id() == 221 )
-		    {
-		      
-		      if(abs(eta) < mesonEtaMax &&  abs(getEta(truthPar)) < photonEtaMax && !checkBarcode((*mother) -> barcode(),mBarCodeEta))truth_eta_E -> Fill(e);
-		      phoEta.push_back(truthPar);
-		      vtxIDEta.push_back((*mother) -> production_vertex());
-		      mBarCodeEta.push_back((*mother) -> barcode());
-		    }
-		  
-		}
+	      phoPi0.push_back(truthPar);//these photons will be unique
+	      vtxIDpi0.push_back(mother -> production_vertex());
+	      
+	      mBarCodePi0.push_back(mother -> barcode());//barcodes will not be unique, as they'll be added per photon
 	    }
+	  else if(mother -> pdg_id() == 221 )
+	    {
+	      
+	      if(abs(eta) < mesonEtaMax &&  abs(getEta(truthPar)) < photonEtaMax && !checkBarcode(mother -> barcode(),mBarCodeEta))truth_eta_E -> Fill(e);
+	      phoEta.push_back(truthPar);
+	      vtxIDEta.push_back(mother -> production_vertex());
+	      mBarCodeEta.push_back(mother -> barcode());
+	    }
+	  
 	}
     }
 
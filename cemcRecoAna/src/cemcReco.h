@@ -4,6 +4,7 @@
 #define CEMCRECO_H
 
 #include <fun4all/SubsysReco.h>
+#include <truthancestry/TruthAncestryIndex.h>
 #include <HepMC/SimpleVector.h> 
 #include <vector>
 //TopNode
@@ -150,6 +151,8 @@ class cemcReco : public SubsysReco
   
   //output file
   TFile *out;
+  //truth ancestry, used when no TruthAncestryIndexBuilder runs before us
+  TruthAncestryIndex localAncestry;
   //values
   const float pi = 3.1415926;
   float trackErrorCount;
@@ -53,6 +53,7 @@
 #include <g4main/PHG4VtxPoint.h>
 #include <phhepmc/PHHepMCGenEvent.h>
 #include <phhepmc/PHHepMCGenEventMap.h>
+#include <truthancestry/TruthAncestryIndex.h>
 #pragma GCC diagnostic push 
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <HepMC/GenEvent.h>
@@ -181,7 +182,13 @@ int isoCluster::process_event(PHCompositeNode *topNode)
       return Fun4AllReturnCodes::ABORTEVENT;
     }
    
-  HepMC::GenEvent *theEvent = genEvent -> getEvent();
+  //barcode lookups into the HepMC event, shared with the other modules if the index is on the node tree
+  TruthAncestryIndex *ancestry = findNode::getClass<TruthAncestryIndex>(topNode, "TruthAncestryIndex");
+  if(!ancestry)
+    {
+      ancestry = &localAncestry;
+      ancestry -> Build(genEventMap, truthinfo);
+    }
 
   CaloEvalStack caloevalstack(topNode, "CEMC");
   CaloRawClusterEval *clustereval = caloevalstack.get_rawcluster_eval();
@@ -218,46 +225,24 @@ int isoCluster::process_event(PHCompositeNode *topNode)
       //PHG4Particle* part = truthinfo->GetParticle(truthIter->second->get_trkid())
       
       PHG4Particle *truthPar = truthIter->second;
-      int previousparentid = -999;
       if(truthPar -> get_pid() != 22) continue;//end with a photon
 
-      
-      int parentid = truthPar->get_parent_id();
-      previousparentid = truthPar->get_track_id();
-      while (parentid != 0)
-	{
-	  previousparentid = parentid;
-	  PHG4Particle* mommypart = truthinfo->GetParticle(parentid);
-	  parentid = mommypart->get_parent_id();
-	}
-      
-      if(previousparentid > 0)truthPar = truthinfo -> GetParticle(previousparentid);
+      truthPar = ancestry -> GetG4Primary(truthPar);
       if(truthPar -> get_pid() != 22) continue;//start with a photon
 
-      for(HepMC::GenEvent::particle_const_iterator p = theEvent -> particles_begin(); p != theEvent -> particles_end(); ++p)
+      const std::vector<HepMC::GenParticle*> &mothers = ancestry -> GetHepMCParents(genEvent -> get_embedding_id(), truthPar -> get_barcode());
+      for(HepMC::GenParticle *mother : mothers)
 	{
-	  assert(*p);
-	   
-	  if((*p) -> barcode() == truthPar -> get_barcode())
-	    {
-	      for(HepMC::GenVertex::particle_iterator mother = (*p)->production_vertex()->particles_begin(HepMC::parents);
-		  mother != (*p)->production_vertex()->particles_end(HepMC::parents); ++mother)
-		{
-		  //std::cout << "Mother pid: " << (*mother) -> pdg_id() << std::endl;
-		  //if((*mother) -> pdg_id() != 21 || (*mother) -> pdg_id() != 1 || (*mother) -> pdg_id() != 2) continue;
-		  if((*mother) -> pdg_id() != 22) continue;
-
-		  HepMC::FourVector moMomentum = (*mother) -> momentum();
-
-		  m_photonE.push_back(moMomentum.e());
-		  m_photonEta.push_back(moMomentum.pseudoRapidity());
-		  m_photonPhi.push_back(moMomentum.phi());
-		  m_photonPt.push_back(sqrt(moMomentum.px()*moMomentum.px()+moMomentum.py()*moMomentum.py()));
-		  
-		  
-		}
-		       
-	    }
+	  //std::cout << "Mother pid: " << mother -> pdg_id() << std::endl;
+	  //if(mother -> pdg_id() != 21 || mother -> pdg_id() != 1 || mother -> pdg_id() != 2) continue;
+	  if(mother -> pdg_id() != 22) continue;
+
+	  HepMC::FourVector moMomentum = mother -> momentum();
+
+	  m_photonE.push_back(moMomentum.e());
+	  m_photonEta.push_back(moMomentum.pseudoRapidity());
+	  m_photonPhi.push_back(moMomentum.phi());
+	  m_photonPt.push_back(sqrt(moMomentum.px()*moMomentum.px()+moMomentum.py()*moMomentum.py()));
 	}
     }
 
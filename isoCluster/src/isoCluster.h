@@ -4,6 +4,7 @@
 #define ISOCLUSTER_H
 
 #include <fun4all/SubsysReco.h>
+#include <truthancestry/TruthAncestryIndex.h>
 
 #include <string>
 
@@ -76,6 +77,8 @@ class isoCluster : public SubsysReco
   TFile *fout;
   std::string outname;
   int getEvent;
+  //truth ancestry, used when no TruthAncestryIndexBuilder runs before us
+  TruthAncestryIndex localAncestry;
 };
 
 #endif // ISOCLUSTER_H
@@ -11,6 +11,7 @@
 #include <fun4all/SubsysReco.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -48,6 +49,20 @@ public:
   void do_cluster_eval(bool b) {_do_cluster_eval = b;}
   void do_gtrack_eval(bool b) {_do_gtrack_eval = b;}
   void do_track_eval(bool b) {_do_track_eval = b;}
+  void do_timezero_eval(bool b) {_do_timezero_eval = b;}
+
+  /// only the psTOF start time, no truth ancestry is evaluated
+  void do_timezero_only() {
+    _do_vertex_eval = _do_gpoint_eval = _do_g4hit_eval = _do_hit_eval = false;
+    _do_cluster_eval = _do_gtrack_eval = _do_track_eval = false;
+    _do_timezero_eval = true;
+  }
+
+  void set_pstof_hit_node(const std::string &name) {_pstof_hit_node = name;}
+  void set_magnetic_field(double bz) {_bz = bz;}                   ///< Tesla, signed along z
+  void set_mass_hypothesis(double m) {_mass_hypothesis = m;}      ///< GeV
+  void set_match_window(double drphi, double dz) {_match_drphi = drphi; _match_dz = dz;} ///< cm
+  void set_timezero_window(double dt) {_t0_window = dt;}          ///< ns, around the median
 
   void scan_for_embedded(bool b) {_scan_for_embedded = b;}
   
@@ -71,8 +86,22 @@ public:
   bool _do_cluster_eval;
   bool _do_gtrack_eval;
   bool _do_track_eval;
+  bool _do_timezero_eval;
 
   bool _scan_for_embedded;
+
+  std::string _pstof_hit_node;
+  double _bz;
+  double _mass_hypothesis;
+  double _match_drphi;
+  double _match_dz;
+  double _t0_window;
+  bool _warned_no_pstof;
+
+  // psTOF hits of the current event
+  std::vector<float> _hit_x, _hit_y, _hit_z, _hit_r, _hit_phi, _hit_t;
+  // start time of each matched track
+  std::vector<float> _t0_tracks;
   
   TNtuple *_ntp_vertex;
   TNtuple *_ntp_gpoint;
@@ -81,6 +110,8 @@ public:
   TNtuple *_ntp_cluster;
   TNtuple *_ntp_gtrack;
   TNtuple *_ntp_track;
+  TNtuple *_ntp_pstof;
+  TNtuple *_ntp_timezero;
 
   // evaluator output file
   std::string _filename;
@@ -90,6 +121,9 @@ public:
   void fillOutputNtuples(PHCompositeNode* topNode); ///< dump the evaluator information into ntuple for external analysis
   void printInputInfo(PHCompositeNode* topNode);    ///< print out the input object information (debugging upstream components)
   void printOutputInfo(PHCompositeNode* topNode);   ///< print out the ancestry information for detailed diagnosis
+  void fillTimezero(PHCompositeNode* topNode);      ///< match tracks to psTOF hits and estimate the event start time
+
+  bool need_evalstack() const;                      ///< any requested output uses the truth ancestry
 };
 
 #endif // SVTXEVALUATOR_HAIWANG_H__